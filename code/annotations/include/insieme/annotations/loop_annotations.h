@@ -44,8 +44,11 @@
 #pragma once
 
 
+#include <map>
+
 #include "insieme/utils/annotation.h"
 #include "insieme/core/ir_expressions.h"
+#include "insieme/core/ir_statements.h"
 
 namespace insieme {
 namespace annotations {
@@ -86,6 +89,72 @@ namespace annotations {
 
 	typedef std::shared_ptr<LoopAnnotation> LoopAnnotationPtr;
 
+
+	/**
+	 * An annotation attached to a function listing the loops within its body which have been proven
+	 * to be free of loop-carried dependences and to only access arrays which are not aliased. Such
+	 * loops may be vectorized safely. The facts are only valid for the annotated function instance,
+	 * thus the annotation is not migrated when the function is transformed.
+	 */
+	class VectorizationAnnotation : public NodeAnnotation {
+		vector<ForStmtPtr> loops;
+
+	  public:
+		static const string NAME;
+		static const utils::StringKey<VectorizationAnnotation> KEY;
+
+		const utils::AnnotationKeyPtr getKey() const {
+			return &KEY;
+		}
+		const std::string& getAnnotationName() const {
+			return NAME;
+		}
+
+		VectorizationAnnotation(const vector<ForStmtPtr>& loops) : loops(loops) {}
+
+		const vector<ForStmtPtr>& getLoops() const;
+
+		virtual void clone(const core::NodeAnnotationPtr& ptr, const core::NodePtr& copy) const;
+
+		static void attach(const NodePtr& node, const vector<ForStmtPtr>& loops);
+		static bool hasAttachedValue(const NodePtr& node);
+		static const vector<ForStmtPtr>& getValue(const NodePtr& node);
+	};
+
+	typedef std::shared_ptr<VectorizationAnnotation> VectorizationAnnotationPtr;
+
+
+	/**
+	 * An annotation attached to a function listing the reference parameters which have been proven
+	 * not to alias any other memory location accessed through it. For each of those parameters the
+	 * alignment guaranteed for the referenced memory in bytes is recorded, 0 if unknown. Like the
+	 * VectorizationAnnotation it is not migrated when the function is transformed.
+	 */
+	class NoAliasAnnotation : public NodeAnnotation {
+		std::map<unsigned, unsigned> alignments;
+
+	  public:
+		static const string NAME;
+		static const utils::StringKey<NoAliasAnnotation> KEY;
+
+		const utils::AnnotationKeyPtr getKey() const {
+			return &KEY;
+		}
+		const std::string& getAnnotationName() const {
+			return NAME;
+		}
+
+		NoAliasAnnotation(const std::map<unsigned, unsigned>& alignments) : alignments(alignments) {}
+
+		const std::map<unsigned, unsigned>& getAlignments() const;
+
+		static void attach(const NodePtr& node, const std::map<unsigned, unsigned>& alignments);
+		static bool hasAttachedValue(const NodePtr& node);
+		static const std::map<unsigned, unsigned>& getValue(const NodePtr& node);
+	};
+
+	typedef std::shared_ptr<NoAliasAnnotation> NoAliasAnnotationPtr;
+
 } // end namespace insieme
 } // end namespace annotations
 
@@ -93,4 +162,8 @@ namespace std {
 
 	std::ostream& operator<<(std::ostream& out, const insieme::annotations::LoopAnnotation& lAnnot);
 
+	std::ostream& operator<<(std::ostream& out, const insieme::annotations::VectorizationAnnotation& vAnnot);
+
+	std::ostream& operator<<(std::ostream& out, const insieme::annotations::NoAliasAnnotation& aAnnot);
+
 } // end namespace std
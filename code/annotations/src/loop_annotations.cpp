@@ -45,8 +45,10 @@
 
 #include "insieme/core/transform/node_replacer.h"
 #include "insieme/core/encoder/encoder.h"
+#include "insieme/core/encoder/maps.h"
 
 #include "insieme/utils/container_utils.h"
+#include "insieme/utils/map_utils.h"
 
 #include "insieme/core/dump/annotations.h"
 
@@ -75,6 +77,55 @@ namespace annotations {
 		return node->getAnnotation(LoopAnnotation::KEY)->getIterations();
 	}
 
+	const string VectorizationAnnotation::NAME = "VectorizationAnnotation";
+	const utils::StringKey<VectorizationAnnotation> VectorizationAnnotation::KEY("Vectorization");
+
+	const vector<ForStmtPtr>& VectorizationAnnotation::getLoops() const {
+		return loops;
+	}
+
+	void VectorizationAnnotation::clone(const core::NodeAnnotationPtr& ptr, const core::NodePtr& copy) const {
+		// the listed loops have to be maintained by the manager of the copy
+		vector<ForStmtPtr> copies;
+		for(const auto& cur : loops) {
+			copies.push_back(copy->getNodeManager().get(cur));
+		}
+		attach(copy, copies);
+	}
+
+	void VectorizationAnnotation::attach(const core::NodePtr& node, const vector<ForStmtPtr>& loops) {
+		node->addAnnotation(std::make_shared<VectorizationAnnotation>(loops));
+	}
+
+	bool VectorizationAnnotation::hasAttachedValue(const core::NodePtr& node) {
+		return node->hasAnnotation(VectorizationAnnotation::KEY);
+	}
+
+	const vector<ForStmtPtr>& VectorizationAnnotation::getValue(const core::NodePtr& node) {
+		assert_true(hasAttachedValue(node)) << "Vectorization Annotation has to be attached!";
+		return node->getAnnotation(VectorizationAnnotation::KEY)->getLoops();
+	}
+
+	const string NoAliasAnnotation::NAME = "NoAliasAnnotation";
+	const utils::StringKey<NoAliasAnnotation> NoAliasAnnotation::KEY("NoAlias");
+
+	const std::map<unsigned, unsigned>& NoAliasAnnotation::getAlignments() const {
+		return alignments;
+	}
+
+	void NoAliasAnnotation::attach(const core::NodePtr& node, const std::map<unsigned, unsigned>& alignments) {
+		node->addAnnotation(std::make_shared<NoAliasAnnotation>(alignments));
+	}
+
+	bool NoAliasAnnotation::hasAttachedValue(const core::NodePtr& node) {
+		return node->hasAnnotation(NoAliasAnnotation::KEY);
+	}
+
+	const std::map<unsigned, unsigned>& NoAliasAnnotation::getValue(const core::NodePtr& node) {
+		assert_true(hasAttachedValue(node)) << "No-Alias Annotation has to be attached!";
+		return node->getAnnotation(NoAliasAnnotation::KEY)->getAlignments();
+	}
+
 	namespace {
 
 		ANNOTATION_CONVERTER(LoopAnnotation)
@@ -89,6 +140,27 @@ namespace annotations {
 			return std::make_shared<LoopAnnotation>(core::encoder::toValue<size_t>(node));
 		};
 	};
+
+		ANNOTATION_CONVERTER(NoAliasAnnotation)
+
+		core::ExpressionPtr toIR(core::NodeManager& manager, const core::NodeAnnotationPtr& annotation) const {
+			assert(dynamic_pointer_cast<NoAliasAnnotation>(annotation) && "Only supports the conversion of No-Alias Annotations!");
+			std::map<uint32_t, uint32_t> alignments;
+			for(const auto& cur : static_pointer_cast<NoAliasAnnotation>(annotation)->getAlignments()) {
+				alignments[cur.first] = cur.second;
+			}
+			return core::encoder::toIR(manager, alignments);
+		};
+
+		core::NodeAnnotationPtr toAnnotation(const core::ExpressionPtr& node) const {
+			assert((core::encoder::isEncodingOf<std::map<uint32_t, uint32_t>>(node)) && "Invalid Encoding!");
+			std::map<unsigned, unsigned> alignments;
+			for(const auto& cur : core::encoder::toValue<std::map<uint32_t, uint32_t>>(node)) {
+				alignments[cur.first] = cur.second;
+			}
+			return std::make_shared<NoAliasAnnotation>(alignments);
+		};
+	};
 }
 
 } // namespace annotations
@@ -102,4 +174,16 @@ namespace std {
 		return out;
 	}
 
+	std::ostream& operator<<(std::ostream& out, const insieme::annotations::VectorizationAnnotation& vAnnot) {
+		out << "VectorizationAnnotation:\n";
+		out << "Loops: " << vAnnot.getLoops().size() << std::endl;
+		return out;
+	}
+
+	std::ostream& operator<<(std::ostream& out, const insieme::annotations::NoAliasAnnotation& aAnnot) {
+		out << "NoAliasAnnotation:\n";
+		out << "Alignments: " << aAnnot.getAlignments() << std::endl;
+		return out;
+	}
+
 } // end namespace std
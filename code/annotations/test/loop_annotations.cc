@@ -41,6 +41,7 @@
 
 #include "insieme/core/ir_builder.h"
 #include "insieme/core/dump/binary_dump.h"
+#include "insieme/core/transform/node_replacer.h"
 
 namespace insieme {
 namespace annotations {
@@ -118,6 +119,57 @@ namespace annotations {
 		//		EXPECT_FALSE(restored3->hasAttachedValue<DummyAnnotation>());
 	}
 
+	TEST(NoAliasAnnotation, BinaryDumpTest) {
+		NodeManager managerA;
+		IRBuilder builder(managerA);
+
+		NodePtr fun = builder.parseExpr("(a : ref<ptr<int<4>>>, b : ref<ptr<int<4>>>) -> unit { }");
+
+		EXPECT_TRUE(fun);
+
+		// attach the facts
+		EXPECT_FALSE(NoAliasAnnotation::hasAttachedValue(fun));
+
+		NoAliasAnnotation::attach(fun, {{0, 16}, {1, 0}});
+		ASSERT_TRUE(NoAliasAnnotation::hasAttachedValue(fun));
+		EXPECT_EQ((std::map<unsigned, unsigned>{{0, 16}, {1, 0}}), NoAliasAnnotation::getValue(fun));
+
+		// dump to binary and restore within a different manager
+		stringstream buffer(ios_base::out | ios_base::in | ios_base::binary);
+		core::dump::binary::dumpIR(buffer, fun);
+
+		NodeManager managerB;
+		NodePtr restored = core::dump::binary::loadIR(buffer, managerB);
+		EXPECT_EQ(*fun, *restored);
+
+		ASSERT_TRUE(NoAliasAnnotation::hasAttachedValue(restored));
+		EXPECT_EQ((std::map<unsigned, unsigned>{{0, 16}, {1, 0}}), NoAliasAnnotation::getValue(restored));
+	}
+
+	TEST(VectorizationAnnotation, Clone) {
+		NodeManager managerA;
+		IRBuilder builder(managerA);
+
+		auto fun = builder.parseExpr("() -> unit { for(int<4> i = 0 .. 10 : 1) { } }").as<LambdaExprPtr>();
+		auto loop = fun->getBody()[0].as<ForStmtPtr>();
+
+		EXPECT_FALSE(VectorizationAnnotation::hasAttachedValue(fun));
+		VectorizationAnnotation::attach(fun, toVector(loop));
+		ASSERT_TRUE(VectorizationAnnotation::hasAttachedValue(fun));
+
+		// the loops have to be maintained by the target manager
+		NodeManager managerB;
+		auto copy = managerB.get(fun);
+		ASSERT_TRUE(VectorizationAnnotation::hasAttachedValue(copy));
+		ASSERT_EQ(1u, VectorizationAnnotation::getValue(copy).size());
+		EXPECT_EQ(copy->getBody()[0], VectorizationAnnotation::getValue(copy)[0]);
+		EXPECT_EQ(&managerB, &VectorizationAnnotation::getValue(copy)[0]->getNodeManager());
+
+		// transformed functions lose the facts
+		auto modified = core::transform::replaceAll(managerA, fun, loop, builder.compoundStmt(), core::transform::globalReplacement);
+		EXPECT_NE(fun, modified);
+		EXPECT_FALSE(VectorizationAnnotation::hasAttachedValue(modified));
+	}
 
 } // end namespace annotations
 } // end namespace insieme
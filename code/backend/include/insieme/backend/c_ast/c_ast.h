@@ -169,9 +169,11 @@ namespace c_ast {
 
 	struct PointerType : public CVQualifiedType {
 		TypePtr elementType;
-		PointerType(TypePtr elementType, bool isConst = false, bool isVolatile = false)
-			: CVQualifiedType(NT_PointerType, isConst, isVolatile), elementType(elementType) {}
+		bool mRestrict;
+		PointerType(TypePtr elementType, bool isConst = false, bool isVolatile = false, bool isRestrict = false)
+			: CVQualifiedType(NT_PointerType, isConst, isVolatile), elementType(elementType), mRestrict(isRestrict) {}
 		virtual bool equals(const Node& other) const;
+		bool isRestrict() const { return mRestrict; }
 	};
 
 	struct ReferenceType : public CVQualifiedType {
@@ -308,6 +310,8 @@ namespace c_ast {
 		StatementPtr check;
 		StatementPtr step;
 		StatementPtr body;
+		// pragmas to be printed in front of the loop (e.g. vectorization hints)
+		vector<string> pragmas;
 		For(StatementPtr init, StatementPtr check, StatementPtr step, StatementPtr body)
 		    : Statement(NT_For), init(init), check(check), step(step), body(body) {}
 		virtual bool equals(const Node& node) const;
@@ -151,8 +151,8 @@ namespace c_ast {
 
 	// --- types ------------------------------------------------
 
-	inline PointerTypePtr ptr(const TypePtr& type, bool isConst = false, bool isVolatile = false) {
-		return type->getManager()->create<c_ast::PointerType>(type, isConst, isVolatile);
+	inline PointerTypePtr ptr(const TypePtr& type, bool isConst = false, bool isVolatile = false, bool isRestrict = false) {
+		return type->getManager()->create<c_ast::PointerType>(type, isConst, isVolatile, isRestrict);
 	}
 
 	inline ReferenceTypePtr ref(const TypePtr& type, bool isConst = false, bool isVolatile = false) {
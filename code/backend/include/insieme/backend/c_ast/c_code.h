@@ -36,9 +36,11 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include <set>
+#include <stdexcept>
 
 #include "insieme/backend/backend.h"
 #include "insieme/backend/c_ast/c_ast.h"
@@ -107,6 +109,46 @@ namespace backend {
 		};
 
 
+		/**
+		 * An exception raised in case code could not be written to its destination.
+		 */
+		class CodeEmissionException : public std::runtime_error {
+		  public:
+			CodeEmissionException(const string& msg) : std::runtime_error(msg) {}
+		};
+
+		/**
+		 * A set of options controlling the way a C code instance is streamed into files.
+		 */
+		struct CodeEmissionOptions {
+			/**
+			 * The number of translation units the code should be distributed among. If set to 1, a single
+			 * source file is produced. Otherwise a shared header and the given number of source files are
+			 * created, where function definitions are spread over all units.
+			 */
+			unsigned numUnits;
+
+			/**
+			 * The size of the write buffer utilized for each of the produced files.
+			 */
+			std::size_t bufferSize;
+
+			/**
+			 * If set, the C AST nodes referenced by code fragments are dropped as soon as the fragment has
+			 * been written. After that, the code instance can not be printed again.
+			 */
+			bool releaseFragments;
+
+			/**
+			 * A map of includes which may only be included by the primary translation unit (e.g. since they
+			 * contain definitions) to a declaration-only replacement to be included by the shared header.
+			 * An empty replacement indicates that the include is simply omitted within the shared header.
+			 */
+			std::map<string, string> primaryIncludes;
+
+			CodeEmissionOptions() : numUnits(1), bufferSize(1 << 20), releaseFragments(false) {}
+		};
+
 		/**
 		 * A class representing a C based target code.
 		 */
@@ -160,6 +202,19 @@ namespace backend {
 			 * to the Printable interface.
 			 */
 			virtual std::ostream& printTo(std::ostream& out) const;
+
+			/**
+			 * Streams this code into the file(s) derived from the given file name. Fragments are written one
+			 * by one in their topological order through a buffered writer, without ever materializing the
+			 * full program text in memory. If multiple units are requested, a shared header named like the
+			 * given file with a .h extension is created next to the source files <stem>_<i><ext>.
+			 *
+			 * @param file the name of the (primary) file to be written
+			 * @param options the options controlling the emission process
+			 * @return the list of source files produced, the first one being the primary unit
+			 * @throws CodeEmissionException if any of the files could not be written
+			 */
+			vector<string> writeTo(const string& file, const CodeEmissionOptions& options = CodeEmissionOptions()) const;
 		};
 
 		/**
@@ -424,6 +479,14 @@ namespace backend {
 			 * @param processor the post-processor to be applied on this fragment.
 			 */
 			void apply(const PostProcessorPtr& processor);
+
+			/**
+			 * Drops the references to the C AST nodes covered by this fragment. This fragment will
+			 * print as empty afterwards.
+			 */
+			void release() {
+				vector<NodePtr>().swap(code);
+			}
 		};
 
 		/**
@@ -46,6 +46,8 @@
 
 #include "insieme/backend/backend_config.h"
 
+#include "insieme/utils/set_utils.h"
+
 namespace insieme {
 namespace backend {
 
@@ -310,6 +312,11 @@ namespace backend {
 		 */
 		std::set<string> includes;
 
+		/**
+		 * The loops within the entry point proven to be safely vectorizable.
+		 */
+		utils::set::PointerSet<core::ForStmtPtr> vectorizableLoops;
+
 	  public:
 		/**
 		 * Creates a new, empty context instance to be used during a conversion
@@ -318,7 +325,7 @@ namespace backend {
 		 * @param converter the converter which will be using the resulting context.
 		 */
 		ConversionContext(const Converter& converter, const core::LambdaPtr& entryPoint = core::LambdaPtr())
-		    : converter(converter), entryPoint(entryPoint), dependencies(), requirements(), variableManager(), includes() {}
+		    : converter(converter), entryPoint(entryPoint), dependencies(), requirements(), variableManager(), includes(), vectorizableLoops() {}
 
 		const Converter& getConverter() const {
 			return converter;
@@ -363,6 +370,10 @@ namespace backend {
 		void addInclude(const string& include) {
 			includes.insert(include);
 		}
+
+		utils::set::PointerSet<core::ForStmtPtr>& getVectorizableLoops() {
+			return vectorizableLoops;
+		}
 	};
 
 
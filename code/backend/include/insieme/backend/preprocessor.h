@@ -201,5 +201,17 @@ namespace backend {
 		virtual core::NodePtr process(const Converter& converter, const core::NodePtr& code);
 	};
 
+	/**
+	 * Analyses the bodies of pfor operations and attaches facts enabling the generation of
+	 * vectorization-friendly code: reference parameters bound to unaliased allocations are
+	 * marked to be non-aliasing and innermost loops free of loop-carried dependences are
+	 * marked to be vectorizable. Since those facts only hold for a specific call, every proven
+	 * call is redirected to a distinct instance of its body function carrying the facts.
+	 */
+	class VectorizationHints : public PreProcessor {
+	  public:
+		virtual core::NodePtr process(const Converter& converter, const core::NodePtr& code);
+	};
+
 } // end namespace backend
 } // end namespace insieme
@@ -36,6 +36,9 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
 #include "insieme/backend/backend.h"
 
 namespace insieme {
@@ -74,6 +77,14 @@ namespace runtime {
 		 */
 		static RuntimeBackendPtr getDefault(bool includeEffortEstimation = false, bool isGemsclaim = false);
 
+		/**
+		 * Obtains the runtime headers which may only be included by the primary translation unit when
+		 * distributing the generated code among multiple units, mapped to their declaration-only replacement.
+		 *
+		 * @return a map suitable for c_ast::CodeEmissionOptions::primaryIncludes
+		 */
+		static std::map<std::string, std::string> getPrimaryIncludes();
+
 
 	  protected:
 		/**
@@ -173,7 +173,7 @@ namespace c_ast {
 	bool PointerType::equals(const Node& type) const {
 		assert(dynamic_cast<const PointerType*>(&type));
 		const auto& other = static_cast<const PointerType&>(type);
-		return CVQualifiedType::equals(other) && *elementType == *other.elementType;
+		return CVQualifiedType::equals(other) && mRestrict == other.mRestrict && *elementType == *other.elementType;
 	}
 
 	bool ReferenceType::equals(const Node& node) const {
@@ -285,7 +285,7 @@ namespace c_ast {
 	bool For::equals(const Node& node) const {
 		assert(dynamic_cast<const For*>(&node));
 		auto other = static_cast<const For&>(node);
-		return *init == *other.init && *check == *other.check && *step == *other.step && *body == *other.body;
+		return *init == *other.init && *check == *other.check && *step == *other.step && *body == *other.body && pragmas == other.pragmas;
 	}
 
 	bool While::equals(const Node& node) const {
@@ -353,6 +353,11 @@ namespace c_ast {
 			}
 
 			PRINT(For) {
+				for(const auto& cur : node->pragmas) {
+					out << "#pragma " << cur;
+					newLine(out);
+				}
+
 				out << "for (" << print(node->init) << "; " << print(node->check) << "; " << print(node->step) << ") ";
 
 				NodePtr body = node->body;
@@ -826,7 +831,7 @@ namespace c_ast {
 		}
 
 		enum PointerQualifier {
-			PLAIN = 0, CONST = 1, VOLATILE = 2
+			PLAIN = 0, CONST = 1, VOLATILE = 2, RESTRICT = 4
 		};
 
 		struct TypeLevel {
@@ -899,7 +904,7 @@ namespace c_ast {
 				cur = static_pointer_cast<PointerType>(cur)->elementType;
 				res.qualifier.push_back(
 						PointerQualifier(
-							((ptr->isConst()) ? CONST : PLAIN) | ((ptr->isVolatile()) ? VOLATILE : PLAIN)
+							((ptr->isConst()) ? CONST : PLAIN) | ((ptr->isVolatile()) ? VOLATILE : PLAIN) | ((ptr->isRestrict()) ? RESTRICT : PLAIN)
 						)
 				);
 			}
@@ -928,6 +933,7 @@ namespace c_ast {
 				out << "*";
 				if (*it & CONST) out << " const";
 				if (*it & VOLATILE) out << " volatile";
+				if (*it & RESTRICT) out << " __restrict";
 			}
 
 			++level_it;
@@ -38,6 +38,7 @@
 
 #include <fstream>
 
+#include <boost/filesystem.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
@@ -48,6 +49,7 @@
 #include "insieme/utils/graph_utils.h"
 
 #include "insieme/utils/logging.h"
+#include "insieme/utils/string_utils.h"
 
 namespace insieme {
 namespace backend {
@@ -61,25 +63,188 @@ namespace c_ast {
 	CCode::CCode(const SharedCodeFragmentManager& manager, const core::NodePtr& source, const vector<CodeFragmentPtr>& fragments)
 	    : TargetCode(source), fragmentManager(manager), fragments(fragments) {}
 
+	namespace {
+
+		std::ostream& printFileHeader(std::ostream& out) {
+			out << "/**\n";
+			out << " * ------------------------ Auto-generated Code ------------------------ \n";
+			out << " *           This code was generated by the Insieme Compiler \n";
+			out << " * --------------------------------------------------------------------- \n";
+			return out << " */\n";
+		}
+
+		std::set<string> collectIncludes(const vector<CodeFragmentPtr>& fragments) {
+			std::set<string> includes;
+			for_each(fragments, [&](const CodeFragmentPtr& cur) { includes.insert(cur->getIncludes().begin(), cur->getIncludes().end()); });
+			return includes;
+		}
+
+		std::ostream& printInclude(std::ostream& out, const string& include) {
+			if(include.empty()) { return out; }
+			if(include[0] == '<' || include[0] == '"') { return out << "#include " << include << "\n"; }
+			return out << "#include <" << include << ">\n";
+		}
+
+		/**
+		 * The placement of a fragment when distributing code among multiple translation units.
+		 */
+		enum Placement {
+			SHARED,      // < may be placed within the shared header (declarations, type definitions, inline functions)
+			DISTRIBUTED, // < may be placed within any of the translation units (non-static function definitions)
+			PRIMARY,     // < has to be placed within the primary unit, but the rest of the code may refer to it
+			PINNED       // < has to be placed within the primary unit and is not accessible from other units
+		};
+
+		bool isSharedElement(const NodePtr& cur) {
+			switch(cur->getType()) {
+			case NT_Comment:
+			case NT_OpaqueCode:
+			case NT_TypeDeclaration:
+			case NT_TypeDefinition:
+			case NT_FunctionPrototype: return true;
+			case NT_GlobalVarDecl: return static_pointer_cast<GlobalVarDecl>(cur)->external;
+			case NT_Function: return static_pointer_cast<Function>(cur)->flags & Function::INLINE;
+			case NT_ExternC: return all(static_pointer_cast<ExternC>(cur)->definitions, [](const TopLevelElementPtr& def) { return isSharedElement(def); });
+			default: return false;
+			}
+		}
+
+		bool isStaticFunction(const NodePtr& cur) {
+			return cur->getType() == NT_Function && (static_pointer_cast<Function>(cur)->flags & Function::STATIC);
+		}
+
+		bool isDistributableElement(const NodePtr& cur) {
+			return cur->getType() == NT_Comment || (cur->getType() == NT_Function && !isSharedElement(cur) && !isStaticFunction(cur));
+		}
+
+		Placement getPlacement(const CodeFragmentPtr& fragment) {
+			// dummy and include fragments are not producing any code
+			if(fragment.isa<DummyFragmentPtr>() || fragment.isa<IncludeFragmentPtr>()) { return SHARED; }
+
+			// other special-purpose fragments are opaque => keep them in the primary unit
+			CCodeFragmentPtr code = fragment.isa<CCodeFragmentPtr>();
+			if(!code) { return PINNED; }
+
+			// classify C code fragments based on their top-level elements
+			const vector<NodePtr>& elements = code->getCode();
+			if(all(elements, &isSharedElement)) { return SHARED; }
+			if(all(elements, &isDistributableElement)) {
+				// the entry point remains within the primary unit
+				bool isMain = any(elements, [](const NodePtr& cur) {
+					return cur->getType() == NT_Function && static_pointer_cast<Function>(cur)->name->name == "main";
+				});
+				return (isMain) ? PRIMARY : DISTRIBUTED;
+			}
+			if(any(elements, [](const NodePtr& cur) { return cur->getType() == NT_VarDecl && static_pointer_cast<VarDecl>(cur)->isStatic; })) { return PINNED; }
+
+			// static functions would be duplicated within every unit including them => keep them in the primary unit
+			if(any(elements, &isStaticFunction)) { return PINNED; }
+			return PRIMARY;
+		}
+
+		/**
+		 * Determines the placement of all the given fragments, which have to be in topological order. Code depending
+		 * (transitively) on inaccessible code needs to be placed within the primary unit too.
+		 */
+		std::map<CodeFragmentPtr, Placement> getPlacements(const vector<CodeFragmentPtr>& fragments) {
+			std::map<CodeFragmentPtr, Placement> res;
+			for(const auto& cur : fragments) {
+				Placement placement = getPlacement(cur);
+				bool dependsOnPinned = any(cur->getDependencies(), [&](const CodeFragmentPtr& dep) {
+					auto pos = res.find(dep);
+					return ((pos != res.end()) ? pos->second : getPlacement(dep)) == PINNED;
+				});
+				if(dependsOnPinned) {
+					// shared code would end up in front of the inaccessible code => it becomes inaccessible itself
+					if(placement == SHARED) { placement = PINNED; }
+					if(placement == DISTRIBUTED) { placement = PRIMARY; }
+				}
+				res[cur] = placement;
+			}
+			return res;
+		}
+
+		/**
+		 * Obtains the declarations to be added to the shared header to make the definitions within the given
+		 * non-shared fragment accessible from within other translation units.
+		 */
+		vector<NodePtr> getExternalDeclarations(CNodeManager& manager, const CCodeFragmentPtr& fragment) {
+			vector<NodePtr> res;
+			for(const NodePtr& cur : fragment->getCode()) {
+				switch(cur->getType()) {
+				case NT_Function: {
+					if(!isSharedElement(cur)) { res.push_back(manager.create<FunctionPrototype>(static_pointer_cast<Function>(cur))); }
+					break;
+				}
+				case NT_GlobalVarDecl: {
+					auto decl = static_pointer_cast<GlobalVarDecl>(cur);
+					if(!decl->external) { res.push_back(manager.create<GlobalVarDecl>(decl->type, decl->name, true)); }
+					break;
+				}
+				case NT_VarDecl: {
+					for(const auto& var : static_pointer_cast<VarDecl>(cur)->varInit) {
+						res.push_back(manager.create<GlobalVarDecl>(var.first->type, var.first->name->name, true));
+					}
+					break;
+				}
+				default: break;
+				}
+			}
+			return res;
+		}
+
+		/**
+		 * A buffered output file utilized for streaming code fragments to the disk.
+		 */
+		class OutputFile : boost::noncopyable {
+			string name;
+			vector<char> buffer;
+			std::ofstream out;
+
+		  public:
+			OutputFile(const string& name, std::size_t bufferSize) : name(name), buffer(bufferSize) {
+				// the buffer has to be installed before opening the file
+				if(bufferSize > 0) { out.rdbuf()->pubsetbuf(&buffer[0], buffer.size()); }
+				out.open(name, std::ofstream::out | std::ofstream::trunc);
+				if(!out.is_open()) { throw CodeEmissionException(format("Unable to open file %s for writing!", name.c_str())); }
+			}
+
+			std::ofstream& stream() {
+				return out;
+			}
+
+			/**
+			 * Verifies that all data written so far could be handed to the file.
+			 */
+			void check() {
+				if(out.fail()) { throw CodeEmissionException(format("Unable to write to file %s!", name.c_str())); }
+			}
+
+			/**
+			 * Flushes and closes the file, verifying that all data has been written.
+			 */
+			void close() {
+				out.flush();
+				out.close();
+				check();
+			}
+
+			std::streamoff size() {
+				return out.tellp();
+			}
+		};
+
+		void releaseFragment(const CodeFragmentPtr& fragment) {
+			if(auto code = fragment.isa<CCodeFragmentPtr>()) { code->release(); }
+		}
+	}
+
 	std::ostream& CCode::printTo(std::ostream& out) const {
 		// print a header
-		out << "/**\n";
-		out << " * ------------------------ Auto-generated Code ------------------------ \n";
-		out << " *           This code was generated by the Insieme Compiler \n";
-		out << " * --------------------------------------------------------------------- \n";
-		out << " */\n";
+		printFileHeader(out);
 
 		// collect and add includes
-		std::set<string> includes;
-		for_each(fragments, [&](const CodeFragmentPtr& cur) { includes.insert(cur->getIncludes().begin(), cur->getIncludes().end()); });
-		for_each(includes, [&](const string& cur) {
-			if(cur.empty()) { return; }
-			if(cur[0] == '<' || cur[0] == '"') {
-				out << "#include " << cur << "\n";
-			} else {
-				out << "#include <" << cur << ">\n";
-			}
-		});
+		for_each(collectIncludes(fragments), [&](const string& cur) { printInclude(out, cur); });
 
 		out << "\n";
 
@@ -88,6 +253,109 @@ namespace c_ast {
 		return out << "\n";
 	}
 
+	vector<string> CCode::writeTo(const string& file, const CodeEmissionOptions& options) const {
+		assert_gt(options.numUnits, 0u) << "At least one translation unit is required!";
+
+		// the single-unit case => just stream the fragments into the target file
+		if(options.numUnits == 1u) {
+			OutputFile out(file, options.bufferSize);
+			printFileHeader(out.stream());
+			for_each(collectIncludes(fragments), [&](const string& cur) { printInclude(out.stream(), cur); });
+			out.stream() << "\n";
+			for(const auto& cur : fragments) {
+				out.stream() << *cur;
+				out.check();
+				if(options.releaseFragments) { releaseFragment(cur); }
+			}
+			out.stream() << "\n";
+			out.close();
+			return toVector(file);
+		}
+
+		// the multi-unit case => create the shared header and the translation units
+		boost::filesystem::path path(file);
+		string header = path.filename().replace_extension(".h").string();
+		vector<string> files;
+		for(unsigned i = 0; i < options.numUnits; ++i) {
+			boost::filesystem::path unit = path.parent_path() / (path.stem().string() + "_" + toString(i) + path.extension().string());
+			files.push_back(unit.string());
+		}
+
+		OutputFile headerFile((path.parent_path() / header).string(), options.bufferSize);
+		vector<std::unique_ptr<OutputFile>> units;
+		for(const auto& cur : files) {
+			units.push_back(std::unique_ptr<OutputFile>(new OutputFile(cur, options.bufferSize)));
+		}
+
+		// print the file headers
+		std::ostream& shared = headerFile.stream();
+		printFileHeader(shared);
+		shared << "#pragma once\n\n";
+		for(const auto& cur : units) {
+			printFileHeader(cur->stream());
+		}
+
+		// add includes - those restricted to the primary unit are replaced within the shared header
+		for(const auto& cur : collectIncludes(fragments)) {
+			auto pos = options.primaryIncludes.find(cur);
+			if(pos == options.primaryIncludes.end()) {
+				printInclude(shared, cur);
+			} else {
+				printInclude(shared, pos->second);
+				printInclude(units[0]->stream(), cur);
+			}
+		}
+		shared << "\n";
+
+		// let all translation units include the shared header
+		for(const auto& cur : units) {
+			cur->stream() << "#include \"" << header << "\"\n\n";
+		}
+
+		// stream fragments in topological order to their destination
+		CNodeManager& manager = *fragmentManager->getNodeManager();
+		auto placements = getPlacements(fragments);
+		for(const auto& cur : fragments) {
+			switch(placements[cur]) {
+			case SHARED: shared << *cur; break;
+			case PINNED: units[0]->stream() << *cur; break;
+			case PRIMARY:
+			case DISTRIBUTED: {
+				// make definitions accessible from other units
+				for(const auto& decl : getExternalDeclarations(manager, static_pointer_cast<CCodeFragment>(cur))) {
+					shared << CPrint(decl);
+				}
+
+				// primary code stays in the first unit, distributed code goes to the smallest unit so far
+				OutputFile* target = units[0].get();
+				if(placements[cur] == DISTRIBUTED) {
+					for(const auto& unit : units) {
+						if(unit->size() < target->size()) { target = unit.get(); }
+					}
+				}
+				target->stream() << *cur;
+				break;
+			}
+			}
+
+			// detect write errors early
+			headerFile.check();
+			for(const auto& unit : units) {
+				unit->check();
+			}
+
+			if(options.releaseFragments) { releaseFragment(cur); }
+		}
+
+		// make sure everything has been written
+		headerFile.close();
+		for(const auto& cur : units) {
+			cur->close();
+		}
+
+		return files;
+	}
+
 	// -- Code Fragment Manager -------------------------------------------------
 
 	CodeFragmentManager::~CodeFragmentManager() {
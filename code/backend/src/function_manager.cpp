@@ -62,6 +62,7 @@
 
 #include "insieme/annotations/c/include.h"
 #include "insieme/annotations/c/extern_c.h"
+#include "insieme/annotations/loop_annotations.h"
 
 #include "insieme/utils/map_utils.h"
 #include "insieme/utils/logging.h"
@@ -129,7 +130,7 @@ namespace backend {
 			// -------- utilities -----------
 
 			FunctionCodeInfo resolveFunction(const c_ast::IdentifierPtr name, const core::FunctionTypePtr& funType, const core::LambdaPtr& lambda,
-			                                 bool external, bool isConst = false);
+			                                 bool external, bool isConst = false, const core::LambdaExprPtr& instance = core::LambdaExprPtr());
 
 			std::pair<c_ast::IdentifierPtr, c_ast::CodeFragmentPtr> resolveLambdaWrapper(const c_ast::FunctionPtr& function,
 			                                                                             const core::FunctionTypePtr& funType, bool external);
@@ -929,7 +930,7 @@ namespace backend {
 
 				// create dummy function ... no body
 				core::LambdaPtr body;
-				FunctionCodeInfo codeInfo = resolveFunction(name, funType, body, false);
+				FunctionCodeInfo codeInfo = resolveFunction(name, funType, body, false, false, lambda);
 				info->function = codeInfo.function;
 
 				auto wrapper = resolveLambdaWrapper(codeInfo.function, funType, false);
@@ -1012,7 +1013,7 @@ namespace backend {
 
 				// resolve function ... now with body
 				const core::FunctionTypePtr& funType = static_pointer_cast<const core::FunctionType>(lambda->getType());
-				FunctionCodeInfo codeInfo = resolveFunction(name, funType, unrolled->getLambda(), false, isConst);
+				FunctionCodeInfo codeInfo = resolveFunction(name, funType, unrolled->getLambda(), false, isConst, lambda);
 
 				// add function
 				LambdaInfo* info = static_cast<LambdaInfo*>(funInfos[lambda]);
@@ -1357,7 +1358,8 @@ namespace backend {
 
 
 		FunctionCodeInfo FunctionInfoStore::resolveFunction(const c_ast::IdentifierPtr name, const core::FunctionTypePtr& funType,
-		                                                    const core::LambdaPtr& lambda, bool external, bool isConst) {
+		                                                    const core::LambdaPtr& lambda, bool external, bool isConst,
+		                                                    const core::LambdaExprPtr& instance) {
 			FunctionCodeInfo res;
 
 			// get C node manager
@@ -1379,9 +1381,14 @@ namespace backend {
 			// create a new variable scope for the resolution of the body
 			nameManager.pushVarScope(true);
 
+			// obtain parameters proven not to be aliased for this particular function instance
+			std::map<unsigned, unsigned> noAlias;
+			if(instance && annotations::NoAliasAnnotation::hasAttachedValue(instance)) { noAlias = annotations::NoAliasAnnotation::getValue(instance); }
+
 			// resolve parameters
 			unsigned counter = 0;
 			vector<c_ast::VariablePtr> parameter;
+			vector<std::pair<c_ast::VariablePtr, unsigned>> alignedParams;
 			for_each(funType->getParameterTypes()->getElements(), [&](const core::TypePtr& cur) {
 
 				// skip type literals passed as arguments
@@ -1411,6 +1418,19 @@ namespace backend {
 				} else {
 					paramName = format("p%d", counter + 1);
 				}
+
+				// mark pointers proven not to be aliased as restricted
+				auto noAliasPos = noAlias.find(counter);
+				if(noAliasPos != noAlias.end()) {
+					if(auto ptrType = paramType.isa<c_ast::PointerTypePtr>()) {
+						paramType = c_ast::ptr(ptrType->elementType, ptrType->isConst(), ptrType->isVolatile(), true);
+
+						// record alignment guarantees
+						unsigned alignment = noAliasPos->second;
+						if(lambda && alignment > 0 && !ptrType->isConst()) { alignedParams.push_back(std::make_pair(c_ast::var(paramType, manager->create(paramName)), alignment)); }
+					}
+				}
+
 				parameter.push_back(c_ast::var(paramType, manager->create(paramName)));
 
 				counter++;
@@ -1423,6 +1443,11 @@ namespace backend {
 			if(lambda) {
 				// set up variable manager
 				ConversionContext context(converter, lambda);
+				if(instance && annotations::VectorizationAnnotation::hasAttachedValue(instance)) {
+					for(const auto& cur : annotations::VectorizationAnnotation::getValue(instance)) {
+						context.getVectorizableLoops().insert(cur);
+					}
+				}
 				for_each(lambda->getParameterList(), [&](const core::VariablePtr& cur) {
 					context.getVariableManager().addInfo(converter, cur, VariableInfo::DIRECT);
 				});
@@ -1438,6 +1463,22 @@ namespace backend {
 				// convert the body code fragment and collect dependencies
 				c_ast::NodePtr code = converter.getStmtConverter().convert(context, body);
 				cBody = static_pointer_cast<c_ast::Statement>(code);
+
+				// inform the C compiler about the alignment of restricted pointers
+				if(!alignedParams.empty()) {
+					vector<c_ast::NodePtr> stmts;
+					for(const auto& cur : alignedParams) {
+						auto alignment = c_ast::lit(manager->create(c_ast::PrimitiveType::Int32), toString(cur.second));
+						auto assume = c_ast::call(manager->create("__builtin_assume_aligned"), cur.first, alignment);
+						stmts.push_back(c_ast::assign(cur.first, c_ast::cast(cur.first->type, assume)));
+					}
+					if(auto compound = cBody.isa<c_ast::CompoundPtr>()) {
+						stmts.insert(stmts.end(), compound->statements.begin(), compound->statements.end());
+					} else {
+						stmts.push_back(cBody);
+					}
+					cBody = manager->create<c_ast::Compound>(stmts);
+				}
 				res.definitionDependencies.insert(context.getDependencies().begin(), context.getDependencies().end());
 
 				// also attach includes
@@ -48,11 +48,15 @@
 
 #include "insieme/core/lang/array.h"
 #include "insieme/core/lang/basic.h"
+#include "insieme/core/lang/parallel.h"
+#include "insieme/core/lang/reference.h"
 #include "insieme/core/lang/static_vars.h"
 
 #include "insieme/core/analysis/ir_utils.h"
 #include "insieme/core/analysis/attributes.h"
 
+#include "insieme/core/annotations/naming.h"
+
 #include "insieme/core/types/type_variable_deduction.h"
 
 #include "insieme/core/transform/node_replacer.h"
@@ -61,6 +65,10 @@
 #include "insieme/core/transform/manipulation_utils.h"
 #include "insieme/core/transform/node_mapper_utils.h"
 
+#include "insieme/transform/loops/dependence.h"
+
+#include "insieme/annotations/loop_annotations.h"
+
 #include "insieme/utils/logging.h"
 
 namespace insieme {
@@ -74,6 +82,7 @@ namespace backend {
 		// steps.push_back(makePreProcessor<RedundancyElimination>());		// optional - disabled for performance reasons
 		steps.push_back(makePreProcessor<CorrectRecVariableUsage>());
 		steps.push_back(makePreProcessor<RecursiveLambdaInstantiator>());
+		steps.push_back(makePreProcessor<VectorizationHints>());
 		return makePreProcessor<PreProcessingSequence>(steps);
 	}
 
@@ -309,5 +318,184 @@ namespace backend {
 		return core::transform::instantiateTypes(code, isCovered);
 	}
 
+
+	// --------------------------------------------------------------------------------------------------------------
+	//      PreProcessor VectorizationHints => attaches aliasing and dependence facts to pfor bodies
+	// --------------------------------------------------------------------------------------------------------------
+
+	namespace {
+
+		/**
+		 * The alignment guaranteed by malloc for heap allocated memory on glibc targets.
+		 */
+		const unsigned HEAP_ALIGNMENT = 2 * sizeof(void*);
+
+		/**
+		 * Obtains the variable an access path consisting of array element accesses is rooted in.
+		 */
+		core::VariablePtr getAccessRoot(core::ExpressionPtr expr) {
+			auto& refExt = expr->getNodeManager().getLangExtension<core::lang::ReferenceExtension>();
+			while(auto call = refExt.isCallOfRefArrayElement(expr)) {
+				expr = call->getArgument(0);
+			}
+			return expr.isa<core::VariablePtr>();
+		}
+
+		/**
+		 * Collects variables bound to freshly allocated memory which is only accessed directly (element
+		 * access, load, store) or captured by the given pfor body calls. No other reference may alias
+		 * such an allocation. The result maps the variables to their guaranteed alignment in bytes.
+		 */
+		utils::map::PointerMap<core::VariablePtr, unsigned> getUnaliasedAllocations(const core::NodePtr& code,
+		                                                                             const utils::set::PointerSet<core::CallExprPtr>& captures) {
+			auto& refExt = code->getNodeManager().getLangExtension<core::lang::ReferenceExtension>();
+
+			// collect allocations
+			utils::map::PointerMap<core::VariablePtr, unsigned> res;
+			core::visitDepthFirstOnce(code, [&](const core::DeclarationStmtPtr& decl) {
+				auto init = decl->getInitialization();
+				if(refExt.isCallOfRefVar(init) || refExt.isCallOfRefVarInit(init)) { res[decl->getVariable()] = 0; }
+				if(refExt.isCallOfRefNew(init) || refExt.isCallOfRefNewInit(init)) { res[decl->getVariable()] = HEAP_ALIGNMENT; }
+			});
+
+			// eliminate allocations escaping through any other use
+			auto check = [&](const core::NodePtr& node, bool allowed) {
+				auto expr = node.isa<core::ExpressionPtr>();
+				if(!expr || allowed) { return; }
+				auto root = getAccessRoot(expr);
+				if(root) { res.erase(root); }
+			};
+
+			core::visitDepthFirstOnce(code, [&](const core::NodePtr& node) {
+				if(auto call = node.isa<core::CallExprPtr>()) {
+					auto fun = call->getFunctionExpr();
+					auto args = call->getArgumentList();
+					for(std::size_t i = 0; i < args.size(); ++i) {
+						bool allowed = refExt.isRefDeref(fun) || ((refExt.isRefAssign(fun) || refExt.isRefArrayElement(fun)) && i == 0)
+						               || (captures.contains(call) && args[i].isa<core::VariablePtr>() && std::count(args.begin(), args.end(), args[i]) == 1);
+						check(args[i], allowed);
+					}
+					check(fun, false);
+					return;
+				}
+				if(auto decl = node.isa<core::DeclarationStmtPtr>()) {
+					check(decl->getInitialization(), false);
+					return;
+				}
+				for(const auto& child : node->getChildList()) {
+					check(child, false);
+				}
+			});
+
+			return res;
+		}
+
+		/**
+		 * Determines whether the given loop contains no further loops.
+		 */
+		bool isInnermostLoop(const core::ForStmtPtr& loop) {
+			bool res = true;
+			core::visitDepthFirstOnce(loop->getBody(), [&](const core::NodePtr& cur) {
+				if(cur->getNodeType() == core::NT_ForStmt || cur->getNodeType() == core::NT_WhileStmt) { res = false; }
+			});
+			return res;
+		}
+
+	} // end anonymous namespace
+
+	core::NodePtr VectorizationHints::process(const Converter& converter, const core::NodePtr& code) {
+		core::NodeManager& manager = converter.getNodeManager();
+		auto& parExt = manager.getLangExtension<core::lang::ParallelExtension>();
+
+		// collect the calls forming the bodies of pfor operations
+		utils::set::PointerSet<core::CallExprPtr> captures;
+		core::visitDepthFirstOnce(code, [&](const core::CallExprPtr& call) {
+			if(!parExt.isCallOfPFor(call)) { return; }
+			auto bind = call->getArgument(4).isa<core::BindExprPtr>();
+			if(bind && bind->getCall()->getFunctionExpr().isa<core::LambdaExprPtr>()) { captures.insert(bind->getCall()); }
+		});
+
+		// if there is nothing to do => done
+		if(captures.empty()) { return code; }
+
+		auto allocations = getUnaliasedAllocations(code, captures);
+
+		core::IRBuilder builder(manager);
+		core::NodeMap replacements;
+		for(const auto& call : captures) {
+			auto lambda = call->getFunctionExpr().as<core::LambdaExprPtr>();
+			auto args = call->getArgumentList();
+
+			// recursive functions are shared by their entire recursive group => leave them untouched
+			if(lambda->isRecursive()) { continue; }
+
+			// determine the parameters bound to unaliased allocations by this particular call
+			std::map<unsigned, unsigned> noAlias;
+			for(std::size_t i = 0; i < args.size(); ++i) {
+				auto var = args[i].isa<core::VariablePtr>();
+				if(!var) { continue; }
+
+				auto pos = allocations.find(var);
+				if(pos != allocations.end()) { noAlias[i] = pos->second; }
+			}
+
+			if(noAlias.empty()) { continue; }
+
+			// the facts only hold for this call => they are attached to a distinct instance of the body; the
+			// instance is normalized since the function manager normalizes functions before converting them
+			std::stringstream name;
+			name << lambda->getReference()->getNameAsString() << "_noalias";
+			for(const auto& cur : noAlias) {
+				name << "_" << cur.first << "_" << cur.second;
+			}
+			auto normalized = builder.normalize(lambda).as<core::LambdaExprPtr>();
+			auto instance = builder.normalize(core::LambdaExpr::get(manager, normalized->getLambda(), name.str())).as<core::LambdaExprPtr>();
+			if(core::annotations::hasAttachedName(lambda)) { core::annotations::attachName(instance, core::annotations::getAttachedName(lambda)); }
+
+			auto params = instance->getParameterList();
+			utils::set::PointerSet<core::VariablePtr> unaliased;
+			for(const auto& cur : noAlias) {
+				unaliased.insert(params[cur.first]);
+			}
+
+			// collect innermost loops accessing unaliased arrays only and being free of loop-carried dependences
+			auto locals = getUnaliasedAllocations(instance->getBody(), utils::set::PointerSet<core::CallExprPtr>());
+			vector<core::ForStmtPtr> loops;
+			core::visitDepthFirstOncePrunable(instance->getBody(), [&](const core::NodePtr& node) -> bool {
+				// nested functions are converted independently
+				if(node->getNodeType() == core::NT_LambdaExpr) { return true; }
+
+				auto loop = node.isa<core::ForStmtPtr>();
+				if(!loop || !isInnermostLoop(loop)) { return false; }
+
+				auto summary = transform::loops::collectAccesses(loop->getBody());
+				if(!summary.analysable) { return true; }
+
+				utils::set::PointerSet<core::ExpressionPtr> distinct;
+				for(const auto& access : summary.accesses) {
+					// the base is either a local allocation, an unaliased parameter or a dereferenced unaliased parameter
+					auto var = access.base.isa<core::VariablePtr>();
+					if(var && locals.find(var) == locals.end() && !unaliased.contains(var)) { return true; }
+					if(!var && !unaliased.contains(access.base.as<core::CallExprPtr>()->getArgument(0).as<core::VariablePtr>())) { return true; }
+					distinct.insert(access.base);
+				}
+
+				if(!transform::loops::hasLoopCarriedDependence(loop, distinct)) { loops.push_back(loop); }
+				return true;
+			});
+
+			annotations::NoAliasAnnotation::attach(instance, noAlias);
+			if(!loops.empty()) { annotations::VectorizationAnnotation::attach(instance, loops); }
+
+			replacements[call] = core::CallExpr::get(manager, call->getType(), instance, args);
+		}
+
+		// if nothing could be proven => done
+		if(replacements.empty()) { return code; }
+
+		// redirect the proven calls to their annotated instances
+		return core::transform::replaceAll(manager, code, replacements, core::transform::globalReplacement);
+	}
+
 } // end namespace backend
 } // end namespace insieme
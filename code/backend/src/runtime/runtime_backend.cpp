@@ -110,6 +110,16 @@ namespace runtime {
 		return res;
 	}
 
+	std::map<std::string, std::string> RuntimeBackend::getPrimaryIncludes() {
+		// the runtime is implemented within its headers => only the primary unit may include the implementation,
+		// all other units share its state through the declarations provided by irt_all_decls.h
+		std::map<std::string, std::string> res;
+		for(const char* cur : {"irt_all_impls.h", "standalone.h", "ir_interface.h", "irt_lock.h", "irt_task_deps.h", "channels.h"}) {
+			res[cur] = "irt_all_decls.h";
+		}
+		return res;
+	}
+
 	Converter RuntimeBackend::buildConverter(core::NodeManager& manager) const {
 		// create and set up the converter
 		Converter converter(manager, "RuntimeBackend", getConfiguration());
@@ -167,6 +177,9 @@ namespace runtime {
 			table["irt_wg_join"] = "irt_all_impls.h";
 			table["irt_wg_barrier"] = "irt_all_impls.h";
 			table["irt_wg_joining_barrier"] = "irt_all_impls.h";
+			table["irt_wg_reduce"] = "irt_all_impls.h";
+			table["irt_wg_ordered_wait"] = "irt_all_impls.h";
+			table["irt_wg_ordered_advance"] = "irt_all_impls.h";
 
 			table["irt_inst_region_start"] = "irt_all_impls.h";
 			table["irt_inst_region_end"] = "irt_all_impls.h";
@@ -176,6 +189,18 @@ namespace runtime {
 			table["irt_lock_tryacquire"] = "irt_all_impls.h";
 			table["irt_lock_release"] = "irt_all_impls.h";
 
+			table["irt_task_deps_create"] = "irt_all_impls.h";
+			table["irt_task_deps_add"] = "irt_all_impls.h";
+			table["irt_task_deps_wait"] = "irt_all_impls.h";
+			table["irt_task_deps_release"] = "irt_all_impls.h";
+
+			table["irt_channel_create"] = "irt_all_impls.h";
+			table["irt_channel_destroy"] = "irt_all_impls.h";
+			table["irt_channel_full"] = "irt_all_impls.h";
+			table["irt_channel_empty"] = "irt_all_impls.h";
+			table["IRT_CHANNEL_SEND"] = "irt_all_impls.h";
+			table["IRT_CHANNEL_RECV"] = "irt_all_impls.h";
+
 			table["irt_atomic_fetch_and_add"] = "irt_all_impls.h";
 			table["irt_atomic_fetch_and_sub"] = "irt_all_impls.h";
 			table["irt_atomic_add_and_fetch"] = "irt_all_impls.h";
@@ -48,6 +48,7 @@
 #include "insieme/backend/c_ast/c_code.h"
 #include "insieme/backend/c_ast/c_ast_utils.h"
 
+#include "insieme/core/lang/channel.h"
 #include "insieme/core/lang/parallel.h"
 #include "insieme/core/lang/instrumentation_extension.h"
 
@@ -71,6 +72,7 @@ namespace runtime {
 	OperatorConverterTable& addRuntimeSpecificOps(core::NodeManager& manager, OperatorConverterTable& table, const BackendConfig& config) {
 		const RuntimeExtension& ext = manager.getLangExtension<RuntimeExtension>();
 		const core::lang::ParallelExtension& parExt = manager.getLangExtension<core::lang::ParallelExtension>();
+		const core::lang::ChannelExtension& chanExt = manager.getLangExtension<core::lang::ChannelExtension>();
 		const core::lang::InstrumentationExtension& instExt = manager.getLangExtension<core::lang::InstrumentationExtension>();
 		const core::lang::BasicGenerator& basic = manager.getLangBasic();
 
@@ -234,6 +236,25 @@ namespace runtime {
 			return c_ast::call(C_NODE_MANAGER->create("irt_wg_barrier"), CONVERT_ARG(0));
 		};
 
+		table[parExt.getTreeReduce()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_wi_get_current");
+			ADD_HEADER_FOR("irt_wg_reduce");
+			c_ast::ExpressionPtr item = c_ast::call(C_NODE_MANAGER->create("irt_wi_get_current"));
+			// the combine function operates on pointers to the reduced type, the runtime passes them as void pointers
+			c_ast::TypePtr funType = c_ast::ptr(C_NODE_MANAGER->create<c_ast::NamedType>(C_NODE_MANAGER->create("irt_wg_reduction_function")));
+			return c_ast::call(C_NODE_MANAGER->create("irt_wg_reduce"), CONVERT_ARG(0), item, CONVERT_ARG(1), c_ast::cast(funType, CONVERT_ARG(2)));
+		};
+
+		table[parExt.getOrderedWait()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_wg_ordered_wait");
+			return c_ast::call(C_NODE_MANAGER->create("irt_wg_ordered_wait"), CONVERT_ARG(0), CONVERT_ARG(1), CONVERT_ARG(2));
+		};
+
+		table[parExt.getOrderedAdvance()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_wg_ordered_advance");
+			return c_ast::call(C_NODE_MANAGER->create("irt_wg_ordered_advance"), CONVERT_ARG(0), CONVERT_ARG(1), CONVERT_ARG(2));
+		};
+
 		table[parExt.getMergeAll()] = OP_CONVERTER {
 			ADD_HEADER_FOR("irt_wi_get_current");
 			ADD_HEADER_FOR("irt_wi_join_all");
@@ -267,6 +288,57 @@ namespace runtime {
 			return c_ast::call(C_NODE_MANAGER->create("irt_lock_release"), CONVERT_ARG(0));
 		};
 
+		// task dependences
+
+		table[parExt.getTaskDepsCreate()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_task_deps_create");
+			return c_ast::call(C_NODE_MANAGER->create("irt_task_deps_create"));
+		};
+		table[parExt.getTaskDepsAdd()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_task_deps_add");
+			c_ast::TypePtr voidPtr = c_ast::ptr(C_NODE_MANAGER->create<c_ast::PrimitiveType>(c_ast::PrimitiveType::Void));
+			return c_ast::call(C_NODE_MANAGER->create("irt_task_deps_add"), CONVERT_ARG(0), c_ast::cast(voidPtr, CONVERT_ARG(1)), CONVERT_ARG(2));
+		};
+		table[parExt.getTaskDepsWait()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_task_deps_wait");
+			return c_ast::call(C_NODE_MANAGER->create("irt_task_deps_wait"), CONVERT_ARG(0));
+		};
+		table[parExt.getTaskDepsRelease()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_task_deps_release");
+			return c_ast::call(C_NODE_MANAGER->create("irt_task_deps_release"), CONVERT_ARG(0));
+		};
+
+		// channels
+
+		table[chanExt.getChannelCreate()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_channel_create");
+			core::lang::ChannelType channel(call);
+			c_ast::TypePtr elementType = GET_TYPE_INFO(channel.getElementType()).rValueType;
+			return c_ast::call(C_NODE_MANAGER->create("irt_channel_create"), c_ast::sizeOf(elementType), CONVERT_EXPR(channel.getSize()));
+		};
+		table[chanExt.getChannelRelease()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_channel_destroy");
+			return c_ast::call(C_NODE_MANAGER->create("irt_channel_destroy"), CONVERT_ARG(0));
+		};
+		table[chanExt.getChannelSend()] = OP_CONVERTER {
+			ADD_HEADER_FOR("IRT_CHANNEL_SEND");
+			c_ast::TypePtr elementType = GET_TYPE_INFO(core::lang::ChannelType(ARG(0)).getElementType()).rValueType;
+			return c_ast::call(C_NODE_MANAGER->create("IRT_CHANNEL_SEND"), CONVERT_ARG(0), elementType, CONVERT_ARG(1));
+		};
+		table[chanExt.getChannelRecv()] = OP_CONVERTER {
+			ADD_HEADER_FOR("IRT_CHANNEL_RECV");
+			c_ast::TypePtr elementType = GET_TYPE_INFO(core::lang::ChannelType(ARG(0)).getElementType()).rValueType;
+			return c_ast::call(C_NODE_MANAGER->create("IRT_CHANNEL_RECV"), CONVERT_ARG(0), elementType);
+		};
+		table[chanExt.getChannelFull()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_channel_full");
+			return c_ast::call(C_NODE_MANAGER->create("irt_channel_full"), CONVERT_ARG(0));
+		};
+		table[chanExt.getChannelEmpty()] = OP_CONVERTER {
+			ADD_HEADER_FOR("irt_channel_empty");
+			return c_ast::call(C_NODE_MANAGER->create("irt_channel_empty"), CONVERT_ARG(0));
+		};
+
 		// atomics
 
 		#define BIN_ATOMIC_CONVERTER(__IRNAME, __IRTNAME)                                                                                                      \
@@ -54,6 +54,7 @@
 #include "insieme/core/lang/instrumentation_extension.h"
 #include "insieme/core/pattern/ir_pattern.h"
 
+#include "insieme/annotations/loop_annotations.h"
 #include "insieme/annotations/meta_info/meta_infos.h"
 #include "insieme/annotations/omp/omp_annotations.h"
 
@@ -77,7 +78,8 @@ namespace runtime {
 					const auto& c = cur.as<core::CallExprPtr>();
 					const auto& f = core::analysis::stripAttributes(c->getFunctionExpr());
 
-					if(parExt.isGetThreadGroup(f) || parExt.isGetGroupSize(f) || parExt.isGetThreadId(f) || parExt.isPFor(f) || parExt.isRedistribute(f)) {
+					if(parExt.isGetThreadGroup(f) || parExt.isGetGroupSize(f) || parExt.isGetThreadId(f) || parExt.isPFor(f) || parExt.isRedistribute(f)
+					   || parExt.isTreeReduce(f)) {
 						hasGroupOps = true;
 					}
 
@@ -661,8 +663,23 @@ namespace runtime {
 			resBody.push_back(builder.declarationStmt(step, builder.accessMember(range, "step")));
 
 			// create loop calling body of p-for
-			core::CallExprPtr loopBodyCall = builder.callExpr(unit, body, begin, end, step);
-			core::StatementPtr loopBody = core::transform::tryInlineToStmt(manager, loopBodyCall);
+			core::StatementPtr loopBody;
+			auto bind = body.isa<core::BindExprPtr>();
+			if(bind && annotations::NoAliasAnnotation::hasAttachedValue(bind->getCall()->getFunctionExpr())) {
+				// the body is an instance carrying vectorization facts (see VectorizationHints) => only resolve
+				// the bind and keep the call to the instance, such that it is converted into an annotated function
+				utils::map::PointerMap<core::VariablePtr, core::ExpressionPtr> bound;
+				auto params = bind->getParameters()->getElements();
+				auto bounds = toVector<core::ExpressionPtr>(begin, end, step);
+				assert_eq(params.size(), bounds.size()) << "Invalid pfor body!";
+				for(std::size_t i = 0; i < params.size(); ++i) {
+					bound[params[i]] = bounds[i];
+				}
+				loopBody = core::transform::replaceVarsGen(manager, bind->getCall(), bound);
+			} else {
+				core::CallExprPtr loopBodyCall = builder.callExpr(unit, body, begin, end, step);
+				loopBody = core::transform::tryInlineToStmt(manager, loopBodyCall);
+			}
 
 			// replace variables within loop body to fit new context
 			core::ExpressionPtr paramTypeToken = builder.getTypeLiteral(dataItemType);
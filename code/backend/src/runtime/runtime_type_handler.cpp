@@ -43,6 +43,7 @@
 #include "insieme/backend/c_ast/c_code.h"
 #include "insieme/backend/c_ast/c_ast_utils.h"
 
+#include "insieme/core/lang/channel.h"
 #include "insieme/core/lang/parallel.h"
 
 #include "insieme/utils/logging.h"
@@ -104,6 +105,10 @@ namespace runtime {
 
 			if(parExt.isLock(type)) { return type_info_utils::createInfo(converter.getFragmentManager(), "irt_lock", "irt_lock.h"); }
 
+			if(parExt.isTaskDeps(type)) { return type_info_utils::createInfo(converter.getFragmentManager(), "irt_task_deps", "irt_task_deps.h"); }
+
+			if(core::lang::isChannel(type)) { return type_info_utils::createInfo(converter.getFragmentManager(), "irt_channel*", "channels.h"); }
+
 			// it is not a special runtime type => let somebody else try
 			return 0;
 		}
@@ -601,7 +601,15 @@ namespace backend {
 
 		converter.getNameManager().popVarScope();
 		// combine all into a for
-		return manager->create<c_ast::For>(cInit, cCheck, cStep, cBody);
+		auto res = manager->create<c_ast::For>(cInit, cCheck, cStep, cBody);
+
+		// add vectorization hints for loops proven to be free of loop-carried dependences
+		if(context.getVectorizableLoops().contains(ptr)) {
+			res->pragmas.push_back("omp simd");
+			res->pragmas.push_back("GCC ivdep");
+		}
+
+		return res;
 	}
 
 	c_ast::NodePtr StmtConverter::visitIfStmt(const core::IfStmtPtr& ptr, ConversionContext& context) {
@@ -36,6 +36,11 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
 #include "insieme/backend/c_ast/c_code.h"
 #include "insieme/utils/test/test_utils.h"
 
@@ -59,6 +64,20 @@ namespace c_ast {
 		CodeFragmentPtr getTextFragment(const SharedCodeFragmentManager& manager, const string& text) {
 			return manager->create<TextFragment>(text);
 		}
+
+		CodeFragmentPtr getFunctionFragment(const SharedCodeFragmentManager& manager, const string& name, unsigned flags = 0) {
+			const SharedCNodeManager& nodeManager = manager->getNodeManager();
+			TypePtr intType = nodeManager->create<PrimitiveType>(PrimitiveType::Int32);
+			FunctionPtr fun = nodeManager->create<Function>(flags, intType, nodeManager->create(name), vector<VariablePtr>(), nodeManager->create<Compound>());
+			return CCodeFragment::createNew(manager, fun);
+		}
+
+		string readFile(const string& file) {
+			std::ifstream in(file);
+			std::stringstream res;
+			res << in.rdbuf();
+			return res.str();
+		}
 	}
 
 
@@ -132,6 +151,141 @@ namespace c_ast {
 		EXPECT_TRUE(codeD->isDependingOn(codeX));
 	}
 
+	TEST(C_AST, StreamedEmission) {
+		namespace fs = boost::filesystem;
+		SharedCodeFragmentManager fragmentManager = CodeFragmentManager::createShared();
+
+		CodeFragmentPtr codeA = getTextFragment(fragmentManager, "A");
+		CodeFragmentPtr codeB = getTextFragment(fragmentManager, "B");
+		codeB->addDependency(codeA);
+
+		CCode code(fragmentManager, core::NodePtr(), codeB);
+
+		fs::path file = fs::unique_path(fs::temp_directory_path() / "insieme-code-%%%%%%%%.c");
+		auto files = code.writeTo(file.string());
+		EXPECT_EQ(toVector(file.string()), files);
+
+		// the streamed code has to be identical to the printed code
+		EXPECT_EQ(toString(code), readFile(file.string()));
+
+		fs::remove(file);
+	}
+
+	TEST(C_AST, MultiUnitEmission) {
+		namespace fs = boost::filesystem;
+		SharedCodeFragmentManager fragmentManager = CodeFragmentManager::createShared();
+
+		CodeFragmentPtr funA = getFunctionFragment(fragmentManager, "funA");
+		CodeFragmentPtr funB = getFunctionFragment(fragmentManager, "funB");
+		CodeFragmentPtr funC = getFunctionFragment(fragmentManager, "funC");
+		CodeFragmentPtr table = getTextFragment(fragmentManager, "TABLE");
+		CodeFragmentPtr user = getFunctionFragment(fragmentManager, "user");
+		table->addDependency(funA);
+		table->addDependency(funB);
+		table->addDependency(funC);
+		user->addDependency(table);
+		funA->addInclude("stdio.h");
+		funA->addInclude("impl.h");
+
+		CCode code(fragmentManager, core::NodePtr(), user);
+
+		CodeEmissionOptions options;
+		options.numUnits = 2;
+		options.releaseFragments = true;
+		options.primaryIncludes["impl.h"] = "decls.h";
+
+		fs::path dir = fs::unique_path(fs::temp_directory_path() / "insieme-code-%%%%%%%%");
+		fs::create_directory(dir);
+		auto files = code.writeTo((dir / "code.c").string(), options);
+		ASSERT_EQ(2u, files.size());
+		EXPECT_EQ((dir / "code_0.c").string(), files[0]);
+		EXPECT_EQ((dir / "code_1.c").string(), files[1]);
+
+		string header = readFile((dir / "code.h").string());
+		string unit0 = readFile(files[0]);
+		string unit1 = readFile(files[1]);
+
+		// all units include the shared header
+		EXPECT_PRED2(containsSubString, unit0, "#include \"code.h\"");
+		EXPECT_PRED2(containsSubString, unit1, "#include \"code.h\"");
+
+		// primary includes are replaced within the header
+		EXPECT_PRED2(containsSubString, header, "#include <stdio.h>");
+		EXPECT_PRED2(containsSubString, header, "#include <decls.h>");
+		EXPECT_PRED2(notContainsSubString, header, "#include <impl.h>");
+		EXPECT_PRED2(containsSubString, unit0, "#include <impl.h>");
+
+		// functions are declared within the header and defined in exactly one unit
+		for(const string& name : toVector<string>("funA", "funB", "funC", "user")) {
+			EXPECT_PRED2(containsSubString, header, "int32_t " + name + "();");
+			EXPECT_NE(containsSubString(unit0, name + "() {"), containsSubString(unit1, name + "() {")) << name;
+		}
+
+		// opaque fragments and code depending on them stay in the primary unit
+		EXPECT_PRED2(containsSubString, unit0, "TABLE");
+		EXPECT_PRED2(containsSubString, unit0, "user() {");
+
+		// function definitions are distributed among the units
+		EXPECT_PRED2(containsSubString, unit1, "() {");
+
+		// fragments have been released
+		EXPECT_TRUE(static_pointer_cast<CCodeFragment>(funA)->getCode().empty());
+
+		fs::remove_all(dir);
+	}
+
+	TEST(C_AST, MultiUnitEmissionPlacement) {
+		namespace fs = boost::filesystem;
+		SharedCodeFragmentManager fragmentManager = CodeFragmentManager::createShared();
+
+		// an inline function depending on opaque code, and a function depending on the inline function
+		CodeFragmentPtr table = getTextFragment(fragmentManager, "TABLE");
+		CodeFragmentPtr inlined = getFunctionFragment(fragmentManager, "inlined", Function::INLINE);
+		CodeFragmentPtr user = getFunctionFragment(fragmentManager, "user");
+		inlined->addDependency(table);
+		user->addDependency(inlined);
+
+		// a static function
+		CodeFragmentPtr local = getFunctionFragment(fragmentManager, "local", Function::STATIC);
+		CodeFragmentPtr other = getFunctionFragment(fragmentManager, "other");
+		other->addDependency(local);
+
+		CCode code(fragmentManager, core::NodePtr(), toVector(table, inlined, user, local, other));
+
+		CodeEmissionOptions options;
+		options.numUnits = 3;
+
+		fs::path dir = fs::unique_path(fs::temp_directory_path() / "insieme-code-%%%%%%%%");
+		fs::create_directory(dir);
+		auto files = code.writeTo((dir / "code.c").string(), options);
+		ASSERT_EQ(3u, files.size());
+
+		string header = readFile((dir / "code.h").string());
+		string unit0 = readFile(files[0]);
+
+		// code depending transitively on the opaque fragment is kept within the primary unit
+		EXPECT_PRED2(notContainsSubString, header, "inlined() {");
+		EXPECT_PRED2(containsSubString, unit0, "inlined() {");
+		EXPECT_PRED2(containsSubString, unit0, "user() {");
+
+		// static functions are not duplicated, neither is code depending on them distributed
+		EXPECT_PRED2(notContainsSubString, header, "local");
+		EXPECT_PRED2(containsSubString, unit0, "local() {");
+		EXPECT_PRED2(containsSubString, unit0, "other() {");
+
+		fs::remove_all(dir);
+	}
+
+	TEST(C_AST, EmissionFailure) {
+		namespace fs = boost::filesystem;
+		SharedCodeFragmentManager fragmentManager = CodeFragmentManager::createShared();
+		CCode code(fragmentManager, core::NodePtr(), getTextFragment(fragmentManager, "A"));
+
+		// the target directory does not exist
+		fs::path file = fs::unique_path(fs::temp_directory_path() / "insieme-missing-%%%%%%%%" / "code.c");
+		EXPECT_THROW(code.writeTo(file.string()), CodeEmissionException);
+	}
+
 } // end namespace c_ast
 } // end namespace backend
 } // end namespace insieme
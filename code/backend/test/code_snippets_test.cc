@@ -371,6 +371,41 @@ namespace backend {
 	}
 
 
+	TEST(Parallel, Channels) {
+		core::NodeManager mgr;
+		core::IRBuilder builder(mgr);
+
+		core::ProgramPtr program = builder.parseProgram(
+		    R"(
+			def consume = (n : uint<8>) -> unit {
+				var ref<channel<int<4>,#n>> d = channel_create(type_lit(int<4>), type_lit(#n));
+				channel_send(*d, 2);
+				channel_release(*d);
+			};
+
+			int<4> main() {
+				var ref<channel<int<4>,4>> c = channel_create(type_lit(int<4>), type_lit(4));
+				channel_send(*c, 1);
+				var ref<int<4>> x = channel_recv(*c);
+				channel_release(*c);
+				consume(5ul);
+				return *x;
+			}
+			)");
+		ASSERT_TRUE(program);
+
+		// both, fixed and variable sized channels, have to be supported
+		auto converted = runtime::RuntimeBackend::getDefault()->convert(program);
+		ASSERT_TRUE(converted);
+
+		string code = toString(*converted);
+		EXPECT_PRED2(containsSubString, code, "irt_channel_create(sizeof(int32_t), ");
+		EXPECT_NE(code.find("irt_channel_create("), code.rfind("irt_channel_create("));
+		EXPECT_PRED2(containsSubString, code, "IRT_CHANNEL_SEND(");
+		EXPECT_PRED2(containsSubString, code, "IRT_CHANNEL_RECV(");
+		EXPECT_PRED2(containsSubString, code, "irt_channel_destroy(");
+	}
+
 	TEST(Arrays, Allocation) {
 		core::NodeManager manager;
 		core::IRBuilder builder(manager);
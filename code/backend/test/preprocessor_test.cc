@@ -42,14 +42,23 @@
 #include "insieme/utils/config.h"
 
 #include "insieme/backend/preprocessor.h"
+#include "insieme/backend/converter.h"
+#include "insieme/backend/sequential/sequential_backend.h"
+#include "insieme/backend/runtime/runtime_backend.h"
 
 #include "insieme/core/ir_program.h"
 #include "insieme/core/ir_builder.h"
 #include "insieme/core/printer/pretty_printer.h"
 #include "insieme/core/checks/full_check.h"
+#include "insieme/core/ir_visitor.h"
+#include "insieme/core/lang/parallel.h"
 
 #include "insieme/core/transform/node_replacer.h"
 
+#include "insieme/annotations/loop_annotations.h"
+
+#include "insieme/utils/test/test_utils.h"
+
 namespace insieme {
 namespace backend {
 
@@ -91,6 +100,110 @@ namespace backend {
 		EXPECT_EQ(core::checks::MessageList(), errors);
 	}
 
+	TEST(Preprocessor, VectorizationHints) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto& parExt = manager.getLangExtension<core::lang::ParallelExtension>();
+
+		auto code = builder.parseStmt(R"(
+			{
+				var ref<array<int<4>,10>> a = ref_new(type_lit(array<int<4>,10>));
+				var ref<array<int<4>,10>> b = ref_new(type_lit(array<int<4>,10>));
+				var ref<array<int<4>,10>> c = ref_new(type_lit(array<int<4>,10>));
+				lit("escape" : (ref<array<int<4>,10>>) -> unit)(c);
+				for(uint<4> i = 0u .. 10u) {
+					a[i] = b[i] + 1;
+				}
+				for(uint<4> i = 0u .. 10u) {
+					b[i] = c[i] + 1;
+				}
+			}
+		)").as<core::CompoundStmtPtr>();
+		ASSERT_TRUE(code);
+
+		// turn the loops into pfors - the resulting bodies are structurally identical
+		core::StatementList stmts = code->getStatements();
+		stmts[4] = builder.pfor(stmts[4].as<core::ForStmtPtr>());
+		stmts[5] = builder.pfor(stmts[5].as<core::ForStmtPtr>());
+		code = builder.compoundStmt(stmts);
+
+		Converter converter(manager);
+		auto res = VectorizationHints().process(converter, code);
+		ASSERT_TRUE(res);
+		EXPECT_NE(code, res);
+
+		// collect the pfor bodies
+		vector<core::LambdaExprPtr> bodies;
+		core::visitDepthFirst(res, [&](const core::CallExprPtr& call) {
+			if(parExt.isCallOfPFor(call)) {
+				bodies.push_back(call->getArgument(4).as<core::BindExprPtr>()->getCall()->getFunctionExpr().as<core::LambdaExprPtr>());
+			}
+		});
+		ASSERT_EQ(2u, bodies.size());
+
+		// the facts only hold for the individual call sites => distinct instances
+		EXPECT_NE(bodies[0], bodies[1]);
+		EXPECT_EQ(*bodies[0]->getLambda(), *bodies[1]->getLambda());
+
+		// the first pfor only accesses unaliased heap allocations
+		ASSERT_TRUE(annotations::NoAliasAnnotation::hasAttachedValue(bodies[0]));
+		auto first = annotations::NoAliasAnnotation::getValue(bodies[0]);
+		EXPECT_EQ(2u, first.size());
+		for(const auto& cur : first) {
+			EXPECT_EQ(2 * sizeof(void*), cur.second);
+		}
+		ASSERT_TRUE(annotations::VectorizationAnnotation::hasAttachedValue(bodies[0]));
+		EXPECT_EQ(1u, annotations::VectorizationAnnotation::getValue(bodies[0]).size());
+
+		// the escaping array c must neither be restricted nor vectorized
+		ASSERT_TRUE(annotations::NoAliasAnnotation::hasAttachedValue(bodies[1]));
+		EXPECT_EQ(1u, annotations::NoAliasAnnotation::getValue(bodies[1]).size());
+		EXPECT_FALSE(annotations::VectorizationAnnotation::hasAttachedValue(bodies[1]));
+
+		// check the generated code
+		auto converted = sequential::SequentialBackend::getDefault()->convert(code);
+		string target = toString(*converted);
+
+		EXPECT_PRED2(containsSubString, target, "__restrict");
+		EXPECT_PRED2(containsSubString, target, "__builtin_assume_aligned");
+		EXPECT_PRED2(containsSubString, target, "#pragma omp simd");
+		EXPECT_PRED2(containsSubString, target, "#pragma GCC ivdep");
+
+		// only the loop of the first pfor is vectorized
+		EXPECT_EQ(target.find("#pragma omp simd"), target.rfind("#pragma omp simd"));
+	}
+
+	TEST(Preprocessor, VectorizationHintsRuntime) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		auto code = builder.parseStmt(R"(
+			{
+				var ref<array<int<4>,10>> a = ref_new(type_lit(array<int<4>,10>));
+				var ref<array<int<4>,10>> b = ref_new(type_lit(array<int<4>,10>));
+				for(uint<4> i = 0u .. 10u) {
+					a[i] = b[i] + 1;
+				}
+			}
+		)").as<core::CompoundStmtPtr>();
+		ASSERT_TRUE(code);
+
+		core::StatementList stmts = code->getStatements();
+		stmts[2] = builder.pfor(stmts[2].as<core::ForStmtPtr>());
+		auto main = builder.lambdaExpr(manager.getLangBasic().getUnit(), core::VariableList(), builder.compoundStmt(stmts));
+		auto program = builder.program(toVector<core::ExpressionPtr>(main));
+
+		// the pfor body is turned into a work item - the facts have to survive this conversion
+		auto converted = runtime::RuntimeBackend::getDefault()->convert(program);
+		string target = toString(*converted);
+
+		EXPECT_PRED2(containsSubString, target, "irt_pfor");
+		EXPECT_PRED2(containsSubString, target, "__restrict");
+		EXPECT_PRED2(containsSubString, target, "__builtin_assume_aligned");
+		EXPECT_PRED2(containsSubString, target, "#pragma omp simd");
+		EXPECT_PRED2(containsSubString, target, "#pragma GCC ivdep");
+	}
+
 
 } // namespace backend
 } // namespace insieme
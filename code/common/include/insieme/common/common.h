@@ -52,7 +52,8 @@ namespace common {
 		IRT_GUIDED = 20,
 		IRT_GUIDED_CHUNKED = 21,
 		IRT_FIXED = 30,
-		IRT_SHARES = 40
+		IRT_SHARES = 40,
+		IRT_ADAPTIVE = 50
 	} irt_loop_sched_policy_type;
 
 	#ifdef __cplusplus
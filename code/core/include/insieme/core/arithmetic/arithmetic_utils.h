@@ -61,6 +61,9 @@ namespace core {
 		 * @return an equivalent formula
 		 *
 		 * @throws a NotAFormulaException if the given expression is not an arithmetic expression
+		 *
+		 * The results for the given expression and its sub-expressions are cached at the
+		 * respective nodes, such that repeated conversions are cheap.
 		 */
 		Formula toFormula(const ExpressionPtr& expr);
 
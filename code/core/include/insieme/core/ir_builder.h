@@ -507,6 +507,9 @@ namespace core {
 		// Direct call expression of barrier
 		CallExprPtr barrier(ExpressionPtr threadgroup = ExpressionPtr()) const;
 
+		// Direct call expression of treeReduce, combining the values referenced by value within the thread group
+		CallExprPtr treeReduce(const ExpressionPtr& value, const ExpressionPtr& combine, ExpressionPtr threadgroup = ExpressionPtr()) const;
+
 		// Direct call expression of mergeAll
 		CallExprPtr mergeAll() const;
 
@@ -132,6 +132,24 @@ namespace lang {
 		 */
 		LANG_EXT_LITERAL(Redistribute, "redistribute", "(threadgroup, 'a, (ref<array<'a>>, uint<8>, uint<8>)=>'b )->'b")
 
+		/**
+		 * A collective reduction among the threads of a thread group. The values referenced by the members are combined
+		 * pairwise in logarithmic depth using the given operation, which folds the value referenced by its second argument
+		 * into the one referenced by its first argument. Upon return, the value of the member with thread id 0 holds the result.
+		 */
+		LANG_EXT_LITERAL(TreeReduce, "tree_reduce", "(threadgroup, ref<'a,f,'v>, (ref<'a,f,'v>, ref<'a,f,'v>)->unit)->unit")
+
+		/**
+		 * Blocks the calling thread until the given ordered counter, shared by the members of the thread group, reaches
+		 * the given value. Instead of spinning, waiting threads get suspended until the counter is advanced to their value.
+		 */
+		LANG_EXT_LITERAL(OrderedWait, "ordered_wait", "(threadgroup, ref<int<8>,f,t>, int<'a>)->unit")
+
+		/**
+		 * Advances the given ordered counter by the given increment and resumes the thread waiting for the new value.
+		 */
+		LANG_EXT_LITERAL(OrderedAdvance, "ordered_advance", "(threadgroup, ref<int<8>,f,t>, int<'a>)->unit")
+
 
 		// -- Parallel Operators --------------------------------------------------------------------------------------------
 
@@ -215,6 +233,35 @@ namespace lang {
 		LANG_EXT_LITERAL(LockRelease, "lock_release", "(ref<lock>)->unit")
 
 
+		// -- Task Dependences ----------------------------------------------------------------------------------------------
+
+		/**
+		 * A handle to the dependences of a task among its siblings.
+		 */
+		LANG_EXT_TYPE(TaskDeps, "task_deps")
+
+		/**
+		 * Creates the dependence handle of a task about to be spawned by the current thread.
+		 */
+		LANG_EXT_LITERAL(TaskDepsCreate, "task_deps_create", "()->task_deps")
+
+		/**
+		 * Registers an access of the task to the given memory location. The boolean flag determines whether
+		 * it is a write access. The task is ordered after all previously registered conflicting accesses.
+		 */
+		LANG_EXT_LITERAL(TaskDepsAdd, "task_deps_add", "(task_deps, ref<'a,'c,'v>, bool)->unit")
+
+		/**
+		 * Blocks the calling task until all the tasks it depends on have released their dependences.
+		 */
+		LANG_EXT_LITERAL(TaskDepsWait, "task_deps_wait", "(task_deps)->unit")
+
+		/**
+		 * Releases the dependences of the calling task, enabling the tasks depending on it.
+		 */
+		LANG_EXT_LITERAL(TaskDepsRelease, "task_deps_release", "(task_deps)->unit")
+
+
 		// -- Atomic Primitives ---------------------------------------------------------------------------------------------
 
 
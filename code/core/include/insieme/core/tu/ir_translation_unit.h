@@ -65,6 +65,8 @@ namespace tu {
 		typedef std::vector<core::ExpressionPtr> Initializer;
 
 		typedef std::vector<core::LiteralPtr> EntryPointList;
+
+		typedef insieme::utils::map::PointerMap<core::NodePtr, core::NodeSet> DependencyIndex;
 		
 	  private:
 		core::NodeManager* mgr;
@@ -81,6 +83,13 @@ namespace tu {
 		
 		bool isCppCode;
 
+		/**
+		 * An index mapping type and function symbols to the potential symbol references within their
+		 * definitions. Entries are computed on demand and dropped whenever the corresponding definition
+		 * is altered, such that the index is preserved among multiple resolution requests.
+		 */
+		mutable DependencyIndex dependencies;
+
 	  public:
 		IRTranslationUnit(core::NodeManager& mgr) : mgr(&mgr), isCppCode(false) {}
 
@@ -90,7 +99,7 @@ namespace tu {
 
 		IRTranslationUnit(const IRTranslationUnit& other)
 		    : mgr(other.mgr), types(other.types), functions(other.functions), globals(other.globals), initializer(other.initializer),
-		      entryPoints(other.entryPoints), isCppCode(other.isCppCode) {}
+		      entryPoints(other.entryPoints), isCppCode(other.isCppCode), dependencies(other.dependencies) {}
 
 		// getter:
 		bool isEmpty() {
@@ -117,9 +126,18 @@ namespace tu {
 			return entryPoints;
 		}
 
+		/**
+		 * Obtains the set of potential symbol references (generic types and function literals) within the
+		 * definition of the given type or function symbol. The result is computed once and kept within the
+		 * dependency index of this unit until the definition of the symbol is altered.
+		 */
+		const core::NodeSet& getDependencies(const core::NodePtr& symbol) const;
+
 		// mutable getter:
 
 		FunctionMap& getFunctions() {
+			// definitions may be altered through the returned reference
+			dependencies.clear();
 			return functions;
 		}
 
@@ -148,6 +166,7 @@ namespace tu {
 			assert_true(definition);
 			assert(types.find(symbol) != types.end());
 			types[symbol] = definition;
+			dependencies.erase(symbol);
 		}
 		void substituteType(const core::GenericTypePtr& oldSymbol, const core::GenericTypePtr& newSymbol, const core::TagTypePtr& definition) {
 			assert_true(oldSymbol);
@@ -156,6 +175,8 @@ namespace tu {
 			assert(types.find(oldSymbol) != types.end());
 			types.erase(oldSymbol);
 			types[newSymbol] = definition;
+			dependencies.erase(oldSymbol);
+			dependencies.erase(newSymbol);
 		}
 
 		void addFunction(const core::LiteralPtr& symbol, const core::LambdaExprPtr& definition) {
@@ -170,6 +191,7 @@ namespace tu {
 			assert_eq(*symbol->getType(), *definition->getType());
 			assert(functions.find(symbol) != functions.end());
 			functions[symbol] = definition;
+			dependencies.erase(symbol);
 		}
 		/**
 		 * replaces previous definition and changes the symbol that points to it
@@ -179,6 +201,8 @@ namespace tu {
 			assert(functions.find(oldSymbol) != functions.end());
 			functions.erase(oldSymbol);
 			functions[newSymbol] = definition;
+			dependencies.erase(oldSymbol);
+			dependencies.erase(newSymbol);
 		}
 
 		void addGlobal(const core::LiteralPtr& symbol, const core::ExpressionPtr& definition = core::ExpressionPtr()) {
@@ -215,6 +239,7 @@ namespace tu {
 			entryPoints.clear();
 			std::copy(other.entryPoints.begin(), other.entryPoints.end(), std::back_inserter(entryPoints));
 			isCppCode = other.isCppCode;
+			dependencies = other.dependencies;
 
 			return *this;
 		}
@@ -294,6 +319,29 @@ namespace tu {
 
 	IRTranslationUnit merge(core::NodeManager& mgr, const vector<IRTranslationUnit>& units);
 
+	/**
+	 * A conflict detected while merging translation units: the given symbol is defined differently by
+	 * two of the merged units. The definition provided by the unit listed first is retained.
+	 */
+	struct MergeConflict : public insieme::utils::Printable {
+		core::NodePtr symbol;
+		unsigned retained;
+		unsigned dropped;
+
+		MergeConflict(const core::NodePtr& symbol, unsigned retained, unsigned dropped) : symbol(symbol), retained(retained), dropped(dropped) {}
+
+		std::ostream& printTo(std::ostream& out) const {
+			return out << "conflicting definitions of " << *symbol << " in units " << retained << " and " << dropped;
+		}
+	};
+
+	/**
+	 * Merges the given translation units within a single k-way pass. Type and function symbols are partitioned
+	 * by their hash and the partitions are merged in parallel. For each symbol the definition of the first unit
+	 * defining it is retained, differing definitions of later units are reported within the given conflict list.
+	 */
+	IRTranslationUnit merge(core::NodeManager& mgr, const vector<IRTranslationUnit>& units, vector<MergeConflict>& conflicts);
+
 
 	// -------------- program conversion ----------------------
 
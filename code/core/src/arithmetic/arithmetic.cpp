@@ -742,6 +742,23 @@ namespace arithmetic {
 			 */
 			mutable utils::Lazy<DNF> dnf;
 
+			/**
+			 * An entry of the cache of versions of this BDD migrated into foreign managers.
+			 */
+			struct MigratedBDD {
+				BDDManagerPtr manager; // < kept first such that it outlives the bdd
+				CuddBDD bdd;
+			};
+
+			/**
+			 * A cache of versions of this BDD migrated into other managers. Piecewise formulas are
+			 * combining the same constraints over and over again, such that migrations are reused.
+			 * The cache is not synchronized: like the CUDD managers it refers to, a BDD must stay
+			 * confined to the thread operating on the node manager it has been created for (cached
+			 * conversion results are dropped when nodes are cloned into another manager).
+			 */
+			mutable vector<MigratedBDD> migrated;
+
 		  public:
 			BDD(bool value) : manager(), isTrue(value), isFalse(!value), bdd(){};
 
@@ -930,6 +947,18 @@ namespace arithmetic {
 				// check whether it is already within the same manager ...
 				if(bdd.manager == manager) { return bdd.bdd; }
 
+				// check whether it has been migrated before ...
+				for(const MigratedBDD& cur : bdd.migrated) {
+					if(cur.manager == manager) { return cur.bdd; }
+				}
+
+				// migrate and remember the result
+				CuddBDD res = migrateToLocalManager(bdd);
+				bdd.migrated.push_back({manager, res});
+				return res;
+			}
+
+			CuddBDD migrateToLocalManager(const BDD& bdd) const {
 				// migrate to local manager
 				CuddBDD res = bdd.bdd.Transfer(manager->getCuddManager());
 
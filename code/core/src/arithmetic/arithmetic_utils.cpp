@@ -36,6 +36,10 @@
 
 #include "insieme/core/arithmetic/arithmetic_utils.h"
 
+#include <exception>
+
+#include <boost/optional.hpp>
+
 #include "insieme/core/ir_node.h"
 #include "insieme/core/ir_builder.h"
 #include "insieme/core/ir_visitor.h"
@@ -61,12 +65,75 @@ namespace arithmetic {
 
 	namespace {
 
+		/**
+		 * An annotation utilized to cache the result of converting an expression into an arithmetic
+		 * representation. Since nodes are maintained uniquely by their node manager, attaching the
+		 * result to the node makes it available to every later conversion of the same expression.
+		 * A failed conversion is cached as well, by preserving the exception raised.
+		 *
+		 * Cached results reference expressions (and, for piecewise formulas, BDDs) owned by the
+		 * manager of the annotated node. They must therefore not be carried along when the node
+		 * is cloned into another manager, which may be used by a different thread.
+		 */
+		template <typename Result>
+		struct ConversionCache : public value_annotation::drop_on_clone {
+			/**
+			 * The result of the conversion, if it was successful.
+			 */
+			boost::optional<Result> result;
+
+			/**
+			 * The exception raised by the conversion, if it failed.
+			 */
+			std::exception_ptr error;
+
+			/**
+			 * A equality operator required for all value annoations.
+			 */
+			bool operator==(const ConversionCache& other) const {
+				return result == other.result && error == other.error;
+			}
+		};
+
+		/**
+		 * Obtains the result of converting the given node using the given conversion, consulting
+		 * and updating the cache attached to the node.
+		 */
+		template <typename Result, typename Conversion>
+		Result convertCached(const NodePtr& node, const Conversion& conversion) {
+			typedef ConversionCache<Result> Cache;
+
+			// check the cache
+			if(node->hasAttachedValue<Cache>()) {
+				const Cache& cache = node->getAttachedValue<Cache>();
+				if(cache.error) { std::rethrow_exception(cache.error); }
+				return *cache.result;
+			}
+
+			// compute and cache the result
+			Cache cache;
+			try {
+				cache.result = conversion(node);
+			} catch(const NotAFormulaException&) {
+				cache.error = std::current_exception();
+				node->attachValue(cache);
+				throw;
+			}
+			node->attachValue(cache);
+			return *cache.result;
+		}
+
 		class FormulaConverter : public IRVisitor<Formula> {
 			const lang::BasicGenerator& lang;
 
 		  public:
 			FormulaConverter(const lang::BasicGenerator& lang) : IRVisitor(false), lang(lang) {}
 
+			Formula visit(const NodePtr& node) {
+				// sub-expressions are converted over and over again => use cached results
+				return convertCached<Formula>(node, [&](const NodePtr& node) { return IRVisitor<Formula>::visit(node); });
+			}
+
 		  protected:
 			Formula visitLiteral(const LiteralPtr& cur) {
 				checkType(cur);
@@ -304,6 +371,11 @@ namespace arithmetic {
 			PiecewiseConverter(const lang::BasicGenerator& lang) : IRVisitor(false), formulaConverter(lang), lang(lang) {}
 
 			Piecewise visit(const NodePtr& node) {
+				return convertCached<Piecewise>(node, [&](const NodePtr& node) { return convert(node); });
+			}
+
+		  private:
+			Piecewise convert(const NodePtr& node) {
 				try {
 					// special handling for select statements (to break recursive cycle with formula converter).
 					if(analysis::isCallOf(node, lang.getSelect())) { return visitCallExpr(node.as<CallExprPtr>()); }
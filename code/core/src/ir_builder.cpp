@@ -1127,6 +1127,11 @@ namespace core {
 		return callExpr(manager.getLangExtension<lang::ParallelExtension>().getBarrier(), threadgroup);
 	}
 
+	CallExprPtr IRBuilderBaseModule::treeReduce(const ExpressionPtr& value, const ExpressionPtr& combine, ExpressionPtr threadgroup) const {
+		if(!threadgroup) { threadgroup = getThreadGroup(); }
+		return callExpr(manager.getLangBasic().getUnit(), manager.getLangExtension<lang::ParallelExtension>().getTreeReduce(), threadgroup, value, combine);
+	}
+
 	CallExprPtr IRBuilderBaseModule::mergeAll() const {
 		return callExpr(manager.getLangExtension<lang::ParallelExtension>().getMergeAll());
 	}
@@ -52,11 +52,10 @@ namespace lang {
 		GenericTypePtr type = node.isa<GenericTypePtr>();
 		if(auto expr = node.isa<ExpressionPtr>()) type = expr->getType().as<GenericTypePtr>();
 
-		// copy over the internal fields
-		*this = ChannelType(
-			type->getTypeParameter(0),
-			type->getTypeParameter(1).as<NumericTypePtr>()->getValue().as<LiteralPtr>()
-		);
+		// copy over the internal fields - the size is either a literal or a variable
+		auto size = type->getTypeParameter(1).isa<NumericTypePtr>();
+		assert_true(size) << "Channel " << *type << " has no fixed or variable size!";
+		*this = ChannelType(type->getTypeParameter(0), size->getValue());
 	}
 
 	ChannelType::operator GenericTypePtr() const {
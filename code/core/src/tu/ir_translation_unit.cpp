@@ -36,6 +36,9 @@
 
 #include "insieme/core/tu/ir_translation_unit.h"
 
+#include <thread>
+#include <unordered_map>
+
 #include "insieme/utils/assert.h"
 #include "insieme/utils/graph_utils.h"
 #include "insieme/utils/logging.h"
@@ -78,6 +81,41 @@ namespace tu {
 		}
 	}
 
+	const core::NodeSet& IRTranslationUnit::getDependencies(const core::NodePtr& symbol) const {
+		// check the index first
+		auto pos = dependencies.find(symbol);
+		if(pos != dependencies.end()) { return pos->second; }
+
+		// obtain the definition of the given symbol (the index is keyed by the instances owned by this unit)
+		core::NodePtr key;
+		core::NodePtr definition;
+		if(const core::GenericTypePtr& type = symbol.isa<core::GenericTypePtr>()) {
+			auto pos = types.find(type);
+			if(pos != types.end()) {
+				key = pos->first;
+				definition = pos->second;
+			}
+		} else if(const core::LiteralPtr& fun = symbol.isa<core::LiteralPtr>()) {
+			auto pos = functions.find(fun);
+			if(pos != functions.end()) {
+				key = pos->first;
+				definition = pos->second;
+			}
+		}
+		assert_true(definition) << "No definition for symbol " << *symbol;
+
+		// collect all nodes which might be referencing a type or function symbol
+		core::NodeSet res;
+		core::visitDepthFirstOnce(definition, [&](const core::NodePtr& cur) {
+			if(cur.isa<core::GenericTypePtr>() || (cur.isa<core::LiteralPtr>() && cur.as<core::LiteralPtr>()->getType().isa<core::FunctionTypePtr>())) {
+				res.insert(cur);
+			}
+		}, true, true);
+
+		// add result to index and return it
+		return dependencies[key] = res;
+	}
+
 	std::ostream& IRTranslationUnit::printTo(std::ostream& out) const {
 		static auto print = [](const core::NodePtr& node) { return core::printer::printInOneLine(node); };
 		return out << "TU(\n\tTypes:\n\t\t"
@@ -166,10 +204,111 @@ namespace tu {
 	}
 
 	IRTranslationUnit merge(core::NodeManager& mgr, const vector<IRTranslationUnit>& units) {
+		vector<MergeConflict> conflicts;
+		IRTranslationUnit res = merge(mgr, units, conflicts);
+		for(const auto& cur : conflicts) {
+			VLOG(1) << "Merging translation units: " << cur;
+		}
+		return res;
+	}
+
+	namespace {
+
+		/**
+		 * A type or function definition contributed by one of the units to be merged.
+		 */
+		struct SymbolEntry {
+			core::NodePtr symbol;
+			core::NodePtr definition;
+			unsigned unit;
+		};
+
+		/**
+		 * Selects the definitions to be retained for a single partition of symbols. All nodes have to be
+		 * maintained by the same manager, such that equality can be decided based on the address only.
+		 */
+		void mergePartition(const vector<SymbolEntry>& entries, vector<const SymbolEntry*>& retained, vector<MergeConflict>& conflicts) {
+			std::unordered_map<const core::Node*, const SymbolEntry*> index;
+			for(const auto& cur : entries) {
+				auto pos = index.insert({&*cur.symbol, &cur});
+				if(pos.second) {
+					retained.push_back(&cur);
+				} else if(pos.first->second->definition != cur.definition) {
+					conflicts.push_back(MergeConflict(cur.symbol, pos.first->second->unit, cur.unit));
+				}
+			}
+		}
+
+	} // end anonymous namespace
+
+	IRTranslationUnit merge(core::NodeManager& mgr, const vector<IRTranslationUnit>& units, vector<MergeConflict>& conflicts) {
 		IRTranslationUnit res(mgr);
+
+		// determine the number of partitions - threads only pay off for larger numbers of symbols
+		std::size_t numSymbols = 0;
 		for(const auto& cur : units) {
-			res = merge(mgr, res, cur);
+			numSymbols += cur.getTypes().size() + cur.getFunctions().size();
 		}
+		unsigned numPartitions = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned)(numSymbols / 1024)));
+
+		// partition the symbols by their hash (the import into the target manager is not thread safe)
+		vector<vector<SymbolEntry>> partitions(numPartitions);
+		auto addEntry = [&](const core::NodePtr& symbol, const core::NodePtr& definition, unsigned unit) {
+			auto entry = SymbolEntry{mgr.get(symbol), mgr.get(definition), unit};
+			partitions[(*entry.symbol).hash() % numPartitions].push_back(entry);
+		};
+		for(unsigned i = 0; i < units.size(); ++i) {
+			for(const auto& cur : units[i].getTypes()) {
+				addEntry(cur.first, cur.second, i);
+			}
+			for(const auto& cur : units[i].getFunctions()) {
+				addEntry(cur.first, cur.second, i);
+			}
+		}
+
+		// merge the partitions in parallel
+		vector<vector<const SymbolEntry*>> retained(numPartitions);
+		vector<vector<MergeConflict>> partitionConflicts(numPartitions);
+		if(numPartitions == 1) {
+			mergePartition(partitions[0], retained[0], partitionConflicts[0]);
+		} else {
+			vector<std::thread> workers;
+			for(unsigned i = 0; i < numPartitions; ++i) {
+				workers.push_back(std::thread([&, i]() { mergePartition(partitions[i], retained[i], partitionConflicts[i]); }));
+			}
+			for(auto& cur : workers) {
+				cur.join();
+			}
+		}
+
+		// collect the retained definitions
+		for(unsigned i = 0; i < numPartitions; ++i) {
+			for(const auto& cur : retained[i]) {
+				if(const core::GenericTypePtr& type = cur->symbol.isa<core::GenericTypePtr>()) {
+					res.addType(type, cur->definition.as<core::TagTypePtr>());
+				} else {
+					res.addFunction(cur->symbol.as<core::LiteralPtr>(), cur->definition.as<core::LambdaExprPtr>());
+				}
+			}
+			conflicts.insert(conflicts.end(), partitionConflicts[i].begin(), partitionConflicts[i].end());
+		}
+
+		// report conflicts in the order of the units
+		std::stable_sort(conflicts.begin(), conflicts.end(), [](const MergeConflict& a, const MergeConflict& b) { return a.dropped < b.dropped; });
+
+		// globals, initializer and entry points are merged in order
+		for(const auto& unit : units) {
+			for(const auto& cur : unit.getGlobals()) {
+				res.addGlobal(cur);
+			}
+			for(const auto& cur : unit.getInitializer()) {
+				res.addInitializer(cur);
+			}
+			for(const auto& cur : unit.getEntryPoints()) {
+				res.addEntryPoints(cur);
+			}
+		}
+
 		res.setCXX(any(units, [](const IRTranslationUnit& cur) { return cur.isCXX(); }));
 		return res;
 	}
@@ -194,10 +333,12 @@ namespace tu {
 
 			FrontendIRBuilder builder;
 
+			const IRTranslationUnit& unit;
+
 			NodeMap symbolMap;
 
 		  public:
-			Resolver(NodeManager& mgr, const IRTranslationUnit& unit) : mgr(mgr), builder(mgr), symbolMap() {
+			Resolver(NodeManager& mgr, const IRTranslationUnit& unit) : mgr(mgr), builder(mgr), unit(unit), symbolMap() {
 				// copy type symbols into symbol table
 				for(auto cur : unit.getTypes()) {
 					symbolMap[mgr.get(cur.first)] = mgr.get(cur.second);
@@ -245,6 +386,17 @@ namespace tu {
 				return symbolMap.find(symbol)->second;
 			}
 
+			NodeList getDependencies(const NodePtr& symbol) const {
+				assert_true(isSymbol(symbol));
+
+				// filter the potential references recorded by the dependency index of the unit
+				NodeList res;
+				for(const auto& cur : unit.getDependencies(symbol)) {
+					if(isSymbol(cur)) { res.push_back(mgr.get(cur)); }
+				}
+				return res;
+			}
+
 			// --- Step 1: Symbol extraction ---
 
 			mutable utils::map::PointerMap<NodePtr, bool> containsSymbolsCache;
@@ -313,7 +465,7 @@ namespace tu {
 					res.addVertex(cur);
 
 					// add dependencies to graph
-					for(const auto& other : getContainedSymbols(getDefinition(cur))) {
+					for(const auto& other : getDependencies(cur)) {
 						// skip already resolved nodes
 						if(isResolved(other)) { continue; }
 
@@ -362,7 +514,7 @@ namespace tu {
 			}
 
 			bool isDirectRecursive(const NodePtr& symbol) {
-				return getContainedSymbols(getDefinition(symbol)).contains(symbol);
+				return contains(getDependencies(symbol), symbol);
 			}
 
 			void resolveComponents(const RecComponentGraph& graph) {
@@ -571,6 +571,48 @@ namespace arithmetic {
 		          toString(toPiecewise(builder.select(v1, builder.select(v2, v3, lt), lt))));
 	}
 
+	TEST(ArithmeticTest, CachedConversion) {
+		NodeManager mgr;
+		IRBuilder builder(mgr);
+		auto& basic = mgr.getLangBasic();
+
+		auto v1 = builder.variable(basic.getInt4(), 1);
+		auto v2 = builder.variable(basic.getInt4(), 2);
+		auto lt = basic.getSignedIntLt();
+
+		// repeated conversions should produce the same results
+		auto sum = builder.add(builder.mul(builder.intLit(2), v1), v2);
+		EXPECT_EQ("2*v1+v2", toString(toFormula(sum)));
+		EXPECT_EQ(toFormula(sum), toFormula(sum));
+		EXPECT_EQ(toPiecewise(sum), toPiecewise(sum));
+
+		// also for structurally identical expressions
+		EXPECT_EQ(toFormula(sum), toFormula(builder.add(builder.mul(builder.intLit(2), v1), v2)));
+
+		// failures should be reproduced
+		auto str = builder.stringLit("hello");
+		EXPECT_THROW(toFormula(str), NotAFormulaException);
+		EXPECT_THROW(toFormula(str), NotAFormulaException);
+
+		// a failed formula conversion must not prevent a piecewise conversion
+		auto select = builder.add(builder.select(v1, v2, lt), builder.intLit(1));
+		EXPECT_THROW(toFormula(select), NotAFormulaException);
+		EXPECT_THROW(toFormula(select), NotAFormulaException);
+
+		Piecewise pw = toPiecewise(select);
+		EXPECT_EQ(pw, toPiecewise(select));
+		EXPECT_EQ(pw + pw, toPiecewise(select) + toPiecewise(select));
+
+		// cached results must not be carried along when cloning nodes into another manager
+		NodeManager mgr2;
+		auto sum2 = mgr2.get(sum);
+		EXPECT_EQ("2*v1+v2", toString(toFormula(sum2)));
+		for(const Value& cur : toFormula(sum2).extractValues()) {
+			EXPECT_EQ(&mgr2, &static_cast<ExpressionPtr>(cur)->getNodeManager());
+		}
+		EXPECT_EQ(toString(pw), toString(toPiecewise(mgr2.get(select))));
+	}
+
 
 } // end namespace arithmetic
 } // end namespace core
@@ -182,6 +182,72 @@ namespace tu {
 		EXPECT_TRUE(res->isRecursive()) << res;
 	}
 
+	TEST(TranslationUnit, DependencyIndex) {
+		core::NodeManager mgr;
+		core::IRBuilder builder(mgr);
+
+		IRTranslationUnit tu(mgr);
+		auto a = builder.genericType("a");
+		auto b = builder.genericType("b");
+		tu.addType(a, builder.parseType("struct a { x : ref<array<b,1>>; }").as<TagTypePtr>());
+		tu.addType(b, builder.parseType("struct b { x : int<4>; }").as<TagTypePtr>());
+
+		// the index covers the referenced symbol
+		EXPECT_TRUE(tu.getDependencies(a).contains(b));
+		EXPECT_FALSE(tu.getDependencies(b).contains(a));
+
+		// the index is preserved when copying the unit
+		IRTranslationUnit copy = tu;
+		EXPECT_TRUE(copy.getDependencies(a).contains(b));
+
+		// replacing a definition updates the index
+		tu.replaceType(b, builder.parseType("struct b { x : ref<array<a,1>>; }").as<TagTypePtr>());
+		EXPECT_TRUE(tu.getDependencies(b).contains(a));
+		EXPECT_FALSE(copy.getDependencies(b).contains(a));
+
+		// resolving twice yields the same result
+		auto res = tu.resolve(a).as<core::TagTypePtr>();
+		EXPECT_TRUE(res->isRecursive()) << res;
+		EXPECT_EQ(res, tu.resolve(a));
+	}
+
+	TEST(TranslationUnit, MergeConflicts) {
+		core::NodeManager mgr;
+		core::IRBuilder builder(mgr);
+
+		auto x = builder.parseExpr("lit(\"X\":()->unit)").as<core::LiteralPtr>();
+		auto y = builder.parseExpr("lit(\"Y\":()->unit)").as<core::LiteralPtr>();
+		auto a = builder.genericType("A");
+
+		vector<IRTranslationUnit> units(3, IRTranslationUnit(mgr));
+		units[0].addType(a, builder.parseType("struct A { x : int<4>; }").as<TagTypePtr>());
+		units[0].addFunction(x, builder.parseExpr("()->unit { return; }").as<core::LambdaExprPtr>());
+		units[1].addType(a, builder.parseType("struct A { x : int<4>; }").as<TagTypePtr>());
+		units[1].addFunction(y, builder.parseExpr("()->unit { return; }").as<core::LambdaExprPtr>());
+		units[1].addGlobal(builder.parseExpr("lit(\"a\":ref<int<4>>)").as<core::LiteralPtr>());
+		units[2].addFunction(x, builder.parseExpr("()->unit { var int<4> x; return; }").as<core::LambdaExprPtr>());
+		units[2].addGlobal(builder.parseExpr("lit(\"a\":ref<int<4>>)").as<core::LiteralPtr>(), builder.parseExpr("12"));
+
+		vector<MergeConflict> conflicts;
+		auto res = merge(mgr, units, conflicts);
+
+		// the identical type definition is no conflict, the function definition is
+		ASSERT_EQ(1u, conflicts.size());
+		EXPECT_EQ(x, conflicts[0].symbol);
+		EXPECT_EQ(0u, conflicts[0].retained);
+		EXPECT_EQ(2u, conflicts[0].dropped);
+
+		// the first definition is retained
+		EXPECT_EQ(1u, res.getTypes().size());
+		EXPECT_EQ(2u, res.getFunctions().size());
+		EXPECT_EQ(*units[0][x], *res[x]);
+		EXPECT_EQ(1u, res.getGlobals().size());
+		EXPECT_TRUE(res.getGlobals()[0].second);
+
+		// the result matches the pairwise merge
+		EXPECT_EQ(toString(merge(mgr, merge(mgr, units[0], units[1]), units[2])), toString(res));
+	}
+
 	TEST(TranslationUnit, MemberFunctionCall) {
 		core::NodeManager mgr;
 		core::IRBuilder builder(mgr);
@@ -51,6 +51,7 @@
 
 #include "insieme/frontend/frontend.h"
 
+#include "insieme/backend/c_ast/c_code.h"
 #include "insieme/backend/runtime/runtime_backend.h"
 #include "insieme/backend/sequential/sequential_backend.h"
 
@@ -363,6 +364,9 @@ int main(int argc, char** argv) {
 		compiler.addFlag(std::string("-D" + cur.first));
 	}
 
+	// enable the runtime selection of task variants
+	if(options.settings.taskGranularityTuning) { compiler.addFlag("-DIRT_TASK_OPT"); }
+
 	// if an optimization flag is set (e.g. -O3)
 	// set this flag in the backend compiler
 	if(!options.settings.optimization.empty()) { compiler.addFlag("-O" + options.settings.optimization); }
@@ -372,5 +376,38 @@ int main(int argc, char** argv) {
 	// if yes, use the same standard in the backend compiler
 	if(options.job.isCxx()) { compiler.addFlag("-std=c++0x"); }
 
+	// split C code into multiple translation units compiled in parallel if requested
+	auto cCode = std::dynamic_pointer_cast<be::c_ast::CCode>(targetCode);
+	if(options.settings.units > 1 && cCode) {
+		fs::path dir = fs::unique_path(fs::temp_directory_path() / "insieme-src-%%%%%%%%");
+		fs::create_directory(dir);
+
+		be::c_ast::CodeEmissionOptions emission;
+		emission.numUnits = options.settings.units;
+		emission.releaseFragments = true;
+		// only the primary unit may include the header-implemented runtime
+		if(std::dynamic_pointer_cast<be::runtime::RuntimeBackend>(backend)) { emission.primaryIncludes = be::runtime::RuntimeBackend::getPrimaryIncludes(); }
+
+		vector<string> units;
+		try {
+			units = cCode->writeTo((dir / "code.c").string(), emission);
+		} catch(const be::c_ast::CodeEmissionException& e) {
+			std::cerr << "Unable to write target code: " << e.what() << std::endl;
+			return 1;
+		}
+
+		// free the C AST before running the backend compiler
+		cCode.reset();
+		targetCode.reset();
+
+		bool success = cp::compile(units, options.settings.outFile.string(), compiler, options.settings.jobs);
+		if(success) {
+			fs::remove_all(dir);
+		} else {
+			std::cerr << "Offending source code can be found in " << dir << std::endl;
+		}
+		return !success;
+	}
+
 	return !cp::compileToBinary(*targetCode, options.settings.outFile.string(), compiler);
 }
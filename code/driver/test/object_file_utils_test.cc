@@ -41,6 +41,7 @@
 #include <boost/filesystem/operations.hpp>
 
 #include "insieme/utils/config.h"
+#include "insieme/utils/timer.h"
 #include "insieme/frontend/frontend.h"
 
 namespace fe = insieme::frontend;
@@ -78,5 +79,91 @@ namespace driver {
 		if(fs::exists(file)) { fs::remove(file); }
 	}
 
+	namespace {
+
+		// creates a set of object files from the test inputs
+		vector<fs::path> createObjectFiles(core::NodeManager& mgr) {
+			vector<fs::path> files;
+			for(const auto& input : {"hello_world.c", "even_odd.c", "jacobi.c", "recursion.c", "simple_loop_nest.c", "structs.c"}) {
+				fe::ConversionJob job(string(DRIVER_TEST_DIR "/inputs/") + input);
+				auto file = fs::unique_path(fs::temp_directory_path() / "tmp%%%%%%%%.o");
+				saveLib(job.toIRTranslationUnit(mgr), file);
+				files.push_back(file);
+			}
+			return files;
+		}
+
+		// loads the given object files repeatedly, as if linking a larger number of object files
+		vector<core::tu::IRTranslationUnit> loadObjectFiles(core::NodeManager& mgr, const vector<fs::path>& files, unsigned copies) {
+			vector<core::tu::IRTranslationUnit> units;
+			for(unsigned i = 0; i < copies; ++i) {
+				for(const auto& file : files) {
+					units.push_back(loadLib(mgr, file));
+				}
+			}
+			return units;
+		}
+
+	}
+
+	TEST(ObjectFile, LinkingManyUnits) {
+		core::NodeManager mgr;
+
+		auto files = createObjectFiles(mgr);
+		auto units = loadObjectFiles(mgr, files, 5);
+
+		// link them by folding them pairwise ..
+		core::tu::IRTranslationUnit pairwise(mgr);
+		for(const auto& cur : units) {
+			pairwise = core::tu::merge(mgr, pairwise, cur);
+		}
+
+		// .. and using the k-way merge
+		vector<core::tu::MergeConflict> conflicts;
+		core::tu::IRTranslationUnit kway = core::tu::merge(mgr, units, conflicts);
+
+		// both should produce the same result
+		EXPECT_EQ(pairwise.getTypes().size(), kway.getTypes().size());
+		EXPECT_EQ(pairwise.getFunctions().size(), kway.getFunctions().size());
+		EXPECT_EQ(pairwise.getGlobals().size(), kway.getGlobals().size());
+		for(const auto& cur : pairwise.getFunctions()) {
+			EXPECT_EQ(cur.second, kway[cur.first]) << cur.first;
+		}
+
+		// the inputs define different main functions, the first one is retained
+		EXPECT_FALSE(conflicts.empty());
+		for(const auto& cur : conflicts) {
+			EXPECT_LT(cur.retained, cur.dropped) << cur;
+		}
+
+		// cleanup
+		for(const auto& file : files) {
+			if(fs::exists(file)) { fs::remove(file); }
+		}
+	}
+
+	// a benchmark rather than a test, run it using --gtest_also_run_disabled_tests
+	TEST(ObjectFile, DISABLED_LinkingBenchmark) {
+		core::NodeManager mgr;
+
+		auto files = createObjectFiles(mgr);
+		auto units = loadObjectFiles(mgr, files, 20);
+
+		core::tu::IRTranslationUnit pairwise(mgr);
+		double pairwiseTime = TIME(for(const auto& cur : units) { pairwise = core::tu::merge(mgr, pairwise, cur); });
+
+		vector<core::tu::MergeConflict> conflicts;
+		core::tu::IRTranslationUnit kway(mgr);
+		double kwayTime = TIME(kway = core::tu::merge(mgr, units, conflicts));
+
+		std::cout << "Linking " << units.size() << " units: pairwise " << pairwiseTime << "s, k-way " << kwayTime << "s\n";
+		EXPECT_EQ(pairwise.getFunctions().size(), kway.getFunctions().size());
+
+		// cleanup
+		for(const auto& file : files) {
+			if(fs::exists(file)) { fs::remove(file); }
+		}
+	}
+
 } // end namespace driver
 } // end namespace insieme
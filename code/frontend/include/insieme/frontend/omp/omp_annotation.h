@@ -178,8 +178,8 @@ namespace omp {
 
 	class Reduction {
 	  public:
-		// operator = + or - or * or & or | or ^ or && or ||
-		enum Operator { PLUS, MINUS, MUL, AND, OR, XOR, LAND, LOR };
+		// operator = + or - or * or & or | or ^ or && or || or min or max
+		enum Operator { PLUS, MINUS, MUL, AND, OR, XOR, LAND, LOR, MIN, MAX };
 
 		Reduction(const Operator& op, const VarListPtr& vars) : op(op), vars(vars) {}
 		const Operator& getOperator() const {
@@ -204,6 +204,8 @@ namespace omp {
 			case XOR: return "^";
 			case LAND: return "&&";
 			case LOR: return "||";
+			case MIN: return "min";
+			case MAX: return "max";
 			}
 			assert_fail() << "Operator doesn't exist";
 			return "?";
@@ -341,9 +343,9 @@ namespace omp {
 		bool hasCollapse() const {
 			return static_cast<bool>(collapseExpr);
 		}
-		const core::Expression& getCollapse() const {
+		const core::ExpressionPtr& getCollapse() const {
 			assert_true(hasCollapse());
-			return *collapseExpr;
+			return collapseExpr;
 		}
 
 		bool hasNoWait() const {
@@ -725,18 +727,42 @@ namespace omp {
 	class Task : public DatasharingClause, public Annotation, public SharedParallelAndTaskClause {
 		bool untied;
 		Reduction dummy;
+		VarListPtr dependInClause;
+		VarListPtr dependOutClause;
 
 	  public:
 		Task(const core::ExpressionPtr& ifClause, bool untied, const DefaultPtr& defaultClause, const VarListPtr& privateClause,
-		     const VarListPtr& firstPrivateClause, const VarListPtr& sharedClause)
+		     const VarListPtr& firstPrivateClause, const VarListPtr& sharedClause, const VarListPtr& dependInClause = VarListPtr(),
+		     const VarListPtr& dependOutClause = VarListPtr())
 		    : DatasharingClause(privateClause, firstPrivateClause),
 		      SharedParallelAndTaskClause(ifClause, defaultClause, sharedClause),
-		      untied(untied), dummy(Reduction::PLUS, VarListPtr()) {}
+		      untied(untied), dummy(Reduction::PLUS, VarListPtr()), dependInClause(dependInClause), dependOutClause(dependOutClause) {}
 
 		bool hasUntied() const {
 			return untied;
 		}
 
+		/**
+		 * Determines whether the task has any depend clause, inout dependences are listed as out dependences.
+		 */
+		bool hasDepend() const {
+			return (dependInClause && !dependInClause->empty()) || (dependOutClause && !dependOutClause->empty());
+		}
+		bool hasDependIn() const {
+			return static_cast<bool>(dependInClause);
+		}
+		const VarList& getDependIn() const {
+			assert_true(hasDependIn());
+			return *dependInClause;
+		}
+		bool hasDependOut() const {
+			return static_cast<bool>(dependOutClause);
+		}
+		const VarList& getDependOut() const {
+			assert_true(hasDependOut());
+			return *dependOutClause;
+		}
+
 		bool hasReduction() const {
 			return false;
 		}
@@ -752,6 +778,8 @@ namespace omp {
 			Annotation::replaceUsage(map);
 			SharedParallelAndTaskClause::replaceUsage(map);
 			if(hasReduction()) { dummy.replaceUsage(map); }
+			replaceVars(dependInClause, map);
+			replaceVars(dependOutClause, map);
 		}
 	};
 
@@ -97,8 +97,16 @@ namespace extensions {
 		// num_threads(list)
 		auto num_threads_clause = kwd("num_threads") >> l_paren >> expr["num_threads"] >> r_paren;
 
-		// + or - or * or & or | or ^ or && or ||
-		auto op = tok::plus | tok::minus | tok::star | tok::amp | tok::pipe | tok::caret | tok::ampamp | tok::pipepipe;
+		// expression *(, expression)
+		auto expr_list = tok::expr["v"] >> *(~comma >> tok::expr["v"]);
+
+		// depend(in | out | inout : list), inout dependences are handled like out dependences
+		auto depend_clause = kwd("depend") >> l_paren
+		                     >> ((kwd("in") >> colon >> expr_list["depend_in"]) | ((kwd("out") | kwd("inout")) >> colon >> expr_list["depend_out"]))
+		                     >> r_paren;
+
+		// + or - or * or & or | or ^ or && or || or min or max
+		auto op = tok::plus | tok::minus | tok::star | tok::amp | tok::pipe | tok::caret | tok::ampamp | tok::pipepipe | kwd("min") | kwd("max");
 
 		// reduction(operator: list)
 		auto reduction_clause = kwd("reduction") >> l_paren >> op["reduction_op"] >> colon >> var_list["reduction"] >> r_paren;
@@ -216,7 +224,8 @@ namespace extensions {
 		    def |                                                       // private(list)
 		    private_clause |                                            // firstprivate(list)
 		    firstprivate_clause |                                       // shared(list)
-		    kwd("shared") >> l_paren >> var_list["shared"] >> r_paren | // local(list)
+		    kwd("shared") >> l_paren >> var_list["shared"] >> r_paren | // depend(in | out | inout : list)
+		    depend_clause |                                             // local(list)
 		    local_clause |                                              // firstlocal(list)
 		    firstlocal_clause |                                         // lastlocal(list)
 		    lastlocal_clause |                                          // target(target-type[:group-id[:core-id]])
@@ -337,6 +346,10 @@ namespace extensions {
 				op = omp::Reduction::LAND;
 			} else if(opIt == "||") {
 				op = omp::Reduction::LOR;
+			} else if(opIt == "min") {
+				op = omp::Reduction::MIN;
+			} else if(opIt == "max") {
+				op = omp::Reduction::MAX;
 			} else {
 				assert_fail() << "Reduction operator not supported.";
 			}
@@ -586,9 +599,13 @@ namespace extensions {
 			    omp::VarListPtr firstPrivateClause = handleIdentifierList(object, "firstprivate");
 			    // check for shared clause
 			    omp::VarListPtr sharedClause = handleIdentifierList(object, "shared");
+			    // check for depend clauses
+			    omp::VarListPtr dependInClause = handleIdentifierList(object, "depend_in");
+			    omp::VarListPtr dependOutClause = handleIdentifierList(object, "depend_out");
 
 			    frontend::omp::BaseAnnotation::AnnotationList anns;
-			    anns.push_back(std::make_shared<omp::Task>(ifClause, untied, defaultClause, privateClause, firstPrivateClause, sharedClause));
+			    anns.push_back(std::make_shared<omp::Task>(ifClause, untied, defaultClause, privateClause, firstPrivateClause, sharedClause, dependInClause,
+			                                               dependOutClause));
 
 			    for(auto& node : nodes) {
 				    core::StatementPtr&& stmt = node.as<core::StatementPtr>();
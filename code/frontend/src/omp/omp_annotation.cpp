@@ -153,6 +153,8 @@ namespace omp {
 		out << "task(";
 		CommonClause::dump(out);
 		SharedParallelAndTaskClause::dump(out);
+		if(hasDependIn() && !dependInClause->empty()) { out << "depend(in:" << join(",", *dependInClause) << "), "; }
+		if(hasDependOut() && !dependOutClause->empty()) { out << "depend(inout:" << join(",", *dependOutClause) << "), "; }
 		if(hasUntied()) { out << "untied"; }
 		return out << ")";
 	}
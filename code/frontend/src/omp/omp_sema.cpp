@@ -49,6 +49,7 @@
 #include "insieme/core/printer/pretty_printer.h"
 #include "insieme/core/analysis/ir_utils.h"
 #include "insieme/core/arithmetic/arithmetic.h"
+#include "insieme/core/arithmetic/arithmetic_utils.h"
 #include "insieme/core/analysis/attributes.h"
 #include "insieme/core/annotations/naming.h"
 
@@ -59,6 +60,7 @@
 #include "insieme/utils/name_mangling.h"
 
 #include "insieme/frontend/utils/clang_cast.h"
+#include "insieme/frontend/utils/expr_to_bool.h"
 #include "insieme/frontend/utils/frontend_inspire_module.h"
 
 #include "insieme/core/tu/ir_translation_unit.h"
@@ -511,53 +513,77 @@ namespace omp {
 			return replacement;
 		}
 
+		// combines two values of a reduction variable according to the given operator
+		ExpressionPtr combineReductionValues(Reduction::Operator op, const ExpressionPtr& a, const ExpressionPtr& b) {
+			switch(op) {
+			case Reduction::PLUS:
+			case Reduction::MINUS: return build.add(a, b);
+			case Reduction::MUL: return build.mul(a, b);
+			case Reduction::AND: return build.bitwiseAnd(a, b);
+			case Reduction::OR: return build.bitwiseOr(a, b);
+			case Reduction::XOR: return build.bitwiseXor(a, b);
+			case Reduction::LAND:
+			case Reduction::LOR: {
+				auto lhs = frontend::utils::exprToBool(a);
+				auto rhs = frontend::utils::exprToBool(b);
+				ExpressionPtr combined = (op == Reduction::LAND) ? build.logicAnd(lhs, rhs) : build.logicOr(lhs, rhs);
+				if(basic.isBool(a->getType())) { return combined; }
+				return build.numericCast(frontend::utils::buildBoolToInt(combined), a->getType());
+			}
+			case Reduction::MIN: return build.ite(build.lt(a, b), build.wrapLazy(a), build.wrapLazy(b));
+			case Reduction::MAX: return build.ite(build.gt(a, b), build.wrapLazy(a), build.wrapLazy(b));
+			}
+			LOG(ERROR) << "OMP reduction operator: " << Reduction::opToStr(op);
+			assert_fail() << "Unsupported reduction operator";
+			return ExpressionPtr();
+		}
+
+		// integer reductions with an atomic read-modify-write counterpart can be applied to the shared variable directly
+		bool isAtomicReduction(Reduction::Operator op, const TypePtr& type) {
+			if(!basic.isInt(core::analysis::getReferencedType(type))) { return false; }
+			return op == Reduction::PLUS || op == Reduction::MINUS || op == Reduction::AND || op == Reduction::OR || op == Reduction::XOR;
+		}
+
+		// builds the function folding the value referenced by its second parameter into the one referenced by its first
+		LambdaExprPtr buildReductionCombinator(Reduction::Operator op, const TypePtr& type) {
+			VariablePtr acc = build.variable(build.refType(type));
+			VariablePtr val = build.variable(build.refType(type));
+			auto accRef = build.deref(acc);
+			auto body = build.assign(accRef, combineReductionValues(op, build.deref(accRef), build.deref(build.deref(val))));
+			return build.lambdaExpr(basic.getUnit(), toVector(acc, val), body);
+		}
+
 		// implements reduction steps after parallel / for clause
-		CompoundStmtPtr implementReductions(const DatasharingClause* clause, NodeMap& publicToPrivateMap) {
+		// - suitable integer reductions update the shared variable using atomics
+		// - otherwise, if the whole thread group executes the construct, the private copies are combined in a tree
+		//   reduction and thread 0 updates the shared variable
+		// - the remaining cases (tasks) are serialized using a critical section
+		CompoundStmtPtr implementReductions(const DatasharingClause* clause, NodeMap& publicToPrivateMap, bool collective) {
 			static unsigned redId = 0;
+			Reduction::Operator op = clause->getReduction().getOperator();
 			StatementList replacements;
+			StatementList masterUpdates;
+			StatementList criticalUpdates;
 			for_each(clause->getReduction().getVars(), [&](const ExpressionPtr& varExp) {
-				StatementPtr operation;
-				switch(clause->getReduction().getOperator()) {
-				case Reduction::PLUS:
-					operation =
-					    build.assign(varExp, build.add(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				case Reduction::MINUS:
-					operation =
-					    build.assign(varExp, build.add(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				case Reduction::MUL:
-					operation =
-					    build.assign(varExp, build.mul(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				case Reduction::AND:
-					operation = build.assign(
-					    varExp, build.bitwiseAnd(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				case Reduction::OR:
-					operation = build.assign(
-					    varExp, build.bitwiseOr(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				case Reduction::XOR:
-					operation = build.assign(
-					    varExp, build.bitwiseXor(build.deref(varExp), build.deref(static_pointer_cast<const Expression>(publicToPrivateMap[varExp]))));
-					break;
-				// TODO: re-enable when new conversion from int to bool is available
-				//			case Reduction::LAND:
-				//				operation = build.assign(varExp, build.logicAnd(build.deref(varExp), build.deref(static_pointer_cast<const
-				//Expression>(publicToPrivateMap[varExp]))));
-				//				break;
-				//			case Reduction::LOR:
-				//				operation = build.assign(varExp, build.logicOr(build.deref(varExp), build.deref(static_pointer_cast<const
-				//Expression>(publicToPrivateMap[varExp]))));
-				//				break;
-				default:
-					LOG(ERROR) << "OMP reduction operator: " << Reduction::opToStr(clause->getReduction().getOperator());
-					assert_fail() << "Unsupported reduction operator";
+				ExpressionPtr privateVar = static_pointer_cast<const Expression>(publicToPrivateMap[varExp]);
+				CallExprPtr operation = build.assign(varExp, combineReductionValues(op, build.deref(varExp), build.deref(privateVar)));
+				if(isAtomicReduction(op, varExp->getType())) {
+					replacements.push_back(build.atomicAssignment(operation));
+				} else if(collective) {
+					replacements.push_back(build.treeReduce(privateVar, buildReductionCombinator(op, privateVar->getType())));
+					masterUpdates.push_back(operation);
+				} else {
+					criticalUpdates.push_back(operation);
 				}
-				replacements.push_back(operation);
 			});
-			return makeCritical(build.compoundStmt(replacements), string("reduce_") + toString(++redId));
+			if(!masterUpdates.empty()) {
+				auto isMaster = build.eq(build.getThreadId(), build.getZero(build.getThreadId().getType()));
+				replacements.push_back(build.ifStmt(isMaster, build.compoundStmt(masterUpdates)));
+			}
+			if(!criticalUpdates.empty()) {
+				replacements.push_back(makeCritical(build.compoundStmt(criticalUpdates), string("reduce_") + toString(++redId)));
+			}
+			return build.compoundStmt(replacements);
 		}
 
 		// returns the correct initial reduction value for the given operator and type
@@ -572,8 +598,8 @@ namespace omp {
 			case Reduction::XOR: ret = build.refVar(build.literal("0", elemType)); break;
 			case Reduction::MUL:
 			case Reduction::AND: ret = build.refVar(build.literal("1", elemType)); break;
-			case Reduction::LAND: ret = build.refVar(build.boolLit(true)); break;
-			case Reduction::LOR: ret = build.refVar(build.boolLit(false)); break;
+			case Reduction::LAND: ret = build.refVar(basic.isBool(elemType) ? build.boolLit(true) : build.literal("1", elemType)); break;
+			case Reduction::LOR: ret = build.refVar(basic.isBool(elemType) ? build.boolLit(false) : build.literal("0", elemType)); break;
 			default: LOG(ERROR) << "OMP reduction operator: " << Reduction::opToStr(op); assert_fail() << "Unsupported reduction operator";
 			}
 			return ret;
@@ -645,7 +671,15 @@ namespace omp {
 					}
 				}
 				if(clause->hasReduction() && contains(clause->getReduction().getVars(), varExp)) {
-					decl = build.declarationStmt(pVar, getReductionInitializer(clause->getReduction().getOperator(), expType));
+					auto op = clause->getReduction().getOperator();
+					if(op == Reduction::MIN || op == Reduction::MAX) {
+						// min and max are idempotent, so private copies may start out with the original value
+						VariablePtr initVar = build.variable(core::analysis::getReferencedType(expType));
+						outsideDecls.push_back(build.declarationStmt(initVar, build.deref(varExp)));
+						decl = build.declarationStmt(pVar, build.refVar(initVar));
+					} else {
+						decl = build.declarationStmt(pVar, getReductionInitializer(op, expType));
+					}
 				}
 				if(contains(lastPrivates, varExp)) { ifStmtBodyLast.push_back(build.assign(varExp, build.deref(pVar))); }
 				replacements.push_back(decl);
@@ -684,8 +718,10 @@ namespace omp {
 			// specific handling if clause is a omp for
 			if(forP) {
 				if(forP->hasOrdered()) { subStmt = processOrderedFor(subStmt); }
+				if(forP->hasOrdered() && forP->hasCollapse()) { LOG(WARNING) << "OMP collapse clause ignored on ordered loop"; }
 				// Handling lastlocal
 				if(lastPrivates.size()) {
+					if(forP->hasCollapse()) { LOG(WARNING) << "OMP collapse clause ignored on loop with lastprivate clause"; }
 					auto outer = static_pointer_cast<const ForStmt>(subStmt);
 					StatementList newForBodyStmts;
 					for_each(outer->getBody()->getStatements(), [&](core::StatementPtr elem) { newForBodyStmts.push_back(elem); });
@@ -695,13 +731,16 @@ namespace omp {
 					//newForBodyStmts.push_back(ifStmt);
 					//auto newForStmt = build.forStmt(outer->getDeclaration(), outer->getEnd(), outer->getStep(), build.compoundStmt(newForBodyStmts));
 					//subStmt = build.pfor(newForStmt);
+				} else if(forP->hasCollapse() && !forP->hasOrdered()) {
+					subStmt = buildCollapsedPFor(static_pointer_cast<const ForStmt>(subStmt), getCollapseDepth(*forP));
 				} else {
 					subStmt = build.pfor(static_pointer_cast<const ForStmt>(subStmt));
 				}
 			}
 			replacements.push_back(subStmt);
 			// implement reductions
-			if(clause->hasReduction()) { replacements.push_back(implementReductions(clause, publicToPrivateMap)); }
+			// (tasks are not executed by the whole thread group, and cannot take part in collective operations)
+			if(clause->hasReduction()) { replacements.push_back(implementReductions(clause, publicToPrivateMap, !taskP)); }
 			// specific handling if clause is a omp for (insert barrier if not nowait)
 			if(forP && !forP->hasNoWait()) { replacements.push_back(build.barrier()); }
 			// append postfix
@@ -743,10 +782,43 @@ namespace omp {
 			return ret;
 		}
 
+		// obtains the memory location a depend clause item refers to
+		ExpressionPtr getDependenceAddress(const ExpressionPtr& item) {
+			if(core::analysis::isRefType(item->getType())) { return item; }
+			auto& refExt = nodeMan.getLangExtension<core::lang::ReferenceExtension>();
+			if(analysis::isCallOf(item, refExt.getRefDeref())) { return analysis::getArgument(item, 0); }
+			assert_fail() << "OMP depend clause item does not denote a memory location: " << *item;
+			return item;
+		}
+
+		// registers the dependences of a task with the runtime before it is spawned and makes the task wait for them
+		// before executing its body, and release its own ones afterwards
+		BindExprPtr implementTaskDependences(const StatementPtr& stmtNode, const Task& taskP, StatementList& outsideStmts) {
+			TypePtr depsType = parExt.getTaskDeps();
+			VariablePtr handle = build.variable(build.refType(depsType));
+			outsideStmts.push_back(build.declarationStmt(handle, build.refVar(build.callExpr(depsType, parExt.getTaskDepsCreate()))));
+			auto addDependences = [&](const VarList& items, bool write) {
+				for(const auto& item : items) {
+					outsideStmts.push_back(
+					    build.callExpr(basic.getUnit(), parExt.getTaskDepsAdd(), build.deref(handle), getDependenceAddress(item), build.boolLit(write)));
+				}
+			};
+			if(taskP.hasDependIn()) { addDependences(taskP.getDependIn(), false); }
+			if(taskP.hasDependOut()) { addDependences(taskP.getDependOut(), true); }
+
+			// the handle is bound by value, since the task may outlive the scope it has been spawned in
+			VariablePtr deps = build.variable(depsType);
+			auto body = build.compoundStmt(build.callExpr(basic.getUnit(), parExt.getTaskDepsWait(), deps), stmtNode,
+			                               build.callExpr(basic.getUnit(), parExt.getTaskDepsRelease(), deps));
+			auto taskLambda = transform::extractLambda(nodeMan, body, toVector(deps));
+			return build.bindExpr(VariableList(), build.callExpr(basic.getUnit(), taskLambda, build.deref(handle)));
+		}
+
 		NodePtr handleTask(const StatementPtr& stmtNode, const TaskPtr& par) {
 			StatementList resultStmts;
 			auto newStmtNode = implementDataClauses(stmtNode, &*par, resultStmts);
-			auto parLambda = transform::extractLambda(nodeMan, stmtNode);
+			// tasks with dependences are ordered after their predecessors only, instead of requiring a taskwait
+			auto parLambda = par->hasDepend() ? implementTaskDependences(stmtNode, *par, resultStmts) : transform::extractLambda(nodeMan, stmtNode);
 			auto range = build.getThreadNumRange(1, 1); // range for tasks is always 1
 
 			JobExprPtr jobExp = build.jobExpr(range, parLambda.as<ExpressionPtr>());
@@ -800,10 +872,7 @@ namespace omp {
 			// set value in first iteration of loop
 			auto initialSet = b.ifStmt(b.eq(iterator, start), b.assign(getVolatileOrderedCount(), start));
 			// add safety net at end of body (for cases where ordered section not encountered)
-			auto waitLoop = b.callExpr(nodeMan.getLangExtension<core::lang::ParallelExtension>().getBusyLoop(),
-			                           b.wrapLazy(b.ne(b.deref(getVolatileOrderedCount()), orderedItLit)));
-			auto atomic = b.atomicAssignment(b.assign(getVolatileOrderedCount(), b.add(b.deref(getVolatileOrderedCount()), orderedIncLit)));
-			auto increment = b.compoundStmt(waitLoop, atomic);
+			auto increment = b.compoundStmt(buildOrderedWait(), buildOrderedAdvance());
 			auto conditionalIncrease = b.ifStmt(b.ge(orderedIncLit, b.getZero(step->getType())), // deal with loops counting down as well as up
 			                                    b.ifStmt(b.le(b.deref(getVolatileOrderedCount()), orderedItLit), increment),
 			                                    b.ifStmt(b.ge(b.deref(getVolatileOrderedCount()), orderedItLit), increment));
@@ -821,19 +890,145 @@ namespace omp {
 			return forStmt;
 		}
 
+		// folds constant integer expressions into literals of the given type, other expressions are converted to it
+		ExpressionPtr toFoldedType(const ExpressionPtr& expr, const TypePtr& type) {
+			try {
+				auto formula = arithmetic::toFormula(expr);
+				if(formula.isInteger()) { return build.literal(type, toString(formula.getIntegerValue())); }
+			} catch(const arithmetic::NotAFormulaException&) {}
+			return build.numericCast(expr, type);
+		}
+
+		// number of iterations of the given loop as an expression of the given type
+		ExpressionPtr getTripCount(const ForStmtPtr& loop, const TypePtr& type) {
+			auto start = toFoldedType(loop->getStart(), type);
+			auto end = toFoldedType(loop->getEnd(), type);
+			auto step = toFoldedType(loop->getStep(), type);
+			// (end - start + step - 1) / step, which is not positive for empty loops
+			auto count = toFoldedType(build.div(build.sub(build.add(end, step), build.add(start, build.literal(type, "1"))), step), type);
+			try {
+				auto formula = arithmetic::toFormula(count);
+				if(formula.isInteger()) { return build.literal(type, toString(std::max<int64_t>(formula.getIntegerValue(), 0))); }
+			} catch(const arithmetic::NotAFormulaException&) {}
+			return build.ite(build.lt(start, end), build.wrapLazy(count), build.wrapLazy(build.literal(type, "0")));
+		}
+
+		// collects the loops of a perfect nest of the given depth, with bounds independent of the iterators of enclosing loops
+		// returns an empty list if there is no such nest
+		vector<ForStmtPtr> getRectangularLoopNest(const ForStmtPtr& outer, unsigned depth) {
+			vector<ForStmtPtr> nest = {outer};
+			while(nest.size() < depth) {
+				StatementPtr inner = nest.back()->getBody();
+				while(inner.isa<CompoundStmtPtr>() && inner.as<CompoundStmtPtr>().size() == 1) {
+					inner = inner.as<CompoundStmtPtr>()[0];
+				}
+				auto innerFor = inner.isa<ForStmtPtr>();
+				if(!innerFor) { return {}; }
+				for(const auto& loop : nest) {
+					for(const ExpressionPtr& bound : toVector(innerFor->getStart(), innerFor->getEnd(), innerFor->getStep())) {
+						if(core::analysis::contains(bound, loop->getIterator())) { return {}; }
+					}
+				}
+				nest.push_back(innerFor);
+			}
+			return nest;
+		}
+
+		// implements an omp for with collapse clause as a single pfor over the linearized iteration space of the loop nest,
+		// so the loop scheduler sees the full iteration count; the original indices are recovered once per chunk from its
+		// start using div/mod and advanced with a carry at the top of every iteration, such that a continue within the body
+		// can not skip any index update
+		CallExprPtr buildCollapsedPFor(const ForStmtPtr& outer, unsigned depth) {
+			auto nest = getRectangularLoopNest(outer, depth);
+			if(nest.size() < 2) {
+				LOG(WARNING) << "OMP collapse(" << depth << ") ignored, loops do not form a perfect rectangular nest";
+				return build.pfor(outer);
+			}
+			auto linearType = basic.getInt8();
+			vector<ExpressionPtr> counts;
+			for(const auto& loop : nest) {
+				counts.push_back(getTripCount(loop, linearType));
+			}
+			// strides of the individual loops in the linearized iteration space
+			vector<ExpressionPtr> strides(nest.size());
+			ExpressionPtr total = build.literal(linearType, "1");
+			for(int k = nest.size() - 1; k >= 0; --k) {
+				strides[k] = total;
+				total = toFoldedType(build.mul(total, counts[k]), linearType);
+			}
+
+			VariablePtr chunkStart = build.variable(linearType);
+			VariablePtr chunkEnd = build.variable(linearType);
+			VariablePtr chunkStep = build.variable(linearType);
+			VariablePtr linear = build.variable(linearType);
+			auto zero = build.literal(linearType, "0");
+			auto one = build.literal(linearType, "1");
+
+			// positions within the individual loops, the innermost one starts one before the chunk as it is advanced first
+			StatementList chunkStmts;
+			vector<VariablePtr> positions;
+			for(unsigned k = 0; k < nest.size(); ++k) {
+				ExpressionPtr pos = build.div(chunkStart, strides[k]);
+				if(k > 0) { pos = build.mod(pos, counts[k]); }
+				if(k == nest.size() - 1) { pos = build.sub(pos, one); }
+				VariablePtr position = build.variable(build.refType(linearType));
+				chunkStmts.push_back(build.declarationStmt(position, build.refVar(pos)));
+				positions.push_back(position);
+			}
+
+			// advance the innermost position, carrying over into the enclosing ones on overflow
+			StatementPtr advance = build.assign(positions[0], build.add(build.deref(positions[0]), one));
+			for(unsigned k = 1; k < nest.size(); ++k) {
+				auto overflow = build.eq(build.deref(positions[k]), counts[k]);
+				advance = build.compoundStmt(build.assign(positions[k], build.add(build.deref(positions[k]), one)),
+				                             build.ifStmt(overflow, build.compoundStmt(build.assign(positions[k], zero), advance)));
+			}
+
+			StatementList iterationStmts;
+			iterationStmts.push_back(advance);
+			NodeMap iteratorReplacements;
+			for(unsigned k = 0; k < nest.size(); ++k) {
+				const auto& loop = nest[k];
+				auto iterType = loop->getIterator()->getType();
+				VariablePtr index = build.variable(iterType);
+				iterationStmts.push_back(
+				    build.declarationStmt(index, build.add(loop->getStart(), build.mul(build.numericCast(build.deref(positions[k]), iterType), loop->getStep()))));
+				iteratorReplacements[loop->getIterator()] = index;
+			}
+
+			iterationStmts.push_back(transform::replaceAll(nodeMan, nest.back()->getBody(), iteratorReplacements).as<StatementPtr>());
+			// the range of a chunk is handed over with the step of the linearized loop, which is 1
+			chunkStmts.push_back(build.forStmt(linear, chunkStart, chunkEnd, chunkStep, build.compoundStmt(iterationStmts)));
+			auto lambda = transform::extractLambda(nodeMan, build.compoundStmt(chunkStmts), toVector(chunkStart, chunkEnd, chunkStep));
+			return build.pfor(lambda, zero, total, one);
+		}
+
+		unsigned getCollapseDepth(const For& forP) {
+			try {
+				auto formula = arithmetic::toFormula(forP.getCollapse());
+				if(formula.isInteger() && formula.getIntegerValue() > 0) { return formula.getIntegerValue(); }
+			} catch(const arithmetic::NotAFormulaException&) {}
+			assert_fail() << "OMP collapse clause requires a positive constant";
+			return 1;
+		}
+
+		// waits until the ordered counter reaches the current iteration, threads waiting for their turn are suspended by the runtime
+		StatementPtr buildOrderedWait() {
+			return build.callExpr(basic.getUnit(), parExt.getOrderedWait(), build.getThreadGroup(), getVolatileOrderedCount(), orderedItLit);
+		}
+
+		// passes the turn on to the next iteration
+		StatementPtr buildOrderedAdvance() {
+			return build.callExpr(basic.getUnit(), parExt.getOrderedAdvance(), build.getThreadGroup(), getVolatileOrderedCount(), orderedIncLit);
+		}
+
 		NodePtr handleOrdered(const StatementPtr& stmtNode, const OrderedPtr& orderedP) {
-			auto& b = build;
-			auto int8 = basic.getInt8();
-			auto waitLoop = b.callExpr(nodeMan.getLangExtension<core::lang::ParallelExtension>().getBusyLoop(),
-			                           b.wrapLazy(b.ne(b.deref(getVolatileOrderedCount()), orderedItLit)));
-			auto increment = b.atomicAssignment(b.assign(getVolatileOrderedCount(), b.add(b.deref(getVolatileOrderedCount()), orderedIncLit)));
-			return b.compoundStmt(waitLoop, stmtNode, increment);
+			return build.compoundStmt(buildOrderedWait(), stmtNode, buildOrderedAdvance());
 		}
 
 		NodePtr handleFor(const StatementPtr& stmtNode, const ForPtr& forP, bool isParallel = false) {
 			assert_eq(stmtNode.getNodeType(), NT_ForStmt) << "OpenMP for attached to non-for statement";
 			ForStmtPtr outer = dynamic_pointer_cast<const ForStmt>(stmtNode);
-			// outer = collapseForNest(outer);
 			StatementList resultStmts;
 			auto newStmtNode = implementDataClauses(outer, &*forP, resultStmts);
 			resultStmts.push_back(newStmtNode);
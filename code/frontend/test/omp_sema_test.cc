@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#include "insieme/core/ir_builder.h"
+#include "insieme/core/ir_visitor.h"
+#include "insieme/core/analysis/ir_utils.h"
+#include "insieme/core/checks/full_check.h"
+#include "insieme/core/lang/parallel.h"
+#include "insieme/core/lang/reference.h"
+#include "insieme/core/tu/ir_translation_unit.h"
+
+#include "insieme/frontend/omp/omp_annotation.h"
+#include "insieme/frontend/omp/omp_sema.h"
+
+namespace insieme {
+namespace frontend {
+namespace omp {
+
+	using namespace core;
+
+	TEST(OmpSema, CollapsedFor) {
+		NodeManager mgr;
+		IRBuilder builder(mgr);
+		auto& parExt = mgr.getLangExtension<lang::ParallelExtension>();
+		auto& refExt = mgr.getLangExtension<lang::ReferenceExtension>();
+
+		auto nest = builder.parseStmt(R"(
+			for(int<4> i = 0 .. 4) {
+				for(int<4> j = 0 .. 3) {
+					if(j == 1) { continue; }
+					lit("use" : (int<4>, int<4>) -> unit)(i, j);
+				}
+			}
+		)");
+		ASSERT_TRUE(nest);
+
+		// annotate the nest with an omp for collapse(2)
+		auto marker = builder.markerStmt(nest, 0);
+		auto forAnn = std::make_shared<For>(VarListPtr(), VarListPtr(), VarListPtr(), ReductionPtr(), SchedulePtr(), builder.intLit(2), true, false);
+		marker->addAnnotation(std::make_shared<BaseAnnotation>(BaseAnnotation::AnnotationList({forAnn})));
+
+		auto fun = builder.lambdaExpr(mgr.getLangBasic().getUnit(), VariableList(), builder.compoundStmt(marker));
+		tu::IRTranslationUnit unit(mgr);
+		unit.addFunction(builder.literal("f", fun->getType()), fun);
+
+		auto res = applySema(unit, mgr);
+		ASSERT_EQ(1u, res.getFunctions().size());
+		auto code = res.getFunctions().begin()->second;
+		EXPECT_TRUE(checks::check(code).getErrors().empty()) << checks::check(code);
+
+		// a single pfor covers the linearized iteration space
+		vector<CallExprPtr> pfors;
+		visitDepthFirst(code, [&](const CallExprPtr& call) {
+			if(parExt.isCallOfPFor(call)) { pfors.push_back(call); }
+		});
+		ASSERT_EQ(1u, pfors.size());
+		EXPECT_EQ("12", pfors[0]->getArgument(2).as<LiteralPtr>()->getStringValue());
+
+		auto body = pfors[0]->getArgument(4).as<BindExprPtr>()->getCall()->getFunctionExpr().as<LambdaExprPtr>()->getBody();
+		vector<ForStmtPtr> loops;
+		visitDepthFirst(body, [&](const ForStmtPtr& loop) { loops.push_back(loop); });
+		ASSERT_EQ(1u, loops.size());
+		auto linear = loops[0];
+
+		// the loop body neither divides nor takes the modulus, the indices are only recovered once per chunk
+		auto& basic = mgr.getLangBasic();
+		auto isDivOrMod = [&](const NodePtr& node) {
+			auto call = node.isa<CallExprPtr>();
+			if(!call) { return false; }
+			auto fun = call->getFunctionExpr();
+			return basic.isSignedIntDiv(fun) || basic.isSignedIntMod(fun) || basic.isUnsignedIntDiv(fun) || basic.isUnsignedIntMod(fun);
+		};
+		unsigned divMods = 0;
+		visitDepthFirst(linear->getBody(), [&](const NodePtr& node) {
+			if(isDivOrMod(node)) { divMods++; }
+		});
+		EXPECT_EQ(0u, divMods) << *linear->getBody();
+
+		// every iteration first advances the positions, then declares both indices ...
+		auto stmts = linear->getBody()->getStatements();
+		ASSERT_LE(4u, stmts.size());
+		EXPECT_FALSE(stmts[0].isa<DeclarationStmtPtr>()) << *stmts[0];
+		for(unsigned k = 1; k < 3; ++k) {
+			auto decl = stmts[k].isa<DeclarationStmtPtr>();
+			ASSERT_TRUE(decl) << *stmts[k];
+		}
+
+		// ... so all index updates precede the body, which the continue could otherwise skip
+		unsigned updates = 0;
+		visitDepthFirst(stmts[0], [&](const NodePtr& node) {
+			if(refExt.isCallOfRefAssign(node)) { updates++; }
+		});
+		EXPECT_LT(0u, updates);
+		unsigned continues = 0;
+		unsigned assignments = 0;
+		visitDepthFirst(linear->getBody(), [&](const NodePtr& node) {
+			if(node->getNodeType() == NT_ContinueStmt) { continues++; }
+			if(refExt.isCallOfRefAssign(node)) { assignments++; }
+		});
+		EXPECT_EQ(1u, continues);
+		EXPECT_EQ(updates, assignments);
+	}
+
+} // end namespace omp
+} // end namespace frontend
+} // end namespace insieme
@@ -49,6 +49,12 @@
 #include <sys/time.h>
 #endif
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 void irt_thread_create(irt_thread_func* fun, void* args, irt_thread* t) {
 	irt_thread thread;
 	if(t == NULL) {
@@ -83,6 +89,29 @@ void irt_thread_yield() {
 	pthread_yield();
 }
 
+void irt_thread_relax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_ia32_pause();
+	#else
+	__sync_synchronize();
+	#endif
+}
+
+void irt_thread_park(volatile uint32* addr, uint32 expected) {
+#if defined(__linux__) && !defined(_GEMS_SIM)
+	syscall(SYS_futex, (uint32*)addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+	#else
+	// no futex available, degrade to yielding
+	if(*addr == expected) { irt_thread_yield(); }
+	#endif
+}
+
+void irt_thread_unpark_one(volatile uint32* addr) {
+#if defined(__linux__) && !defined(_GEMS_SIM)
+	syscall(SYS_futex, (uint32*)addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+	#endif
+}
+
 bool irt_thread_check_equality(irt_thread* t1, irt_thread* t2) {
 #ifdef _WIN32
 	return t1->p == t2->p;
@@ -41,6 +41,11 @@
 #include "abstraction/threads.h"
 #include "error_handling.h"
 
+#if defined(_MSC_VER) && (_WIN32_WINNT >= 0x0602)
+// WaitOnAddress / WakeByAddressSingle used for parking idle workers
+#pragma comment(lib, "Synchronization.lib")
+#endif
+
 #define IRT_SPIN_LOCKED 1
 #define IRT_SPIN_UNLOCKED 0
 #define IRT_SPIN_DESTROYED -1 // makes lock variable unusable
@@ -113,6 +118,27 @@ void irt_thread_yield() {
 	IRT_WARN("irt_thread_yield empty implementation");
 }
 
+void irt_thread_relax() {
+	YieldProcessor();
+}
+
+void irt_thread_park(volatile uint32* addr, uint32 expected) {
+#if(_WIN32_WINNT >= 0x0602)
+	WaitOnAddress(addr, &expected, sizeof(uint32), INFINITE);
+#else
+	// WaitOnAddress is not available before Windows 8, degrade to yielding
+	if(*addr == expected) { SwitchToThread(); }
+#endif
+}
+
+void irt_thread_unpark_one(volatile uint32* addr) {
+#if(_WIN32_WINNT >= 0x0602)
+	WakeByAddressSingle((PVOID)addr);
+#else
+// nothing to wake: parked threads only yield and re-check their park word themselves
+#endif
+}
+
 bool irt_thread_check_equality(irt_thread* t1, irt_thread* t2) {
 	return t1->thread_id == t2->thread_id;
 }
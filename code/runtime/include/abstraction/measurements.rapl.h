@@ -159,7 +159,11 @@ void irt_rapl_finalize();
 
 
 // pointer to the function that is used to obtain energy readings
+#ifndef IRT_DECLARATIONS_ONLY
 void (*irt_get_energy_consumption)(rapl_energy_data* data);
+#else
+extern void (*irt_get_energy_consumption)(rapl_energy_data* data);
+#endif
 
 /*
  * a dummy method if no energy instrumentation is available
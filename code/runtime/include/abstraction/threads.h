@@ -80,84 +80,93 @@ typedef struct _irt_cond_bundle {
 typedef void* irt_thread_func(void*);
 
 /** create a new thread executing fun with parameter args, info about new thread will be saved in t if t is not NULL */
-inline void irt_thread_create(irt_thread_func* fun, void* args, irt_thread* t);
+void irt_thread_create(irt_thread_func* fun, void* args, irt_thread* t);
 
 /** saves thread information of current thread in t  */
-inline void irt_thread_get_current(irt_thread* t);
+void irt_thread_get_current(irt_thread* t);
 
 /** requests cancelation of the given thread */
-inline void irt_thread_cancel(irt_thread*);
+void irt_thread_cancel(irt_thread*);
 
 /** makes calling thread wait for cancellation of thread t, return value of terminated thread is returned */
-inline int irt_thread_join(irt_thread* t);
+int irt_thread_join(irt_thread* t);
 
 /** exit a thread with specified exit code */
-inline void irt_thread_exit(int exit_code);
+void irt_thread_exit(int exit_code);
 
 /** calling thread relinquishes the CPU */
-inline void irt_thread_yield();
+void irt_thread_yield();
 
 /** check if two thread objects are equal */
 bool irt_thread_check_equality(irt_thread* t1, irt_thread* t2);
 
+/** hint to the CPU that the calling thread is busy-waiting */
+void irt_thread_relax();
+
+/** blocks the calling thread while *addr == expected; may return spuriously, callers have to re-check */
+void irt_thread_park(volatile uint32* addr, uint32 expected);
+
+/** wakes at most one thread blocked in irt_thread_park on addr */
+void irt_thread_unpark_one(volatile uint32* addr);
+
 
 /* MUTEX FUNCTIONS ------------------------------------------------------------------- */
 
 /** initialize mutex object */
-inline void irt_mutex_init(irt_mutex_obj*);
+void irt_mutex_init(irt_mutex_obj*);
 
 /** acquire mutex object */
-inline void irt_mutex_lock(irt_mutex_obj*);
+void irt_mutex_lock(irt_mutex_obj*);
 
 /** try to acquire mutex object not waiting until mutex is acquired, returns 0 on success, nonzero otherwise */
 int irt_mutex_trylock(irt_mutex_obj*);
 
 /** release mutex object */
-inline void irt_mutex_unlock(irt_mutex_obj*);
+void irt_mutex_unlock(irt_mutex_obj*);
 
 /** destroy the mutex object */
-inline void irt_mutex_destroy(irt_mutex_obj*);
+void irt_mutex_destroy(irt_mutex_obj*);
 
 /** wake all threads which slept on the condition variable */
-inline void irt_cond_wake_all(irt_cond_var*);
+void irt_cond_wake_all(irt_cond_var*);
 
 /** initialize the condition variable */
-inline void irt_cond_var_init(irt_cond_var*);
+void irt_cond_var_init(irt_cond_var*);
 
 /** destroy the condition variable */
-inline void irt_cond_var_destroy(irt_cond_var*);
+void irt_cond_var_destroy(irt_cond_var*);
 
 /** releases the mutex and sleeps the thread on the condition variable */
-inline int irt_cond_wait(irt_cond_var*, irt_mutex_obj*);
+int irt_cond_wait(irt_cond_var*, irt_mutex_obj*);
 
 /** releases the mutex and sleeps the thread on the condition variable, for a maximum amount of time */
-inline int irt_cond_timedwait(irt_cond_var*, irt_mutex_obj*, uint64);
+int irt_cond_timedwait(irt_cond_var*, irt_mutex_obj*, uint64);
 
 /** singal and wake a thread which is blocked by the condition variable cv */
-inline void irt_cond_wake_one(irt_cond_var* cv);
+void irt_cond_wake_one(irt_cond_var* cv);
 
 /** initialize the condition variable and associated mutex */
-inline void irt_cond_bundle_init(irt_cond_bundle*);
+void irt_cond_bundle_init(irt_cond_bundle*);
 
 /** releases the mutex and sleeps the thread on the condition variable */
-inline int irt_cond_bundle_wait(irt_cond_bundle*);
+int irt_cond_bundle_wait(irt_cond_bundle*);
 
 /** destroys the condition variable and associated mutex */
-inline void irt_cond_bundle_destroy(irt_cond_bundle*);
+void irt_cond_bundle_destroy(irt_cond_bundle*);
 
 /* THREAD LOCAL STORAGE FUNCTIONS ------------------------------------------------------------------- */
 
 /** creates a new thread local storage key at location k */
-inline int irt_tls_key_create(irt_tls_key* k);
+int irt_tls_key_create(irt_tls_key* k);
 
 /** delete key k, if value is pointer to memory location, caller is responsible for freeing it */
-inline void irt_tls_key_delete(irt_tls_key k);
+void irt_tls_key_delete(irt_tls_key k);
 
 /** get the thread local value for key k */
-inline void* irt_tls_get(irt_tls_key k);
+void* irt_tls_get(irt_tls_key k);
 
 /** set the thread local value for key k */
-inline int irt_tls_set(irt_tls_key k, void* val);
+int irt_tls_set(irt_tls_key k, void* val);
 
 
 #endif // ifndef __GUARD_ABSTRACTION_THREADS_H
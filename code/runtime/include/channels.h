@@ -39,25 +39,84 @@
 #define __GUARD_CHANNELS_H
 
 #include "irt_inttypes.h"
+#include "declarations.h"
 
 #include "id_generation.h"
+#include "abstraction/spin_locks.h"
 
 /* ------------------------------ data structures ----- */
 
 IRT_MAKE_ID_TYPE(channel);
 
+// a work item suspended until the channel it is waiting for can make progress
+typedef struct _irt_channel_waiter {
+	irt_work_item* wi;
+	irt_worker* worker;
+	struct _irt_channel_waiter* next;
+} irt_channel_waiter;
+
+// A bounded ring buffer of fixed size elements. Every slot holds a sequence number followed by the element,
+// the sequence number tells senders and receivers at which position the slot can be written or read next.
+// Positions are claimed without locks, the spin lock only protects the lists of suspended work items.
 struct _irt_channel {
 	irt_channel_id id;
-	// TODO
+	uint32 elem_size;
+	uint32 slot_size;
+	uint64 mask; // capacity - 1, the capacity being a power of two
+	bool single_producer;
+	bool single_consumer;
+	unsigned char* slots;
+	// senders and receivers are kept on separate cache lines
+	char _pad0[64];
+	volatile uint64 send_pos;
+	char _pad1[64];
+	volatile uint64 recv_pos;
+	char _pad2[64];
+	irt_spinlock wait_lock;
+	volatile uint32 num_waiting_senders;
+	volatile uint32 num_waiting_receivers;
+	irt_channel_waiter* waiting_senders;
+	irt_channel_waiter* waiting_receivers;
 };
 
 
 /* ------------------------------ operations ----- */
 
-irt_channel* irt_channel_create();
-void irt_channel_destroy(irt_channel* wi);
+// creates a channel for elements of the given size shared by any number of senders and receivers,
+// the capacity is rounded up to the next power of two
+irt_channel* irt_channel_create(uint32 elem_size, uint32 capacity);
+// creates a channel used by a single sending and a single receiving work item
+irt_channel* irt_channel_create_spsc(uint32 elem_size, uint32 capacity);
+void irt_channel_destroy(irt_channel* channel);
+
+// non-blocking operations, the batch versions return the number of elements transferred
+bool irt_channel_try_send(irt_channel* channel, const void* elem);
+bool irt_channel_try_recv(irt_channel* channel, void* elem);
+uint32 irt_channel_try_send_batch(irt_channel* channel, const void* elems, uint32 num);
+uint32 irt_channel_try_recv_batch(irt_channel* channel, void* elems, uint32 num);
+
+// blocking operations, suspending the current work item while the buffer is full / empty
+void irt_channel_send(irt_channel* channel, const void* elem);
+void irt_channel_recv(irt_channel* channel, void* elem);
+void irt_channel_send_batch(irt_channel* channel, const void* elems, uint32 num);
+void irt_channel_recv_batch(irt_channel* channel, void* elems, uint32 num);
+
+// probes, the result may be outdated by the time it is returned
+bool irt_channel_empty(irt_channel* channel);
+bool irt_channel_full(irt_channel* channel);
 
-// TODO send recieve test probe try
+// value based variants of send and receive used by generated code
+#define IRT_CHANNEL_SEND(__channel, __type, __value)                                                                                                           \
+	({                                                                                                                                                         \
+		__type __irt_channel_value = (__value);                                                                                                                \
+		irt_channel_send(__channel, &__irt_channel_value);                                                                                                     \
+	})
+#define IRT_CHANNEL_RECV(__channel, __type)                                                                                                                    \
+	({                                                                                                                                                         \
+		__type __irt_channel_value;                                                                                                                            \
+		irt_channel_recv(__channel, &__irt_channel_value);                                                                                                     \
+		__irt_channel_value;                                                                                                                                   \
+	})
 
 
 #endif // ifndef __GUARD_CHANNELS_H
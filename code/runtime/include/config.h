@@ -44,6 +44,7 @@
 #define IRT_CONTEXT_LT_BUCKETS 7
 #define IRT_DATA_ITEM_LT_BUCKETS 97
 #define IRT_EVENT_LT_BUCKETS /*65536*/ /*64567*/ 97 /*7207301*/
+#define IRT_TASK_DEP_TABLE_BUCKETS 97
 
 // scheduling policy
 #ifndef IRT_SCHED_POLICY
@@ -58,10 +59,27 @@
 
 #define IRT_LOOP_SCHED_POLICY_ENV "IRT_LOOP_SCHED_POLICY"
 
-// determines if workers should ever go to sleep
-// - needs to be unset for the stealing policies!
+// adaptive loop scheduling: number of candidate policies (static, dynamic, guided) and
+// how often each of them is measured per implementation before the best one is locked in
+#define IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS 3
+#ifndef IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS
+#define IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS 3
+#endif
+
+// determines if idle workers should ever go to sleep (define IRT_WORKER_NO_SLEEPING to keep them spinning)
+// - the stealing and lazy binary splitting policies cannot wake up thieves, their workers only back off
 // workers must not sleep when compiling/running a program on windows xp because condition variables are not supported there
-//#define IRT_WORKER_SLEEPING
+#if !defined(IRT_WORKER_SLEEPING) && !defined(IRT_WORKER_NO_SLEEPING)
+#define IRT_WORKER_SLEEPING
+#endif
+
+// idling of sleeping workers: spin with exponential backoff, then yield, then park until signaled
+#ifndef IRT_WORKER_IDLE_SPIN_ROUNDS
+#define IRT_WORKER_IDLE_SPIN_ROUNDS 10
+#endif
+#ifndef IRT_WORKER_IDLE_YIELD_ROUNDS
+#define IRT_WORKER_IDLE_YIELD_ROUNDS 16
+#endif
 
 // ir interface
 #ifndef IRT_SANE_PARALLEL_MAX
@@ -87,6 +105,12 @@
 #define IRT_MQUEUE_MAXMSGS 4
 #define IRT_MQUEUE_MAXMSGSIZE 256
 
+// distributed runtime: time an idle node blocks waiting for messages of its peers, and
+// how often connecting to a peer which is not yet listening is attempted
+#define IRT_DIST_POLL_TIMEOUT 1 // in ms
+#define IRT_DIST_CONNECT_RETRIES 1000
+#define IRT_DIST_CONNECT_RETRY_INTERVAL 10 // in ms
+
 // instrumentation
 #define IRT_INST_OUTPUT_PATH_ENV "IRT_INST_OUTPUT_PATH"
 #define IRT_INST_OUTPUT_PATH_CHAR_SIZE 4096
@@ -94,15 +118,23 @@
 #define IRT_INST_WORKER_EVENT_LOGGING_ENV "IRT_INST_WORKER_EVENT_LOGGING"
 #define IRT_INST_WORKER_EVENT_TYPES_ENV "IRT_INST_WORKER_EVENT_TYPES"
 #define IRT_INST_WORKER_PD_BLOCKSIZE 512
+#define IRT_INST_EVENT_STREAMING_ENV "IRT_INST_EVENT_STREAMING"
+#define IRT_INST_EVENT_RING_BUFFER_SIZE 8192               // per worker, must be a power of two
+#define IRT_INST_EVENT_STREAM_FLUSH_INTERVAL 16            // in ms
+#define IRT_INST_EVENT_STREAM_CHUNK_SIZE (4 * 1024 * 1024) // bytes the stream files are grown by
 #define IRT_INST_REGION_INSTRUMENTATION_ENV "IRT_INST_REGION_INSTRUMENTATION"
 #define IRT_INST_REGION_INSTRUMENTATION_TYPES_ENV "IRT_INST_REGION_INSTRUMENTATION_TYPES"
 #define IRT_INST_REGION_INSTRUMENTATION_RING_BUFFER_SIZE 256
+#define IRT_INST_REGION_SAMPLING_INTERVAL_ENV "IRT_INST_REGION_SAMPLING_INTERVAL"
+#define IRT_INST_REGION_SAMPLING_DEFAULT_INTERVAL 1000 // in us
 
 // standalone
 #define IRT_NUM_WORKERS_ENV "IRT_NUM_WORKERS"
 #define IRT_CPU_FREQUENCIES "IRT_CPU_FREQUENCIES"
 #define IRT_REPORT_ENV "IRT_REPORT"
 #define IRT_REPORT_TO_FILE_ENV "IRT_REPORT_TO_FILE"
+// if set, only the first worker is started with the runtime, the others are brought up in the background once parallelism is requested
+#define IRT_LAZY_WORKER_STARTUP_ENV "IRT_LAZY_WORKER_STARTUP"
 
 // for using a minimal variant of the runtime without affinity and message queues => standalone mode only
 #define IRT_MIN_MODE
@@ -118,6 +150,21 @@
 
 // work group
 #define IRT_WG_RING_BUFFER_SIZE 1024
+// members waiting in an ordered region spin, then yield, then get suspended until their iteration is due
+#ifndef IRT_WG_ORDERED_SPIN_ROUNDS
+#define IRT_WG_ORDERED_SPIN_ROUNDS 256
+#endif
+#ifndef IRT_WG_ORDERED_YIELD_ROUNDS
+#define IRT_WG_ORDERED_YIELD_ROUNDS 4
+#endif
+
+// channel operations on a full / empty buffer spin, then yield, then get suspended until a peer makes progress
+#ifndef IRT_CHANNEL_SPIN_ROUNDS
+#define IRT_CHANNEL_SPIN_ROUNDS 256
+#endif
+#ifndef IRT_CHANNEL_YIELD_ROUNDS
+#define IRT_CHANNEL_YIELD_ROUNDS 4
+#endif
 
 // worker
 #define IRT_DEFAULT_VARIANT_ENV "IRT_DEFAULT_VARIANT"
@@ -128,6 +175,32 @@
 #ifndef IRT_WI_STACK_SIZE
 #define IRT_WI_STACK_SIZE 8 * 1024 * 1024
 #endif
+// number of stacks each worker allocates when starting up, and how much of each of them is pre-faulted (from the top)
+#ifndef IRT_LWT_STACK_POOL_SIZE
+#define IRT_LWT_STACK_POOL_SIZE 2
+#endif
+#ifndef IRT_LWT_STACK_PREFAULT_SIZE
+#define IRT_LWT_STACK_PREFAULT_SIZE 64 * 1024
+#endif
+// number of stacks a worker keeps in its own pool; surplus stacks are handed to a pool shared by all workers,
+// which keeps at most IRT_LWT_STACK_SHARED_POOL_MAX stacks and releases any further ones
+#ifndef IRT_LWT_STACK_POOL_MAX
+#define IRT_LWT_STACK_POOL_MAX 16
+#endif
+#ifndef IRT_LWT_STACK_SHARED_POOL_MAX
+#define IRT_LWT_STACK_SHARED_POOL_MAX 64
+#endif
+// allocate lwt stacks with mmap (POSIX only): memory is only committed when touched, an inaccessible guard region
+// below each stack catches overflows, and stacks moving to the shared pool return their cold pages to the OS
+//#define IRT_LWT_STACK_MMAP
+#ifndef IRT_LWT_STACK_GUARD_SIZE
+#define IRT_LWT_STACK_GUARD_SIZE 4 * 1024
+#endif
+// additionally align mmap'ed stacks to huge pages and advise the kernel to back them with transparent huge pages
+//#define IRT_LWT_STACK_HUGEPAGES
+#ifndef IRT_LWT_STACK_HUGEPAGE_SIZE
+#define IRT_LWT_STACK_HUGEPAGE_SIZE 2 * 1024 * 1024
+#endif
 
 #ifndef IRT_DEF_WORKERS
 #define IRT_DEF_WORKERS 1
@@ -159,6 +232,8 @@
 //#define IRT_ENABLE_OMPP_OPTIMIZER
 // enables DCT optimizations based on openmp+
 //#define IRT_ENABLE_OMPP_OPTIMIZER_DCT
+// replaces the hill climbing step of the openmp+ optimizer by a selection from the pareto front of all explored settings
+//#define IRT_ENABLE_OMPP_OPTIMIZER_PARETO
 // enables measurments of resource compsumption with different frequencies
 //#defines IRT_ENABLE_OMPP_OPTIMIZER_DVFS_EVAL
 // defines how many times a new frequency will be picked
@@ -178,5 +253,9 @@
 #define IRT_OPTIMIZER_LT_BUCKETS 97
 // the index of the frequency (among the vector of available ones) used by the rt
 #define IRT_OPTIMIZER_RT_FREQ 1
+// maximum number of non-dominated settings kept per region by the pareto search
+#define IRT_OPTIMIZER_PARETO_MAX_POINTS 64
+// selects the frequency / energy provider of the optimizer: "hardware" (default) or "simulated"
+#define IRT_OPTIMIZER_PROVIDER_ENV "IRT_OPTIMIZER_PROVIDER"
 
 #endif // ifndef __GUARD_CONFIG_H
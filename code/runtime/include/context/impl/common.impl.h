@@ -57,4 +57,213 @@ typedef struct {
 } irt_cap_pointer_substitute;
 
 
+// -- the profile file format --
+
+/**
+ * Profiles are organized in chunks, one per region, such that the data of a
+ * single region can be restored without touching the rest of the file:
+ *
+ *   uint32 magic number, uint32 format version, uint32 number of regions
+ *   for each region: uint32 id, uint32 number of blocks, uint32 total size of blocks,
+ *                    uint64 offset of the region chunk, uint64 size of the region chunk
+ *   for each region chunk, for each block:
+ *       uint32 id, int32 tag, uint32 address, uint32 size,
+ *       uint32 size + run-length encoded mask of life-in bytes,
+ *       uint32 encoding, uint32 number of life-in bytes, uint32 size + encoded life-in bytes,
+ *       uint32 size + run-length encoded mask of pointers
+ *
+ * Life-in bytes are stored densely (only bytes marked within the mask), either
+ * plain or compressed using the LZ-style encoding below.
+ */
+#define IRT_CAP_PROFILE_FORMAT_VERSION 2
+
+#define IRT_CAP_ENCODING_PLAIN 0
+#define IRT_CAP_ENCODING_LZ 1
+
+
+// -- compression utilities shared by writing and reading profiles --
+
+static inline char* irt_cap_put_varint(char* out, uint64 value) {
+	while(value >= 0x80) {
+		*out++ = (char)((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	*out++ = (char)value;
+	return out;
+}
+
+// returns NULL if the encoded value exceeds the given end
+static inline const char* irt_cap_get_varint(const char* in, const char* end, uint64* value) {
+	uint64 res = 0;
+	for(uint32 shift = 0; in < end && shift < 64; shift += 7) {
+		uint8 byte = (uint8)*in++;
+		res |= (uint64)(byte & 0x7F) << shift;
+		if(!(byte & 0x80)) {
+			*value = res;
+			return in;
+		}
+	}
+	return NULL;
+}
+
+// the maximum size of a run-length encoded mask covering the given number of flags
+static inline size_t irt_cap_rle_bound(size_t size) {
+	return 5 * (size + 2);
+}
+
+/**
+ * Encodes the given mask as a sequence of alternating run lengths of cleared and
+ * set flags, starting with a (potentially empty) run of cleared flags.
+ *
+ * @return the number of bytes written to out
+ */
+size_t irt_cap_rle_encode(const bool* mask, uint32 size, char* out) {
+	char* cur = out;
+	bool state = false;
+	uint32 run = 0;
+	for(uint32 i = 0; i < size; i++) {
+		if(mask[i] != state) {
+			cur = irt_cap_put_varint(cur, run);
+			state = mask[i];
+			run = 0;
+		}
+		run++;
+	}
+	if(run > 0) { cur = irt_cap_put_varint(cur, run); }
+	return cur - out;
+}
+
+/**
+ * An iterator over the runs of set flags within a run-length encoded mask.
+ */
+typedef struct {
+	const char* cur;
+	const char* end;
+	uint32 pos;
+} irt_cap_rle_iterator;
+
+static inline void irt_cap_rle_iterator_init(irt_cap_rle_iterator* it, const char* data, size_t size) {
+	it->cur = data;
+	it->end = data + size;
+	it->pos = 0;
+}
+
+// moves to the next run of set flags, returns false if there is none
+bool irt_cap_rle_next(irt_cap_rle_iterator* it, uint32* start, uint32* length) {
+	uint64 cleared, set;
+	while(it->cur < it->end) {
+		if(!(it->cur = irt_cap_get_varint(it->cur, it->end, &cleared))) { return false; }
+		it->pos += cleared;
+		if(it->cur == it->end) { return false; }
+		if(!(it->cur = irt_cap_get_varint(it->cur, it->end, &set))) { return false; }
+		*start = it->pos;
+		*length = set;
+		it->pos += set;
+		if(set > 0) { return true; }
+	}
+	return false;
+}
+
+// the maximum size of LZ-compressed data of the given size
+static inline size_t irt_cap_lz_bound(size_t size) {
+	return size + size / 2 + 16;
+}
+
+#define IRT_CAP_LZ_HASH_BITS 14
+#define IRT_CAP_LZ_MIN_MATCH 4
+
+// the hash table of the LZ compressor, shared among subsequent inputs to avoid clearing it for every one of them
+typedef struct {
+	uint32 table[1 << IRT_CAP_LZ_HASH_BITS]; // last position of each hashed word, offset by the base of its input
+	uint32 base;                             // the offset of the current input, entries below refer to earlier inputs
+} irt_cap_lz_state;
+
+static inline void irt_cap_lz_state_init(irt_cap_lz_state* state) {
+	memset(state->table, 0, sizeof(state->table));
+	state->base = 1;
+}
+
+static inline char* _irt_cap_lz_literals(char* out, const char* begin, const char* end) {
+	if(begin == end) { return out; }
+	out = irt_cap_put_varint(out, (uint64)(end - begin) << 1);
+	memcpy(out, begin, end - begin);
+	return out + (end - begin);
+}
+
+/**
+ * Compresses the given data using a greedy LZ77 scheme. The result is a sequence of
+ * tokens, each either a run of literal bytes (varint length*2 followed by the bytes)
+ * or a back reference (varint (length-4)*2+1 followed by the varint distance).
+ * The given state has to be initialized by irt_cap_lz_state_init once.
+ *
+ * @return the number of bytes written to out, at most irt_cap_lz_bound(size)
+ */
+size_t irt_cap_lz_compress(irt_cap_lz_state* state, const char* in, uint32 size, char* out) {
+	// only start over once the positions of this input would exceed the range of the table entries
+	if(size > (uint32)-1 - state->base) { irt_cap_lz_state_init(state); }
+	uint32* table = state->table;
+	const uint32 base = state->base;
+
+	char* cur = out;
+	size_t literals = 0;
+	size_t i = 0;
+	while(i + IRT_CAP_LZ_MIN_MATCH <= size) {
+		uint32 word;
+		memcpy(&word, in + i, sizeof(word));
+		uint32 hash = (word * 2654435761u) >> (32 - IRT_CAP_LZ_HASH_BITS);
+		uint32 entry = table[hash];
+		table[hash] = base + (uint32)i;
+
+		size_t candidate = entry - base;
+		if(entry < base || memcmp(in + candidate, in + i, IRT_CAP_LZ_MIN_MATCH) != 0) {
+			i++;
+			continue;
+		}
+
+		// extend match as far as possible
+		size_t length = IRT_CAP_LZ_MIN_MATCH;
+		while(i + length < size && in[candidate + length] == in[i + length]) {
+			length++;
+		}
+
+		cur = _irt_cap_lz_literals(cur, in + literals, in + i);
+		cur = irt_cap_put_varint(cur, ((uint64)(length - IRT_CAP_LZ_MIN_MATCH) << 1) | 1);
+		cur = irt_cap_put_varint(cur, i - candidate);
+		i += length;
+		literals = i;
+	}
+	cur = _irt_cap_lz_literals(cur, in + literals, in + size);
+
+	state->base = base + size;
+	return cur - out;
+}
+
+// decompresses exactly size bytes into out, returns false if the input is corrupted
+bool irt_cap_lz_decompress(const char* in, size_t in_size, char* out, size_t size) {
+	const char* end = in + in_size;
+	size_t pos = 0;
+	while(in < end) {
+		uint64 token;
+		if(!(in = irt_cap_get_varint(in, end, &token))) { return false; }
+		uint64 length = token >> 1;
+		if(!(token & 1)) {
+			if(length > (uint64)(end - in) || length > size - pos) { return false; }
+			memcpy(out + pos, in, length);
+			in += length;
+			pos += length;
+			continue;
+		}
+		uint64 distance;
+		if(!(in = irt_cap_get_varint(in, end, &distance))) { return false; }
+		length += IRT_CAP_LZ_MIN_MATCH;
+		if(distance == 0 || distance > pos || length > size - pos) { return false; }
+		// byte-wise, since source and target may overlap
+		for(uint64 k = 0; k < length; k++, pos++) {
+			out[pos] = out[pos - distance];
+		}
+	}
+	return pos == size;
+}
+
+
 #endif // ifndef __GUARD_CONTEXT_IMPL_COMMON_IMPL_H
@@ -60,6 +60,13 @@
  * Internally, the list of blocks is handled within a linked list. Blocks
  * are added at the front, increasing indices incrementally. Further, more
  * recent region definitions are covering older definitions automatically.
+ *
+ * Since lookups are performed on every recorded read and write, the list
+ * is complemented by an index of disjoint address intervals, each mapped to
+ * the most recent block covering it, which is searched using binary search.
+ * Blocks registered after the last rebuild of the index are still searched
+ * linearly, the index is rebuilt once there are too many of those. Finally,
+ * every thread remembers the index segment found by its last lookup.
  */
 
 typedef struct _irt_cap_data_block_info_list_node {
@@ -73,6 +80,47 @@ typedef struct _irt_cap_data_block_info_list_node {
  */
 irt_cap_data_block_info_list_node* volatile irt_g_cap_data_block_list = NULL;
 
+
+/**
+ * The number of blocks which may be registered since the last index rebuild
+ * before a lookup is triggering a rebuild of the index.
+ */
+#define IRT_CAP_DBI_MAX_PENDING 32
+
+typedef struct _irt_cap_dbi_segment {
+	uint64 begin;                        // the first address covered by this segment
+	uint64 end;                          // the first address after this segment
+	const irt_cap_data_block_info* info; // the most recent block covering this segment
+} irt_cap_dbi_segment;
+
+typedef struct _irt_cap_dbi_index {
+	uint32 max_id;                   // the index is covering all blocks up to this ID
+	uint32 num_segments;             // the number of segments within the index
+	irt_cap_dbi_segment* segments;   // the segments, sorted by address
+	struct _irt_cap_dbi_index* next; // enables retired indices to be kept within a list
+} irt_cap_dbi_index;
+
+typedef struct _irt_cap_dbi_cache {
+	irt_cap_dbi_segment segment;     // the index segment found by the last lookup of the owning thread
+	uint32 generation;               // the ID of the most recent block at the time of this lookup
+	struct _irt_cap_dbi_cache* next; // enables caches to be kept within a list
+} irt_cap_dbi_cache;
+
+/**
+ * The current index, indices replaced by a rebuild which might still be in use and
+ * the number of threads currently searching an index.
+ */
+irt_cap_dbi_index* volatile irt_g_cap_dbi_index = NULL;
+irt_cap_dbi_index* irt_g_cap_dbi_retired_indices = NULL;
+volatile uint32 irt_g_cap_dbi_readers = 0;
+irt_mutex_obj irt_g_cap_dbi_index_mutex;
+
+/**
+ * The per-thread lookup caches and the list of all of them.
+ */
+irt_tls_key irt_g_cap_dbi_cache_key;
+irt_cap_dbi_cache* volatile irt_g_cap_dbi_caches = NULL;
+
 const irt_cap_data_block_info* irt_cap_dbi_register_block(void* base, uint32 size) {
 	// create new block
 	irt_cap_data_block_info_list_node* node = (irt_cap_data_block_info_list_node*)malloc(sizeof(irt_cap_data_block_info_list_node));
@@ -94,23 +142,222 @@ const irt_cap_data_block_info* irt_cap_dbi_register_block(void* base, uint32 siz
 	return &(node->info);
 }
 
+static inline bool _irt_cap_dbi_covers(const irt_cap_data_block_info* info, uint64 pos) {
+	uint64 base = (uint64)info->base;
+	return base <= pos && pos < base + info->size;
+}
+
+typedef struct _irt_cap_dbi_event {
+	uint64 pos;   // the address of this event
+	uint32 id;    // the ID of the block starting or ending here
+	bool starts;  // whether the block is starting or ending at this address
+} irt_cap_dbi_event;
+
+int _irt_cap_dbi_event_compare(const void* a, const void* b) {
+	uint64 x = ((const irt_cap_dbi_event*)a)->pos;
+	uint64 y = ((const irt_cap_dbi_event*)b)->pos;
+	return (x < y) ? -1 : (x > y);
+}
+
+/**
+ * Builds an index covering all blocks in the given list by sweeping over the sorted
+ * block boundaries while maintaining a max-heap of the IDs of the covering blocks.
+ */
+irt_cap_dbi_index* _irt_cap_dbi_build_index(irt_cap_data_block_info_list_node* head) {
+	uint32 n = head->info.id;
+
+	// collect blocks and their boundaries
+	const irt_cap_data_block_info** blocks = (const irt_cap_data_block_info**)malloc((n + 1) * sizeof(irt_cap_data_block_info*));
+	irt_cap_dbi_event* events = (irt_cap_dbi_event*)malloc(2 * n * sizeof(irt_cap_dbi_event));
+	uint32 num_events = 0;
+	for(irt_cap_data_block_info_list_node* cur = head; cur != NULL; cur = cur->next) {
+		blocks[cur->info.id] = &(cur->info);
+		if(cur->info.size == 0) { continue; }
+		irt_cap_dbi_event start = {(uint64)cur->info.base, cur->info.id, true};
+		irt_cap_dbi_event end = {(uint64)cur->info.base + cur->info.size, cur->info.id, false};
+		events[num_events++] = start;
+		events[num_events++] = end;
+	}
+	qsort(events, num_events, sizeof(irt_cap_dbi_event), &_irt_cap_dbi_event_compare);
+
+	uint32* heap = (uint32*)malloc((n + 1) * sizeof(uint32));
+	bool* ended = (bool*)calloc(n + 1, sizeof(bool));
+	uint32 heap_size = 0;
+
+	irt_cap_dbi_index* index = (irt_cap_dbi_index*)malloc(sizeof(irt_cap_dbi_index));
+	index->max_id = n;
+	index->num_segments = 0;
+	index->segments = (irt_cap_dbi_segment*)malloc((num_events + 1) * sizeof(irt_cap_dbi_segment));
+	index->next = NULL;
+
+	uint32 i = 0;
+	while(i < num_events) {
+		uint64 pos = events[i].pos;
+
+		// process all boundaries at the current address
+		for(; i < num_events && events[i].pos == pos; i++) {
+			if(!events[i].starts) {
+				ended[events[i].id] = true;
+				continue;
+			}
+			// push and sift up
+			uint32 j = heap_size++;
+			while(j > 0 && heap[(j - 1) / 2] < events[i].id) {
+				heap[j] = heap[(j - 1) / 2];
+				j = (j - 1) / 2;
+			}
+			heap[j] = events[i].id;
+		}
+
+		// drop blocks which have ended from the top of the heap
+		while(heap_size > 0 && ended[heap[0]]) {
+			uint32 last = heap[--heap_size];
+			uint32 j = 0;
+			for(;;) {
+				uint32 c = 2 * j + 1;
+				if(c >= heap_size) { break; }
+				if(c + 1 < heap_size && heap[c + 1] > heap[c]) { c++; }
+				if(heap[c] <= last) { break; }
+				heap[j] = heap[c];
+				j = c;
+			}
+			heap[j] = last;
+		}
+
+		// the most recent block still open is covering the interval up to the next boundary
+		if(heap_size == 0 || i == num_events) { continue; }
+		const irt_cap_data_block_info* info = blocks[heap[0]];
+		irt_cap_dbi_segment* last = (index->num_segments > 0) ? &index->segments[index->num_segments - 1] : NULL;
+		if(last && last->info == info && last->end == pos) {
+			last->end = events[i].pos;
+		} else {
+			irt_cap_dbi_segment* segment = &index->segments[index->num_segments++];
+			segment->begin = pos;
+			segment->end = events[i].pos;
+			segment->info = info;
+		}
+	}
+
+	free(ended);
+	free(heap);
+	free(events);
+	free(blocks);
+	return index;
+}
+
+/**
+ * Replaces the current index by one covering all registered blocks. If some other
+ * thread is already rebuilding the index, this call returns immediately.
+ */
+void _irt_cap_dbi_rebuild_index() {
+	if(irt_mutex_trylock(&irt_g_cap_dbi_index_mutex) != 0) { return; }
+
+	irt_cap_data_block_info_list_node* head = irt_g_cap_data_block_list;
+	irt_cap_dbi_index* old = irt_g_cap_dbi_index;
+	if(head != NULL && (old == NULL || old->max_id < head->info.id)) {
+		irt_cap_dbi_index* index = _irt_cap_dbi_build_index(head);
+		irt_atomic_store(&irt_g_cap_dbi_index, index);
+
+		// retire the old index, free retired indices once no thread is searching any of them
+		if(old) {
+			old->next = irt_g_cap_dbi_retired_indices;
+			irt_g_cap_dbi_retired_indices = old;
+		}
+		if(irt_atomic_load(&irt_g_cap_dbi_readers) == 0) {
+			while(irt_g_cap_dbi_retired_indices != NULL) {
+				irt_cap_dbi_index* next = irt_g_cap_dbi_retired_indices->next;
+				free(irt_g_cap_dbi_retired_indices->segments);
+				free(irt_g_cap_dbi_retired_indices);
+				irt_g_cap_dbi_retired_indices = next;
+			}
+		}
+	}
+
+	irt_mutex_unlock(&irt_g_cap_dbi_index_mutex);
+}
+
+const irt_cap_dbi_segment* _irt_cap_dbi_index_lookup(const irt_cap_dbi_index* index, uint64 pos) {
+	// find the last segment starting at or before the given position
+	uint32 lo = 0, hi = index->num_segments;
+	while(lo < hi) {
+		uint32 mid = lo + (hi - lo) / 2;
+		if(index->segments[mid].begin <= pos) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if(lo == 0 || pos >= index->segments[lo - 1].end) { return NULL; }
+	return &index->segments[lo - 1];
+}
+
+irt_cap_dbi_cache* _irt_cap_dbi_get_cache() {
+	irt_cap_dbi_cache* cache = (irt_cap_dbi_cache*)irt_tls_get(irt_g_cap_dbi_cache_key);
+	if(cache) { return cache; }
+
+	// first lookup of this thread => create cache
+	cache = (irt_cap_dbi_cache*)malloc(sizeof(irt_cap_dbi_cache));
+	cache->segment.info = NULL;
+	cache->generation = 0;
+	do {
+		cache->next = irt_g_cap_dbi_caches;
+	} while(!irt_atomic_bool_compare_and_swap((intptr_t*)&irt_g_cap_dbi_caches, (intptr_t)(cache->next), (intptr_t)cache, intptr_t));
+	irt_tls_set(irt_g_cap_dbi_cache_key, cache);
+	return cache;
+}
+
 const irt_cap_data_block_info* irt_cap_dbi_lookup(void* ptr) {
-	// search for the corresponding block
-	irt_cap_data_block_info_list_node* cur = irt_g_cap_data_block_list;
+	irt_cap_data_block_info_list_node* head = irt_g_cap_data_block_list;
+	if(head == NULL) { return NULL; }
 	uint64 pos = (uint64)ptr;
-	while(cur != NULL) {
-		// check whether block is covering the location pointed to
-		uint64 base = (uint64)cur->info.base;
-		if(base <= pos && pos < base + cur->info.size) { return &(cur->info); }
-		cur = cur->next;
+
+	// the segment of the last lookup is still valid if no block has been registered since
+	irt_cap_dbi_cache* cache = _irt_cap_dbi_get_cache();
+	if(cache->segment.info && cache->generation == head->info.id && cache->segment.begin <= pos && pos < cache->segment.end) {
+		return cache->segment.info;
 	}
 
-	// unknown block!
-	return NULL;
+	const irt_cap_data_block_info* res = NULL;
+	irt_atomic_inc(&irt_g_cap_dbi_readers, uint32);
+	irt_cap_dbi_index* index = irt_g_cap_dbi_index;
+	uint32 indexed = (index) ? index->max_id : 0;
+
+	// search blocks not covered by the index yet, most recent first
+	uint32 pending = 0;
+	for(irt_cap_data_block_info_list_node* cur = head; cur != NULL && cur->info.id > indexed; cur = cur->next, pending++) {
+		if(_irt_cap_dbi_covers(&(cur->info), pos)) {
+			res = &(cur->info);
+			break;
+		}
+	}
+
+	// search the index, remember the segment unless it might be covered by pending blocks
+	if(!res && index) {
+		const irt_cap_dbi_segment* segment = _irt_cap_dbi_index_lookup(index, pos);
+		if(segment) {
+			res = segment->info;
+			if(pending == 0) {
+				cache->segment = *segment;
+				cache->generation = head->info.id;
+			}
+		}
+	}
+	irt_atomic_dec(&irt_g_cap_dbi_readers, uint32);
+
+	// fold pending blocks into the index if there are too many of them
+	if(pending > IRT_CAP_DBI_MAX_PENDING) { _irt_cap_dbi_rebuild_index(); }
+
+	return res;
 }
 
 void irt_cap_dbi_init() {
 	irt_g_cap_data_block_list = NULL;
+	irt_g_cap_dbi_index = NULL;
+	irt_g_cap_dbi_retired_indices = NULL;
+	irt_g_cap_dbi_readers = 0;
+	irt_g_cap_dbi_caches = NULL;
+	irt_mutex_init(&irt_g_cap_dbi_index_mutex);
+	irt_tls_key_create(&irt_g_cap_dbi_cache_key);
 }
 
 void irt_cap_dbi_finalize() {
@@ -122,6 +369,30 @@ void irt_cap_dbi_finalize() {
 		cur = next;
 	}
 	irt_g_cap_data_block_list = NULL;
+
+	// delete current and retired indices
+	if(irt_g_cap_dbi_index) {
+		irt_g_cap_dbi_index->next = irt_g_cap_dbi_retired_indices;
+		irt_g_cap_dbi_retired_indices = irt_g_cap_dbi_index;
+		irt_g_cap_dbi_index = NULL;
+	}
+	while(irt_g_cap_dbi_retired_indices != NULL) {
+		irt_cap_dbi_index* next = irt_g_cap_dbi_retired_indices->next;
+		free(irt_g_cap_dbi_retired_indices->segments);
+		free(irt_g_cap_dbi_retired_indices);
+		irt_g_cap_dbi_retired_indices = next;
+	}
+
+	// delete per-thread caches
+	irt_cap_dbi_cache* cache = irt_g_cap_dbi_caches;
+	while(cache != NULL) {
+		irt_cap_dbi_cache* next = cache->next;
+		free(cache);
+		cache = next;
+	}
+	irt_g_cap_dbi_caches = NULL;
+	irt_tls_key_delete(irt_g_cap_dbi_cache_key);
+	irt_mutex_destroy(&irt_g_cap_dbi_index_mutex);
 }
 
 
@@ -611,60 +882,13 @@ void irt_cap_written_pointer(void** pos) {
 
 
 #define OUT(X) (tmp = X, fwrite((&tmp), sizeof(tmp), 1, f))
-
-uint32 irt_cap_count_mask_fragments(bool* marks, size_t size) {
-	uint32 counter = 0;
-	for(uint32 i = 1; i < size - 1; i++) {
-		if(marks[i - 1] && !marks[i]) { // increment whenever a fragment is done
-			counter++;
-		}
-	}
-	if(marks[size - 1]) { counter++; }
-	return counter;
-}
+#define OUT64(X) (tmp64 = X, fwrite((&tmp64), sizeof(tmp64), 1, f))
 
 uint32 irt_cap_sum_of_block_sizes(irt_cap_block_usage_info* list) {
 	if(list == NULL) { return 0; }
 	return list->block->size + irt_cap_sum_of_block_sizes(list->next);
 }
 
-void irt_cap_output_append_data_fragments(char* data, bool* flags, size_t size, FILE* f) {
-	uint32 tmp; // used by write macro
-
-	int start = -1;
-	for(uint32 i = 0; i < size; i++) {
-		if(flags[i] && start == -1) {
-			// start new fragment
-			start = i;
-		} else if(!flags[i] && start != -1) {
-			// write fragment data
-			uint32 length = (size_t)(i - start);
-			OUT(start);
-			OUT(length);
-
-			if(data) { fwrite(&(data[start]), sizeof(char), length, f); }
-
-			DEBUG(printf("Safed Fragment from %d - size %d.\n", start, (int)length));
-
-			start = -1;
-		}
-	}
-	if(flags[size - 1]) {
-		// write fragment data
-		uint32 length = (size_t)(size - start);
-		OUT(start);
-		OUT(length);
-
-		if(data) { fwrite(&(data[start]), sizeof(char), length, f); }
-
-		DEBUG(printf("Safed Fragment from %d - size %d.\n", start, (int)length));
-	}
-}
-
-void irt_cap_output_append_mask_fragments(bool* flags, size_t size, FILE* f) {
-	irt_cap_output_append_data_fragments(NULL, flags, size, f);
-}
-
 uint32 irt_cap_get_num_regions() {
 	uint32 res = 0;
 	irt_cap_region_list* cur = irt_g_cap_region_list;
@@ -680,35 +904,91 @@ uint32 irt_cap_count_block_infos(irt_cap_block_usage_info* list) {
 	return irt_cap_count_block_infos(list->next) + 1;
 }
 
-void irt_cap_profile_save() {
+// writes the given mask run-length encoded, preceded by its encoded size
+void irt_cap_output_append_mask(bool* flags, uint32 size, char* buffer, FILE* f) {
+	uint32 tmp; // used by write macro
+	uint32 length = irt_cap_rle_encode(flags, size, buffer);
+	OUT(length);
+	fwrite(buffer, sizeof(char), length, f);
+}
+
+// writes the bytes marked by the given flags densely, compressed if this is saving space
+void irt_cap_output_append_data(char* data, bool* flags, uint32 size, char* buffer, irt_cap_lz_state* lz, FILE* f) {
 	uint32 tmp; // used by write macro
 
+	// collect marked bytes
+	char* dense = (char*)malloc(size + 1);
+	uint32 num = 0;
+	for(uint32 i = 0; i < size; i++) {
+		if(flags[i]) { dense[num++] = data[i]; }
+	}
+
+	uint32 length = irt_cap_lz_compress(lz, dense, num, buffer);
+	if(length < num) {
+		OUT(IRT_CAP_ENCODING_LZ);
+		OUT(num);
+		OUT(length);
+		fwrite(buffer, sizeof(char), length, f);
+	} else {
+		OUT(IRT_CAP_ENCODING_PLAIN);
+		OUT(num);
+		OUT(num);
+		fwrite(dense, sizeof(char), num, f);
+	}
+	DEBUG(printf("Saved %u life-in bytes using %u bytes.\n", num, (length < num) ? length : num));
+
+	free(dense);
+}
+
+void irt_cap_profile_save() {
+	uint32 tmp;   // used by write macro
+	uint64 tmp64; // used by write macro
+
 	// determine profile name
 	const char* file_name = irt_cap_profile_get_filename();
 
 	// safe data to file
-	FILE* f = fopen(file_name, "w");
+	FILE* f = fopen(file_name, "wb");
 
-	// start with magic number
+	// start with magic number and version
 	OUT(MAGIC_NUMBER);
+	OUT(IRT_CAP_PROFILE_FORMAT_VERSION);
 
 	// write number of stored regions
-	OUT(irt_cap_get_num_regions());
-	for(irt_cap_region_list* it = irt_g_cap_region_list; it != NULL; it = it->next) {
-		irt_cap_region* region = &(it->region);
-
-		// write current region ID
-		OUT(region->id);
+	uint32 num_regions = irt_cap_get_num_regions();
+	OUT(num_regions);
 
-		// write number of blocks
-		OUT(irt_cap_count_block_infos(region->usage));
+	// write region directory, chunk positions are filled in once known
+	long directory = ftell(f);
+	for(irt_cap_region_list* it = irt_g_cap_region_list; it != NULL; it = it->next) {
+		OUT(it->region.id);
+		OUT(irt_cap_count_block_infos(it->region.usage));
+		OUT(irt_cap_sum_of_block_sizes(it->region.usage));
+		OUT64(0);
+		OUT64(0);
+	}
 
-		// write total size of blocks
-		OUT(irt_cap_sum_of_block_sizes(region->usage));
+	// a buffer large enough for encoding any of the blocks
+	uint32 max_size = 0;
+	for(irt_cap_region_list* it = irt_g_cap_region_list; it != NULL; it = it->next) {
+		for(irt_cap_block_usage_info* info = it->region.usage; info != NULL; info = info->next) {
+			if(info->block->size > max_size) { max_size = info->block->size; }
+		}
+	}
+	size_t buffer_size = irt_cap_rle_bound(max_size);
+	if(irt_cap_lz_bound(max_size) > buffer_size) { buffer_size = irt_cap_lz_bound(max_size); }
+	char* buffer = (char*)malloc(buffer_size);
+	irt_cap_lz_state* lz = (irt_cap_lz_state*)malloc(sizeof(irt_cap_lz_state));
+	irt_cap_lz_state_init(lz);
+
+	uint64* chunk_offsets = (uint64*)malloc(sizeof(uint64) * (num_regions + 1));
+	uint32 r = 0;
+	for(irt_cap_region_list* it = irt_g_cap_region_list; it != NULL; it = it->next, r++) {
+		irt_cap_region* region = &(it->region);
+		chunk_offsets[r] = ftell(f);
 
-		// write life_in blocks
-		for(irt_cap_block_usage_info* it2 = region->usage; it2 != NULL; it2 = it2->next) {
-			irt_cap_block_usage_info* info = it2;
+		// write blocks
+		for(irt_cap_block_usage_info* info = region->usage; info != NULL; info = info->next) {
 			uint32 size = info->block->size;
 
 			// add block id
@@ -723,45 +1003,32 @@ void irt_cap_profile_save() {
 			// add block size
 			OUT(size);
 
-			// add number of life-in fragments
-			OUT(irt_cap_count_mask_fragments(info->read, size));
+			// add life-in mask and values
+			irt_cap_output_append_mask(info->read, size, buffer, f);
+			irt_cap_output_append_data(info->life_in_values, info->read, size, buffer, lz, f);
 
-			// add life-in fragments
-			irt_cap_output_append_data_fragments(info->life_in_values, info->read, size, f);
+			// add pointer mask
+			irt_cap_output_append_mask(info->is_pointer, size, buffer, f);
 		}
-
-		// write pointer information
-		for(irt_cap_block_usage_info* it2 = region->usage; it2 != NULL; it2 = it2->next) {
-			irt_cap_block_usage_info* info = it2;
-			uint32 size = info->block->size;
-
-			// add number of pointer fragments
-			OUT(irt_cap_count_mask_fragments(info->is_pointer, size));
-
-			// add is_pointer fragments
-			irt_cap_output_append_mask_fragments(info->is_pointer, size, f);
-		}
-
-		//		// write life_out information
-		//		for(irt_cap_block_usage_info* it2 = region->usage; it2 !=NULL; it2 = it2->next) {
-		//			irt_cap_block_usage_info* info = it2;
-		//			uint32 size = info->block->size;
-		//
-		//			// add block id
-		//			OUT(info->block->id);
-		//
-		//			// add number of life-out fragments
-		//			OUT(irt_cap_count_mask_fragments(info->is_life_out, size));
-		//
-		//			// add life-out fragments
-		//			irt_cap_output_append_data_fragments(info->life_out_values, info->is_life_out, size, f);
-		//		}
+	}
+	chunk_offsets[r] = ftell(f);
+
+	// fill in chunk positions
+	fseek(f, directory, SEEK_SET);
+	for(uint32 i = 0; i < num_regions; i++) {
+		fseek(f, 3 * sizeof(uint32), SEEK_CUR);
+		OUT64(chunk_offsets[i]);
+		OUT64(chunk_offsets[i + 1] - chunk_offsets[i]);
 	}
 
+	free(chunk_offsets);
+	free(lz);
+	free(buffer);
 	fclose(f);
 }
 
 #undef OUT
+#undef OUT64
 
 #ifdef __INTEL_COMPILER
 #pragma warning pop
@@ -42,6 +42,14 @@
 
 #include "context/impl/common.impl.h"
 
+#include <assert.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef __INTEL_COMPILER
 #pragma warning push
 // 279 - controlling expression is constant
@@ -56,8 +64,9 @@
 
 typedef struct {
 	uint32 id;  // the ID of the represented data block / item
-	int32 tag;  // the user defined tag of this data item
-	char* data; // does not own the data, just a pointer to the location
+	int32 tag;   // the user defined tag of this data item
+	uint32 size; // the size of this data item
+	char* data;  // does not own the data, just a pointer to the location
 } irt_cap_profile_data_block;
 
 typedef struct _irt_cap_profile_life_out_data_fragment {
@@ -70,8 +79,14 @@ typedef struct _irt_cap_profile_life_out_data_fragment {
 typedef struct {
 	uint32 id;         // the region ID this context was captured for
 	uint32 num_blocks; // the number of blocks within the data context
+	uint32 total_size; // the accumulated size of all blocks within the data context
+
+	// the location of the region chunk within the profile file
+	uint64 offset;
+	uint64 length;
 
-	// life in data structures
+	// life in data structures, only restored on demand
+	bool loaded;                        // whether the data below has been restored already
 	char* data;                         // one data block containing all values
 	irt_cap_profile_data_block* blocks; // the list of blocks within the data block above
 
@@ -79,165 +94,384 @@ typedef struct {
 
 
 typedef struct {
+	char* file;                                // the content of the profile file (mapped)
+	size_t file_size;                          // the size of the profile file
 	size_t num_contexts;                       // the number of regions stored within this storage
 	irt_cap_profile_region_context contexts[]; // the list of contexts (variable size at the end of the struct)
 } irt_cap_profile;
 
-#define IN() (fread(&tmp, sizeof(tmp), 1, f) == 1 ? tmp : 0)
+// reads values from the profile file, a read beyond its end clears ok and yields zero
+#define IN(T) (_irt_cap_profile_read(&cur, end, &ok, &T##_tmp, sizeof(T)), T##_tmp)
+
+static inline void _irt_cap_profile_read(const char** cur, const char* end, bool* ok, void* target, size_t size) {
+	if(!*ok || size > (size_t)(end - *cur)) {
+		*ok = false;
+		memset(target, 0, size);
+		return;
+	}
+	memcpy(target, *cur, size);
+	*cur += size;
+}
+
+// skips the given number of bytes within the profile file, returns the skipped range or NULL if it exceeds the end
+static inline const char* _irt_cap_profile_skip(const char** cur, const char* end, bool* ok, size_t size) {
+	if(!*ok || size > (size_t)(end - *cur)) {
+		*ok = false;
+		return NULL;
+	}
+	const char* res = *cur;
+	*cur += size;
+	return res;
+}
+
+// maps the given file into memory
+char* _irt_cap_profile_map_file(const char* file_name, size_t* size) {
+	#ifndef _WIN32
+	int fd = open(file_name, O_RDONLY);
+	if(fd < 0) { return NULL; }
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return NULL;
+	}
+	*size = st.st_size;
+	char* res = (char*)mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	return (res == MAP_FAILED) ? NULL : res;
+	#else
+	FILE* f = fopen(file_name, "rb");
+	if(!f) { return NULL; }
+	fseek(f, 0, SEEK_END);
+	*size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	char* res = (char*)malloc(*size);
+	*size = fread(res, sizeof(char), *size, f);
+	fclose(f);
+	return res;
+	#endif
+}
+
+void _irt_cap_profile_unmap_file(char* file, size_t size) {
+	#ifndef _WIN32
+	munmap(file, size);
+	#else
+	free(file);
+	#endif
+}
 
+/**
+ * Loads the directory of the profile file. The actual data of a region is
+ * restored by irt_cap_load_region_context once it is requested.
+ *
+ * @return the loaded profile or NULL if the file is missing, outdated or corrupted
+ */
 irt_cap_profile* irt_cap_load_profile() {
-	uint32 tmp; // used by read macro
+	uint32 uint32_tmp; // used by read macro
+	uint64 uint64_tmp; // used by read macro
+	bool ok = true;    // used by read macro
 
 	// determine profile name
 	const char* file_name = irt_cap_profile_get_filename();
 
-	// safe data to file
-	FILE* f = fopen(file_name, "r");
-	if(!f) {
+	// map the file
+	size_t file_size = 0;
+	char* file = _irt_cap_profile_map_file(file_name, &file_size);
+	if(!file) {
 		printf("Profile file '%s' not found - please specify file using env. variable IRT_CONTEXT_FILE\n", file_name);
-		exit(1);
+		return NULL;
+	}
+	const char* cur = file;
+	const char* end = file + file_size;
+
+	// start by checking the magic number and version
+	uint32 magic = IN(uint32);
+	uint32 version = IN(uint32);
+	if(ok && magic == MAGIC_NUMBER && version != IRT_CAP_PROFILE_FORMAT_VERSION) {
+		printf("Profile file '%s' has an unsupported format version - please re-record it\n", file_name);
+		_irt_cap_profile_unmap_file(file, file_size);
+		return NULL;
 	}
-
-	// start by checking the magic number
-	tmp = IN();
-	assert(tmp == MAGIC_NUMBER && "File corrupted!");
 
 	// read the number of regions / context contained within the file
-	tmp = IN(); // number of regions
-	irt_cap_profile* res = (irt_cap_profile*)malloc(sizeof(irt_cap_profile) + sizeof(irt_cap_profile_region_context) * tmp);
-	res->num_contexts = tmp;
+	uint32 num_contexts = IN(uint32);
+	const size_t entry_size = 3 * sizeof(uint32) + 2 * sizeof(uint64);
+	if(!ok || magic != MAGIC_NUMBER || num_contexts > (size_t)(end - cur) / entry_size) {
+		printf("Profile file '%s' is corrupted\n", file_name);
+		_irt_cap_profile_unmap_file(file, file_size);
+		return NULL;
+	}
+
+	irt_cap_profile* res = (irt_cap_profile*)malloc(sizeof(irt_cap_profile) + sizeof(irt_cap_profile_region_context) * num_contexts);
+	res->file = file;
+	res->file_size = file_size;
+	res->num_contexts = num_contexts;
 
 	DEBUG(printf("Resolving %d context(s) ...\n", (int)res->num_contexts));
 
-	// resolve contexts
+	// read the region directory
 	for(size_t i = 0; i < res->num_contexts; i++) {
-		// create context instance
-		uint32 id = IN();
-		uint32 num_blocks = IN();
-
 		irt_cap_profile_region_context* context = &(res->contexts[i]);
+		context->id = IN(uint32);
+		context->num_blocks = IN(uint32);
+		context->total_size = IN(uint32);
+		context->offset = IN(uint64);
+		context->length = IN(uint64);
+		context->loaded = false;
+		context->data = NULL;
+		context->blocks = NULL;
+		if(context->offset > file_size || context->length > file_size - context->offset) { ok = false; }
+	}
 
-		context->id = id;
-		context->num_blocks = num_blocks;
-		context->blocks = (irt_cap_profile_data_block*)malloc(sizeof(irt_cap_profile_data_block) * num_blocks);
+	if(!ok) {
+		printf("Profile file '%s' is corrupted\n", file_name);
+		_irt_cap_profile_unmap_file(file, file_size);
+		free(res);
+		return NULL;
+	}
 
-		// create data store
-		uint32 totalSize = IN();
-		DEBUG(printf("Total Size: %d\n", (int)totalSize));
-		DEBUG(printf("Allocating           %d bytes.\n", (int)(totalSize + IRT_CONTEXT_CAPTURE_ALIGNMENT * context->num_blocks)));
-		context->data = (char*)malloc(totalSize + IRT_CONTEXT_CAPTURE_ALIGNMENT * context->num_blocks);
+	return res;
+}
 
-		// load individual blocks
-		char* cur = context->data;
-		for(uint32 j = 0; j < context->num_blocks; j++) {
-			irt_cap_profile_data_block* item = &(context->blocks[j]);
+// restores the values of the given block from its life-in mask and the (decoded) life-in values, returns false if they do not fit
+static inline bool _irt_cap_profile_fill_block(irt_cap_profile_data_block* item, const char* mask, uint32 mask_size, const char* values, uint32 num_values) {
+	irt_cap_rle_iterator it;
+	irt_cap_rle_iterator_init(&it, mask, mask_size);
+	uint32 start, length, consumed = 0;
+	while(irt_cap_rle_next(&it, &start, &length)) {
+		if(length > item->size || start > item->size - length || length > num_values - consumed) { return false; }
+		memcpy(item->data + start, values + consumed, length);
+		consumed += length;
+	}
+	return true;
+}
 
-			// get item ID
-			item->id = IN();
+// replaces the pointers marked by the pointer mask of the given block by their restored location, returns false if the mask is invalid
+static inline bool _irt_cap_profile_restore_pointers(irt_cap_profile_region_context* context, irt_cap_profile_data_block* item, const char* mask,
+                                                     uint32 mask_size) {
+	char* base = item->data;
+
+	irt_cap_rle_iterator it;
+	irt_cap_rle_iterator_init(&it, mask, mask_size);
+	uint32 start, length;
+	while(irt_cap_rle_next(&it, &start, &length)) {
+		if(length % sizeof(void*) != 0 || length > item->size || start > item->size - length) { return false; }
+
+		// restore pointers
+		for(uint32 l = start; l < start + length; l += sizeof(void*)) {
+			// load replacement
+			irt_cap_pointer_substitute* replacement = (irt_cap_pointer_substitute*)(&(base[l]));
+
+			// lookup block within context
+			irt_cap_profile_data_block* block = NULL;
+			for(uint32 m = 0; m < context->num_blocks && !block; m++) {
+				if(context->blocks[m].id == replacement->block) { block = &(context->blocks[m]); }
+			}
 
-			// get item Tag
-			item->tag = IN();
+			// compute actual location
+			char* ptr = (char*)0x123456; // default value - if not dereferenced, just read!
+			if(replacement->block == 0) {
+				ptr = NULL;
+				DEBUG(printf("Restored NULL pointer\n"));
+			} else if(block) {
+				ptr = block->data + replacement->offset;
+				DEBUG(printf("Restored pointer to block %d offest %d - %p - %p\n", replacement->block, replacement->offset, (void*)block->data, (void*)ptr));
+			}
 
-			// get pointer address
-			uint32 address = IN();
+			// restore pointer to block
+			*((char**)(&(base[l]))) = ptr;
+		}
+	}
+	return true;
+}
 
-			// compute next location within data block having the same alignment
-			size_t reqAlign = address % IRT_CONTEXT_CAPTURE_ALIGNMENT;
-			size_t curAlign = (size_t)cur % IRT_CONTEXT_CAPTURE_ALIGNMENT;
-			int diff = reqAlign - curAlign;
+/**
+ * Restores the data of the given region from the chunk within the profile file.
+ *
+ * @return true if the region has been restored, false if its chunk is corrupted
+ */
+bool irt_cap_load_region_context(irt_cap_profile* profile, irt_cap_profile_region_context* context) {
+	uint32 uint32_tmp; // used by read macro
+	int32 int32_tmp;   // used by read macro
+	bool ok = true;    // used by read macro
 
-			// save start position
-			size_t new_pos = (size_t)cur + ((diff < 0) ? diff + IRT_CONTEXT_CAPTURE_ALIGNMENT : diff);
-			item->data = (char*)new_pos;
+	if(context->loaded) { return true; }
 
-			// check alignment
-			assert((char*)new_pos >= cur && "Error in computation - overlapping blocks encountered!");
-			assert(new_pos % IRT_CONTEXT_CAPTURE_ALIGNMENT == reqAlign && "Incorrect alignment computation!");
+	const char* cur = profile->file + context->offset;
+	const char* end = cur + context->length;
 
-			// move current end
-			uint32 size = IN();
-			cur = (char*)(new_pos + size); // reads size of block
+	// every block occupies at least 9 uint32 values within the chunk
+	if(context->num_blocks > context->length / (9 * sizeof(uint32))) { return false; }
 
-			// fill in data
-			size_t num_fragments = IN();
-			for(size_t k = 0; k < num_fragments; k++) {
-				char* start = item->data + IN(); // start position
-				size_t length = IN();
+	context->blocks = (irt_cap_profile_data_block*)malloc(sizeof(irt_cap_profile_data_block) * context->num_blocks);
 
-				// copy data
-				length = fread(start, sizeof(char), length, f);
-			}
+	// create data store
+	size_t data_size = (size_t)context->total_size + IRT_CONTEXT_CAPTURE_ALIGNMENT * context->num_blocks;
+	DEBUG(printf("Total Size: %d\n", (int)context->total_size));
+	DEBUG(printf("Allocating           %d bytes.\n", (int)data_size));
+	context->data = (char*)malloc(data_size);
+	const char* data_end = context->data + data_size;
 
-			DEBUG(printf("Restored block %d size %d @ %p\n", item->id, size, (void*)item->data));
-		}
+	// the pointer masks are processed after all blocks have been restored
+	const char** pointer_masks = (const char**)malloc(sizeof(char*) * context->num_blocks);
+	uint32* pointer_mask_sizes = (uint32*)malloc(sizeof(uint32) * context->num_blocks);
 
-		// correct pointers
-		for(uint32 j = 0; j < context->num_blocks; j++) {
-			// load number of pointer fragments
-			uint32 num_fragments = IN();
-
-			// get base index of current block
-			char* base = context->blocks[j].data;
-
-			for(uint32 k = 0; k < num_fragments; k++) {
-				uint32 start = IN();
-				uint32 length = IN();
-
-				assert(length % sizeof(void*) == 0 && "Invalid pointer fragment length!");
-
-				// restore pointers
-				for(uint32 l = start; l < start + length; l += sizeof(void*)) {
-					// load replacement
-					irt_cap_pointer_substitute* replacement = (irt_cap_pointer_substitute*)(&(base[l]));
-
-					// lookup block within context
-					irt_cap_profile_data_block* block = NULL;
-					for(uint32 m = 0; m < context->num_blocks && !block; m++) {
-						if(context->blocks[m].id == replacement->block) { block = &(context->blocks[m]); }
-					}
-
-					// compute actual location
-					char* ptr = (char*)0x123456; // default value - if not dereferenced, just read!
-					if(replacement->block == 0) {
-						ptr = NULL;
-						DEBUG(printf("Restored NULL pointer\n"));
-					} else if(block) {
-						ptr = block->data + replacement->offset;
-						DEBUG(printf("Restored pointer to block %d offest %d - %p - %p\n", replacement->block, replacement->offset, (void*)block->data,
-						             (void*)ptr));
-					}
-
-					// restore pointer to block
-					*((char**)(&(base[l]))) = ptr;
-				}
+	// decoding buffer for compressed life-in values, grown on demand
+	char* decoded = NULL;
+	uint32 decoded_size = 0;
+
+	// load individual blocks
+	char* pos = context->data;
+	for(uint32 j = 0; ok && j < context->num_blocks; j++) {
+		irt_cap_profile_data_block* item = &(context->blocks[j]);
+
+		// get item ID
+		item->id = IN(uint32);
+
+		// get item Tag
+		item->tag = IN(int32);
+
+		// get pointer address
+		uint32 address = IN(uint32);
+
+		// compute next location within data block having the same alignment
+		size_t reqAlign = address % IRT_CONTEXT_CAPTURE_ALIGNMENT;
+		size_t curAlign = (size_t)pos % IRT_CONTEXT_CAPTURE_ALIGNMENT;
+		size_t new_pos = (size_t)pos + (reqAlign + IRT_CONTEXT_CAPTURE_ALIGNMENT - curAlign) % IRT_CONTEXT_CAPTURE_ALIGNMENT;
+		item->data = (char*)new_pos;
+
+		// check alignment
+		assert((char*)new_pos >= pos && "Error in computation - overlapping blocks encountered!");
+		assert(new_pos % IRT_CONTEXT_CAPTURE_ALIGNMENT == reqAlign && "Incorrect alignment computation!");
+
+		// move current end, the sizes of the blocks have to add up to the total size of the region
+		item->size = IN(uint32);
+		if(item->data > data_end || item->size > (size_t)(data_end - item->data)) {
+			ok = false;
+			break;
+		}
+		pos = item->data + item->size;
+
+		// get life-in mask
+		uint32 mask_size = IN(uint32);
+		const char* mask = _irt_cap_profile_skip(&cur, end, &ok, mask_size);
+
+		// get life-in values
+		uint32 encoding = IN(uint32);
+		uint32 num_values = IN(uint32);
+		uint32 encoded_size = IN(uint32);
+		const char* values = _irt_cap_profile_skip(&cur, end, &ok, encoded_size);
+		if(!ok) { break; }
+		if(encoding == IRT_CAP_ENCODING_LZ) {
+			if(num_values > decoded_size) {
+				free(decoded);
+				decoded = (char*)malloc(num_values);
+				decoded_size = num_values;
 			}
+			ok = irt_cap_lz_decompress(values, encoded_size, decoded, num_values);
+			values = decoded;
+		} else {
+			ok = encoding == IRT_CAP_ENCODING_PLAIN && encoded_size == num_values;
 		}
 
-		// re-allocate array to save some memory
-		// DEBUG(printf("Reallocating to %d bytes.\n", cur - context->data));
-		// context->data = realloc(context->data, cur - context->data);
+		// fill in data
+		ok = ok && _irt_cap_profile_fill_block(item, mask, mask_size, values, num_values);
+
+		// get pointer mask
+		pointer_mask_sizes[j] = IN(uint32);
+		pointer_masks[j] = _irt_cap_profile_skip(&cur, end, &ok, pointer_mask_sizes[j]);
+
+		DEBUG(printf("Restored block %d size %d @ %p\n", item->id, item->size, (void*)item->data));
 	}
+	free(decoded);
 
-	// done
-	fclose(f);
+	// correct pointers
+	for(uint32 j = 0; ok && j < context->num_blocks; j++) {
+		ok = _irt_cap_profile_restore_pointers(context, &(context->blocks[j]), pointer_masks[j], pointer_mask_sizes[j]);
+	}
 
-	return res;
+	free(pointer_masks);
+	free((void*)pointer_mask_sizes);
+
+	if(!ok) {
+		free(context->data);
+		free(context->blocks);
+		context->data = NULL;
+		context->blocks = NULL;
+		return false;
+	}
+
+	context->loaded = true;
+	return true;
 }
 
+/**
+ * Prints the number of blocks, the captured and the stored number of bytes of
+ * each region within the current profile file.
+ */
+void irt_cap_profile_print_summary(FILE* out) {
+	uint32 uint32_tmp; // used by read macro
+	bool ok = true;    // used by read macro
+
+	irt_cap_profile* profile = irt_cap_load_profile();
+	if(!profile) {
+		fprintf(out, "unable to load profile file '%s'\n", irt_cap_profile_get_filename());
+		return;
+	}
+	fprintf(out, "%8s %8s %14s %14s %14s\n", "region", "blocks", "block bytes", "life-in bytes", "stored bytes");
+
+	uint64 total_stored = 0;
+	for(size_t i = 0; i < profile->num_contexts; i++) {
+		irt_cap_profile_region_context* context = &(profile->contexts[i]);
+
+		// sum up life-in values without decoding them
+		uint64 life_in = 0;
+		const char* cur = profile->file + context->offset;
+		const char* end = cur + context->length;
+		for(uint32 j = 0; ok && j < context->num_blocks; j++) {
+			_irt_cap_profile_skip(&cur, end, &ok, 4 * sizeof(uint32)); // id, tag, address, size
+			_irt_cap_profile_skip(&cur, end, &ok, IN(uint32));         // life-in mask
+			_irt_cap_profile_skip(&cur, end, &ok, sizeof(uint32));     // encoding
+			life_in += IN(uint32);
+			_irt_cap_profile_skip(&cur, end, &ok, IN(uint32)); // life-in values
+			_irt_cap_profile_skip(&cur, end, &ok, IN(uint32)); // pointer mask
+		}
+		if(!ok) {
+			fprintf(out, "%8u corrupted\n", context->id);
+			ok = true;
+			continue;
+		}
+
+		fprintf(out, "%8u %8u %14u %14" PRIu64 " %14" PRIu64 "\n", context->id, context->num_blocks, context->total_size, life_in, context->length);
+		total_stored += context->length;
+	}
+	fprintf(out, "total: %" PRIu64 " bytes in %u regions, file size %" PRIu64 " bytes\n", total_stored, (uint32)profile->num_contexts,
+	        (uint64)profile->file_size);
+
+	_irt_cap_profile_unmap_file(profile->file, profile->file_size);
+	free(profile);
+}
+
+#undef IN
 
 irt_cap_profile* irt_g_cap_profile = NULL;
 
 void irt_cap_profile_get_value(void* target, uint16 region_id, uint16 tag, uint32 size) {
 	if(!irt_g_cap_profile) { irt_g_cap_profile = irt_cap_load_profile(); }
+	IRT_ASSERT(irt_g_cap_profile != NULL, IRT_ERR_IO, "Unable to load profile file '%s'!", irt_cap_profile_get_filename());
 
 	// search for region
-	for(int i = 0; i < irt_g_cap_profile->num_contexts; i++) {
+	for(size_t i = 0; i < irt_g_cap_profile->num_contexts; i++) {
 		if(irt_g_cap_profile->contexts[i].id == region_id) {
 			irt_cap_profile_region_context* context = &(irt_g_cap_profile->contexts[i]);
 
+			// restore region data on first access
+			bool loaded = irt_cap_load_region_context(irt_g_cap_profile, context);
+			IRT_ASSERT(loaded, IRT_ERR_IO, "Data of region %d within profile file '%s' is corrupted!", region_id, irt_cap_profile_get_filename());
+
 			for(uint32 m = 0; m < context->num_blocks; m++) {
 				if(context->blocks[m].tag == tag) {
 					char* base = context->blocks[m].data;
+					IRT_ASSERT(size <= context->blocks[m].size, IRT_ERR_IO, "Requested %u bytes from data block of %u bytes!", size, context->blocks[m].size);
 
 					// copy data
 					memcpy(target, base, size);
@@ -258,10 +492,11 @@ void irt_cap_profile_finalize() {
 	if(!irt_g_cap_profile) { return; }
 
 	// free the context information
-	for(int i = 0; i < irt_g_cap_profile->num_contexts; i++) {
+	for(size_t i = 0; i < irt_g_cap_profile->num_contexts; i++) {
 		free(irt_g_cap_profile->contexts[i].data);
 		free(irt_g_cap_profile->contexts[i].blocks);
 	}
+	_irt_cap_profile_unmap_file(irt_g_cap_profile->file, irt_g_cap_profile->file_size);
 	free(irt_g_cap_profile);
 	irt_g_cap_profile = NULL;
 }
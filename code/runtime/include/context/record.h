@@ -117,7 +117,8 @@ const irt_cap_data_block_info* irt_cap_dbi_register_block(void* base, uint32 siz
 /**
  * Obtains a pointer to the information stored for the data block referenced
  * by the given pointer. In case there is no such block, a null pointer will
- * be returned.
+ * be returned. If multiple blocks are covering the given location, the most
+ * recently registered block is returned.
  *
  * @param ptr a pointer pointing on one of the elements of the requested block
  * @return the information maintained for the corresponding data block
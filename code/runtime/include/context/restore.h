@@ -38,6 +38,8 @@
 #ifndef __GUARD_CONTEXT_RESTORE_H
 #define __GUARD_CONTEXT_RESTORE_H
 
+#include <stdio.h>
+
 /**
  * This function can be used to obtain a value from a profile file being tagged with a given value.
  */
@@ -49,5 +51,11 @@ void irt_cap_profile_get_value(void* target, uint16 region_id, uint16 tag, uint3
  */
 void irt_cap_profile_finalize();
 
+/**
+ * Prints the number of blocks as well as the captured and stored number of bytes
+ * for each region recorded within the profile file.
+ */
+void irt_cap_profile_print_summary(FILE* out);
+
 
 #endif // ifndef __GUARD_CONTEXT_RESTORE_H
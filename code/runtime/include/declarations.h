@@ -116,6 +116,12 @@ typedef struct _irt_pd_table irt_pd_table;
 typedef struct _irt_epd_table irt_epd_table;
 typedef struct _irt_apd_table irt_apd_table;
 
+/* ------------------------------ task dependences ----- */
+
+typedef struct _irt_task_dep_node irt_task_dep_node;
+typedef struct _irt_task_dep_table irt_task_dep_table;
+typedef irt_task_dep_node* irt_task_deps;
+
 /* ------------------------------ types ----- */
 
 typedef int32 irt_type_id;
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_DIST_DIST_H
+#define __GUARD_DIST_DIST_H
+
+#include "declarations.h"
+#include "work_item.h"
+
+/*
+ * The distributed runtime (dirt) runs several shared-nothing runtime processes, each of them a
+ * full runtime instance, and distributes jobs among them. A job is the invocation of a work item
+ * implementation of the context table on a range and a light weight data item. Idle processes
+ * steal queued jobs of their peers; the results, the data item as modified by the job, are sent
+ * back to the process the job originates from, where it is joined.
+ *
+ * All processes have to execute the same binary, such that implementation and type ids refer to
+ * the same entries of the context tables. Data items are copied by value, hence they must not
+ * contain pointers. All operations on a node have to be issued by a single work item of its
+ * process, which is also the one executing the jobs of that node.
+ */
+
+/* ------------------------------ data structures ----- */
+
+typedef struct _dirt_job_id {
+	uint32 node;  // the rank of the node the job originates from
+	uint32 index; // the index of the job within the table of its origin
+} dirt_job_id;
+
+typedef struct _dirt_job dirt_job;
+struct _dirt_job {
+	dirt_job_id id;
+	irt_work_item_range range;
+	uint32 impl_id;
+	uint32 params_size;
+	irt_lw_data_item* params;
+	dirt_job* prev;
+	dirt_job* next;
+};
+
+// the state of a job originating from this node
+typedef struct _dirt_job_record {
+	bool completed;
+	irt_lw_data_item* params; // the result, once completed
+} dirt_job_record;
+
+typedef enum _dirt_msg_tag {
+	DIRT_MSG_STEAL_REQUEST, // the sender is idle and asks for work
+	DIRT_MSG_WORK,          // a stolen job, handed over to the thief
+	DIRT_MSG_NO_WORK,       // the denial of a steal request
+	DIRT_MSG_COMPLETED,     // the result of a job, sent to its origin
+	DIRT_MSG_SHUTDOWN       // the request to leave serving
+} dirt_msg_tag;
+
+typedef struct _dirt_node {
+	uint32 rank;
+	uint32 num_nodes;
+	int* peers; // a connected stream socket per node, -1 for the node itself
+	irt_context* context;
+	// jobs ready to be executed here, the owner executes the newest, thieves get the oldest
+	dirt_job* queue_head;
+	dirt_job* queue_tail;
+	// records of the jobs originating from this node
+	dirt_job_record* jobs;
+	uint32 num_jobs;
+	uint32 jobs_capacity;
+	// stealing state
+	bool steal_pending;
+	uint32 steal_victim;
+	bool shutdown;
+	// statistics
+	uint32 num_executed;
+	uint32 num_stolen;
+	uint32 num_remote_completed;
+} dirt_node;
+
+/* ------------------------------ transport ----- */
+
+// creates a fully connected mesh of local sockets among num_nodes processes which are forked afterwards,
+// fds has to provide num_nodes*num_nodes entries, the endpoint of node i connected to node j being fds[i*num_nodes+j]
+bool dirt_mesh_create_local(uint32 num_nodes, int* fds);
+
+// selects the endpoints of the given rank from a local mesh and closes all others, peers has to provide num_nodes entries
+void dirt_mesh_select_local(uint32 num_nodes, uint32 rank, int* fds, int* peers);
+
+// connects the given rank to all other nodes using TCP, node i listening on base_port+i at the given host
+bool dirt_mesh_connect_tcp(uint32 num_nodes, uint32 rank, const char* host, uint16 base_port, int* peers);
+
+/* ------------------------------ operations ----- */
+
+// creates a node of the given rank communicating through the given sockets, to be called within a work item
+dirt_node* dirt_node_create(uint32 rank, uint32 num_nodes, const int* peers);
+
+// destroys the given node and closes its sockets
+void dirt_node_destroy(dirt_node* node);
+
+// submits the implementation impl_id of the current context as a new job, the parameters are copied
+dirt_job_id dirt_spawn(dirt_node* node, irt_work_item_range range, uint32 impl_id, irt_lw_data_item* params);
+
+// waits for the given job to be completed, executing and stealing jobs in the meantime
+// if result is not NULL, the parameters as modified by the job are copied into it
+void dirt_join(dirt_node* node, dirt_job_id job, irt_lw_data_item* result);
+
+// executes and steals jobs until a shutdown is requested by some other node
+void dirt_node_serve(dirt_node* node);
+
+// requests all other nodes to leave serving, all jobs have to be joined before
+void dirt_node_shutdown(dirt_node* node);
+
+#endif // ifndef __GUARD_DIST_DIST_H
@@ -98,7 +98,7 @@ dirt_blob_container _dirt_init() {
 void _dirt_delete(dirt_blob_container* container) {
 	dirt_container_node* curr = container->root;
 	while(curr != NULL) {
-		_dirt_container_node* tmp = curr;
+		dirt_container_node* tmp = curr;
 		curr = curr->next;
 		free(tmp);
 	}
@@ -113,13 +113,13 @@ void _dirt_delete(dirt_blob_container* container) {
 
 void _dirt_write_to_blob_container(dirt_blob_container* container, void* ptr, size_t size) {
 	// initialize
-	dirt_container_node* new_node = (_dirt_container_node*)malloc(sizeof(_dirt_container_node));
+	dirt_container_node* new_node = (dirt_container_node*)malloc(sizeof(dirt_container_node));
 	new_node->next = NULL;
 	new_node->blob.payload = ptr;
 	new_node->blob.size = size;
 
 	// attach
-	_dirt_container_node* current = container->root;
+	dirt_container_node* current = container->root;
 	if(current == NULL) {
 		container->root = new_node;
 	} else {
@@ -131,7 +131,7 @@ void _dirt_write_to_blob_container(dirt_blob_container* container, void* ptr, si
 }
 
 dirt_blob _dirt_read_from_blob_container(dirt_blob_container* container) {
-	_dirt_container_node* top = container->root;
+	dirt_container_node* top = container->root;
 
 	// sanity check
 	IRT_ASSERT(top != NULL, IRT_ERR_BLOB_CONTAINER, "the blob container is empty");
@@ -147,7 +147,7 @@ dirt_byte_stream _dirt_blob_pack(dirt_blob_container* container) {
 	// compute size
 	size_t total_size = 0;
 
-	_dirt_container_node* curr = container->root;
+	dirt_container_node* curr = container->root;
 	do {
 		if(curr != NULL) {
 			total_size += curr->blob.size;
@@ -184,10 +184,11 @@ void _dirt_blob_unpack(dirt_blob_container* container, dirt_byte_stream stream)
 	size_t total_size = stream.size;
 	unsigned char* ptr = stream.payload;
 
-	_dirt_container_node* new_node = (_dirt_container_node*)malloc(sizeof(_dirt_container_node));
 	IRT_ASSERT(container->root == NULL, IRT_ERR_BLOB_CONTAINER, "the blob container must be empty");
-	container->root = new_node;
-	while(ptr < stream.payload + stream.size) {
+	dirt_container_node** tail = &container->root;
+	while(ptr < stream.payload + total_size) {
+		dirt_container_node* new_node = (dirt_container_node*)malloc(sizeof(dirt_container_node));
+		new_node->next = NULL;
 		// read a size
 		memcpy(&new_node->blob.size, ptr, sizeof(size_t));
 		ptr += sizeof(size_t);
@@ -196,9 +197,8 @@ void _dirt_blob_unpack(dirt_blob_container* container, dirt_byte_stream stream)
 
 		// move ptr
 		ptr += new_node->blob.size;
-		new_node->next = (_dirt_container_node*)malloc(sizeof(_dirt_container_node));
-		new_node = new_node->next;
-		new_node->next = NULL;
+		*tail = new_node;
+		tail = &new_node->next;
 	}
 
 	// save the stream pointer in the container context for future deletion
@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_DIST_IMPL_DIST_IMPL_H
+#define __GUARD_DIST_IMPL_DIST_IMPL_H
+
+#include "dist/dist.h"
+#include "dist/impl/transport.impl.h"
+
+#include "irt_context.h"
+#include "irt_types.h"
+#include "worker.h"
+
+/* ------------------------------ job queue ----- */
+
+static inline void _dirt_queue_push(dirt_node* node, dirt_job* job) {
+	job->next = NULL;
+	job->prev = node->queue_tail;
+	if(node->queue_tail) {
+		node->queue_tail->next = job;
+	} else {
+		node->queue_head = job;
+	}
+	node->queue_tail = job;
+}
+
+static inline dirt_job* _dirt_queue_remove(dirt_node* node, dirt_job* job) {
+	if(job == NULL) { return NULL; }
+	if(job->prev) {
+		job->prev->next = job->next;
+	} else {
+		node->queue_head = job->next;
+	}
+	if(job->next) {
+		job->next->prev = job->prev;
+	} else {
+		node->queue_tail = job->prev;
+	}
+	job->prev = job->next = NULL;
+	return job;
+}
+
+static inline void _dirt_job_destroy(dirt_job* job) {
+	free(job->params);
+	free(job);
+}
+
+/* ------------------------------ messages ----- */
+
+static inline void _dirt_peer_lost(dirt_node* node, uint32 peer) {
+	IRT_ASSERT(node->shutdown || node->rank != 0, IRT_ERR_DIST, "Distributed runtime: connection to node %u lost", peer);
+	close(node->peers[peer]);
+	node->peers[peer] = -1;
+	// without the node jobs originate from there is nothing left to do
+	if(peer == 0) { node->shutdown = true; }
+	// a pending steal request will never be answered
+	if(node->steal_pending && node->steal_victim == peer) { node->steal_pending = false; }
+}
+
+static inline void _dirt_send_to(dirt_node* node, uint32 peer, dirt_msg_tag tag, dirt_blob_container* container) {
+	if(node->peers[peer] < 0) { return; }
+	if(!_dirt_send(node->peers[peer], tag, container)) { _dirt_peer_lost(node, peer); }
+}
+
+static inline void _dirt_send_job(dirt_node* node, uint32 peer, dirt_msg_tag tag, dirt_job* job) {
+	dirt_blob_container container = _dirt_init();
+	_dirt_write_to_blob_container(&container, job, sizeof(dirt_job));
+	if(job->params_size > 0) { _dirt_write_to_blob_container(&container, job->params, job->params_size); }
+	_dirt_send_to(node, peer, tag, &container);
+	_dirt_delete(&container);
+}
+
+static inline dirt_job* _dirt_read_job(dirt_blob_container* container) {
+	dirt_job* job = (dirt_job*)malloc(sizeof(dirt_job));
+	dirt_blob header = _dirt_read_from_blob_container(container);
+	IRT_ASSERT(header.size == sizeof(dirt_job), IRT_ERR_DIST, "Distributed runtime: malformed job received");
+	memcpy(job, header.payload, sizeof(dirt_job));
+	job->params = NULL;
+	job->prev = job->next = NULL;
+	if(job->params_size > 0) {
+		dirt_blob params = _dirt_read_from_blob_container(container);
+		IRT_ASSERT(params.size == job->params_size, IRT_ERR_DIST, "Distributed runtime: malformed job parameters received");
+		job->params = (irt_lw_data_item*)malloc(params.size);
+		memcpy(job->params, params.payload, params.size);
+	}
+	return job;
+}
+
+// records the completion of a job originating from this node, taking over its parameters
+static inline void _dirt_complete(dirt_node* node, dirt_job* job) {
+	IRT_ASSERT(job->id.node == node->rank && job->id.index < node->num_jobs, IRT_ERR_DIST, "Distributed runtime: completion of unknown job");
+	dirt_job_record* record = &node->jobs[job->id.index];
+	record->completed = true;
+	record->params = job->params;
+	free(job);
+}
+
+static inline void _dirt_handle_message(dirt_node* node, uint32 peer) {
+	dirt_msg_tag tag;
+	dirt_blob_container container = _dirt_init();
+	if(!_dirt_receive(node->peers[peer], &tag, &container)) {
+		_dirt_delete(&container);
+		_dirt_peer_lost(node, peer);
+		return;
+	}
+
+	switch(tag) {
+	case DIRT_MSG_STEAL_REQUEST: {
+		// hand over the oldest job, which is likely to be the largest one
+		dirt_job* job = _dirt_queue_remove(node, node->queue_head);
+		if(job) {
+			_dirt_send_job(node, peer, DIRT_MSG_WORK, job);
+			_dirt_job_destroy(job);
+			node->num_stolen++;
+		} else {
+			_dirt_send_to(node, peer, DIRT_MSG_NO_WORK, NULL);
+		}
+		break;
+	}
+	case DIRT_MSG_WORK:
+		_dirt_queue_push(node, _dirt_read_job(&container));
+		node->steal_pending = false;
+		break;
+	case DIRT_MSG_NO_WORK:
+		node->steal_pending = false;
+		break;
+	case DIRT_MSG_COMPLETED:
+		_dirt_complete(node, _dirt_read_job(&container));
+		node->num_remote_completed++;
+		break;
+	case DIRT_MSG_SHUTDOWN: node->shutdown = true; break;
+	default: IRT_ASSERT(false, IRT_ERR_DIST, "Distributed runtime: unknown message %u received", (uint32)tag);
+	}
+
+	_dirt_delete(&container);
+}
+
+// handles all messages received so far, if block is set waits for messages to arrive for a short time
+static inline void _dirt_progress(dirt_node* node, bool block) {
+	struct pollfd* fds = (struct pollfd*)alloca(sizeof(struct pollfd) * node->num_nodes);
+	for(uint32 i = 0; i < node->num_nodes; ++i) {
+		fds[i].fd = node->peers[i]; // negative descriptors are ignored
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+	if(poll(fds, node->num_nodes, block ? IRT_DIST_POLL_TIMEOUT : 0) <= 0) { return; }
+	for(uint32 i = 0; i < node->num_nodes; ++i) {
+		if(fds[i].revents & (POLLIN | POLLHUP | POLLERR)) { _dirt_handle_message(node, i); }
+	}
+}
+
+// asks the next peer in a round-robin fashion for work, unless there is a request pending already
+static inline void _dirt_steal(dirt_node* node) {
+	if(node->steal_pending) { return; }
+	for(uint32 i = 1; i < node->num_nodes; ++i) {
+		uint32 victim = (node->steal_victim + i) % node->num_nodes;
+		if(victim == node->rank || node->peers[victim] < 0) { continue; }
+		node->steal_victim = victim;
+		node->steal_pending = true;
+		_dirt_send_to(node, victim, DIRT_MSG_STEAL_REQUEST, NULL);
+		return;
+	}
+}
+
+static inline void _dirt_execute(dirt_node* node, dirt_job* job) {
+	IRT_ASSERT(job->impl_id < node->context->impl_table_size, IRT_ERR_DIST, "Distributed runtime: unknown implementation %u", job->impl_id);
+	irt_worker_run_immediate(irt_worker_get_current(), &job->range, &node->context->impl_table[job->impl_id], job->params);
+	node->num_executed++;
+
+	// a remote join, the result is returned to the origin
+	if(job->id.node != node->rank) {
+		_dirt_send_job(node, job->id.node, DIRT_MSG_COMPLETED, job);
+		_dirt_job_destroy(job);
+		return;
+	}
+	_dirt_complete(node, job);
+}
+
+// executes a queued job or otherwise tries to steal one, returns false if it had to wait
+static inline bool _dirt_work(dirt_node* node) {
+	_dirt_progress(node, false);
+	dirt_job* job = _dirt_queue_remove(node, node->queue_tail);
+	if(job) {
+		_dirt_execute(node, job);
+		return true;
+	}
+	_dirt_steal(node);
+	_dirt_progress(node, true);
+	return false;
+}
+
+/* ------------------------------ operations ----- */
+
+dirt_node* dirt_node_create(uint32 rank, uint32 num_nodes, const int* peers) {
+	IRT_ASSERT(rank < num_nodes, IRT_ERR_INVALIDARGUMENT, "Distributed runtime: rank %u exceeds number of nodes %u", rank, num_nodes);
+	dirt_node* node = (dirt_node*)calloc(1, sizeof(dirt_node));
+	node->rank = rank;
+	node->num_nodes = num_nodes;
+	node->peers = (int*)malloc(sizeof(int) * num_nodes);
+	memcpy(node->peers, peers, sizeof(int) * num_nodes);
+	node->peers[rank] = -1;
+	node->context = irt_context_get_current();
+	node->steal_victim = rank;
+	return node;
+}
+
+void dirt_node_destroy(dirt_node* node) {
+	for(uint32 i = 0; i < node->num_nodes; ++i) {
+		if(node->peers[i] >= 0) { close(node->peers[i]); }
+	}
+	while(node->queue_head) {
+		_dirt_job_destroy(_dirt_queue_remove(node, node->queue_head));
+	}
+	for(uint32 i = 0; i < node->num_jobs; ++i) {
+		free(node->jobs[i].params);
+	}
+	free(node->jobs);
+	free(node->peers);
+	free(node);
+}
+
+dirt_job_id dirt_spawn(dirt_node* node, irt_work_item_range range, uint32 impl_id, irt_lw_data_item* params) {
+	// register the job
+	if(node->num_jobs == node->jobs_capacity) {
+		node->jobs_capacity = node->jobs_capacity ? node->jobs_capacity * 2 : 16;
+		node->jobs = (dirt_job_record*)realloc(node->jobs, sizeof(dirt_job_record) * node->jobs_capacity);
+	}
+	dirt_job_id id = {node->rank, node->num_jobs++};
+	node->jobs[id.index].completed = false;
+	node->jobs[id.index].params = NULL;
+
+	// create and enqueue it
+	dirt_job* job = (dirt_job*)malloc(sizeof(dirt_job));
+	job->id = id;
+	job->range = range;
+	job->impl_id = impl_id;
+	job->params_size = params ? irt_type_get_bytes(node->context, params->type_id) : 0;
+	job->params = NULL;
+	if(params) {
+		job->params = (irt_lw_data_item*)malloc(job->params_size);
+		memcpy(job->params, params, job->params_size);
+	}
+	_dirt_queue_push(node, job);
+	return id;
+}
+
+void dirt_join(dirt_node* node, dirt_job_id job, irt_lw_data_item* result) {
+	IRT_ASSERT(job.node == node->rank && job.index < node->num_jobs, IRT_ERR_INVALIDARGUMENT, "Distributed runtime: joining job not spawned by this node");
+	while(!node->jobs[job.index].completed) {
+		_dirt_work(node);
+	}
+	dirt_job_record* record = &node->jobs[job.index];
+	if(result && record->params) { memcpy(result, record->params, irt_type_get_bytes(node->context, record->params->type_id)); }
+	free(record->params);
+	record->params = NULL;
+}
+
+void dirt_node_serve(dirt_node* node) {
+	while(!node->shutdown) {
+		_dirt_work(node);
+	}
+}
+
+void dirt_node_shutdown(dirt_node* node) {
+	node->shutdown = true;
+	for(uint32 i = 0; i < node->num_nodes; ++i) {
+		if(i != node->rank) { _dirt_send_to(node, i, DIRT_MSG_SHUTDOWN, NULL); }
+	}
+}
+
+#endif // ifndef __GUARD_DIST_IMPL_DIST_IMPL_H
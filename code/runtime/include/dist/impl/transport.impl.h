@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_DIST_IMPL_TRANSPORT_IMPL_H
+#define __GUARD_DIST_IMPL_TRANSPORT_IMPL_H
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "dist/dist.h"
+#include "dist/impl/blob_container.impl.h"
+#include "error_handling.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//			Types
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// every message consists of this header followed by size bytes of a packed blob container
+typedef struct _dirt_msg_header {
+	uint32 tag;
+	uint32 padding;
+	uint64 size;
+} dirt_msg_header;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//			Impl
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline bool _dirt_send_fully(int fd, const unsigned char* buffer, size_t size) {
+	while(size > 0) {
+		ssize_t sent = send(fd, buffer, size, MSG_NOSIGNAL);
+		if(sent < 0 && errno == EINTR) { continue; }
+		if(sent <= 0) { return false; }
+		buffer += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+static inline bool _dirt_receive_fully(int fd, unsigned char* buffer, size_t size) {
+	while(size > 0) {
+		ssize_t received = recv(fd, buffer, size, 0);
+		if(received < 0 && errno == EINTR) { continue; }
+		if(received <= 0) { return false; }
+		buffer += received;
+		size -= received;
+	}
+	return true;
+}
+
+// sends a message consisting of the blobs of the given container, which may be NULL for an empty message
+// returns false if the peer is no longer connected
+bool _dirt_send(int fd, dirt_msg_tag tag, dirt_blob_container* container) {
+	dirt_byte_stream stream = {NULL, 0};
+	if(container != NULL && container->root != NULL) { stream = _dirt_blob_pack(container); }
+
+	dirt_msg_header header = {tag, 0, stream.size};
+	bool res = _dirt_send_fully(fd, (unsigned char*)&header, sizeof(header)) && _dirt_send_fully(fd, stream.payload, stream.size);
+	free(stream.payload);
+	return res;
+}
+
+// receives a message, its blobs are appended to the given empty container which takes over the buffer
+// returns false if the peer is no longer connected
+bool _dirt_receive(int fd, dirt_msg_tag* tag, dirt_blob_container* container) {
+	dirt_msg_header header;
+	if(!_dirt_receive_fully(fd, (unsigned char*)&header, sizeof(header))) { return false; }
+	*tag = (dirt_msg_tag)header.tag;
+	if(header.size == 0) { return true; }
+
+	dirt_byte_stream stream = {(unsigned char*)malloc(header.size), header.size};
+	if(!_dirt_receive_fully(fd, stream.payload, stream.size)) {
+		free(stream.payload);
+		return false;
+	}
+	_dirt_blob_unpack(container, stream);
+	return true;
+}
+
+bool dirt_mesh_create_local(uint32 num_nodes, int* fds) {
+	for(uint32 i = 0; i < num_nodes; ++i) {
+		fds[i * num_nodes + i] = -1;
+		for(uint32 j = i + 1; j < num_nodes; ++j) {
+			int pair[2];
+			if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) { return false; }
+			fds[i * num_nodes + j] = pair[0];
+			fds[j * num_nodes + i] = pair[1];
+		}
+	}
+	return true;
+}
+
+void dirt_mesh_select_local(uint32 num_nodes, uint32 rank, int* fds, int* peers) {
+	for(uint32 i = 0; i < num_nodes; ++i) {
+		for(uint32 j = 0; j < num_nodes; ++j) {
+			int fd = fds[i * num_nodes + j];
+			if(i == rank) {
+				peers[j] = fd;
+			} else if(fd >= 0) {
+				close(fd);
+			}
+		}
+	}
+}
+
+static inline struct addrinfo* _dirt_resolve(const char* host, uint16 port) {
+	char service[8];
+	snprintf(service, sizeof(service), "%u", (unsigned)port);
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	struct addrinfo* res = NULL;
+	if(getaddrinfo(host, service, &hints, &res) != 0) { return NULL; }
+	return res;
+}
+
+bool dirt_mesh_connect_tcp(uint32 num_nodes, uint32 rank, const char* host, uint16 base_port, int* peers) {
+	int one = 1;
+	peers[rank] = -1;
+
+	// listen for the nodes of higher rank
+	struct addrinfo* own = _dirt_resolve(host, base_port + rank);
+	if(own == NULL) { return false; }
+	int server = socket(own->ai_family, own->ai_socktype, own->ai_protocol);
+	setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	bool listening = server >= 0 && bind(server, own->ai_addr, own->ai_addrlen) == 0 && listen(server, num_nodes) == 0;
+	freeaddrinfo(own);
+	if(!listening) {
+		if(server >= 0) { close(server); }
+		return false;
+	}
+
+	// connect to the nodes of lower rank, which might not be listening yet
+	for(uint32 i = 0; i < rank; ++i) {
+		struct addrinfo* addr = _dirt_resolve(host, base_port + i);
+		if(addr == NULL) { return false; }
+		int fd = -1;
+		for(uint32 attempt = 0; fd < 0 && attempt < IRT_DIST_CONNECT_RETRIES; ++attempt) {
+			fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+			if(fd >= 0 && connect(fd, addr->ai_addr, addr->ai_addrlen) != 0) {
+				close(fd);
+				fd = -1;
+				usleep(IRT_DIST_CONNECT_RETRY_INTERVAL * 1000);
+			}
+		}
+		freeaddrinfo(addr);
+		// introduce ourselves
+		if(fd < 0 || !_dirt_send_fully(fd, (unsigned char*)&rank, sizeof(rank))) {
+			close(server);
+			return false;
+		}
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		peers[i] = fd;
+	}
+
+	// accept the nodes of higher rank, in any order
+	for(uint32 i = rank + 1; i < num_nodes; ++i) {
+		int fd = accept(server, NULL, NULL);
+		uint32 peer;
+		if(fd < 0 || !_dirt_receive_fully(fd, (unsigned char*)&peer, sizeof(peer)) || peer <= rank || peer >= num_nodes) {
+			close(server);
+			return false;
+		}
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		peers[peer] = fd;
+	}
+
+	close(server);
+	return true;
+}
+
+#endif // ifndef __GUARD_DIST_IMPL_TRANSPORT_IMPL_H
@@ -69,6 +69,26 @@ typedef struct _irt_hw_info {
 	uint32 memory_levels;
 } irt_hw_info;
 
+uint32 irt_hw_get_num_cpus();
+void _irt_hw_set_num_cpus(uint32 num);
+void _irt_hw_info_shutdown();
+int32 _irt_hw_info_init();
+uint32 irt_hw_get_num_threads_per_core();
+uint32 irt_hw_get_num_cores_per_socket();
+uint32 irt_hw_get_num_sockets();
+uint32 irt_hw_get_num_numa_nodes();
+uint32 irt_hw_get_sibling_hyperthread(uint32 coreid);
+uint32 irt_hw_get_cpu_max_mhz();
+uint32 irt_hw_get_cpu_min_mhz();
+bool irt_hw_get_hyperthreading_enabled();
+irt_hw_cpuid_info irt_hw_get_cpuid_info();
+char* irt_hw_get_vendor_string();
+char* irt_hw_get_model_string();
+void irt_hw_dump_info(FILE* fd);
+void irt_hw_print_info();
+
+#ifndef IRT_DECLARATIONS_ONLY
+
 static irt_hw_info __irt_g_cached_hw_info;
 
 // static uint32 __irt_g_cached_cpu_count = 0;
@@ -279,5 +299,6 @@ void irt_hw_print_info() {
 	irt_hw_dump_info(stdout);
 }
 
+#endif // ifndef IRT_DECLARATIONS_ONLY
 
 #endif // ifndef __GUARD_HWINFO_H
@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_IMPL_CHANNELS_IMPL_H
+#define __GUARD_IMPL_CHANNELS_IMPL_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "declarations.h"
+#include "channels.h"
+#include "abstraction/atomic.h"
+#include "abstraction/impl/spin_locks.impl.h"
+#include "abstraction/impl/threads.impl.h"
+#include "impl/irt_scheduling.impl.h"
+#include "impl/worker.impl.h"
+
+/* ------------------------------ slots ----- */
+
+static inline unsigned char* _irt_channel_slot(irt_channel* channel, uint64 pos) {
+	return channel->slots + (pos & channel->mask) * channel->slot_size;
+}
+
+static inline volatile uint64* _irt_channel_seq(unsigned char* slot) {
+	return (volatile uint64*)slot;
+}
+
+static inline unsigned char* _irt_channel_data(unsigned char* slot) {
+	return slot + sizeof(uint64);
+}
+
+/* ------------------------------ suspension ----- */
+
+// continues all work items waiting in the given list
+static inline void _irt_channel_wake(irt_channel* channel, irt_channel_waiter** list, volatile uint32* num_waiting) {
+	irt_spin_lock(&channel->wait_lock);
+	irt_channel_waiter* waiter = *list;
+	*list = NULL;
+	for(irt_channel_waiter* cur = waiter; cur != NULL; cur = cur->next) {
+		irt_atomic_dec(num_waiting, uint32);
+	}
+	irt_spin_unlock(&channel->wait_lock);
+	while(waiter) {
+		// the waiter record lives on the stack of the suspended work item, it must not be accessed once it is continued
+		irt_channel_waiter* next = waiter->next;
+		irt_worker* target = waiter->worker;
+		irt_work_item* wi = waiter->wi;
+		irt_inst_insert_wi_event(irt_worker_get_current(), IRT_INST_WORK_ITEM_RESUMED_IO, wi->id);
+		irt_scheduling_continue_wi(target, wi);
+		irt_signal_worker(target);
+		waiter = next;
+	}
+}
+
+// waits for a peer to make progress, the given round determines whether to spin, yield or suspend
+static inline void _irt_channel_wait(irt_channel* channel, uint32 round, bool sending) {
+	if(round < IRT_CHANNEL_SPIN_ROUNDS) {
+		irt_thread_relax();
+		return;
+	}
+	irt_worker* self = irt_worker_get_current();
+	if(self == NULL) {
+		// not within a work item, there is nothing to suspend
+		irt_thread_yield();
+		return;
+	}
+	irt_work_item* swi = self->cur_wi;
+	if(round < IRT_CHANNEL_SPIN_ROUNDS + IRT_CHANNEL_YIELD_ROUNDS) {
+		irt_scheduling_yield(self, swi);
+		return;
+	}
+
+	irt_channel_waiter** list = sending ? &channel->waiting_senders : &channel->waiting_receivers;
+	volatile uint32* num_waiting = sending ? &channel->num_waiting_senders : &channel->num_waiting_receivers;
+
+	irt_spin_lock(&channel->wait_lock);
+	// any peer making progress after the counter got incremented is going to wake us up
+	irt_atomic_inc(num_waiting, uint32);
+	if(sending ? !irt_channel_full(channel) : !irt_channel_empty(channel)) {
+		irt_atomic_dec(num_waiting, uint32);
+		irt_spin_unlock(&channel->wait_lock);
+		return;
+	}
+	irt_channel_waiter waiter = {swi, self, *list};
+	*list = &waiter;
+	irt_spin_unlock(&channel->wait_lock);
+	irt_inst_insert_wi_event(self, IRT_INST_WORK_ITEM_SUSPENDED_IO, swi->id);
+	_irt_worker_switch_from_wi(self, swi);
+}
+
+/* ------------------------------ operations ----- */
+
+static inline irt_channel* _irt_channel_create(uint32 elem_size, uint32 capacity, bool single_producer, bool single_consumer) {
+	irt_channel* channel = (irt_channel*)calloc(1, sizeof(irt_channel));
+	channel->id = irt_generate_channel_id(IRT_LOOKUP_GENERATOR_ID_PTR);
+	channel->id.cached = channel;
+	uint64 size = 1;
+	while(size < capacity) {
+		size <<= 1;
+	}
+	channel->elem_size = elem_size;
+	channel->slot_size = sizeof(uint64) + ((elem_size + sizeof(uint64) - 1) / sizeof(uint64)) * sizeof(uint64);
+	channel->mask = size - 1;
+	channel->single_producer = single_producer;
+	channel->single_consumer = single_consumer;
+	channel->slots = (unsigned char*)malloc(size * channel->slot_size);
+	// initially, slot i can be written at position i
+	for(uint64 i = 0; i < size; ++i) {
+		*_irt_channel_seq(_irt_channel_slot(channel, i)) = i;
+	}
+	irt_spin_init(&channel->wait_lock);
+	return channel;
+}
+
+irt_channel* irt_channel_create(uint32 elem_size, uint32 capacity) {
+	return _irt_channel_create(elem_size, capacity, false, false);
+}
+
+irt_channel* irt_channel_create_spsc(uint32 elem_size, uint32 capacity) {
+	return _irt_channel_create(elem_size, capacity, true, true);
+}
+
+void irt_channel_destroy(irt_channel* channel) {
+	irt_spin_destroy(&channel->wait_lock);
+	free(channel->slots);
+	free(channel);
+}
+
+// claims up to num consecutive positions starting at the current one whose slots are in the state expected at position+offset,
+// returns the number of claimed positions and stores the first of them in claimed
+static inline uint32 _irt_channel_claim(irt_channel* channel, volatile uint64* position, uint64 offset, bool single, uint32 num, uint64* claimed) {
+	uint64 pos = irt_atomic_load(position);
+	while(true) {
+		uint32 count = 0;
+		while(count < num && count <= channel->mask && irt_atomic_load(_irt_channel_seq(_irt_channel_slot(channel, pos + count))) == pos + count + offset) {
+			count++;
+		}
+		if(count == 0) {
+			// either the buffer is full / empty, or the position has been claimed by a peer in the meantime
+			int64 diff = (int64)irt_atomic_load(_irt_channel_seq(_irt_channel_slot(channel, pos))) - (int64)(pos + offset);
+			if(diff < 0) { return 0; }
+			pos = irt_atomic_load(position);
+			continue;
+		}
+		if(single) {
+			irt_atomic_store(position, pos + count);
+		} else if(!irt_atomic_bool_compare_and_swap(position, pos, pos + count, uint64)) {
+			pos = irt_atomic_load(position);
+			continue;
+		}
+		*claimed = pos;
+		return count;
+	}
+}
+
+uint32 irt_channel_try_send_batch(irt_channel* channel, const void* elems, uint32 num) {
+	uint64 pos;
+	uint32 count = _irt_channel_claim(channel, &channel->send_pos, 0, channel->single_producer, num, &pos);
+	for(uint32 i = 0; i < count; ++i) {
+		unsigned char* slot = _irt_channel_slot(channel, pos + i);
+		memcpy(_irt_channel_data(slot), (const unsigned char*)elems + i * channel->elem_size, channel->elem_size);
+		irt_atomic_store(_irt_channel_seq(slot), pos + i + 1);
+	}
+	if(count > 0 && irt_atomic_load(&channel->num_waiting_receivers) > 0) {
+		_irt_channel_wake(channel, &channel->waiting_receivers, &channel->num_waiting_receivers);
+	}
+	return count;
+}
+
+uint32 irt_channel_try_recv_batch(irt_channel* channel, void* elems, uint32 num) {
+	uint64 pos;
+	uint32 count = _irt_channel_claim(channel, &channel->recv_pos, 1, channel->single_consumer, num, &pos);
+	for(uint32 i = 0; i < count; ++i) {
+		unsigned char* slot = _irt_channel_slot(channel, pos + i);
+		memcpy((unsigned char*)elems + i * channel->elem_size, _irt_channel_data(slot), channel->elem_size);
+		// the slot can be written again once the senders wrapped around
+		irt_atomic_store(_irt_channel_seq(slot), pos + i + channel->mask + 1);
+	}
+	if(count > 0 && irt_atomic_load(&channel->num_waiting_senders) > 0) {
+		_irt_channel_wake(channel, &channel->waiting_senders, &channel->num_waiting_senders);
+	}
+	return count;
+}
+
+bool irt_channel_try_send(irt_channel* channel, const void* elem) {
+	return irt_channel_try_send_batch(channel, elem, 1) == 1;
+}
+
+bool irt_channel_try_recv(irt_channel* channel, void* elem) {
+	return irt_channel_try_recv_batch(channel, elem, 1) == 1;
+}
+
+void irt_channel_send_batch(irt_channel* channel, const void* elems, uint32 num) {
+	const unsigned char* cur = (const unsigned char*)elems;
+	uint32 round = 0;
+	while(num > 0) {
+		uint32 sent = irt_channel_try_send_batch(channel, cur, num);
+		cur += sent * channel->elem_size;
+		num -= sent;
+		if(sent > 0) {
+			round = 0;
+		} else {
+			_irt_channel_wait(channel, round++, true);
+		}
+	}
+}
+
+void irt_channel_recv_batch(irt_channel* channel, void* elems, uint32 num) {
+	unsigned char* cur = (unsigned char*)elems;
+	uint32 round = 0;
+	while(num > 0) {
+		uint32 received = irt_channel_try_recv_batch(channel, cur, num);
+		cur += received * channel->elem_size;
+		num -= received;
+		if(received > 0) {
+			round = 0;
+		} else {
+			_irt_channel_wait(channel, round++, false);
+		}
+	}
+}
+
+void irt_channel_send(irt_channel* channel, const void* elem) {
+	irt_channel_send_batch(channel, elem, 1);
+}
+
+void irt_channel_recv(irt_channel* channel, void* elem) {
+	irt_channel_recv_batch(channel, elem, 1);
+}
+
+bool irt_channel_empty(irt_channel* channel) {
+	uint64 pos = irt_atomic_load(&channel->recv_pos);
+	return irt_atomic_load(_irt_channel_seq(_irt_channel_slot(channel, pos))) < pos + 1;
+}
+
+bool irt_channel_full(irt_channel* channel) {
+	uint64 pos = irt_atomic_load(&channel->send_pos);
+	return irt_atomic_load(_irt_channel_seq(_irt_channel_slot(channel, pos))) < pos;
+}
+
+#endif // ifndef __GUARD_IMPL_CHANNELS_IMPL_H
@@ -46,6 +46,13 @@
 #include <errno.h>
 #include "utils/timing.h"
 #include "instrumentation_events.h"
+#if defined(IRT_ENABLE_INSTRUMENTATION) && defined(IRT_INST_EVENT_STREAMING_SUPPORTED)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "irt_maintenance.h"
+#include "utils/event_stream.h"
+#endif
 #include "impl/error_handling.impl.h"
 
 #ifdef IRT_ENABLE_INSTRUMENTATION
@@ -73,34 +80,218 @@ void _irt_inst_event_data_table_resize(irt_instrumentation_event_data_table* tab
 // allocates memory for performance data, sets all fields
 irt_instrumentation_event_data_table* irt_inst_create_event_data_table() {
 	irt_instrumentation_event_data_table* table = (irt_instrumentation_event_data_table*)malloc(sizeof(irt_instrumentation_event_data_table));
-	table->size = IRT_INST_WORKER_PD_BLOCKSIZE * 2;
+	// streamed tables are fixed-size ring buffers, drained while running
+	table->size = irt_g_instrumentation_event_output_is_streamed ? IRT_INST_EVENT_RING_BUFFER_SIZE : IRT_INST_WORKER_PD_BLOCKSIZE * 2;
 	table->number_of_elements = 0;
 	table->data = (irt_instrumentation_event_data*)malloc(sizeof(irt_instrumentation_event_data) * table->size);
+	table->stream = NULL;
 	return table;
 }
 
 // frees allocated memory
 void irt_inst_destroy_event_data_table(irt_instrumentation_event_data_table* table) {
 	if(table != NULL) {
+		if(table->stream != NULL) { irt_inst_event_stream_close(table); }
 		if(table->data != NULL) { free(table->data); }
 		free(table);
 	}
 }
 
-void _irt_inst_event_insert_time(irt_worker* worker, const int event, const uint64 id, const uint64 time) {
+// returns the directory instrumentation output is written to, creating it if necessary
+const char* _irt_inst_get_output_path() {
+	const char* outputprefix = ".";
+	if(getenv(IRT_INST_OUTPUT_PATH_ENV)) { outputprefix = getenv(IRT_INST_OUTPUT_PATH_ENV); }
+
+	#ifndef _GEMS_SIM
+	struct stat st;
+	int stat_retval = stat(outputprefix, &st);
+	if(stat_retval != 0) { mkdir(outputprefix, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH); }
+
+	IRT_ASSERT(stat(outputprefix, &st) == 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Error creating directory for performance log writing: %s",
+	           strerror(errno));
+	#endif
+	return outputprefix;
+}
+
+// =============== functions for streaming event data while running ===============
+
+#ifdef IRT_INST_EVENT_STREAMING_SUPPORTED
+
+// streams currently open, indexed by worker thread id, guarded by irt_g_inst_event_streams_lock
+irt_instrumentation_event_data_table* irt_g_inst_event_streams[IRT_MAX_WORKERS];
+irt_spinlock irt_g_inst_event_streams_lock;
+uint32 irt_g_inst_event_streams_open = 0;
+bool irt_g_inst_event_stream_flusher_registered = false;
+irt_maintenance_lambda irt_g_inst_event_stream_flusher;
+
+// resets the stream registry, needs to be called before any worker opens its stream
+void _irt_inst_event_stream_init() {
+	irt_spin_init(&irt_g_inst_event_streams_lock);
+	memset(irt_g_inst_event_streams, 0, sizeof(irt_g_inst_event_streams));
+	irt_g_inst_event_streams_open = 0;
+	irt_g_inst_event_stream_flusher_registered = false;
+}
+
+// maps (a larger part of) the stream file such that at least size more bytes can be written
+void _irt_inst_event_stream_reserve(irt_inst_event_stream* stream, uint64 size) {
+	if(stream->offset + size <= stream->map_size) { return; }
+
+	uint64 new_size = stream->map_size;
+	while(stream->offset + size > new_size) {
+		new_size += IRT_INST_EVENT_STREAM_CHUNK_SIZE;
+	}
+	if(stream->map != NULL) { munmap(stream->map, stream->map_size); }
+	IRT_ASSERT(ftruncate(stream->fd, new_size) == 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Unable to grow event stream file: %s", strerror(errno));
+	stream->map = (char*)mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, stream->fd, 0);
+	IRT_ASSERT(stream->map != MAP_FAILED, IRT_ERR_INSTRUMENTATION, "Instrumentation: Unable to map event stream file: %s", strerror(errno));
+	stream->map_size = new_size;
+}
+
+// maintenance event draining all open streams, unregisters itself once no stream is left
+uint64 _irt_inst_event_stream_flusher_func(void* data) {
+	irt_spin_lock(&irt_g_inst_event_streams_lock);
+	if(irt_g_inst_event_streams_open == 0) {
+		irt_g_inst_event_stream_flusher_registered = false;
+		irt_spin_unlock(&irt_g_inst_event_streams_lock);
+		return 0;
+	}
+	for(uint32 i = 0; i < IRT_MAX_WORKERS && i < irt_g_worker_count; ++i) {
+		if(irt_g_inst_event_streams[i] != NULL) { irt_inst_event_stream_flush(irt_g_inst_event_streams[i]); }
+	}
+	irt_spin_unlock(&irt_g_inst_event_streams_lock);
+	return IRT_INST_EVENT_STREAM_FLUSH_INTERVAL;
+}
+
+void irt_inst_event_stream_open(irt_worker* worker) {
 	irt_instrumentation_event_data_table* table = worker->instrumentation_event_data;
+	IRT_ASSERT(table != NULL && table->stream == NULL, IRT_ERR_INSTRUMENTATION, "Instrumentation: Worker has no event data or already streams it")
+	IRT_ASSERT((table->size & (table->size - 1)) == 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Event ring buffer size must be a power of two")
+
+	char outputfilename[IRT_INST_OUTPUT_PATH_CHAR_SIZE];
+	sprintf(outputfilename, "%s/worker_event_stream.%04u", _irt_inst_get_output_path(), worker->id.thread);
+
+	irt_inst_event_stream* stream = (irt_inst_event_stream*)calloc(1, sizeof(irt_inst_event_stream));
+	irt_spin_init(&stream->lock);
+	stream->worker = worker->id.thread;
+	stream->fd = open(outputfilename, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	IRT_ASSERT(stream->fd >= 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Unable to open file for event stream writing: %s", strerror(errno));
+
+	// write header and event name table, the counters are updated on every flush
+	irt_inst_event_stream_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, IRT_INST_EVENT_STREAM_MAGIC, sizeof(header.magic));
+	header.num_event_types = irt_g_inst_num_event_types;
+	header.worker = stream->worker;
+	_irt_inst_event_stream_reserve(stream, irt_inst_event_stream_payload_offset(&header));
+	memcpy(stream->map, &header, sizeof(header));
+	char* names = stream->map + sizeof(header);
+	for(uint i = 0; i < irt_g_inst_num_event_types; ++i) {
+		char entry[IRT_INST_EVENT_STREAM_NAME_SIZE + 1];
+		snprintf(entry, sizeof(entry), "%-4.4s%-60.60s", irt_g_instrumentation_group_names[i], irt_g_instrumentation_event_names[i]);
+		memcpy(names + i * IRT_INST_EVENT_STREAM_NAME_SIZE, entry, IRT_INST_EVENT_STREAM_NAME_SIZE);
+	}
+	stream->offset = irt_inst_event_stream_payload_offset(&header);
+	table->stream = stream;
+
+	// register stream, start the flusher if it is not running yet
+	irt_spin_lock(&irt_g_inst_event_streams_lock);
+	irt_g_inst_event_streams[stream->worker] = table;
+	irt_g_inst_event_streams_open++;
+	bool register_flusher = !irt_g_inst_event_stream_flusher_registered;
+	irt_g_inst_event_stream_flusher_registered = true;
+	irt_spin_unlock(&irt_g_inst_event_streams_lock);
+
+	// the maintenance thread holds its slot lock while calling the flusher, so we may not hold the streams lock here
+	if(register_flusher) {
+		irt_g_inst_event_stream_flusher.func = &_irt_inst_event_stream_flusher_func;
+		irt_g_inst_event_stream_flusher.data = NULL;
+		irt_g_inst_event_stream_flusher.interval = IRT_INST_EVENT_STREAM_FLUSH_INTERVAL;
+		irt_maintenance_register(&irt_g_inst_event_stream_flusher);
+	}
+}
+
+// encodes all events between tail and head, may be called concurrently with the owning worker recording new events
+void irt_inst_event_stream_flush(irt_instrumentation_event_data_table* table) {
+	irt_inst_event_stream* stream = table->stream;
+	irt_spin_lock(&stream->lock);
+	uint64 head = irt_atomic_load(&stream->head);
+	uint64 tail = stream->tail;
+	if(head != tail) {
+		_irt_inst_event_stream_reserve(stream, (head - tail) * IRT_INST_EVENT_STREAM_MAX_RECORD_SIZE);
+		char* out = stream->map + stream->offset;
+		for(; tail != head; ++tail) {
+			irt_instrumentation_event_data* ev = &table->data[tail & (table->size - 1)];
+			irt_inst_event_stream_record record = {ev->timestamp, ev->event_id, ev->thread, ev->index};
+			out = irt_inst_event_stream_encode(out, &record, stream->last_timestamp);
+			stream->last_timestamp = ev->timestamp;
+		}
+		stream->offset = out - stream->map;
+
+		irt_inst_event_stream_header* header = (irt_inst_event_stream_header*)stream->map;
+		header->number_of_events = head;
+		header->payload_size = stream->offset - irt_inst_event_stream_payload_offset(header);
+		irt_atomic_store(&stream->tail, head);
+	}
+	irt_spin_unlock(&stream->lock);
+}
+
+void irt_inst_event_stream_close(irt_instrumentation_event_data_table* table) {
+	irt_inst_event_stream* stream = table->stream;
+
+	irt_spin_lock(&irt_g_inst_event_streams_lock);
+	irt_g_inst_event_streams[stream->worker] = NULL;
+	irt_g_inst_event_streams_open--;
+	irt_spin_unlock(&irt_g_inst_event_streams_lock);
+
+	irt_inst_event_stream_flush(table);
+	((irt_inst_event_stream_header*)stream->map)->ticks_per_sec = irt_g_time_ticks_per_sec;
+	munmap(stream->map, stream->map_size);
+	IRT_ASSERT(ftruncate(stream->fd, stream->offset) == 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Unable to truncate event stream file: %s",
+	           strerror(errno));
+	close(stream->fd);
+	irt_spin_destroy(&stream->lock);
+	free(stream);
+	table->stream = NULL;
+}
 
-	IRT_ASSERT(table->number_of_elements <= table->size, IRT_ERR_INSTRUMENTATION, "Instrumentation: Number of event table entries larger than table size")
+#else // if not IRT_INST_EVENT_STREAMING_SUPPORTED
 
-	if(table->number_of_elements >= table->size) { _irt_inst_event_data_table_resize(table); }
+void irt_inst_event_stream_open(irt_worker* worker) {}
+void irt_inst_event_stream_flush(irt_instrumentation_event_data_table* table) {}
+void irt_inst_event_stream_close(irt_instrumentation_event_data_table* table) {}
 
-	irt_instrumentation_event_data* pd = &(table->data[table->number_of_elements]);
+#endif // IRT_INST_EVENT_STREAMING_SUPPORTED
+
+void _irt_inst_event_insert_time(irt_worker* worker, const int event, const uint64 id, const uint64 time) {
+	irt_instrumentation_event_data_table* table = worker->instrumentation_event_data;
+	irt_inst_event_stream* stream = table->stream;
+	irt_instrumentation_event_data* pd;
+
+	if(stream) {
+		// single producer: only the flusher moves the tail, if it fell behind we drain the ring buffer ourselves
+		uint64 head = stream->head;
+		if(head - irt_atomic_load(&stream->tail) >= table->size) { irt_inst_event_stream_flush(table); }
+		pd = &(table->data[head & (table->size - 1)]);
+	} else {
+		IRT_ASSERT(table->number_of_elements <= table->size, IRT_ERR_INSTRUMENTATION,
+		           "Instrumentation: Number of event table entries larger than table size")
+
+		if(table->number_of_elements >= table->size) { _irt_inst_event_data_table_resize(table); }
+
+		pd = &(table->data[table->number_of_elements]);
+	}
 
 	pd->timestamp = time;
 	pd->event_id = event;
 	pd->index = ((irt_work_item_id*)&id)->index;
 	pd->thread = ((irt_work_item_id*)&id)->thread;
-	++table->number_of_elements;
+
+	if(stream) {
+		// publish the entry only after it has been written completely
+		irt_atomic_store(&stream->head, stream->head + 1);
+	} else {
+		++table->number_of_elements;
+	}
 }
 
 
@@ -163,20 +354,17 @@ void irt_inst_event_data_output_all(bool binary_format) {
 
 // writes csv files
 void irt_inst_event_data_output(irt_worker* worker, bool binary_format) {
+	// streamed event logs have already been written while running
+	if(worker->instrumentation_event_data != NULL && worker->instrumentation_event_data->stream != NULL) {
+		irt_inst_event_stream_close(worker->instrumentation_event_data);
+		return;
+	}
+
 	FILE* outputfile = stdout;
 	char outputfilename[IRT_INST_OUTPUT_PATH_CHAR_SIZE];
-	char defaultoutput[] = ".";
-	char* outputprefix = defaultoutput;
-	if(getenv(IRT_INST_OUTPUT_PATH_ENV)) { outputprefix = getenv(IRT_INST_OUTPUT_PATH_ENV); }
+	const char* outputprefix = _irt_inst_get_output_path();
 
 	#ifndef _GEMS_SIM
-	struct stat st;
-	int stat_retval = stat(outputprefix, &st);
-	if(stat_retval != 0) { mkdir(outputprefix, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH); }
-
-	IRT_ASSERT(stat(outputprefix, &st) == 0, IRT_ERR_INSTRUMENTATION, "Instrumentation: Error creating directory for performance log writing: %s",
-	           strerror(errno));
-
 	sprintf(outputfilename, "%s/worker_event_log.%04u", outputprefix, worker->id.thread);
 
 	outputfile = fopen(outputfilename, "w");
@@ -388,6 +576,18 @@ void irt_inst_set_all_instrumentation_from_env() {
 	if(getenv(IRT_INST_WORKER_EVENT_LOGGING_ENV) && strcmp(getenv(IRT_INST_WORKER_EVENT_LOGGING_ENV), "enabled") == 0) {
 		irt_log_setting_s(IRT_INST_WORKER_EVENT_LOGGING_ENV, "enabled");
 
+		// set whether event logs are streamed to disk while running
+		#ifdef IRT_INST_EVENT_STREAMING_SUPPORTED
+		if(getenv(IRT_INST_EVENT_STREAMING_ENV) && (strcmp(getenv(IRT_INST_EVENT_STREAMING_ENV), "enabled") == 0)) {
+			irt_g_instrumentation_event_output_is_streamed = true;
+			_irt_inst_event_stream_init();
+			irt_log_setting_s(IRT_INST_EVENT_STREAMING_ENV, "enabled");
+		} else {
+			irt_g_instrumentation_event_output_is_streamed = false;
+			irt_log_setting_s(IRT_INST_EVENT_STREAMING_ENV, "disabled");
+		}
+		#endif
+
 		// set whether binary format is enabled
 		if(getenv(IRT_INST_BINARY_OUTPUT_ENV) && (strcmp(getenv(IRT_INST_BINARY_OUTPUT_ENV), "enabled") == 0)) {
 			irt_g_instrumentation_event_output_is_binary = true;
@@ -441,6 +641,7 @@ void irt_inst_set_all_instrumentation_from_env() {
 		return;
 	}
 	irt_inst_set_all_instrumentation(false);
+	irt_g_instrumentation_event_output_is_streamed = false;
 	irt_log_setting_s(IRT_INST_WORKER_EVENT_LOGGING_ENV, "disabled");
 }
 
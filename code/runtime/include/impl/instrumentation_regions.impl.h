@@ -47,6 +47,13 @@
 #include <sys/stat.h>
 #endif
 #include <errno.h>
+#ifdef IRT_INST_REGION_SAMPLING_SUPPORTED
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
 
 #include "utils/timing.h"
 #include "abstraction/measurements.h"
@@ -69,11 +76,17 @@ void _irt_inst_region_stack_push(irt_work_item* wi, irt_inst_region_context_data
 	IRT_ASSERT(list->length <= list->size, IRT_ERR_INSTRUMENTATION, "WI region stack overflow, size %lu length %lu", list->size, list->length)
 
 	if(list->length == list->size) {
+		// no realloc, a sampling signal must never observe a freed stack
+		irt_inst_region_context_data** old_items = list->items;
+		irt_inst_region_context_data** new_items = (irt_inst_region_context_data**)malloc(2 * list->size * sizeof(irt_inst_region_context_data*));
+		memcpy(new_items, old_items, list->length * sizeof(irt_inst_region_context_data*));
+		irt_atomic_store(&list->items, new_items);
 		list->size *= 2;
-		list->items = (irt_inst_region_context_data**)realloc(list->items, list->size * sizeof(irt_inst_region_context_data*));
+		free(old_items);
 	}
 
-	list->items[list->length++] = region;
+	list->items[list->length] = region;
+	irt_atomic_store(&list->length, list->length + 1);
 }
 
 irt_inst_region_context_data* _irt_inst_region_stack_pop(irt_work_item* wi) {
@@ -294,12 +307,24 @@ void irt_inst_region_init(irt_context* context) {
 
 void irt_inst_region_init_worker(irt_worker* worker) {
 	_irt_inst_region_metrics_init_worker(worker);
+	if(irt_g_inst_region_sampling) { irt_inst_region_sampling_start_worker(worker); }
 }
 
 void irt_inst_region_finalize(irt_context* context) {
 	_irt_inst_region_metrics_finalize(context);
 	irt_time_ticks_per_sec_calibration_mark(); // needs to be done before any time instrumentation processing!
-	irt_inst_region_output();
+	if(irt_g_inst_region_sampling) {
+		irt_inst_region_sampling_stop();
+		irt_inst_region_sampling_collect(context);
+		irt_g_inst_region_sampling = false;
+		irt_inst_region_output();
+		for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+			free((void*)irt_g_inst_region_samplers[i].samples);
+			irt_g_inst_region_samplers[i].samples = NULL;
+		}
+	} else {
+		irt_inst_region_output();
+	}
 	// irt_inst_region_debug_output();
 	for(uint32 i = 0; i < context->num_regions; ++i) {
 		irt_spin_destroy(&context->inst_region_data[i].lock);
@@ -312,6 +337,7 @@ void irt_inst_region_finalize_worker(irt_worker* worker) {
 }
 
 void irt_inst_region_propagate_data_from_wi_to_regions(irt_work_item* wi) {
+	if(irt_g_inst_region_sampling) { return; }
 	irt_inst_region_list* list = wi->inst_region_list;
 
 	for(uint64 i = 0; i < list->length; ++i) {
@@ -344,7 +370,7 @@ void irt_inst_region_propagate_data_from_wi_to_regions(irt_work_item* wi) {
 }
 
 void irt_inst_region_start_measurements(irt_work_item* wi) {
-	if(wi->inst_region_list->length <= 0) { return; }
+	if(irt_g_inst_region_sampling || wi->inst_region_list->length <= 0) { return; }
 
 	irt_context* context = irt_context_table_lookup(wi->context_id);
 	#pragma GCC diagnostic push
@@ -372,7 +398,7 @@ void irt_inst_region_start_measurements(irt_work_item* wi) {
 #pragma GCC diagnostic pop // needs to be done after ending the function scope
 
 void irt_inst_region_end_measurements(irt_work_item* wi) {
-	if(wi->inst_region_list->length <= 0) { return; }
+	if(irt_g_inst_region_sampling || wi->inst_region_list->length <= 0) { return; }
 
 	irt_context* context = irt_context_table_lookup(wi->context_id);
 
@@ -409,6 +435,12 @@ void irt_inst_region_start(const irt_inst_region_id id) {
 	           IRT_INST_REGION_INSTRUMENTATION_RING_BUFFER_SIZE)
 	irt_inst_region_context_data* inner_region = &(context->inst_region_data[id]);
 
+	if(irt_g_inst_region_sampling) {
+		// samples are attributed by the sampler, only the region stack needs to be maintained
+		_irt_inst_region_stack_push(wi, inner_region);
+		return;
+	}
+
 	if(outer_region) {
 		IRT_ASSERT(outer_region != inner_region, IRT_ERR_INSTRUMENTATION, "Region %u start encountered, but this region was already started", id)
 		irt_inst_region_end_measurements(wi);
@@ -450,6 +482,12 @@ void irt_inst_region_end(const irt_inst_region_id id) {
 	IRT_ASSERT(inner_region, IRT_ERR_INSTRUMENTATION, "Region end occurred while no region was started")
 	IRT_ASSERT(inner_region->id == id, IRT_ERR_INSTRUMENTATION, "Region end id %lu did not match currently open region id %lu", id, inner_region->id)
 
+	if(irt_g_inst_region_sampling) {
+		if(wi->num_groups == 0 || wi->wg_memberships[0].num == 0) { irt_atomic_inc(&inner_region->num_executions, uint64); }
+		_irt_inst_region_stack_pop(wi);
+		return;
+	}
+
 	irt_inst_region_end_measurements(wi);
 	irt_inst_region_propagate_data_from_wi_to_regions(wi);
 
@@ -484,6 +522,125 @@ void irt_inst_region_end(const irt_inst_region_id id) {
 	if(outer_region) { irt_inst_region_start_measurements(wi); }
 }
 
+// -------------------------------------------------------------------------------------------------------------------- sampling
+
+#ifdef IRT_INST_REGION_SAMPLING_SUPPORTED
+
+void _irt_inst_region_sampling_handler(int sig) {
+	if(!irt_g_inst_region_sampling) { return; }
+	int saved_errno = errno;
+	irt_worker* self = irt_worker_get_current();
+	irt_inst_region_sampler* sampler = self ? &irt_g_inst_region_samplers[self->id.thread] : NULL;
+	if(sampler && sampler->samples && sampler->armed) {
+		// cpu time timers are only checked on scheduler ticks, expirations in between are reported as overruns
+		int overrun = timer_getoverrun(sampler->timer);
+		uint64 weight = 1 + (overrun > 0 ? overrun : 0);
+		irt_work_item* wi = self->cur_wi;
+		irt_inst_region_list* list = wi ? wi->inst_region_list : NULL;
+		uint64 length = list ? list->length : 0;
+		if(length == 0) {
+			sampler->unattributed += weight;
+		} else {
+			irt_inst_region_context_data** items = list->items;
+			for(uint64 i = 0; i < length; ++i) {
+				if(!items[i]) { continue; }
+				// regions entered recursively are only counted once
+				bool seen = false;
+				for(uint64 j = 0; j < i && !seen; ++j) {
+					seen = items[j] == items[i];
+				}
+				if(!seen) { sampler->samples[items[i]->id] += weight; }
+			}
+		}
+	}
+	errno = saved_errno;
+}
+
+bool _irt_inst_region_sampling_enable() {
+	uint64 interval = IRT_INST_REGION_SAMPLING_DEFAULT_INTERVAL;
+	if(getenv(IRT_INST_REGION_SAMPLING_INTERVAL_ENV)) { interval = strtoull(getenv(IRT_INST_REGION_SAMPLING_INTERVAL_ENV), NULL, 10); }
+	if(interval == 0) { interval = IRT_INST_REGION_SAMPLING_DEFAULT_INTERVAL; }
+
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &_irt_inst_region_sampling_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if(sigaction(SIGPROF, &action, NULL) != 0) {
+		IRT_WARN("Instrumentation: Unable to install SIGPROF handler for region sampling: %s\n", strerror(errno));
+		return false;
+	}
+
+	memset(irt_g_inst_region_samplers, 0, sizeof(irt_g_inst_region_samplers));
+	irt_g_inst_region_sampling_interval = interval * 1000;
+	irt_g_inst_region_sampling = true;
+	return true;
+}
+
+void irt_inst_region_sampling_start_worker(irt_worker* worker) {
+	irt_context* context = irt_context_table_lookup(worker->cur_context);
+	irt_inst_region_sampler* sampler = &irt_g_inst_region_samplers[worker->id.thread];
+	sampler->samples = (volatile uint64*)calloc(context->num_regions, sizeof(uint64));
+	sampler->unattributed = 0;
+
+	// deliver the signal to this very worker, ticking in its cpu time
+	struct sigevent event;
+	memset(&event, 0, sizeof(event));
+	event.sigev_notify = SIGEV_THREAD_ID;
+	event.sigev_signo = SIGPROF;
+	event.sigev_notify_thread_id = syscall(SYS_gettid);
+	if(timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &sampler->timer) != 0) {
+		IRT_WARN("Instrumentation: Unable to create sampling timer for worker %u: %s\n", worker->id.thread, strerror(errno));
+		return;
+	}
+
+	struct itimerspec spec;
+	spec.it_interval.tv_sec = irt_g_inst_region_sampling_interval / 1000000000ull;
+	spec.it_interval.tv_nsec = irt_g_inst_region_sampling_interval % 1000000000ull;
+	spec.it_value = spec.it_interval;
+	timer_settime(sampler->timer, 0, &spec, NULL);
+	sampler->armed = true;
+}
+
+void irt_inst_region_sampling_stop() {
+	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+		if(irt_g_inst_region_samplers[i].armed) {
+			timer_delete(irt_g_inst_region_samplers[i].timer);
+			irt_g_inst_region_samplers[i].armed = false;
+		}
+	}
+}
+
+#else // if not IRT_INST_REGION_SAMPLING_SUPPORTED
+
+bool _irt_inst_region_sampling_enable() {
+	IRT_WARN("Instrumentation: Region sampling is not supported on this platform\n");
+	return false;
+}
+
+void irt_inst_region_sampling_start_worker(irt_worker* worker) {}
+void irt_inst_region_sampling_stop() {}
+
+#endif // IRT_INST_REGION_SAMPLING_SUPPORTED
+
+void irt_inst_region_sampling_collect(irt_context* context) {
+	// samples are assigned rather than added, collecting is idempotent
+	for(uint32 r = 0; r < context->num_regions; ++r) {
+		uint64 samples = 0;
+		for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+			if(irt_g_inst_region_samplers[i].samples) { samples += irt_g_inst_region_samplers[i].samples[r]; }
+		}
+		#if !defined(ISOLATE_METRIC) || defined(ISOLATE_CPU_TIME)
+		// stored in ticks like measured cpu time, converted to ns on output
+		context->inst_region_data[r].aggregated_cpu_time =
+		    (uint64)((double)samples * irt_g_inst_region_sampling_interval * irt_g_time_ticks_per_sec / 1e9);
+		#endif
+	}
+	#if !defined(ISOLATE_METRIC) || defined(ISOLATE_CPU_TIME)
+	irt_g_inst_region_metric_measure_cpu_time = true;
+	#endif
+}
+
 // selectively enable region instrumentation metrics - NOTE: a NULL pointer or an empty string as an argument will enable all metrics!
 void irt_inst_region_select_metrics(const char* selection) {
 	char enabled_types[4096];
@@ -539,7 +696,13 @@ void irt_inst_region_select_metrics_from_env() {
 		irt_g_inst_region_metric_measure_##_name__ = false;                                                                                                    \
 		irt_g_inst_region_metric_group_##_group__##membership_count = 0;
 	#include "irt_metrics.def"
-		irt_log_setting_s(IRT_INST_REGION_INSTRUMENTATION_ENV, "disabled");
+		if(getenv(IRT_INST_REGION_INSTRUMENTATION_ENV) && strcmp(getenv(IRT_INST_REGION_INSTRUMENTATION_ENV), "sampling") == 0
+		   && _irt_inst_region_sampling_enable()) {
+			irt_log_setting_s(IRT_INST_REGION_INSTRUMENTATION_ENV, "sampling");
+			irt_log_setting_u(IRT_INST_REGION_SAMPLING_INTERVAL_ENV, irt_g_inst_region_sampling_interval / 1000);
+		} else {
+			irt_log_setting_s(IRT_INST_REGION_INSTRUMENTATION_ENV, "disabled");
+		}
 	}
 	#endif
 }
@@ -669,6 +832,9 @@ void irt_inst_region_select_metrics(const char* selection) {}
 void irt_inst_region_select_metrics_from_env() {}
 void irt_inst_region_debug_output() {}
 void irt_inst_region_output() {}
+void irt_inst_region_sampling_start_worker(irt_worker* worker) {}
+void irt_inst_region_sampling_stop() {}
+void irt_inst_region_sampling_collect(irt_context* context) {}
 irt_inst_region_context_data* irt_inst_region_get_current(irt_work_item* wi) {
 	return NULL;
 }
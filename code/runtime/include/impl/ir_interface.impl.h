@@ -124,6 +124,7 @@ irt_joinable irt_parallel(const irt_parallel_job* job) {
 	// Note: this call and the call of irt_optimizer_set_wrapping_optimizations below maybe should be moved further down just before WI assignment
 	irt_optimizer_apply_dct(&job->impl->variants[0]);
 	#endif
+	irt_worker_request_lazy_startup();
 	irt_work_group* retwg = irt_wg_create();
 	irt_joinable ret;
 	ret.wg_id = retwg->id;
@@ -165,6 +166,7 @@ irt_joinable irt_task(const irt_parallel_job* job) {
 #ifdef IRT_ENABLE_APP_TIME_ACCOUNTING
 	irt_atomic_add_and_fetch(&irt_g_app_progress, 1, uint64);
 	#endif // IRT_ENABLE_APP_TIME_ACCOUNTING
+	irt_worker_request_lazy_startup();
 	irt_worker* target = irt_worker_get_current();
 	IRT_ASSERT(job->max == 1, IRT_ERR_INIT, "Task invalid range");
 	return irt_scheduling_optional(target, &irt_g_wi_range_one_elem, job->impl, job->args);
@@ -209,6 +211,8 @@ void irt_merge(irt_joinable joinable) {
 
 double irt_time_wis_get_total() {
 #ifdef IRT_ENABLE_APP_TIME_ACCOUNTING
+	// thread clocks are only available once all threads are running
+	irt_worker_await_lazy_startup();
 	double ret = 0.0;
 	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
 		irt_worker* cur = irt_g_workers[i];
@@ -241,6 +241,83 @@ static inline void irt_schedule_loop_guided_prepare(volatile irt_loop_sched_data
 }
 
 
+// candidate policies explored by the adaptive loop scheduling policy
+static const irt_loop_sched_policy_type irt_g_loop_sched_adaptive_arms[IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS] = {IRT_STATIC, IRT_DYNAMIC, IRT_GUIDED};
+
+// the adaptive selector is stored with the variant which executes the loop fragments
+static inline irt_loop_sched_selector* _irt_loop_sched_get_selector(irt_wi_implementation* impl) {
+	return &impl->variants[0].rt_data.loop_sched_selector;
+}
+
+// picks the candidate policy for the next execution of a loop: the least measured candidate while exploring,
+// the locked in one afterwards
+static inline int32 _irt_loop_sched_adaptive_pick(irt_loop_sched_selector* sel) {
+	int32 locked = sel->locked_arm;
+	if(locked > 0) { return locked - 1; }
+	int32 arm = 0;
+	for(int32 i = 1; i < IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS; ++i) {
+		if(sel->samples[i] < sel->samples[arm]) { arm = i; }
+	}
+	return arm;
+}
+
+// records the measured cost of one execution of a loop scheduled by the given candidate
+// locks in the cheapest candidate once every candidate has been measured often enough
+static inline void _irt_loop_sched_adaptive_record(irt_loop_sched_selector* sel, int32 arm, uint64 ticks, uint64 iterations) {
+	// measurements racing with an update are simply dropped, they would not change the outcome significantly
+	if(!irt_atomic_bool_compare_and_swap(&sel->updating, 0, 1, uint32)) { return; }
+	if(sel->locked_arm == 0) {
+		double cost = (double)ticks / (double)MAX(iterations, 1);
+		uint32 n = sel->samples[arm];
+		sel->cost[arm] = (sel->cost[arm] * n + cost) / (n + 1);
+		sel->samples[arm] = n + 1;
+
+		int32 best = 0;
+		bool done = true;
+		for(int32 i = 0; i < IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS; ++i) {
+			if(sel->samples[i] < IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS) { done = false; }
+			if(sel->cost[i] < sel->cost[best]) { best = i; }
+		}
+		if(done) {
+			IRT_DEBUG("Adaptive loop scheduling locked in policy %d", irt_g_loop_sched_adaptive_arms[best]);
+			sel->locked_arm = best + 1;
+		}
+	}
+	irt_atomic_store(&sel->updating, 0);
+}
+
+// replaces the group policy of a loop about to start by the policy bound to its implementation (if any),
+// then resolves IRT_ADAPTIVE to a candidate of the adaptive selector
+static inline void _irt_loop_sched_select_policy(irt_loop_sched_data* sched_data, irt_wi_implementation* impl) {
+	sched_data->adaptive_arm = -1;
+	irt_loop_sched_selector* sel = _irt_loop_sched_get_selector(impl);
+	if(sel->bound_policy) { sched_data->policy = *sel->bound_policy; }
+	if(sched_data->policy.type == IRT_ADAPTIVE) {
+		int32 arm = _irt_loop_sched_adaptive_pick(sel);
+		sched_data->policy.type = irt_g_loop_sched_adaptive_arms[arm];
+		sched_data->policy.param.chunk_size = 0;
+		// only measure while exploring, the choice is final afterwards
+		if(sel->locked_arm == 0) {
+			sched_data->adaptive_arm = arm;
+			sched_data->adaptive_participants_complete = 0;
+			sched_data->adaptive_start_time = irt_time_ticks();
+		}
+	}
+}
+
+// called by each participant after finishing its share of an adaptively scheduled loop
+// the last participant to finish reports the runtime of the whole loop
+// the ticks are measured here rather than taken from the region statistics, since region instrumentation is only
+// available if the runtime is compiled with IRT_ENABLE_REGION_INSTRUMENTATION, while adaptive scheduling is not
+static inline void _irt_loop_sched_adaptive_completed(irt_wi_implementation* impl, irt_work_item_range base_range, volatile irt_loop_sched_data* sched_data) {
+	uint64 end_time = irt_time_ticks();
+	if(irt_atomic_add_and_fetch(&sched_data->adaptive_participants_complete, 1, uint32) != sched_data->policy.participants) { return; }
+	uint64 range = base_range.end - base_range.begin;
+	uint64 numit = range / (base_range.step) + (range % base_range.step > 0);
+	_irt_loop_sched_adaptive_record(_irt_loop_sched_get_selector(impl), sched_data->adaptive_arm, end_time - sched_data->adaptive_start_time, numit);
+}
+
+
 void print_effort_estimation(irt_wi_implementation* impl, irt_work_item_range base_range, wi_effort_estimation_func* est_fn) {
 	static bool printed[10000];
 	if(impl->id < 0 || printed[impl->id]) { return; }
@@ -341,6 +418,7 @@ inline static void irt_schedule_loop(irt_work_item* self, irt_work_group* group,
 		irt_loop_sched_data* sched_data = &group->loop_sched_data[group->pfor_count % IRT_WG_RING_BUFFER_SIZE];
 
 		sched_data->policy = group->cur_sched;
+		_irt_loop_sched_select_policy(sched_data, impl);
 
 		sched_data->policy.participants = MIN(sched_data->policy.participants, group->local_member_count);
 
@@ -387,6 +465,9 @@ inline static void irt_schedule_loop(irt_work_item* self, irt_work_group* group,
 	default: IRT_ASSERT(false, IRT_ERR_INTERNAL, "Unknown scheduling policy");
 	}
 
+	// report to the adaptive selector if this loop is one of its measurements
+	if(sched_data->adaptive_arm >= 0) { _irt_loop_sched_adaptive_completed(impl, base_range, sched_data); }
+
 	// gather performance data if required & cleanup
 	#ifdef IRT_RUNTIME_TUNING
 	#ifdef IRT_RUNTIME_TUNING_EXTENDED
@@ -420,6 +501,17 @@ void irt_wg_set_loop_scheduling_policy(irt_work_group* group, const irt_loop_sch
 	group->cur_sched = *policy;
 }
 
+void irt_loop_sched_bind_policy(irt_wi_implementation* impl, const irt_loop_sched_policy* policy) {
+	_irt_loop_sched_get_selector(impl)->bound_policy = policy;
+}
+
+bool irt_loop_sched_get_adaptive_choice(irt_wi_implementation* impl, irt_loop_sched_policy_type* chosen) {
+	int32 locked = _irt_loop_sched_get_selector(impl)->locked_arm;
+	if(locked == 0) { return false; }
+	*chosen = irt_g_loop_sched_adaptive_arms[locked - 1];
+	return true;
+}
+
 void irt_loop_sched_policy_init() {
 	char* policy_env = getenv(IRT_LOOP_SCHED_POLICY_ENV);
 	if(policy_env) {
@@ -463,6 +555,10 @@ void irt_loop_sched_policy_init() {
 					irt_g_loop_sched_policy_default.participants = IRT_SANE_PARALLEL_MAX;
 					irt_g_loop_sched_policy_default.param.chunk_size = 0;
 				}
+			} else if(strcmp("IRT_ADAPTIVE", policy_str) == 0) {
+				irt_g_loop_sched_policy_default.type = IRT_ADAPTIVE;
+				irt_g_loop_sched_policy_default.participants = IRT_SANE_PARALLEL_MAX;
+				irt_g_loop_sched_policy_default.param.chunk_size = 0;
 			} else {
 				fprintf(stderr, "unknown loop scheduler policy requested: %s\n", policy_env_copy);
 				#ifdef _GEMS_SIM
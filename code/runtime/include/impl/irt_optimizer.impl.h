@@ -45,6 +45,8 @@
 
 #include "optimizers/opencl_optimizer.h"
 #include "optimizers/shared_mem_effort_estimate_external_load_optimizer.h"
+#include "optimizers/frequency_provider.h"
+#include "optimizers/pareto_optimizer.h"
 
 void irt_optimizer_objective_init(irt_context* context);
 void irt_optimizer_objective_destroy(irt_context* context);
@@ -114,7 +116,7 @@ int irt_g_dvfs_eval_count[128];
 #endif
 
 void get_available_freqs() {
-	if(!irt_cpu_freq_get_available_frequencies(irt_g_available_freqs, &irt_g_available_freq_count)) { return; }
+	if(!irt_g_optimizer_provider.get_available_frequencies(irt_g_optimizer_provider.state, irt_g_available_freqs, &irt_g_available_freq_count)) { return; }
 
 	// scaling_available_frequencies not available
 
@@ -130,6 +132,7 @@ void get_available_freqs() {
 
 
 void irt_optimizer_objective_init(irt_context* context) {
+	irt_optimizer_provider_select_from_env();
 	get_available_freqs();
 
 	for(int i = 0; i < context->impl_table_size; i++) {
@@ -147,17 +150,24 @@ void irt_optimizer_objective_init(irt_context* context) {
 			context->impl_table[i].variants[j].rt_data.optimizer_rt_data.cur.frequency = 1;                         // let's skip freq 0 (turbo boost (?));
 			context->impl_table[i].variants[j].rt_data.optimizer_rt_data.cur.thread_count = irt_g_worker_count - 1; // 0 based as the rest
 			memset(&(context->impl_table[i].variants[j].rt_data.optimizer_rt_data.cur_resources), 0, sizeof(irt_optimizer_resources));
+			#ifdef IRT_ENABLE_OMPP_OPTIMIZER_PARETO
+			context->impl_table[i].variants[j].rt_data.optimizer_rt_data.pareto_front =
+			    (irt_optimizer_pareto_front*)calloc(1, sizeof(irt_optimizer_pareto_front));
+			#endif
 		}
 	}
 }
 
 void irt_optimizer_objective_destroy(irt_context* context) {
 	// restore highest frequency
-	irt_cpu_freq_set_frequency_worker(NULL, irt_g_available_freqs[IRT_OPTIMIZER_RT_FREQ]);
+	irt_g_optimizer_provider.set_frequency_worker(irt_g_optimizer_provider.state, NULL, irt_g_available_freqs[IRT_OPTIMIZER_RT_FREQ]);
 
 	for(int i = 0; i < context->impl_table_size; i++)
 		for(int j = 0; j < context->impl_table[i].num_variants; j++) {
 			irt_spin_destroy(&context->impl_table[i].variants[j].rt_data.optimizer_rt_data.spinlock);
+			#ifdef IRT_ENABLE_OMPP_OPTIMIZER_PARETO
+			free(context->impl_table[i].variants[j].rt_data.optimizer_rt_data.pareto_front);
+			#endif
 		}
 }
 
@@ -331,6 +341,18 @@ void irt_optimizer_compute_optimizations(irt_wi_implementation_variant* variant,
 			#define ISOLATE_WALL_TIME
 			#include "irt_metrics.def"
 
+			// a simulated provider predicts the resources of the current setting instead of relying on measurements
+			if(irt_g_optimizer_provider.evaluate) {
+				irt_optimizer_provider_config config = {
+				    irt_g_available_freqs[MIN(variant->rt_data.optimizer_rt_data.cur.frequency, (uint64)irt_g_available_freq_count - 1)],
+				    (uint32)variant->rt_data.optimizer_rt_data.cur.thread_count + 1};
+				irt_optimizer_provider_measurement measurement;
+				if(irt_g_optimizer_provider.evaluate(irt_g_optimizer_provider.state, &config, &measurement)) {
+					cur_resources.cpu_energy = variant->rt_data.optimizer_rt_data.cur_resources.cpu_energy + measurement.energy;
+					cur_resources.wall_time = variant->rt_data.optimizer_rt_data.cur_resources.wall_time + (uint64)(measurement.time * 1e9);
+				}
+			}
+
 			variant->rt_data.optimizer_rt_data.cur_resources.cpu_energy =
 			    cur_resources.cpu_energy - variant->rt_data.optimizer_rt_data.cur_resources.cpu_energy;
 			variant->rt_data.optimizer_rt_data.cur_resources.wall_time = cur_resources.wall_time - variant->rt_data.optimizer_rt_data.cur_resources.wall_time;
@@ -390,6 +412,11 @@ void irt_optimizer_compute_optimizations(irt_wi_implementation_variant* variant,
 					                         variant->rt_data.optimizer_rt_data.best_resources.cpu_energy);
 				}
 
+				#ifdef IRT_ENABLE_OMPP_OPTIMIZER_PARETO
+				irt_optimizer_pareto_insert(variant->rt_data.optimizer_rt_data.pareto_front, &variant->rt_data.optimizer_rt_data.cur,
+				                            &variant->rt_data.optimizer_rt_data.cur_resources);
+				#endif
+
 				// Computing new settings
 
 				new_element.frequency = rand() % irt_g_available_freq_count;
@@ -402,8 +429,20 @@ void irt_optimizer_compute_optimizations(irt_wi_implementation_variant* variant,
 					new_element.param_value[i] = rand();
 				}
 			} else {
+			#ifdef IRT_ENABLE_OMPP_OPTIMIZER_PARETO
+				// second step: pick the setting best matching the objective among the non-dominated ones
+				irt_optimizer_pareto_front* front = variant->rt_data.optimizer_rt_data.pareto_front;
+				int32 selected = irt_optimizer_pareto_select(front, &variant->meta_info->ompp_objective);
+				if(selected >= 0) {
+					variant->rt_data.optimizer_rt_data.best = front->points[selected].id;
+					variant->rt_data.optimizer_rt_data.best_resources = front->points[selected].resources;
+				}
+				variant->rt_data.optimizer_rt_data.hc_end = true;
+				new_element = variant->rt_data.optimizer_rt_data.best;
+			#else
 				// second step: hill climbing
 				new_element = hill_climb(&(variant->rt_data.optimizer_rt_data), variant->meta_info->ompp_objective);
+			#endif
 			}
 
 			IRT_OMPP_OPTIMIZER_PRINT("NEXT: next freq %" PRIu64 " next thread count %" PRIu64 " next param %" PRIu64 "\n", new_element.frequency,
@@ -434,8 +473,8 @@ void irt_optimizer_apply_dvfs(irt_wi_implementation_variant* variant) {
 	irt_spin_lock(&data->spinlock);
 
 	irt_worker* self = irt_worker_get_current();
-	irt_cpu_freq_set_frequency_worker(
-	    self, irt_g_available_freqs[(irt_g_available_freq_count - 1 < data->cur.frequency) ? irt_g_available_freq_count - 1 : data->cur.frequency]);
+	irt_g_optimizer_provider.set_frequency_worker(
+	    irt_g_optimizer_provider.state, self, irt_g_available_freqs[(irt_g_available_freq_count - 1 < data->cur.frequency) ? irt_g_available_freq_count - 1 : data->cur.frequency]);
 
 	irt_spin_unlock(&data->spinlock);
 
@@ -451,7 +490,7 @@ void irt_optimizer_remove_dvfs(irt_wi_implementation_variant* variant) {
 	if(variant->meta_info->ompp_objective.region_id == UINT_MAX && !variant->rt_data.wrapping_optimizer_rt_data) { return; }
 
 	irt_worker* self = irt_worker_get_current();
-	irt_cpu_freq_set_frequency_worker(self, irt_g_available_freqs[IRT_OPTIMIZER_RT_FREQ]);
+	irt_g_optimizer_provider.set_frequency_worker(irt_g_optimizer_provider.state, self, irt_g_available_freqs[IRT_OPTIMIZER_RT_FREQ]);
 
 	// printf("%s: %d\n", __func__, irt_g_available_freqs[IRT_OPTIMIZER_RT_FREQ]);
 #endif
@@ -74,6 +74,8 @@ void irt_scheduling_set_dop_per_socket(uint32 sockets, uint32* dops) {
 	}
 	irt_scheduling_set_dop(parallelism);
 
+	// moving workers requires their threads
+	irt_worker_await_lazy_startup();
 	uint32 worker_num = 0;
 	for(uint32 s = 0; s < sockets; ++s) {
 		for(uint32 c = 0; c < dops[s]; ++c) {
@@ -104,10 +106,55 @@ bool _irt_scheduling_sleep_if_dop_inactive(irt_worker* self) {
 	return false;
 }
 
+#ifdef IRT_WORKER_SLEEPING
+// performs one idle round of the worker, returns true once spinning and yielding are exhausted and the worker should park
+bool _irt_scheduling_idle_backoff(irt_worker* self) {
+	uint32 round = self->idle_rounds++;
+	if(round < IRT_WORKER_IDLE_SPIN_ROUNDS) {
+		// exponential backoff: 1, 2, 4, ... pause instructions
+		for(uint32 i = 0; i < (1u << round); ++i) {
+			irt_thread_relax();
+		}
+		return false;
+	}
+	if(round < IRT_WORKER_IDLE_SPIN_ROUNDS + IRT_WORKER_IDLE_YIELD_ROUNDS) {
+		irt_thread_yield();
+		return false;
+	}
+	return true;
+}
+
+// parks the worker on its own futex word until it is signaled
+// a signal that arrived after the worker last found work is consumed instead of parking
+void _irt_scheduling_park(irt_worker* self) {
+	if(irt_atomic_bool_compare_and_swap(&self->park_state, IRT_WORKER_PARK_NOTIFIED, IRT_WORKER_PARK_AWAKE, uint32)) { return; }
+	// always keep at least one worker awake
+	uint32 active;
+	do {
+		active = irt_atomic_load(&irt_g_active_worker_count);
+		if(active <= 1) { return; }
+	} while(!irt_atomic_bool_compare_and_swap(&irt_g_active_worker_count, active, active - 1, uint32));
+
+	// announce parking before the policy takes a final look for work, such that work published
+	// concurrently is either found by the policy or its producer sees this worker parked
+	if(irt_atomic_load(&self->state) != IRT_WORKER_STATE_STOP
+	   && irt_atomic_bool_compare_and_swap(&self->park_state, IRT_WORKER_PARK_AWAKE, IRT_WORKER_PARK_PARKED, uint32)) {
+		if(irt_scheduling_worker_sleep(self)) {
+			while(irt_atomic_load(&self->park_state) == IRT_WORKER_PARK_PARKED) {
+				irt_thread_park(&self->park_state, IRT_WORKER_PARK_PARKED);
+			}
+		}
+		// woken up, a signal raced with parking or the policy vetoed - all consume the notification
+		irt_atomic_store(&self->park_state, IRT_WORKER_PARK_AWAKE);
+		irt_atomic_val_compare_and_swap(&self->state, IRT_WORKER_STATE_SLEEPING, IRT_WORKER_STATE_RUNNING, uint32);
+	}
+	irt_atomic_inc(&irt_g_active_worker_count, uint32);
+	self->idle_rounds = 0;
+}
+#endif // IRT_WORKER_SLEEPING
+
 void irt_scheduling_loop(irt_worker* self) {
 	while(irt_atomic_load(&self->state) != IRT_WORKER_STATE_STOP) {
-	#ifdef IRT_WORKER_SLEEPING
-	#endif // IRT_WORKER_SLEEPING
 		// while there is something to do, continue scheduling
 		while(irt_scheduling_iteration(self)) {
 			IRT_DEBUG("%sWorker %3d scheduled something.\n", self->id.thread == 0 ? "" : "\t\t\t\t\t\t", self->id.thread);
@@ -125,40 +172,29 @@ void irt_scheduling_loop(irt_worker* self) {
 				self->share_stack_wi = NULL;
 			}
 			#endif // IRT_ASTEROIDEA_STACKS
+			#ifdef IRT_WORKER_SLEEPING
+			self->idle_rounds = 0;
+			#endif // IRT_WORKER_SLEEPING
 			if(_irt_scheduling_sleep_if_dop_inactive(self)) { break; }
 		}
 		_irt_scheduling_sleep_if_dop_inactive(self);
 		#ifdef IRT_WORKER_SLEEPING
-		irt_mutex_lock(&irt_g_active_worker_mutex);
-		// check if self is the last worker
-		if(irt_g_active_worker_count <= 1 || self->wake_signal) {
-			self->wake_signal = false;
-			irt_mutex_unlock(&irt_g_active_worker_mutex);
-			continue;
-		}
-		if(!irt_scheduling_worker_sleep(self)) {
-			irt_mutex_unlock(&irt_g_active_worker_mutex);
-			continue;
-		}
-		irt_g_active_worker_count--;
-		// nothing to schedule, wait for signal
-		int wait_err = irt_cond_wait(&self->wait_cond, &irt_g_active_worker_mutex);
-		IRT_ASSERT(wait_err == 0, IRT_ERR_INTERNAL, "Worker failed to wait on scheduling condition");
-		// we were woken up by the signal and now own the mutex
-		irt_g_active_worker_count++;
-		irt_atomic_val_compare_and_swap(&self->state, IRT_WORKER_STATE_SLEEPING, IRT_WORKER_STATE_RUNNING, uint32);
-		irt_mutex_unlock(&irt_g_active_worker_mutex);
+		// nothing to schedule: spin, then yield, then park until signaled
+		if(_irt_scheduling_idle_backoff(self)) { _irt_scheduling_park(self); }
 		#endif // IRT_WORKER_SLEEPING
 	}
 }
 
 inline void _irt_signal_worker(irt_worker* target) {
 #ifdef IRT_WORKER_SLEEPING
-	irt_mutex_lock(&irt_g_active_worker_mutex);
-	target->wake_signal = true;
-	irt_cond_wake_one(&target->wait_cond);
+	// lock-free targeted wakeup: only issue a system call if the target is actually parked
+	uint32 prev;
+	do {
+		prev = irt_atomic_load(&target->park_state);
+		if(prev == IRT_WORKER_PARK_NOTIFIED) { return; }
+	} while(!irt_atomic_bool_compare_and_swap(&target->park_state, prev, IRT_WORKER_PARK_NOTIFIED, uint32));
+	if(prev == IRT_WORKER_PARK_PARKED) { irt_thread_unpark_one(&target->park_state); }
 	IRT_DEBUG("%sWorker %3d signaled.\n", target->id.thread == 0 ? "" : "\t\t\t\t\t\t", target->id.thread);
-	irt_mutex_unlock(&irt_g_active_worker_mutex);
 	#endif // IRT_WORKER_SLEEPING
 }
 
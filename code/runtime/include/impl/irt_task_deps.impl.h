@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_IMPL_IRT_TASK_DEPS_IMPL_H
+#define __GUARD_IMPL_IRT_TASK_DEPS_IMPL_H
+
+#include <stdlib.h>
+
+#include "declarations.h"
+#include "irt_task_deps.h"
+#include "abstraction/atomic.h"
+#include "abstraction/impl/threads.impl.h"
+#include "impl/error_handling.impl.h"
+#include "impl/irt_scheduling.impl.h"
+#include "impl/worker.impl.h"
+#include "work_item.h"
+
+#define IRT_TASK_DEP_INITIAL_CAPACITY 4
+
+static inline void _irt_task_dep_node_ref(irt_task_dep_node* node) {
+	irt_atomic_inc(&node->ref_count, int32);
+}
+
+static inline void _irt_task_dep_node_unref(irt_task_dep_node* node) {
+	if(irt_atomic_sub_and_fetch(&node->ref_count, 1, int32) == 0) {
+		free(node->successors);
+		free(node);
+	}
+}
+
+static inline void _irt_task_dep_append(irt_task_dep_node*** list, uint32* size, uint32* capacity, irt_task_dep_node* node) {
+	if(*size == *capacity) {
+		*capacity = (*capacity == 0) ? IRT_TASK_DEP_INITIAL_CAPACITY : *capacity * 2;
+		*list = (irt_task_dep_node**)realloc(*list, sizeof(irt_task_dep_node*) * (*capacity));
+	}
+	(*list)[(*size)++] = node;
+}
+
+// orders the given successor after the given predecessor, unless the predecessor has already completed
+static inline void _irt_task_dep_add_edge(irt_task_dep_node* pred, irt_task_dep_node* succ) {
+	if(pred == succ) { return; }
+	irt_spin_lock(&pred->lock);
+	if(!pred->completed) {
+		irt_spin_lock(&succ->lock);
+		succ->num_pending++;
+		irt_spin_unlock(&succ->lock);
+		_irt_task_dep_append(&pred->successors, &pred->num_successors, &pred->successors_capacity, succ);
+	}
+	irt_spin_unlock(&pred->lock);
+}
+
+static inline irt_task_dep_entry* _irt_task_dep_table_lookup(irt_task_dep_table* table, void* address) {
+	uint32 bucket = (uint32)(((uintptr_t)address >> 3) % IRT_TASK_DEP_TABLE_BUCKETS);
+	for(irt_task_dep_entry* entry = table->buckets[bucket]; entry != NULL; entry = entry->next) {
+		if(entry->address == address) { return entry; }
+	}
+	irt_task_dep_entry* entry = (irt_task_dep_entry*)calloc(1, sizeof(irt_task_dep_entry));
+	entry->address = address;
+	entry->next = table->buckets[bucket];
+	table->buckets[bucket] = entry;
+	return entry;
+}
+
+irt_task_deps irt_task_deps_create() {
+	irt_work_item* self = irt_wi_get_current();
+	if(self->task_dep_table == NULL) { self->task_dep_table = (irt_task_dep_table*)calloc(1, sizeof(irt_task_dep_table)); }
+	irt_task_dep_node* node = (irt_task_dep_node*)calloc(1, sizeof(irt_task_dep_node));
+	irt_spin_init(&node->lock);
+	node->ref_count = 1; // held by the task until it is released
+	node->table = self->task_dep_table;
+	return node;
+}
+
+void irt_task_deps_add(irt_task_deps deps, void* address, bool write) {
+	irt_task_dep_entry* entry = _irt_task_dep_table_lookup(deps->table, address);
+	if(write) {
+		// a write has to wait for all reads since the last write, or the last write itself if there were none
+		if(entry->num_readers > 0) {
+			for(uint32 i = 0; i < entry->num_readers; ++i) {
+				_irt_task_dep_add_edge(entry->readers[i], deps);
+				_irt_task_dep_node_unref(entry->readers[i]);
+			}
+			entry->num_readers = 0;
+		} else if(entry->last_writer) {
+			_irt_task_dep_add_edge(entry->last_writer, deps);
+		}
+		if(entry->last_writer) { _irt_task_dep_node_unref(entry->last_writer); }
+		_irt_task_dep_node_ref(deps);
+		entry->last_writer = deps;
+	} else {
+		if(entry->last_writer) { _irt_task_dep_add_edge(entry->last_writer, deps); }
+		// drop readers which are already done to keep the list short
+		uint32 kept = 0;
+		for(uint32 i = 0; i < entry->num_readers; ++i) {
+			if(entry->readers[i]->completed) {
+				_irt_task_dep_node_unref(entry->readers[i]);
+			} else {
+				entry->readers[kept++] = entry->readers[i];
+			}
+		}
+		entry->num_readers = kept;
+		_irt_task_dep_node_ref(deps);
+		_irt_task_dep_append(&entry->readers, &entry->num_readers, &entry->readers_capacity, deps);
+	}
+}
+
+void irt_task_deps_wait(irt_task_deps deps) {
+	irt_spin_lock(&deps->lock);
+	if(deps->num_pending == 0) { // ready
+		irt_spin_unlock(&deps->lock);
+		return;
+	}
+	// suspend until the last predecessor completes
+	irt_worker* wo = irt_worker_get_current();
+	irt_work_item* wi = wo->cur_wi;
+	deps->waiting_wi = wi;
+	deps->waiting_worker = wo;
+	irt_spin_unlock(&deps->lock);
+	irt_inst_insert_wi_event(wo, IRT_INST_WORK_ITEM_SUSPENDED_JOIN, wi->id);
+	_irt_worker_switch_from_wi(wo, wi);
+}
+
+void irt_task_deps_release(irt_task_deps deps) {
+	irt_spin_lock(&deps->lock);
+	deps->completed = true;
+	irt_spin_unlock(&deps->lock);
+	// no further successors can be added, the list is ours now
+	for(uint32 i = 0; i < deps->num_successors; ++i) {
+		irt_task_dep_node* succ = deps->successors[i];
+		irt_work_item* wake_wi = NULL;
+		irt_worker* wake_worker = NULL;
+		irt_spin_lock(&succ->lock);
+		if(--succ->num_pending == 0 && succ->waiting_wi) {
+			wake_wi = succ->waiting_wi;
+			wake_worker = succ->waiting_worker;
+			succ->waiting_wi = NULL;
+		}
+		irt_spin_unlock(&succ->lock);
+		// the successor may run to completion as soon as it is continued, so it must not be accessed afterwards
+		if(wake_wi) {
+			irt_inst_insert_wi_event(irt_worker_get_current(), IRT_INST_WORK_ITEM_RESUMED_JOIN, wake_wi->id);
+			irt_scheduling_continue_wi(wake_worker, wake_wi);
+			irt_signal_worker(wake_worker);
+		}
+	}
+	_irt_task_dep_node_unref(deps);
+}
+
+void irt_task_dep_table_destroy(irt_work_item* wi) {
+	irt_task_dep_table* table = wi->task_dep_table;
+	if(table == NULL) { return; }
+	for(uint32 b = 0; b < IRT_TASK_DEP_TABLE_BUCKETS; ++b) {
+		irt_task_dep_entry* entry = table->buckets[b];
+		while(entry != NULL) {
+			irt_task_dep_entry* next = entry->next;
+			if(entry->last_writer) { _irt_task_dep_node_unref(entry->last_writer); }
+			for(uint32 i = 0; i < entry->num_readers; ++i) {
+				_irt_task_dep_node_unref(entry->readers[i]);
+			}
+			free(entry->readers);
+			free(entry);
+			entry = next;
+		}
+	}
+	free(table);
+	wi->task_dep_table = NULL;
+}
+
+#endif // ifndef __GUARD_IMPL_IRT_TASK_DEPS_IMPL_H
@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_IMPL_PERF_EVENT_HELPER_IMPL_H
+#define __GUARD_IMPL_PERF_EVENT_HELPER_IMPL_H
+
+#include "perf_event_helper.h"
+
+#if defined(IRT_USE_PERF_EVENT) && !defined(IRT_USE_PAPI) && defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include "worker.h"
+#include "irt_context.h"
+
+typedef struct {
+	const char* name;
+	uint32 type;
+	uint64 config;
+} _irt_perf_event_description;
+
+// indexed by irt_perf_event_type
+static const _irt_perf_event_description _irt_g_perf_event_descriptions[IRT_PERF_EVENT_NUM_EVENTS] = {
+    {"PAPI_TOT_CYC", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"PAPI_TOT_INS", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"PAPI_L1_DCM", PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"PAPI_L3_TCM", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"PAPI_BR_MSP", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+irt_perf_event_worker_data irt_g_perf_event_data[IRT_MAX_WORKERS];
+
+/*
+ * opens a single counter of the calling thread, joining the group of group_fd (or leading a new one if -1)
+ */
+
+int32 _irt_perf_event_open(irt_perf_event_type type, int32 group_fd) {
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = _irt_g_perf_event_descriptions[type].type;
+	attr.config = _irt_g_perf_event_descriptions[type].config;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.disabled = group_fd == -1; // the whole group is enabled via the leader once complete
+	return (int32)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/*
+ * reads the raw counts of all counters of the group through the kernel, along with the times the group has been enabled and running
+ */
+
+void _irt_perf_event_read_syscall(irt_perf_event_worker_data* data, int64* values, uint64* enabled, uint64* running) {
+	uint64 buffer[3 + IRT_INST_PERF_EVENT_MAX_COUNTERS];
+	if(read(data->fds[0], buffer, sizeof(buffer)) < (ssize_t)(3 * sizeof(uint64))) {
+		memset(values, 0, sizeof(int64) * data->num_counters);
+		*enabled = *running = 0;
+		return;
+	}
+	uint64 nr = buffer[0];
+	*enabled = buffer[1];
+	*running = buffer[2];
+	for(uint32 i = 0; i < data->num_counters && i < nr; ++i) {
+		values[i] = (int64)buffer[3 + i];
+	}
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64 _irt_perf_event_rdpmc(uint32 counter) {
+	uint32 low, high;
+	__asm__ __volatile__("rdpmc" : "=a"(low), "=d"(high) : "c"(counter));
+	return ((uint64)high << 32) | low;
+}
+#endif
+
+/*
+ * reads the raw count of a single counter in user space, returns false if the counter is not currently on a
+ * hardware counter or has been multiplexed, in which case the caller needs to fall back to the system call
+ */
+
+bool _irt_perf_event_read_rdpmc(void* page, int64* value, uint64* enabled, uint64* running) {
+#if defined(__x86_64__) || defined(__i386__)
+	volatile struct perf_event_mmap_page* pc = (volatile struct perf_event_mmap_page*)page;
+	uint32 seq, index;
+	int64 count;
+	do {
+		seq = pc->lock;
+		__sync_synchronize();
+		index = pc->index;
+		*enabled = pc->time_enabled;
+		*running = pc->time_running;
+		if(!pc->cap_user_rdpmc || index == 0 || *enabled != *running) { return false; }
+		count = pc->offset;
+		uint16 width = pc->pmc_width;
+		int64 pmc = (int64)_irt_perf_event_rdpmc(index - 1);
+		// sign extend the raw counter to 64 bit
+		pmc <<= 64 - width;
+		pmc >>= 64 - width;
+		count += pmc;
+		__sync_synchronize();
+	} while(pc->lock != seq);
+	*value = count;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * reads the raw counts of all counters, in user space if possible - both paths deliver unscaled counts,
+ * such that readings taken at the start and the end of a measurement can be combined freely
+ */
+
+void _irt_perf_event_read(irt_perf_event_worker_data* data, int64* values, uint64* enabled, uint64* running) {
+	for(uint32 i = 0; i < data->num_counters; ++i) {
+		if(!data->pages[i] || !_irt_perf_event_read_rdpmc(data->pages[i], &values[i], enabled, running)) {
+			_irt_perf_event_read_syscall(data, values, enabled, running);
+			return;
+		}
+	}
+}
+
+void _irt_perf_event_close(irt_perf_event_worker_data* data) {
+	// make sure counters are only closed once, either by their worker or at context teardown
+	if(!irt_atomic_bool_compare_and_swap(&data->open, 1, 0, uint32)) { return; }
+	long page_size = sysconf(_SC_PAGESIZE);
+	for(uint32 i = 0; i < data->num_counters; ++i) {
+		if(data->pages[i]) { munmap(data->pages[i], page_size); }
+		close(data->fds[i]);
+	}
+	data->num_counters = 0;
+}
+
+/*
+ * context setup and teardown
+ */
+
+void irt_perf_event_setup_context(irt_context* context) {
+	memset(irt_g_perf_event_data, 0, sizeof(irt_perf_event_worker_data) * irt_g_worker_count);
+}
+
+void irt_perf_event_finalize_context(irt_context* context) {
+	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+		_irt_perf_event_close(&irt_g_perf_event_data[i]);
+	}
+}
+
+/*
+ * select counters from a comma-delimited string, executed by each worker for itself
+ */
+
+void irt_perf_event_select_events(irt_worker* worker, const char* events_string) {
+	if(!events_string) { return; }
+	irt_perf_event_worker_data* data = &irt_g_perf_event_data[worker->id.thread];
+	_irt_perf_event_close(data);
+
+	char events_string_copy[strlen(events_string) + 1];
+	strcpy(events_string_copy, events_string);
+	char* saveptr = NULL;
+	long page_size = sysconf(_SC_PAGESIZE);
+
+	for(char* cur = strtok_r(events_string_copy, ",", &saveptr); cur != NULL; cur = strtok_r(NULL, ",", &saveptr)) {
+		// skip everything that is not a supported counter
+		int32 type = -1;
+		for(int32 t = 0; t < IRT_PERF_EVENT_NUM_EVENTS; ++t) {
+			if(strcmp(cur, _irt_g_perf_event_descriptions[t].name) == 0) { type = t; }
+		}
+		if(type < 0) { continue; }
+		if(data->num_counters == IRT_INST_PERF_EVENT_MAX_COUNTERS) {
+			IRT_INFO("Instrumentation: Too many perf events, ignoring %s\n", cur);
+			continue;
+		}
+
+		int32 fd = _irt_perf_event_open((irt_perf_event_type)type, data->num_counters == 0 ? -1 : data->fds[0]);
+		if(fd < 0) {
+			IRT_INFO("Instrumentation: Error opening perf event %s for worker %hd! Reason: %s\n", cur, worker->id.thread, strerror(errno));
+			continue;
+		}
+		void* page = mmap(NULL, page_size, PROT_READ, MAP_SHARED, fd, 0);
+		data->fds[data->num_counters] = fd;
+		data->types[data->num_counters] = (irt_perf_event_type)type;
+		data->pages[data->num_counters] = page == MAP_FAILED ? NULL : page;
+		data->num_counters++;
+	}
+
+	if(data->num_counters > 0) {
+		ioctl(data->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		data->open = 1;
+	}
+}
+
+void irt_perf_event_select_events_from_env(irt_worker* worker) {
+	const char* events_string = getenv(IRT_INST_REGION_INSTRUMENTATION_TYPES_ENV);
+	if(events_string && strcmp(events_string, "") != 0) { irt_perf_event_select_events(worker, events_string); }
+}
+
+void irt_perf_event_setup_worker(irt_worker* worker) {
+	irt_perf_event_select_events_from_env(worker);
+}
+
+void irt_perf_event_finalize_worker(irt_worker* worker) {
+	_irt_perf_event_close(&irt_g_perf_event_data[worker->id.thread]);
+}
+
+/*
+ * counters keep running, starting and stopping a measurement only takes readings
+ */
+
+void irt_perf_event_start() {
+	irt_perf_event_worker_data* data = &irt_g_perf_event_data[irt_worker_get_current()->id.thread];
+	if(data->num_counters == 0) { return; }
+	_irt_perf_event_read(data, data->start_values, &data->start_time_enabled, &data->start_time_running);
+}
+
+void irt_perf_event_stop(int64* perf_values) {
+	irt_perf_event_worker_data* data = &irt_g_perf_event_data[irt_worker_get_current()->id.thread];
+	if(data->num_counters == 0) { return; }
+	uint64 enabled, running;
+	_irt_perf_event_read(data, perf_values, &enabled, &running);
+	// scale the differences if the group has been multiplexed during the measurement
+	enabled -= data->start_time_enabled;
+	running -= data->start_time_running;
+	double scale = (running > 0 && running < enabled) ? (double)enabled / running : 1.0;
+	for(uint32 i = 0; i < data->num_counters; ++i) {
+		perf_values[i] = (int64)((perf_values[i] - data->start_values[i]) * scale);
+	}
+}
+
+int64 irt_perf_event_get_value(int64* perf_values, irt_perf_event_type type) {
+	irt_perf_event_worker_data* data = &irt_g_perf_event_data[irt_worker_get_current()->id.thread];
+	if(data->num_counters == 0) { return -1; }
+	for(uint32 i = 0; i < data->num_counters; ++i) {
+		if(data->types[i] == type) { return perf_values[i]; }
+	}
+	return 0;
+}
+
+#else // IRT_USE_PERF_EVENT
+
+void irt_perf_event_setup_context(irt_context* context) {}
+
+void irt_perf_event_finalize_context(irt_context* context) {}
+
+void irt_perf_event_setup_worker(irt_worker* worker) {}
+
+void irt_perf_event_finalize_worker(irt_worker* worker) {}
+
+void irt_perf_event_start() {}
+
+void irt_perf_event_stop(int64* perf_values) {}
+
+int64 irt_perf_event_get_value(int64* perf_values, irt_perf_event_type type) {
+	return -1;
+}
+
+void irt_perf_event_select_events(irt_worker* worker, const char* events_string) {}
+
+void irt_perf_event_select_events_from_env(irt_worker* worker) {}
+
+#endif // IRT_USE_PERF_EVENT
+
+#endif // ifndef __GUARD_IMPL_PERF_EVENT_HELPER_IMPL_H
@@ -68,6 +68,8 @@ irt_work_group* _irt_wg_create(irt_worker* self) {
 	wg->redistribute_data_array = NULL;
 	wg->cur_sched = irt_g_loop_sched_policy_default;
 	irt_spin_init(&wg->lock);
+	irt_spin_init(&wg->ordered_lock);
+	wg->ordered_waiters = NULL;
 	// create entry in event table
 	irt_wg_event_register_create(wg->id);
 	irt_inst_region_wg_init(wg);
@@ -88,6 +90,7 @@ void irt_wg_end(irt_work_group* wg) {
 	               IRT_ASSERT(reg->occured_flag[IRT_WG_EV_COMPLETED], IRT_ERR_INTERNAL, "Incomplete triggering"); irt_spin_unlock(&reg->lock);)
 	irt_wg_event_register_destroy(wg->id);
 	irt_spin_destroy(&wg->lock);
+	irt_spin_destroy(&wg->ordered_lock);
 	_irt_wg_recycle(wg);
 }
 
@@ -224,6 +227,20 @@ void irt_wg_redistribute(irt_work_group* wg, irt_work_item* this_wi, void* my_da
 	irt_wg_barrier(wg);
 }
 
+void irt_wg_reduce(irt_work_group* wg, irt_work_item* this_wi, void* value, irt_wg_reduction_function* combine) {
+	if(wg->redistribute_data_array == NULL) { _irt_wg_allocate_redist_array(wg); }
+	uint32 local_id = irt_wg_get_wi_num(wg, this_wi);
+	uint32 num_members = wg->local_member_count;
+	wg->redistribute_data_array[local_id] = value;
+	irt_wg_barrier(wg);
+	// in each step, members at multiples of 2*stride fold in the partial result stride members away
+	// the barrier after the last step also keeps the values alive until member 0 is done reading them
+	for(uint32 stride = 1; stride < num_members; stride *= 2) {
+		if(local_id % (2 * stride) == 0 && local_id + stride < num_members) { combine(value, wg->redistribute_data_array[local_id + stride]); }
+		irt_wg_barrier(wg);
+	}
+}
+
 typedef struct __irt_wg_join_event_data {
 	irt_work_item* joining_wi;
 	irt_worker* join_to;
@@ -248,5 +265,56 @@ void irt_wg_join(irt_work_group_id wg_id) {
 	}
 }
 
+void irt_wg_ordered_wait(irt_work_group* wg, volatile int64* counter, int64 value) {
+	// the preceding iteration is usually about to finish, so briefly spinning avoids the cost of a context switch
+	for(uint32 i = 0; i < IRT_WG_ORDERED_SPIN_ROUNDS; ++i) {
+		if(*counter == value) { return; }
+		irt_thread_relax();
+	}
+	irt_worker* self = irt_worker_get_current();
+	irt_work_item* swi = self->cur_wi;
+	for(uint32 i = 0; i < IRT_WG_ORDERED_YIELD_ROUNDS; ++i) {
+		if(*counter == value) { return; }
+		irt_scheduling_yield(self, swi);
+	}
+	// suspend until the member completing the preceding iteration advances the counter to our value
+	irt_spin_lock(&wg->ordered_lock);
+	if(*counter == value) {
+		irt_spin_unlock(&wg->ordered_lock);
+		return;
+	}
+	irt_wg_ordered_waiter waiter = {swi, self, counter, value, wg->ordered_waiters};
+	wg->ordered_waiters = &waiter;
+	irt_spin_unlock(&wg->ordered_lock);
+	irt_inst_region_end_measurements(swi);
+	irt_inst_insert_wi_event(self, IRT_INST_WORK_ITEM_SUSPENDED_BARRIER, swi->id);
+	_irt_worker_switch_from_wi(self, swi);
+	irt_inst_region_start_measurements(swi);
+}
+
+void irt_wg_ordered_advance(irt_work_group* wg, volatile int64* counter, int64 increment) {
+	irt_wg_ordered_waiter* woken = NULL;
+	irt_spin_lock(&wg->ordered_lock);
+	// the counter is only modified while holding the lock, so waiters can not miss the update
+	int64 value = *counter + increment;
+	*counter = value;
+	for(irt_wg_ordered_waiter** cur = &wg->ordered_waiters; *cur != NULL; cur = &(*cur)->next) {
+		if((*cur)->counter == counter && (*cur)->value == value) {
+			woken = *cur;
+			*cur = woken->next;
+			break;
+		}
+	}
+	irt_spin_unlock(&wg->ordered_lock);
+	if(woken) {
+		// the waiter record lives on the stack of the suspended member, it must not be accessed once it is continued
+		irt_worker* target = woken->worker;
+		irt_work_item* wi = woken->wi;
+		irt_inst_insert_wi_event(irt_worker_get_current(), IRT_INST_WORK_ITEM_RESUMED_BARRIER, wi->id);
+		irt_scheduling_continue_wi(target, wi);
+		irt_signal_worker(target);
+	}
+}
+
 
 #endif // ifndef __GUARD_IMPL_WORK_GROUP_IMPL_H
@@ -50,26 +50,9 @@
 #include "impl/irt_events.impl.h"
 #include "impl/instrumentation_regions.impl.h"
 #include "impl/instrumentation_events.impl.h"
+#include "impl/irt_task_deps.impl.h"
 #include "irt_types.h"
-
-static inline irt_wi_wg_membership irt_wi_get_wg_membership(irt_work_item* wi, uint32 index) {
-	IRT_ASSERT(index < wi->num_groups, IRT_ERR_INTERNAL, "WG membership access out of range.");
-	return wi->wg_memberships[index];
-}
-static inline uint32 irt_wi_get_wg_num(irt_work_item* wi, uint32 index) {
-	IRT_ASSERT(index < wi->num_groups, IRT_ERR_INTERNAL, "WG membership number access out of range.");
-	return wi->wg_memberships[index].num;
-}
-static inline uint32 irt_wi_get_wg_size(irt_work_item* wi, uint32 index) {
-	return irt_wi_get_wg(wi, index)->local_member_count;
-}
-static inline irt_work_group* irt_wi_get_wg(irt_work_item* wi, uint32 index) {
-	return irt_wi_get_wg_membership(wi, index).wg_id.cached; // TODO cached distributed crash
-}
-
-static inline irt_work_item* irt_wi_get_current() {
-	return irt_worker_get_current()->cur_wi;
-}
+#include "impl/work_item_accessors.impl.h"
 
 static inline irt_work_item* _irt_wi_new(irt_worker* self) {
 	irt_work_item* ret;
@@ -133,6 +116,7 @@ static inline void _irt_wi_init(irt_worker* self, irt_work_item* wi, const irt_w
 	wi->num_fragments = 0;
 	wi->stack_storage = NULL;
 	wi->wg_memberships = NULL;
+	wi->task_dep_table = NULL;
 	// if this WI has a parent (which means it's not the entry point) migrate some values
 	if(self->cur_wi) {
 		wi->parent_id = self->cur_wi->id;
@@ -173,6 +157,7 @@ irt_work_item* _irt_wi_create_fragment(irt_work_item* source, irt_work_item_rang
 	retval->id = irt_generate_work_item_id(IRT_LOOKUP_GENERATOR_ID_PTR);
 	retval->id.cached = retval;
 	retval->num_fragments = 0;
+	retval->task_dep_table = NULL;
 	retval->range = range;
 	irt_inst_region_list_copy(retval, self->cur_wi);
 	irt_inst_insert_wi_event(self, IRT_INST_WORK_ITEM_CREATED, retval->id);
@@ -319,6 +304,7 @@ void irt_wi_end(irt_work_item* wi) {
 	irt_inst_region_end_measurements(wi);
 	irt_inst_region_propagate_data_from_wi_to_regions(wi);
 	irt_inst_insert_wi_event(worker, IRT_INST_WORK_ITEM_END_START, wi->id);
+	irt_task_dep_table_destroy(wi);
 
 	// check for fragment, handle
 	if(irt_wi_is_fragment(wi)) {
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_IMPL_WORK_ITEM_ACCESSORS_IMPL_H
+#define __GUARD_IMPL_WORK_ITEM_ACCESSORS_IMPL_H
+
+// work item accessors called directly by generated code; kept separate from work_item.impl.h
+// so that translation units built against irt_all_decls.h can inline them as well
+
+#include "work_item.h"
+#include "work_group.h"
+#include "worker.h"
+#include "error_handling.h"
+
+static inline irt_wi_wg_membership irt_wi_get_wg_membership(irt_work_item* wi, uint32 index) {
+	IRT_ASSERT(index < wi->num_groups, IRT_ERR_INTERNAL, "WG membership access out of range.");
+	return wi->wg_memberships[index];
+}
+static inline uint32 irt_wi_get_wg_num(irt_work_item* wi, uint32 index) {
+	IRT_ASSERT(index < wi->num_groups, IRT_ERR_INTERNAL, "WG membership number access out of range.");
+	return wi->wg_memberships[index].num;
+}
+static inline uint32 irt_wi_get_wg_size(irt_work_item* wi, uint32 index) {
+	return irt_wi_get_wg(wi, index)->local_member_count;
+}
+static inline irt_work_group* irt_wi_get_wg(irt_work_item* wi, uint32 index) {
+	return irt_wi_get_wg_membership(wi, index).wg_id.cached; // TODO cached distributed crash
+}
+
+static inline irt_work_item* irt_wi_get_current() {
+	return irt_worker_get_current()->cur_wi;
+}
+
+#endif // ifndef __GUARD_IMPL_WORK_ITEM_ACCESSORS_IMPL_H
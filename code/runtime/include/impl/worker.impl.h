@@ -91,13 +91,11 @@ void _irt_worker_print_debug_info(irt_worker* self) {
 
 typedef struct __irt_worker_func_arg {
 	irt_worker* generated;
-	irt_affinity_mask affinity;
-	uint16 index;
 	irt_worker_init_signal* signal;
 } _irt_worker_func_arg;
 
 
-/** wait until all worker threads are created (signal->init_count == irt_g_worker_count) */
+/** wait until all worker threads are created (signal->init_count == signal->init_target) */
 void _irt_await_all_workers_init(irt_worker_init_signal* signal) {
 #if defined(WINVER) && (WINVER < 0x0600)
 	irt_atomic_inc(&(signal->init_count, uint32));
@@ -107,7 +105,7 @@ void _irt_await_all_workers_init(irt_worker_init_signal* signal) {
 	#else
 	irt_mutex_lock(&signal->init_mutex);
 	signal->init_count++;
-	if(signal->init_count == irt_g_worker_count) {
+	if(signal->init_count == signal->init_target) {
 		// signal readyness of created thread to master thread
 		irt_cond_wake_all(&signal->init_condvar);
 	} else {
@@ -117,20 +115,15 @@ void _irt_await_all_workers_init(irt_worker_init_signal* signal) {
 	#endif
 }
 
-void* _irt_worker_func(void* argvp) {
-	_irt_worker_func_arg* arg = (_irt_worker_func_arg*)argvp;
-	irt_thread t;
-	irt_thread_get_current(&t);
-	irt_set_affinity(arg->affinity, t);
-	arg->generated = (irt_worker*)calloc(1, sizeof(irt_worker));
-	irt_worker* self = arg->generated;
-	irt_thread_get_current(&(self->thread));
+irt_worker* irt_worker_prepare(uint16 index, irt_affinity_mask affinity) {
+	irt_worker* self = (irt_worker*)calloc(1, sizeof(irt_worker));
 	self->id.index = 1;
-	self->id.thread = arg->index;
+	self->id.thread = index;
 	self->id.node = 0; // TODO correct node id
 	self->id.cached = self;
 	self->generator_id = self->id.full;
-	self->affinity = arg->affinity;
+	self->affinity = affinity;
+	self->state = IRT_WORKER_STATE_CREATED;
 	self->cur_context = irt_context_null_id();
 	self->cur_wi = NULL;
 	self->finalize_wi = NULL;
@@ -138,17 +131,15 @@ void* _irt_worker_func(void* argvp) {
 	if(getenv(IRT_DEFAULT_VARIANT_ENV)) { self->default_variant = atoi(getenv(IRT_DEFAULT_VARIANT_ENV)); }
 
 	#ifdef IRT_WORKER_SLEEPING
-	irt_cond_var_init(&self->wait_cond);
-	self->wake_signal = true;
+	self->park_state = IRT_WORKER_PARK_NOTIFIED;
+	self->idle_rounds = 0;
 	#endif
 	irt_cond_var_init(&self->dop_wait_cond);
 	irt_spin_init(&self->shutdown_lock);
 
 	irt_scheduling_init_worker(self);
-	IRT_ASSERT(irt_tls_set(irt_g_worker_key, arg->generated) == 0, IRT_ERR_INTERNAL, "Could not set worker threadprivate data");
 
 	#ifdef IRT_ENABLE_APP_TIME_ACCOUNTING
-	IRT_ASSERT(pthread_getcpuclockid(t, &self->clockid) == 0, IRT_ERR_INIT, "Failed to retrieve thread clock id");
 	self->app_time_total = 0.0;
 	self->app_time_last_start = 0.0;
 	self->app_time_running = false;
@@ -156,6 +147,7 @@ void* _irt_worker_func(void* argvp) {
 
 	#ifdef IRT_ENABLE_INSTRUMENTATION
 	self->instrumentation_event_data = irt_inst_create_event_data_table();
+	if(irt_g_instrumentation_event_output_is_streamed) { irt_inst_event_stream_open(self); }
 	#endif
 	#ifdef IRT_OCL_INSTR
 	self->event_data = irt_ocl_create_event_table();
@@ -176,15 +168,32 @@ void* _irt_worker_func(void* argvp) {
 	self->wi_reuse_stack = NULL;      // prepare some?
 	self->stack_reuse_stack = NULL;
 
-	irt_atomic_store(&self->state, IRT_WORKER_STATE_READY);
+	irt_g_workers[index] = self;
+	return self;
+}
+
+void* _irt_worker_func(void* argvp) {
+	_irt_worker_func_arg* arg = (_irt_worker_func_arg*)argvp;
+	irt_worker* self = arg->generated;
+	irt_thread_get_current(&(self->thread));
+	irt_set_affinity(self->affinity, self->thread);
+	IRT_ASSERT(irt_tls_set(irt_g_worker_key, self) == 0, IRT_ERR_INTERNAL, "Could not set worker threadprivate data");
+
+	#ifdef IRT_ENABLE_APP_TIME_ACCOUNTING
+	IRT_ASSERT(pthread_getcpuclockid(self->thread, &self->clockid) == 0, IRT_ERR_INIT, "Failed to retrieve thread clock id");
+	#endif // IRT_ENABLE_APP_TIME_ACCOUNTING
+
+	// allocate stacks for the first work items up front, from the thread that is going to use them
+	lwt_fill_stack_pool(self->id.thread, IRT_LWT_STACK_POOL_SIZE);
 
-	// store self, free arg
-	irt_g_workers[arg->index] = self;
+	// the worker might have been stopped before its thread got to run
 	irt_worker_init_signal* signal = arg->signal;
 	free(arg);
+	bool stopped = !irt_atomic_bool_compare_and_swap(&self->state, IRT_WORKER_STATE_START, IRT_WORKER_STATE_READY, uint32);
 
 	// wait until all workers are initialized
-	_irt_await_all_workers_init(signal);
+	if(signal) { _irt_await_all_workers_init(signal); }
+	if(stopped) { return NULL; }
 
 	irt_worker_late_init(self);
 
@@ -198,7 +207,8 @@ void* _irt_worker_func(void* argvp) {
 
 uint32 _irt_worker_select_implementation_variant(const irt_worker* self, const irt_work_item* wi) {
 	irt_wi_implementation* wimpl = wi->impl;
-	#ifndef IRT_TASK_OPT
+	// demand driven variant selection is only provided by the circular stealing policy
+	#if !defined(IRT_TASK_OPT) || IRT_SCHED_POLICY != IRT_SCHED_POLICY_STEALING_CIRCULAR
 	if(self->default_variant < wimpl->num_variants) {
 		return self->default_variant;
 	} else {
@@ -278,12 +288,14 @@ void irt_worker_run_immediate(irt_worker* target, const irt_work_item_range* ran
 	uint32 prev_selected_impl_variant = self->selected_impl_variant;
 	irt_work_item_id prev_source = self->source_id;
 	uint32 prev_fragments = self->num_fragments;
+	irt_task_dep_table* prev_task_dep_table = self->task_dep_table;
 	// set new wi data
 	self->parameters = args;
 	self->range = *range;
 	self->impl = impl;
 	self->source_id = irt_work_item_null_id();
 	self->num_fragments = 0;
+	self->task_dep_table = NULL;
 	// need unique active child number, can re-use id (and thus register entry)
 	volatile uint32* prev_parent_active_child_count = self->parent_num_active_children;
 	self->parent_num_active_children = self->num_active_children;
@@ -296,6 +308,8 @@ void irt_worker_run_immediate(irt_worker* target, const irt_work_item_range* ran
 	self->num_active_children = self->parent_num_active_children;
 	self->parent_num_active_children = prev_parent_active_child_count;
 	// restore data
+	irt_task_dep_table_destroy(self);
+	self->task_dep_table = prev_task_dep_table;
 	self->parameters = prev_args;
 	self->range = prev_range;
 	self->impl = prev_impl;
@@ -304,14 +318,41 @@ void irt_worker_run_immediate(irt_worker* target, const irt_work_item_range* ran
 	self->num_fragments = prev_fragments;
 }
 
-void irt_worker_create(uint16 index, irt_affinity_mask affinity, irt_worker_init_signal* signal) {
+void irt_worker_start(irt_worker* self, irt_worker_init_signal* signal) {
 	_irt_worker_func_arg* arg = (_irt_worker_func_arg*)malloc(sizeof(_irt_worker_func_arg));
-	arg->affinity = affinity;
-	arg->index = index;
+	arg->generated = self;
 	arg->signal = signal;
+	irt_atomic_store(&self->state, IRT_WORKER_STATE_START);
 	irt_thread_create(&_irt_worker_func, arg, NULL);
 }
 
+void irt_worker_create(uint16 index, irt_affinity_mask affinity, irt_worker_init_signal* signal) {
+	irt_worker_start(irt_worker_prepare(index, affinity), signal);
+}
+
+void* _irt_worker_lazy_startup_func(void* unused) {
+	for(uint32 i = 1; i < irt_g_worker_count; ++i) {
+		irt_worker_start(irt_g_workers[i], NULL);
+	}
+	irt_atomic_store(&irt_g_worker_lazy_startup, IRT_WORKER_LAZY_STARTUP_DONE);
+	return NULL;
+}
+
+static inline void irt_worker_request_lazy_startup() {
+	if(irt_atomic_load(&irt_g_worker_lazy_startup) != IRT_WORKER_LAZY_STARTUP_PENDING) { return; }
+	if(irt_atomic_bool_compare_and_swap(&irt_g_worker_lazy_startup, IRT_WORKER_LAZY_STARTUP_PENDING, IRT_WORKER_LAZY_STARTUP_SPAWNING, uint32)) {
+		irt_log_comment("lazily starting remaining worker threads");
+		irt_thread_create(&_irt_worker_lazy_startup_func, NULL, NULL);
+	}
+}
+
+void irt_worker_await_lazy_startup() {
+	irt_worker_request_lazy_startup();
+	while(irt_atomic_load(&irt_g_worker_lazy_startup) == IRT_WORKER_LAZY_STARTUP_SPAWNING) {
+		irt_thread_yield();
+	}
+}
+
 void irt_worker_late_init(irt_worker* self) {
 	irt_context_id nullid = irt_context_null_id();
 	// loop until context id has been set (i.e. is not nullid), which means that the context setup is done
@@ -339,11 +380,24 @@ void _irt_worker_end_all() {
 	irt_thread calling_thread;
 	irt_thread_get_current(&calling_thread);
 
+	// workers which were never started do not need to be started just to be stopped again
+	if(!irt_atomic_bool_compare_and_swap(&irt_g_worker_lazy_startup, IRT_WORKER_LAZY_STARTUP_PENDING, IRT_WORKER_LAZY_STARTUP_CANCELLED, uint32)) {
+		irt_worker_await_lazy_startup();
+	}
+
 	irt_mutex_lock(&irt_g_degree_of_parallelism_mutex);
 	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
 		irt_worker* cur = irt_g_workers[i];
 		irt_spin_lock(&cur->shutdown_lock);
 		if(irt_atomic_load(&cur->state) == IRT_WORKER_STATE_JOINED) { continue; }
+		if(irt_atomic_bool_compare_and_swap(&cur->state, IRT_WORKER_STATE_CREATED, IRT_WORKER_STATE_JOINED, uint32)) {
+			irt_spin_unlock(&cur->shutdown_lock);
+			continue;
+		}
+		// a thread which has just been started needs to publish its handle before it can be joined
+		while(irt_atomic_load(&cur->state) == IRT_WORKER_STATE_START) {
+			irt_thread_yield();
+		}
 		do {
 			irt_atomic_store(&cur->state, IRT_WORKER_STATE_STOP);
 			irt_signal_worker(cur);
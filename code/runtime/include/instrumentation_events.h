@@ -41,6 +41,7 @@
 #include <stdio.h>
 
 #include "declarations.h"
+#include "abstraction/spin_locks.h"
 
 #ifdef USE_OPENCL
 #define IRT_ENABLE_INSTRUMENTATION
@@ -50,6 +51,11 @@
 //#define IRT_ENABLE_INSTRUMENTATION
 #endif
 
+// streaming event logs to disk while running requires mmap and the maintenance thread
+#if !defined(_GEMS_SIM) && !defined(_GEMS) && !defined(_WIN32)
+#define IRT_INST_EVENT_STREAMING_SUPPORTED
+#endif
+
 #define IRT_DECLARE_PERFORMANCE_TABLE(__type__)                                                                                                                \
 	struct _irt_##__type__##_table {                                                                                                                           \
 		uint32 size;                                                                                                                                           \
@@ -65,6 +71,8 @@ typedef enum _irt_instrumentation_event {
 } irt_instrumentation_event;
 #undef IRT_INST_EVENT
 
+#ifndef IRT_DECLARATIONS_ONLY
+
 #define IRT_INST_EVENT(event, group_label, event_label) event_label,
 const char* irt_g_instrumentation_event_names[] = {
 #include "instrumentation_events.def"
@@ -83,6 +91,14 @@ uint32 irt_g_inst_num_event_types = 0
     ;
 #undef IRT_INST_EVENT
 
+#else
+
+extern const char* irt_g_instrumentation_event_names[];
+extern const char* irt_g_instrumentation_group_names[];
+extern uint32 irt_g_inst_num_event_types;
+
+#endif // ifndef IRT_DECLARATIONS_ONLY
+
 typedef struct _irt_instrumentation_event_data {
 	uint64 timestamp;
 	union {
@@ -95,10 +111,26 @@ typedef struct _irt_instrumentation_event_data {
 	};
 } irt_instrumentation_event_data;
 
+// state of a worker's event log that is streamed to disk while the program is running
+typedef struct _irt_inst_event_stream {
+	volatile uint64 head;  // number of events recorded so far, only written by the owning worker
+	volatile uint64 tail;  // number of events encoded into the file so far, only written while holding lock
+	irt_spinlock lock;     // serializes draining by the maintenance thread and the owning worker
+	uint64 last_timestamp; // timestamp of the last encoded event, base of the next delta
+	uint32 worker;
+	int fd;
+	char* map;
+	uint64 map_size;
+	uint64 offset; // end of the encoded data within the file
+} irt_inst_event_stream;
+
+// if stream is set, data is a ring buffer of (power of two) size entries indexed via the stream's
+// head and tail counters and number_of_elements is not used; otherwise data grows on demand
 typedef struct _irt_instrumentation_event_data_table {
 	uint32 size;
 	uint32 number_of_elements;
 	irt_instrumentation_event_data* data;
+	irt_inst_event_stream* stream;
 } irt_instrumentation_event_data_table;
 
 #ifdef USE_OPENCL
@@ -125,6 +157,12 @@ irt_instrumentation_event_data_table* irt_inst_create_event_data_table();
 
 void irt_inst_destroy_event_data_table(irt_instrumentation_event_data_table* table);
 
+// functions for streaming event data to disk while running
+
+void irt_inst_event_stream_open(irt_worker* worker);
+void irt_inst_event_stream_flush(irt_instrumentation_event_data_table* table);
+void irt_inst_event_stream_close(irt_instrumentation_event_data_table* table);
+
 // initialization functions
 
 void irt_instrumentation_init_energy_instrumentation();
@@ -164,6 +202,7 @@ void _irt_inst_insert_no_di_event(irt_worker* worker, irt_instrumentation_event
 void _irt_inst_insert_no_db_event(irt_worker* worker, irt_instrumentation_event event, irt_worker_id subject_id);
 
 #ifdef IRT_ENABLE_INSTRUMENTATION
+#ifndef IRT_DECLARATIONS_ONLY
 // global function pointers to switch instrumentation on/off
 void (*irt_inst_insert_wi_event)(irt_worker* worker, irt_instrumentation_event event, irt_work_item_id subject_id) = &_irt_inst_insert_no_wi_event;
 void (*irt_inst_insert_wg_event)(irt_worker* worker, irt_instrumentation_event event, irt_work_group_id subject_id) = &_irt_inst_insert_no_wg_event;
@@ -172,6 +211,17 @@ void (*irt_inst_insert_wo_event)(irt_worker* worker, irt_instrumentation_event e
 void (*irt_inst_insert_db_event)(irt_worker* worker, irt_instrumentation_event event, irt_worker_id subject_id) = &_irt_inst_insert_no_db_event;
 bool irt_g_instrumentation_event_output_is_enabled = false;
 bool irt_g_instrumentation_event_output_is_binary = false;
+bool irt_g_instrumentation_event_output_is_streamed = false;
+#else
+extern void (*irt_inst_insert_wi_event)(irt_worker* worker, irt_instrumentation_event event, irt_work_item_id subject_id);
+extern void (*irt_inst_insert_wg_event)(irt_worker* worker, irt_instrumentation_event event, irt_work_group_id subject_id);
+extern void (*irt_inst_insert_di_event)(irt_worker* worker, irt_instrumentation_event event, irt_data_item_id subject_id);
+extern void (*irt_inst_insert_wo_event)(irt_worker* worker, irt_instrumentation_event event, irt_worker_id subject_id);
+extern void (*irt_inst_insert_db_event)(irt_worker* worker, irt_instrumentation_event event, irt_worker_id subject_id);
+extern bool irt_g_instrumentation_event_output_is_enabled;
+extern bool irt_g_instrumentation_event_output_is_binary;
+extern bool irt_g_instrumentation_event_output_is_streamed;
+#endif // ifndef IRT_DECLARATIONS_ONLY
 
 #endif // IRT_ENABLE_INSTRUMENTATION
 
@@ -212,4 +262,10 @@ bool irt_g_instrumentation_event_output_is_binary = false;
  * (note: the strings are written without the termination character '\0'!)
  */
 
+/*
+ * If IRT_INST_EVENT_STREAMING is enabled, events are written to worker_event_stream.<worker>
+ * files while the program is running instead, see utils/event_stream.h for their format.
+ * The insieme_inst_event_merge tool combines them into a single timeline.
+ */
+
 #endif // #ifndef __GUARD_INSTRUMENTATION_EVENTS_H
@@ -42,6 +42,12 @@
 
 #include "declarations.h"
 
+#if defined(__linux__) && !defined(_GEMS_SIM) && !defined(_GEMS)
+#define IRT_INST_REGION_SAMPLING_SUPPORTED
+#include <signal.h>
+#include <time.h>
+#endif
+
 #ifndef IRT_ENABLE_INSTRUMENTATION
 //#define IRT_ENABLE_INSTRUMENTATION
 #endif
@@ -53,24 +59,30 @@
 
 typedef uint32 irt_inst_region_id;
 
-uint32 irt_g_inst_region_metric_count = 0;
-uint32 irt_g_inst_region_metric_group_count = 0;
+#ifndef IRT_DECLARATIONS_ONLY
+#define IRT_INST_REGION_GLOBAL(_decl__, _init__) _decl__ = _init__
+#else
+#define IRT_INST_REGION_GLOBAL(_decl__, _init__) extern _decl__
+#endif
+
+IRT_INST_REGION_GLOBAL(uint32 irt_g_inst_region_metric_count, 0);
+IRT_INST_REGION_GLOBAL(uint32 irt_g_inst_region_metric_group_count, 0);
 
 #define METRIC(_name__, _id__, _unit__, _data_type__, _format_string__, _scope__, _aggregation__, _group__, _wi_start_code__, wi_end_code__,                   \
                _region_early_start_code__, _region_late_end_code__, _output_conversion_code__)                                                                 \
-	uint32 irt_g_region_metric_##_name__##_id;
+	IRT_INST_REGION_GLOBAL(uint32 irt_g_region_metric_##_name__##_id, 0);
 #define GROUP(_name__, _global_var_decls__, _local_var_decls__, _init_code__, _init_code_worker__, _finalize_code__, _finalize_code_worker__,                  \
               _wi_start_code__, wi_end_code__, _region_early_start_code__, _region_late_end_code__)                                                            \
-	uint32 irt_g_region_metric_group_##_name__##_id;
+	IRT_INST_REGION_GLOBAL(uint32 irt_g_region_metric_group_##_name__##_id, 0);
 #include "irt_metrics.def"
 
 // create metric flags and group counts for selectively enabling/disabling instrumentation
 #define METRIC(_name__, _id__, _unit__, _data_type__, _format_string__, _scope__, _aggregation__, _group__, _wi_start_code__, wi_end_code__,                   \
                _region_early_start_code__, _region_late_end_code__, _output_conversion_code__)                                                                 \
-	bool irt_g_inst_region_metric_measure_##_name__ = false;
+	IRT_INST_REGION_GLOBAL(bool irt_g_inst_region_metric_measure_##_name__, false);
 #define GROUP(_name__, _global_var_decls__, _local_var_decls__, _init_code__, _init_code_worker__, _finalize_code__, _finalize_code_worker__,                  \
               _wi_start_code__, wi_end_code__, _region_early_start_code__, _region_late_end_code__)                                                            \
-	uint32 irt_g_inst_region_metric_group_##_name__##membership_count = 0;
+	IRT_INST_REGION_GLOBAL(uint32 irt_g_inst_region_metric_group_##_name__##membership_count, 0);
 #include "irt_metrics.def"
 
 typedef enum { IRT_HW_SCOPE_CORE, IRT_HW_SCOPE_SOCKET, IRT_HW_SCOPE_SYSTEM, IRT_HW_SCOPE_NUM_SCOPES } IRT_HW_SCOPES;
@@ -154,4 +166,38 @@ void irt_inst_region_output();
 
 irt_inst_region_context_data* irt_inst_region_get_current(irt_work_item* wi);
 
+// -----------------------------------------------------------------------------------------------------------------
+//													Sampling
+// -----------------------------------------------------------------------------------------------------------------
+
+/* Statistical region profiling, enabled by setting IRT_INST_REGION_INSTRUMENTATION to "sampling".
+ * Region entries and exits then only maintain the region stack of the work item, while a per-worker SIGPROF timer
+ * (ticking in thread cpu time every IRT_INST_REGION_SAMPLING_INTERVAL microseconds) attributes a sample to every
+ * region on the stack of the work item the worker is currently executing. Samples are reported as cpu_time.
+ */
+
+typedef struct {
+	volatile uint64* samples;     // per region, only written by the signal handler on the owning worker
+	volatile uint64 unattributed; // samples taken while no region was active
+	bool armed;
+	#ifdef IRT_INST_REGION_SAMPLING_SUPPORTED
+	timer_t timer;
+	#endif
+} irt_inst_region_sampler;
+
+IRT_INST_REGION_GLOBAL(bool irt_g_inst_region_sampling, false);
+IRT_INST_REGION_GLOBAL(uint64 irt_g_inst_region_sampling_interval, 0); // in ns
+#ifndef IRT_DECLARATIONS_ONLY
+irt_inst_region_sampler irt_g_inst_region_samplers[IRT_MAX_WORKERS];
+#else
+extern irt_inst_region_sampler irt_g_inst_region_samplers[IRT_MAX_WORKERS];
+#endif
+
+void irt_inst_region_sampling_start_worker(irt_worker* worker);
+
+void irt_inst_region_sampling_stop();
+
+// folds the samples taken so far into the cpu_time of the regions of the given context
+void irt_inst_region_sampling_collect(irt_context* context);
+
 #endif // #ifndef __GUARD_INSTRUMENTATION_REGIONS_H
@@ -41,5 +41,6 @@
 #include "abstraction/measurements.h"
 #include "utils/timing.h"
 #include "papi_helper.h"
+#include "perf_event_helper.h"
 
 #endif // #ifndef __GUARD_INSTRUMENTATION_REGIONS_INCLUDES_H
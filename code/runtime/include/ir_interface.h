@@ -41,7 +41,9 @@
 #include "declarations.h"
 #include "instrumentation_regions.h"
 #include "utils/timing.h"
+#ifndef IRT_DECLARATIONS_ONLY
 #include "utils/impl/timing.impl.h"
+#endif
 #include "work_item.h"
 #include "work_group.h"
 
@@ -58,7 +60,7 @@ typedef struct _irt_parallel_job {
 	irt_lw_data_item* args;
 } irt_parallel_job;
 
-irt_joinable irt_joinable_null() {
+static inline irt_joinable irt_joinable_null() {
 	static irt_joinable null_joinable = {{{0}}};
 	return null_joinable;
 }
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+#pragma once
+#ifndef __GUARD_IRT_ALL_DECLS_H
+#define __GUARD_IRT_ALL_DECLS_H
+
+/*
+    Declarations of the runtime interface for translation units which are linked against
+    a unit including irt_all_impls.h (e.g. generated code distributed among multiple units).
+    In declaration-only mode, runtime headers only declare global variables and functions
+    instead of defining them, such that all units share the state of the primary unit.
+*/
+
+#define IRT_DECLARATIONS_ONLY
+
+#include "irt_globals.h"
+#include "irt_context.h"
+#include "data_item.h"
+#include "work_item.h"
+#include "work_group.h"
+#include "worker.h"
+#include "irt_lock.h"
+#include "irt_task_deps.h"
+#include "channels.h"
+#include "ir_interface.h"
+#include "instrumentation_regions.h"
+#include "irt_types.h"
+#include "wi_implementation.h"
+#include "impl/work_item_accessors.impl.h"
+#include "abstraction/atomic.h"
+
+// entry points provided by standalone.h
+uint32 irt_get_default_worker_count();
+void irt_runtime_standalone(uint32 worker_count, init_context_fun* init_fun, cleanup_context_fun* cleanup_fun, irt_wi_implementation* impl,
+                            irt_lw_data_item* startup_params);
+void irt_exit(int i);
+
+#endif // ifndef __GUARD_IRT_ALL_DECLS_H
@@ -47,10 +47,13 @@
 #include "impl/work_group.impl.h"
 #include "impl/irt_events.impl.h"
 #include "impl/irt_lock.impl.h"
+#include "impl/irt_task_deps.impl.h"
+#include "impl/channels.impl.h"
 #include "impl/ir_interface.impl.h"
 #include "impl/irt_loop_sched.impl.h"
 #include "impl/irt_logging.impl.h"
 #include "impl/papi_helper.impl.h"
+#include "impl/perf_event_helper.impl.h"
 #include "irt_types.h"
 #include "meta_information/meta_infos.h"
 #include "wi_implementation.h"
@@ -83,7 +83,9 @@ struct _irt_context {
 
 /* ------------------------------ operations ----- */
 
+#ifndef IRT_DECLARATIONS_ONLY
 static inline irt_context* irt_context_get_current();
+#endif
 
 irt_context* irt_context_create(irt_client_app*, init_context_fun*, cleanup_context_fun*);
 irt_context* irt_context_create_standalone(init_context_fun*, cleanup_context_fun*);
@@ -159,6 +159,11 @@ typedef enum _irt_wg_event_code {
 IRT_DECLARE_EVENTS(work_group, wg, IRT_WG_EV_NUM)
 
 
+void irt_event_debug_init();
+void irt_event_debug_destroy();
+
+#ifndef IRT_DECLARATIONS_ONLY
+
 void irt_event_debug_init() {
 	// add each new event type to this functions also
 	_IRT_EVENT_DEBUG_INIT(wi)
@@ -171,5 +176,7 @@ void irt_event_debug_destroy() {
 	_IRT_EVENT_DEBUG_DESTROY(wg)
 }
 
+#endif // ifndef IRT_DECLARATIONS_ONLY
+
 
 #endif // ifndef __GUARD_IRT_EVENTS_H
@@ -55,13 +55,34 @@ struct _irt_loop_sched_policy {
 	} param;
 };
 
-static irt_loop_sched_policy irt_g_loop_sched_policy_default;
-static irt_loop_sched_policy irt_g_loop_sched_policy_single;
+#ifndef IRT_DECLARATIONS_ONLY
+irt_loop_sched_policy irt_g_loop_sched_policy_default;
+irt_loop_sched_policy irt_g_loop_sched_policy_single;
+#else
+extern irt_loop_sched_policy irt_g_loop_sched_policy_default;
+extern irt_loop_sched_policy irt_g_loop_sched_policy_single;
+#endif
+
+// per-implementation state of the adaptive (IRT_ADAPTIVE) loop scheduling policy
+// every candidate policy is tried IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS times, then the one with the lowest
+// average cost per iteration is locked in for all further executions of the implementation
+// zero-initialized state corresponds to "nothing measured yet, no policy bound"
+typedef struct _irt_loop_sched_selector {
+	volatile uint32 updating;                                   // try-lock guarding the statistics below
+	volatile uint32 samples[IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS];  // number of measured executions per candidate
+	double cost[IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS];              // average ticks per iteration per candidate
+	volatile int32 locked_arm;                                  // index of the chosen candidate + 1, 0 while exploring
+	const irt_loop_sched_policy* bound_policy;                  // fixed policy bound to the implementation, overrides everything
+} irt_loop_sched_selector;
 
 struct _irt_loop_sched_data {
 	irt_loop_sched_policy policy;
 	volatile uint64 completed;
 	volatile uint64 block_size;
+	// bookkeeping for the adaptive policy, only used if the group policy is IRT_ADAPTIVE
+	int32 adaptive_arm;
+	uint64 adaptive_start_time;
+	volatile uint32 adaptive_participants_complete;
 	#ifdef IRT_RUNTIME_TUNING
 	volatile uint32 participants_complete;
 	uint64 start_time;
@@ -73,12 +94,24 @@ struct _irt_loop_sched_data {
 
 // schedule a loop using the policy specified for this group
 // runs the optimizer and collects instrumentation data if the IRT_RUNTIME_TUNING flag is active
+#ifndef IRT_DECLARATIONS_ONLY
 inline static void irt_schedule_loop(irt_work_item* self, irt_work_group* group, irt_work_item_range base_range, irt_wi_implementation* impl,
                                      irt_lw_data_item* args);
+#endif
 
 // sets the scheduling policy for the given group
 // it will activate upon reaching the next loop
 void irt_wg_set_loop_scheduling_policy(irt_work_group* group, const irt_loop_sched_policy* policy);
 
+// binds a fixed scheduling policy to all loops executing the given implementation
+// overrides the policy of the executing group; binding IRT_ADAPTIVE enables adaptive selection for this implementation only
+// pass NULL to remove the binding
+// the policy is referenced, not copied, and needs to outlive its use
+void irt_loop_sched_bind_policy(irt_wi_implementation* impl, const irt_loop_sched_policy* policy);
+
+// returns the policy the adaptive selector locked in for the given implementation
+// returns false if the selector is still exploring or the implementation was never run adaptively
+bool irt_loop_sched_get_adaptive_choice(irt_wi_implementation* impl, irt_loop_sched_policy_type* chosen);
+
 
 #endif // ifndef __GUARD_IRT_LOOP_SCHED_H
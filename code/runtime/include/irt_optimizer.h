@@ -123,6 +123,9 @@ typedef struct _irt_optimizer_runtime_data {
 	bool hc_end;   // true if hill climbing completed
 	int16 hc_elem; // element in irt_optimizer_wi_data_id currently hill climbed
 	int8 hc_dir;   // current hill climbing direction
+	#ifdef IRT_ENABLE_OMPP_OPTIMIZER_PARETO
+	struct _irt_optimizer_pareto_front* pareto_front; // non-dominated settings explored so far
+	#endif
 	irt_spinlock spinlock;
 } irt_optimizer_runtime_data;
 
@@ -81,16 +81,19 @@ void irt_scheduling_set_dop_per_socket(uint32 sockets, uint32* dops);
  * and/or splitting them) as well as checking the process-wide event queue
  * from time to time.
  */
-inline int irt_scheduling_iteration(irt_worker* self);
+int irt_scheduling_iteration(irt_worker* self);
 
 /* The scheduling loop which repeatedly runs scheduling iterations.
  * Should take care not to cause too much overhead when there is nothing
- * to schedule.
+ * to schedule. With IRT_WORKER_SLEEPING (the default), idle workers spin with
+ * exponential backoff, then yield and finally park until they are signaled,
+ * unless irt_scheduling_worker_sleep vetoes.
  */
 void irt_scheduling_loop(irt_worker* self);
 
 /* A notification function that should be called whenever a new wi
- * enters the queue of the target worker.
+ * enters the queue of the target worker. Wakes only the target, and only
+ * if it is parked; no locks are taken.
  */
 void _irt_signal_worker(irt_worker* target);
 #ifdef IRT_WORKER_SLEEPING
@@ -113,24 +116,27 @@ void irt_scheduling_assign_wi(irt_worker* target, irt_work_item* wi);
  * scheduling policies may manage wis differently, this needs to be provided
  * by the scheduling policy.
  */
+#ifndef IRT_DECLARATIONS_ONLY
 static inline void irt_scheduling_continue_wi(irt_worker* target, irt_work_item* wi);
+#endif
 
 /* Either runs wi directly on the current worker, or acts identically to
  * irt_scheduling_assign_wi. The decision depends on the scheduling policy.
  */
-inline irt_joinable irt_scheduling_optional_wi(irt_worker* target, irt_work_item* wi);
+irt_joinable irt_scheduling_optional_wi(irt_worker* target, irt_work_item* wi);
 
 /* Either runs implementation directly on the current worker, or creates a work item
  * for it and acts identically to irt_scheduling_assign_wi. The decision depends on the scheduling policy.
  */
-inline irt_joinable irt_scheduling_optional(irt_worker* target, const irt_work_item_range* range, irt_wi_implementation* impl, irt_lw_data_item* args);
+irt_joinable irt_scheduling_optional(irt_worker* target, const irt_work_item_range* range, irt_wi_implementation* impl, irt_lw_data_item* args);
 
 /* Work item yielding_wi yields on self.
  * Precondition: yielding_wi is self's current_wi
  */
 void irt_scheduling_yield(irt_worker* self, irt_work_item* yielding_wi);
 
-/* Prepare worker for sleep. Self must be executing the call.
+/* Prepare worker for sleep. Self must be executing the call and has already
+ * announced parking, so work published after this check will signal it.
  * returns true if sleep should proceed, false to stay awake
  */
 bool irt_scheduling_worker_sleep(irt_worker* self);
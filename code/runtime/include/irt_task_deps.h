@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_IRT_TASK_DEPS_H
+#define __GUARD_IRT_TASK_DEPS_H
+
+#include "declarations.h"
+#include "abstraction/threads.h"
+
+/* ------------------------------ data structures ----- */
+
+// A node of the dependence graph among the tasks spawned by a single work item.
+// The node is created by the spawning work item, which registers the addresses the task reads and writes in its
+// dependence table before spawning it. The task waits for the node to become ready before executing its body and
+// releases it once done, enabling its successors.
+struct _irt_task_dep_node {
+	irt_spinlock lock;
+	volatile int32 ref_count;       // references held by the dependence table and the task itself
+	uint32 num_pending;             // number of predecessors which are not yet completed
+	bool completed;
+	irt_task_dep_node** successors; // tasks waiting for this one to complete
+	uint32 num_successors;
+	uint32 successors_capacity;
+	irt_work_item* waiting_wi;      // the task, if it is suspended waiting for its predecessors
+	irt_worker* waiting_worker;
+	irt_task_dep_table* table;      // the table of the spawning work item
+};
+
+// per-address record of the last task writing to it and the tasks reading it since then
+typedef struct _irt_task_dep_entry {
+	void* address;
+	irt_task_dep_node* last_writer;
+	irt_task_dep_node** readers;
+	uint32 num_readers;
+	uint32 readers_capacity;
+	struct _irt_task_dep_entry* next;
+} irt_task_dep_entry;
+
+// the dependence table of a work item, only accessed by that work item
+struct _irt_task_dep_table {
+	irt_task_dep_entry* buckets[IRT_TASK_DEP_TABLE_BUCKETS];
+};
+
+/* ------------------------------ operations ----- */
+
+// creates a new dependence node for a task about to be spawned by the current work item
+irt_task_deps irt_task_deps_create();
+
+// registers an access of the task to the given address, which will be ordered after preceding conflicting accesses
+void irt_task_deps_add(irt_task_deps deps, void* address, bool write);
+
+// suspends the current work item until all predecessors of the given node have completed
+void irt_task_deps_wait(irt_task_deps deps);
+
+// marks the given node as completed, enabling its successors
+void irt_task_deps_release(irt_task_deps deps);
+
+// releases the dependence table of the given work item, if any
+void irt_task_dep_table_destroy(irt_work_item* wi);
+
+#endif // ifndef __GUARD_IRT_TASK_DEPS_H
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_OPTIMIZERS_FREQUENCY_PROVIDER_H
+#define __GUARD_OPTIMIZERS_FREQUENCY_PROVIDER_H
+
+#include <math.h>
+#include <string.h>
+
+#include "utils/frequency.h"
+
+/*
+ * Frequency / energy providers decouple the OpenMP+ optimizer from the hardware it is tuning.
+ *
+ * The hardware provider forwards to the cpufreq interface (utils/frequency.h), its resource consumption
+ * has to be measured by region instrumentation. The simulated provider implements a deterministic model of
+ * execution time and energy as a function of frequency and thread count, which allows the optimizer to be
+ * exercised and benchmarked on machines without writable cpufreq or RAPL.
+ */
+
+// a configuration evaluated by a provider
+typedef struct _irt_optimizer_provider_config {
+	uint32 frequency; // in MHz
+	uint32 thread_count;
+} irt_optimizer_provider_config;
+
+// the resources consumed by one execution of a region in a given configuration
+typedef struct _irt_optimizer_provider_measurement {
+	double time;   // in s
+	double energy; // in J
+} irt_optimizer_provider_measurement;
+
+typedef struct _irt_optimizer_provider {
+	const char* name;
+	// fills frequencies (in MHz, descending) and sets length, returns 0 on success (same convention as irt_cpu_freq_get_available_frequencies)
+	int32 (*get_available_frequencies)(void* state, uint32* frequencies, uint32* length);
+	// sets the frequency of the core the given worker is running on (NULL for all workers), returns 0 on success
+	int32 (*set_frequency_worker)(void* state, const irt_worker* worker, uint32 frequency);
+	// predicts the resources consumed in the given configuration, NULL if the provider can only be measured
+	bool (*evaluate)(void* state, const irt_optimizer_provider_config* config, irt_optimizer_provider_measurement* result);
+	void* state;
+} irt_optimizer_provider;
+
+// model parameters of the simulated provider
+typedef struct _irt_optimizer_sim_model {
+	uint32 min_frequency;      // in MHz
+	uint32 max_frequency;      // in MHz
+	uint32 frequency_step;     // in MHz
+	uint32 max_threads;        // number of cores available
+	double work;               // runtime of the region on a single core at max_frequency, in s
+	double serial_fraction;    // share of the work which does not scale with the number of threads (Amdahl)
+	double memory_fraction;    // share of the work which does not scale with the frequency (memory bound)
+	double static_power;       // power consumed by the package independently of its load, in W
+	double core_dynamic_power; // power consumed by each busy core at max_frequency, in W
+	double core_idle_power;    // power consumed by each idle core, in W
+	// frequency last set per worker by the optimizer, index IRT_MAX_WORKERS is used for requests on all workers
+	uint32 cur_frequency[IRT_MAX_WORKERS + 1];
+	uint32 set_frequency_calls;
+} irt_optimizer_sim_model;
+
+// initializes a simulated model roughly resembling a quad core desktop processor running a mostly compute bound region
+void irt_optimizer_sim_model_init_default(irt_optimizer_sim_model* model, uint32 max_threads);
+
+// initializes provider to forward to the hardware
+void irt_optimizer_provider_init_hardware(irt_optimizer_provider* provider);
+
+// initializes provider to simulate model, which needs to outlive the provider
+void irt_optimizer_provider_init_simulated(irt_optimizer_provider* provider, irt_optimizer_sim_model* model);
+
+// the provider used by the optimizer, selected by irt_optimizer_provider_select_from_env
+irt_optimizer_provider irt_g_optimizer_provider;
+irt_optimizer_sim_model irt_g_optimizer_sim_model;
+
+// selects irt_g_optimizer_provider based on the IRT_OPTIMIZER_PROVIDER environment variable ("hardware" or "simulated")
+void irt_optimizer_provider_select_from_env();
+
+
+/* ------------------------------ hardware provider ----- */
+
+int32 _irt_optimizer_hw_get_available_frequencies(void* state, uint32* frequencies, uint32* length) {
+	return irt_cpu_freq_get_available_frequencies(frequencies, length);
+}
+
+int32 _irt_optimizer_hw_set_frequency_worker(void* state, const irt_worker* worker, uint32 frequency) {
+	return irt_cpu_freq_set_frequency_worker(worker, frequency);
+}
+
+void irt_optimizer_provider_init_hardware(irt_optimizer_provider* provider) {
+	provider->name = "hardware";
+	provider->get_available_frequencies = &_irt_optimizer_hw_get_available_frequencies;
+	provider->set_frequency_worker = &_irt_optimizer_hw_set_frequency_worker;
+	provider->evaluate = NULL;
+	provider->state = NULL;
+}
+
+
+/* ------------------------------ simulated provider ----- */
+
+void irt_optimizer_sim_model_init_default(irt_optimizer_sim_model* model, uint32 max_threads) {
+	memset(model, 0, sizeof(irt_optimizer_sim_model));
+	model->min_frequency = 1200;
+	model->max_frequency = 3400;
+	model->frequency_step = 200;
+	model->max_threads = max_threads;
+	model->work = 1.0;
+	model->serial_fraction = 0.05;
+	model->memory_fraction = 0.2;
+	model->static_power = 15.0;
+	model->core_dynamic_power = 10.0;
+	model->core_idle_power = 1.0;
+}
+
+int32 _irt_optimizer_sim_get_available_frequencies(void* state, uint32* frequencies, uint32* length) {
+	irt_optimizer_sim_model* model = (irt_optimizer_sim_model*)state;
+	uint32 count = 0;
+	for(uint32 f = model->max_frequency; f >= model->min_frequency; f -= model->frequency_step) {
+		frequencies[count++] = f;
+		if(model->frequency_step == 0 || f < model->min_frequency + model->frequency_step) { break; }
+	}
+	*length = count;
+	return 0;
+}
+
+int32 _irt_optimizer_sim_set_frequency_worker(void* state, const irt_worker* worker, uint32 frequency) {
+	irt_optimizer_sim_model* model = (irt_optimizer_sim_model*)state;
+	if(frequency < model->min_frequency || frequency > model->max_frequency) { return -1; }
+	model->cur_frequency[worker ? worker->id.thread : IRT_MAX_WORKERS] = frequency;
+	model->set_frequency_calls++;
+	return 0;
+}
+
+// time: the frequency dependent part of the work scales with max_frequency / frequency, the parallel part with 1 / thread_count
+// power: static power, plus dynamic power of the busy cores scaling cubically with the frequency (voltage tracks frequency),
+//        plus idle power of the remaining cores; during the serial part only a single core is busy
+bool _irt_optimizer_sim_evaluate(void* state, const irt_optimizer_provider_config* config, irt_optimizer_provider_measurement* result) {
+	irt_optimizer_sim_model* model = (irt_optimizer_sim_model*)state;
+	if(config->thread_count == 0 || config->thread_count > model->max_threads || config->frequency == 0) { return false; }
+
+	double slowdown = model->memory_fraction + (1.0 - model->memory_fraction) * ((double)model->max_frequency / config->frequency);
+	double serial_time = model->work * model->serial_fraction * slowdown;
+	double parallel_time = model->work * (1.0 - model->serial_fraction) * slowdown / config->thread_count;
+
+	double core_power = model->core_dynamic_power * pow((double)config->frequency / model->max_frequency, 3.0);
+	double serial_power = model->static_power + core_power + (model->max_threads - 1) * model->core_idle_power;
+	double parallel_power = model->static_power + config->thread_count * core_power + (model->max_threads - config->thread_count) * model->core_idle_power;
+
+	result->time = serial_time + parallel_time;
+	result->energy = serial_time * serial_power + parallel_time * parallel_power;
+	return true;
+}
+
+void irt_optimizer_provider_init_simulated(irt_optimizer_provider* provider, irt_optimizer_sim_model* model) {
+	provider->name = "simulated";
+	provider->get_available_frequencies = &_irt_optimizer_sim_get_available_frequencies;
+	provider->set_frequency_worker = &_irt_optimizer_sim_set_frequency_worker;
+	provider->evaluate = &_irt_optimizer_sim_evaluate;
+	provider->state = model;
+}
+
+void irt_optimizer_provider_select_from_env() {
+	char* provider_env = getenv(IRT_OPTIMIZER_PROVIDER_ENV);
+	if(provider_env && strcmp(provider_env, "simulated") == 0) {
+		irt_optimizer_sim_model_init_default(&irt_g_optimizer_sim_model, irt_g_worker_count);
+		irt_optimizer_provider_init_simulated(&irt_g_optimizer_provider, &irt_g_optimizer_sim_model);
+	} else {
+		if(provider_env && strcmp(provider_env, "hardware") != 0) { IRT_WARN("Unknown optimizer provider requested: %s, using hardware\n", provider_env); }
+		irt_optimizer_provider_init_hardware(&irt_g_optimizer_provider);
+	}
+	irt_log_setting_s("IRT_OPTIMIZER_PROVIDER", irt_g_optimizer_provider.name);
+}
+
+
+#endif // ifndef __GUARD_OPTIMIZERS_FREQUENCY_PROVIDER_H
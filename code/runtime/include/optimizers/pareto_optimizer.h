@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_OPTIMIZERS_PARETO_OPTIMIZER_H
+#define __GUARD_OPTIMIZERS_PARETO_OPTIMIZER_H
+
+#include <float.h>
+
+#include "irt_optimizer.h"
+#include "optimizers/frequency_provider.h"
+
+/*
+ * Multi-objective search for the OpenMP+ optimizer.
+ *
+ * Instead of hill climbing along a single objective, every evaluated configuration is offered to an archive
+ * which keeps only the configurations that are not dominated in (wall time, energy, quality). Once the search
+ * space has been sampled, the configuration best matching the weights and bounds of the region objective is
+ * picked from the front.
+ */
+
+typedef struct _irt_optimizer_pareto_point {
+	irt_optimizer_wi_data_id id;
+	irt_optimizer_resources resources;
+} irt_optimizer_pareto_point;
+
+typedef struct _irt_optimizer_pareto_front {
+	uint32 size;
+	irt_optimizer_pareto_point points[IRT_OPTIMIZER_PARETO_MAX_POINTS];
+} irt_optimizer_pareto_front;
+
+// returns true if a is at least as good as b in every objective and better in at least one
+bool irt_optimizer_pareto_dominates(const irt_optimizer_resources* a, const irt_optimizer_resources* b);
+
+// offers a configuration to the front, removing all points it dominates
+// returns false if it is dominated by a point of the front (or the front is full), in which case the front is unchanged
+bool irt_optimizer_pareto_insert(irt_optimizer_pareto_front* front, const irt_optimizer_wi_data_id* id, const irt_optimizer_resources* resources);
+
+// returns the index of the point best matching the objective, -1 if the front is empty
+// points violating a bound of the objective are only picked if no point satisfies all of them, then the fastest one is used
+int32 irt_optimizer_pareto_select(const irt_optimizer_pareto_front* front, const ompp_objective_info* objective);
+
+// evaluates all combinations of the given frequencies (indices into frequencies are stored in the points)
+// and 1 to max_threads threads using provider, which needs to be able to predict resources
+// returns the number of evaluated configurations
+uint32 irt_optimizer_pareto_sweep(irt_optimizer_pareto_front* front, const irt_optimizer_provider* provider, const uint32* frequencies,
+                                  uint32 frequency_count, uint32 max_threads);
+
+
+bool irt_optimizer_pareto_dominates(const irt_optimizer_resources* a, const irt_optimizer_resources* b) {
+	if(a->wall_time > b->wall_time || a->cpu_energy > b->cpu_energy || a->quality > b->quality) { return false; }
+	return a->wall_time < b->wall_time || a->cpu_energy < b->cpu_energy || a->quality < b->quality;
+}
+
+bool irt_optimizer_pareto_insert(irt_optimizer_pareto_front* front, const irt_optimizer_wi_data_id* id, const irt_optimizer_resources* resources) {
+	for(uint32 i = 0; i < front->size; ++i) {
+		if(irt_optimizer_pareto_dominates(&front->points[i].resources, resources)) { return false; }
+	}
+	// compact the front, dropping dominated points
+	uint32 kept = 0;
+	for(uint32 i = 0; i < front->size; ++i) {
+		if(!irt_optimizer_pareto_dominates(resources, &front->points[i].resources)) { front->points[kept++] = front->points[i]; }
+	}
+	front->size = kept;
+	if(front->size == IRT_OPTIMIZER_PARETO_MAX_POINTS) {
+		IRT_DEBUG("Pareto front full, dropping non-dominated configuration");
+		return false;
+	}
+	front->points[front->size].id = *id;
+	front->points[front->size].resources = *resources;
+	front->size++;
+	return true;
+}
+
+// bounds of ompp objectives are disabled by negative values
+static inline bool _irt_optimizer_pareto_satisfies(const irt_optimizer_resources* res, const ompp_objective_info* objective) {
+	double time = (double)res->wall_time / 1e9;
+	double energy = (double)res->cpu_energy;
+	double power = time > 0.0 ? energy / time : 0.0;
+	if(objective->time_max >= 0 && time > objective->time_max) { return false; }
+	if(objective->energy_max >= 0 && energy > objective->energy_max) { return false; }
+	if(objective->power_max >= 0 && power > objective->power_max) { return false; }
+	if(objective->quality_max >= 0 && res->quality > objective->quality_max * objective->param_count) { return false; }
+	return true;
+}
+
+int32 irt_optimizer_pareto_select(const irt_optimizer_pareto_front* front, const ompp_objective_info* objective) {
+	if(front->size == 0) { return -1; }
+
+	// normalize every objective by its best value on the front, so weights are independent of units
+	double min_time = DBL_MAX, min_energy = DBL_MAX, min_power = DBL_MAX, min_quality = DBL_MAX;
+	for(uint32 i = 0; i < front->size; ++i) {
+		const irt_optimizer_resources* res = &front->points[i].resources;
+		double time = (double)res->wall_time / 1e9;
+		double energy = (double)res->cpu_energy;
+		min_time = MIN(min_time, time);
+		min_energy = MIN(min_energy, energy);
+		min_power = MIN(min_power, time > 0.0 ? energy / time : 0.0);
+		min_quality = MIN(min_quality, (double)res->quality);
+	}
+
+	// without any weights, minimize energy (as the hill climbing optimizer does)
+	bool weighted = objective->time_weight > 0 || objective->energy_weight > 0 || objective->power_weight > 0 || objective->quality_weight > 0;
+
+	int32 best = -1, fastest = 0;
+	double best_score = DBL_MAX;
+	for(uint32 i = 0; i < front->size; ++i) {
+		const irt_optimizer_resources* res = &front->points[i].resources;
+		if(res->wall_time < front->points[fastest].resources.wall_time) { fastest = i; }
+		if(!_irt_optimizer_pareto_satisfies(res, objective)) { continue; }
+
+		double time = (double)res->wall_time / 1e9;
+		double energy = (double)res->cpu_energy;
+		double score;
+		if(weighted) {
+			double power = time > 0.0 ? energy / time : 0.0;
+			score = 0.0;
+			if(objective->time_weight > 0) { score += objective->time_weight * time / MAX(min_time, DBL_MIN); }
+			if(objective->energy_weight > 0) { score += objective->energy_weight * energy / MAX(min_energy, DBL_MIN); }
+			if(objective->power_weight > 0) { score += objective->power_weight * power / MAX(min_power, DBL_MIN); }
+			if(objective->quality_weight > 0) { score += objective->quality_weight * (res->quality + 1) / (min_quality + 1); }
+		} else {
+			score = energy;
+		}
+		if(score < best_score) {
+			best_score = score;
+			best = i;
+		}
+	}
+	return best >= 0 ? best : fastest;
+}
+
+uint32 irt_optimizer_pareto_sweep(irt_optimizer_pareto_front* front, const irt_optimizer_provider* provider, const uint32* frequencies,
+                                  uint32 frequency_count, uint32 max_threads) {
+	if(!provider->evaluate) { return 0; }
+	uint32 evaluations = 0;
+	for(uint32 f = 0; f < frequency_count; ++f) {
+		for(uint32 t = 1; t <= max_threads; ++t) {
+			irt_optimizer_provider_config config = {frequencies[f], t};
+			irt_optimizer_provider_measurement measurement;
+			if(!provider->evaluate(provider->state, &config, &measurement)) { continue; }
+			evaluations++;
+
+			// ids use the same encoding as the hill climbing optimizer: frequency index and 0 based thread count
+			irt_optimizer_wi_data_id id;
+			memset(&id, 0, sizeof(id));
+			id.frequency = f;
+			id.thread_count = t - 1;
+			irt_optimizer_resources resources;
+			memset(&resources, 0, sizeof(resources));
+			resources.wall_time = (uint64)(measurement.time * 1e9);
+			resources.cpu_energy = measurement.energy;
+			irt_optimizer_pareto_insert(front, &id, &resources);
+		}
+	}
+	return evaluations;
+}
+
+
+#endif // ifndef __GUARD_OPTIMIZERS_PARETO_OPTIMIZER_H
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_PERF_EVENT_HELPER_H
+#define __GUARD_PERF_EVENT_HELPER_H
+
+/*
+ *
+ * Hardware performance counters via the Linux perf_event_open interface, an alternative to PAPI
+ * for nodes without a PAPI installation. Enabled with IRT_USE_PERF_EVENT (ignored if IRT_USE_PAPI
+ * is set as well).
+ *
+ * The supported counters are exposed under their PAPI preset names, such that region
+ * instrumentation output stays compatible. Select them like PAPI events, i.e. via
+ * IRT_INST_REGION_INSTRUMENTATION_TYPES, e.g. "wall_time,PAPI_TOT_CYC,PAPI_TOT_INS".
+ *
+ * Each worker opens one counter group which keeps counting for its whole lifetime; starting and
+ * stopping a measurement merely reads the counters. Whenever the kernel permits it, counters are
+ * read in user space via rdpmc, otherwise (or if the group has been multiplexed) via read(),
+ * with counts scaled by time_enabled / time_running.
+ *
+ * Note that /proc/sys/kernel/perf_event_paranoid must be 2 or lower.
+ *
+ */
+
+#define IRT_INST_PERF_EVENT_MAX_COUNTERS 8
+
+typedef enum {
+	IRT_PERF_EVENT_TOT_CYC, // PAPI_TOT_CYC
+	IRT_PERF_EVENT_TOT_INS, // PAPI_TOT_INS
+	IRT_PERF_EVENT_L1_DCM,  // PAPI_L1_DCM
+	IRT_PERF_EVENT_L3_TCM,  // PAPI_L3_TCM
+	IRT_PERF_EVENT_BR_MSP,  // PAPI_BR_MSP
+	IRT_PERF_EVENT_NUM_EVENTS
+} irt_perf_event_type;
+
+typedef struct {
+	volatile uint32 open;
+	uint32 num_counters;
+	int32 fds[IRT_INST_PERF_EVENT_MAX_COUNTERS]; // fds[0] is the group leader
+	irt_perf_event_type types[IRT_INST_PERF_EVENT_MAX_COUNTERS];
+	void* pages[IRT_INST_PERF_EVENT_MAX_COUNTERS]; // mapped perf_event_mmap_page per counter, NULL if rdpmc is unavailable
+	int64 start_values[IRT_INST_PERF_EVENT_MAX_COUNTERS]; // raw counts at the start of the current measurement
+	uint64 start_time_enabled;                           // time the group has been enabled at the start of the current measurement
+	uint64 start_time_running;                           // time the group has been running at the start of the current measurement
+} irt_perf_event_worker_data;
+
+void irt_perf_event_setup_context(irt_context* context);
+
+void irt_perf_event_finalize_context(irt_context* context);
+
+void irt_perf_event_setup_worker(irt_worker* worker);
+
+void irt_perf_event_finalize_worker(irt_worker* worker);
+
+void irt_perf_event_start();
+
+void irt_perf_event_stop(int64* perf_values);
+
+int64 irt_perf_event_get_value(int64* perf_values, irt_perf_event_type type);
+
+void irt_perf_event_select_events(irt_worker* worker, const char* events_string);
+
+void irt_perf_event_select_events_from_env(irt_worker* worker);
+
+#endif // ifndef __GUARD_PERF_EVENT_HELPER_H
@@ -68,6 +68,11 @@ void irt_scheduling_init_worker(irt_worker* self) {
 	irt_work_item_deque_init(&self->sched_data.pool);
 }
 
+bool irt_scheduling_worker_sleep(irt_worker* self) {
+	// thieves are never signaled, so idle workers only back off
+	return false;
+}
+
 int irt_scheduling_iteration(irt_worker* self) {
 	// try to take a ready WI from the pool
 	irt_work_item* next_wi = irt_work_item_deque_pop_front(&self->sched_data.pool);
@@ -47,6 +47,11 @@ void irt_scheduling_init_worker(irt_worker* self) {
 	irt_work_item_deque_init(&self->sched_data.pool);
 }
 
+bool irt_scheduling_worker_sleep(irt_worker* self) {
+	// thieves are never signaled, so idle workers only back off
+	return false;
+}
+
 // linear predecessor single stealing
 
 int irt_scheduling_iteration(irt_worker* self) {
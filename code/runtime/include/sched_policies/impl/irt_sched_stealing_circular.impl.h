@@ -43,6 +43,7 @@
 #include "impl/worker.impl.h"
 
 #include "ir_interface.h"
+#include "meta_information/meta_infos.h"
 
 #ifdef _WIN32
 #include "../../include_win32/rand_r.h"
@@ -52,6 +53,21 @@
 
 // ============================================================================ Scheduling (general)
 
+// work in any queue may be stolen by any worker => wake up one parked worker to steal it
+static inline void _irt_cwb_wake_thief(irt_worker* target) {
+	#ifdef IRT_WORKER_SLEEPING
+	// the locked read orders this check after the preceding push, see _irt_scheduling_park
+	if(irt_atomic_fetch_and_add(&irt_g_active_worker_count, 0, uint32) >= irt_g_worker_count) { return; }
+	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+		irt_worker* cur = irt_g_workers[i];
+		if(cur != target && irt_atomic_load(&cur->park_state) == IRT_WORKER_PARK_PARKED) {
+			irt_signal_worker(cur);
+			return;
+		}
+	}
+	#endif // IRT_WORKER_SLEEPING
+}
+
 static inline bool _irt_cwb_try_push_back(irt_worker* target, irt_work_item* wi) {
 	// if other full, find random worker
 	bool success = false;
@@ -62,6 +78,7 @@ static inline bool _irt_cwb_try_push_back(irt_worker* target, irt_work_item* wi)
 			target = irt_g_workers[rand_r(&(irt_worker_get_current()->rand_seed)) % irt_g_worker_count];
 		} else {
 			irt_signal_worker(target);
+			_irt_cwb_wake_thief(target);
 		}
 		tries--;
 	}
@@ -77,6 +94,7 @@ static inline bool _irt_cwb_try_push_front(irt_worker* target, irt_work_item* wi
 			target = irt_g_workers[rand_r(&(irt_worker_get_current()->rand_seed)) % irt_g_worker_count];
 		} else {
 			irt_signal_worker(target);
+			_irt_cwb_wake_thief(target);
 		}
 		tries--;
 	}
@@ -92,6 +110,16 @@ void irt_scheduling_init_worker(irt_worker* self) {
 	#endif // IRT_TASK_OPT
 }
 
+bool irt_scheduling_worker_sleep(irt_worker* self) {
+	// only sleep if there is nothing left to steal - since parking has already been announced,
+	// work pushed after this check will wake up a thief
+	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+		irt_worker* cur = irt_g_workers[i];
+		if(irt_cwb_size(&cur->sched_data.queue) > 0 || cur->sched_data.overflow_stack != NULL) { return false; }
+	}
+	return irt_atomic_bool_compare_and_swap(&self->state, IRT_WORKER_STATE_RUNNING, IRT_WORKER_STATE_SLEEPING, uint32);
+}
+
 void irt_scheduling_yield(irt_worker* self, irt_work_item* yielding_wi) {
 	IRT_DEBUG("Worker yield, worker: %p,  wi: %p", (void*)self, (void*)yielding_wi);
 	irt_inst_insert_wi_event(self, IRT_INST_WORK_ITEM_YIELD, yielding_wi->id);
@@ -157,6 +185,13 @@ uint32 irt_scheduling_select_taskopt_variant(irt_work_item* wi, irt_worker* wo)
 		//} else if(demand > (IRT_CWBUFFER_LENGTH*(IRT_NUM_TASK_VARIANTS-6))/(IRT_NUM_TASK_VARIANTS*2)) {
 		//	return 5;
 	}
+	// never select variants estimated to spawn too fine-grained tasks at compile time
+	irt_meta_info_table_entry* info = wi->impl->variants[0].meta_info;
+	if(irt_meta_info_is_task_granularity_available(info)) {
+		uint64 min_variant = irt_meta_info_get_task_granularity(info)->min_variant;
+		if(selection < min_variant) { selection = min_variant; }
+	}
+	if(selection >= wi->impl->num_variants) { selection = wi->impl->num_variants - 1; }
 	irt_inst_insert_db_event(wo, IRT_INST_DBG_TASK_SELECTION, *(irt_worker_id*)(&selection));
 	return (uint32)selection;
 }
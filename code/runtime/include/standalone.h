@@ -98,9 +98,9 @@ void irt_init_globals() {
 	irt_time_ticks_per_sec_calibration_mark();
 
 	_irt_hw_info_init();
-	#if defined IRT_ENABLE_REGION_INSTRUMENTATION && !defined _GEMS
+	#if(defined IRT_ENABLE_REGION_INSTRUMENTATION || defined IRT_ENABLE_INSTRUMENTATION) && !defined _GEMS
 	irt_maintenance_init();
-	#endif // IRT_ENABLE_REGION_INSTRUMENTATION
+	#endif // IRT_ENABLE_REGION_INSTRUMENTATION || IRT_ENABLE_INSTRUMENTATION
 
 	// not using IRT_ASSERT since environment is not yet set up
 	int err_flag = irt_tls_key_create(&irt_g_worker_key);
@@ -111,7 +111,6 @@ void irt_init_globals() {
 	irt_mutex_init(&irt_g_error_mutex);
 	irt_mutex_init(&irt_g_exit_handler_mutex);
 	irt_mutex_init(&irt_g_degree_of_parallelism_mutex);
-	irt_mutex_init(&irt_g_active_worker_mutex);
 	irt_data_item_table_init();
 	irt_context_table_init();
 	irt_wi_event_register_table_init();
@@ -184,9 +183,9 @@ void irt_exit_handler() {
 
 	_irt_hw_info_shutdown();
 
-	#if defined IRT_ENABLE_REGION_INSTRUMENTATION && !defined _GEMS
+	#if(defined IRT_ENABLE_REGION_INSTRUMENTATION || defined IRT_ENABLE_INSTRUMENTATION) && !defined _GEMS
 	irt_maintenance_cleanup();
-	#endif // IRT_ENABLE_REGION_INSTRUMENTATION
+	#endif // IRT_ENABLE_REGION_INSTRUMENTATION || IRT_ENABLE_INSTRUMENTATION
 
 	#ifdef USE_OPENCL
 	irt_ocl_release_devices();
@@ -225,13 +224,13 @@ void* _irt_init_signalable(irt_worker_init_signal* signal) {
 void _irt_wake_sleeping_workers(irt_worker_init_signal* signal, void* ev_handle) {
 // Windows XP Version
 #if defined(WINVER) && (WINVER < 0x0600)
-	while(!irt_atomic_bool_compare_and_swap(&(signal->init_count), irt_g_worker_count, irt_g_worker_count)) {
+	while(!irt_atomic_bool_compare_and_swap(&(signal->init_count), signal->init_target, signal->init_target)) {
 	}
 	// wake waiting threads
 	SetEvent(ev_handle);
 	#else
 	irt_mutex_lock(&(signal->init_mutex));
-	if(signal->init_count < irt_g_worker_count) { irt_cond_wait(&(signal->init_condvar), &(signal->init_mutex)); }
+	if(signal->init_count < signal->init_target) { irt_cond_wait(&(signal->init_condvar), &(signal->init_mutex)); }
 	irt_mutex_unlock(&(signal->init_mutex));
 	#endif
 }
@@ -260,20 +259,31 @@ void irt_runtime_start(irt_runtime_behaviour_flags behaviour, uint32 worker_coun
 	irt_g_worker_count = worker_count;
 	irt_g_active_worker_count = worker_count;
 	irt_g_degree_of_parallelism = worker_count;
-	irt_g_workers = (irt_worker**)malloc(irt_g_worker_count * sizeof(irt_worker*));
+	irt_g_workers = (irt_worker**)calloc(irt_g_worker_count, sizeof(irt_worker*));
 
 	// initialize affinity mapping & load affinity policy
 	irt_affinity_init_physical_mapping(&irt_g_affinity_physical_mapping);
 	irt_affinity_policy aff_policy = irt_load_affinity_from_env();
 
+	// in lazy startup mode, only the first worker gets a thread right away
+	// the others are fully prepared, such that they can be targeted by scheduling, but their threads are only started in the
+	// background once parallelism is requested (see irt_worker_request_lazy_startup)
+	bool lazy = getenv(IRT_LAZY_WORKER_STARTUP_ENV) && irt_g_worker_count > 1;
+	irt_log_setting_u("IRT_LAZY_WORKER_STARTUP", lazy);
+	irt_g_worker_lazy_startup = lazy ? IRT_WORKER_LAZY_STARTUP_PENDING : IRT_WORKER_LAZY_STARTUP_DISABLED;
+
 	// initialize workers
 	static irt_worker_init_signal signalStruct;
 	signalStruct.init_count = 0;
+	signalStruct.init_target = lazy ? 1 : irt_g_worker_count;
 
 	void* ev_handle = _irt_init_signalable(&signalStruct);
 
 	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
-		irt_worker_create(i, irt_get_affinity(i, aff_policy), &signalStruct);
+		irt_worker_prepare(i, irt_get_affinity(i, aff_policy));
+	}
+	for(uint32 i = 0; i < signalStruct.init_target; ++i) {
+		irt_worker_start(irt_g_workers[i], &signalStruct);
 	}
 
 	// wait until all workers have signaled readiness
@@ -70,7 +70,9 @@ typedef struct {
 	uint32 map[IRT_MAX_CORES];
 } irt_affinity_physical_mapping;
 
+#ifndef IRT_DECLARATIONS_ONLY
 static irt_affinity_physical_mapping irt_g_affinity_physical_mapping;
+#endif
 
 #define IRT_AFFINITY_MASK_BITS_PER_QUAD ((uint64)64)                                 // number of processors identifiable through a bitmask
 #define IRT_AFFINTY_MASK_NUM_QUADS (IRT_MAX_CORES / IRT_AFFINITY_MASK_BITS_PER_QUAD) // number of bitmasks required to capture every processor
@@ -86,7 +88,11 @@ static const irt_affinity_mask irt_g_empty_affinity_mask = {{0}};
 
 // original affinity mask before any changes to affinity were applied; will be restored
 // when calling irt_clear_affinity()
+#ifndef IRT_DECLARATIONS_ONLY
 static irt_native_cpu_set irt_g_affinity_base_mask;
+#endif
+
+#ifndef IRT_DECLARATIONS_ONLY
 
 // affinity mask struct handling ////////////////////////////////////////////////////////////////////////////
 
@@ -112,6 +118,8 @@ irt_affinity_policy irt_load_affinity_from_env();
 
 static inline irt_affinity_mask irt_get_affinity(uint32 id, irt_affinity_policy policy);
 
+#endif // ifndef IRT_DECLARATIONS_ONLY
+
 void irt_set_global_affinity_policy(irt_affinity_policy policy);
 
 
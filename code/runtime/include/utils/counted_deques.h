@@ -39,7 +39,9 @@
 #define __GUARD_UTILS_COUNTED_DEQUES_H
 
 #include "abstraction/threads.h"
+#ifndef IRT_DECLARATIONS_ONLY
 #include "abstraction/impl/threads.impl.h"
+#endif
 
 #include "error_handling.h"
 
@@ -39,8 +39,10 @@
 #define __GUARD_UTILS_DEQUES_H
 
 #include "abstraction/threads.h"
+#ifndef IRT_DECLARATIONS_ONLY
 #include "abstraction/impl/threads.impl.h"
 #include "abstraction/impl/spin_locks.impl.h"
+#endif
 
 #include "error_handling.h"
 
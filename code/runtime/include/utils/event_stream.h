@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+#ifndef __GUARD_UTILS_EVENT_STREAM_H
+#define __GUARD_UTILS_EVENT_STREAM_H
+
+#include <string.h>
+
+#include "irt_inttypes.h"
+
+/*
+ * Record encoding of streamed worker event logs (file version "INSIEME2").
+ *
+ * This header only depends on the basic integer types, so it is shared between the
+ * runtime (which writes the streams) and the stand-alone merge tool (which reads them).
+ *
+ * -------------------------------------------------------------
+ *  8 byte: char, file version identifier, must read "INSIEME2"!
+ *  4 byte: uint32, number of event name table entries (=n)
+ *  4 byte: uint32, id of the worker thread that recorded the events
+ *  8 byte: uint64, clock ticks per second (0 if unknown, timestamps are raw ticks then)
+ *  8 byte: uint64, number of events (=m)
+ *  8 byte: uint64, size of the record section in bytes
+ * -------------------------------------------------------------
+ *  4 byte: char, event group identifier 1
+ * 60 byte: char, event name identifier 1
+ * ...
+ *  4 byte: char, event group identifier n
+ * 60 byte: char, event name identifier n
+ * -------------------------------------------------------------
+ *  record 1 ... record m, each consisting of four LEB128 varints:
+ *   - zig-zag encoded timestamp difference to the previous record (to 0 for the first one)
+ *   - event id
+ *   - thread id
+ *   - target index
+ * -------------------------------------------------------------
+ * EOF
+ *
+ * The header is updated after every flush, hence a stream of a crashed program can still
+ * be read up to the last completed flush.
+ */
+
+#define IRT_INST_EVENT_STREAM_MAGIC "INSIEME2"
+#define IRT_INST_EVENT_STREAM_NAME_SIZE 64
+#define IRT_INST_EVENT_STREAM_GROUP_NAME_SIZE 4
+
+// upper bound for the size of a single encoded record: 10 + 3 + 3 + 5 bytes
+#define IRT_INST_EVENT_STREAM_MAX_RECORD_SIZE 21
+
+typedef struct _irt_inst_event_stream_header {
+	char magic[8];
+	uint32 num_event_types;
+	uint32 worker;
+	uint64 ticks_per_sec;
+	uint64 number_of_events;
+	uint64 payload_size;
+} irt_inst_event_stream_header;
+
+typedef struct _irt_inst_event_stream_record {
+	uint64 timestamp;
+	uint16 event_id;
+	uint16 thread;
+	uint32 index;
+} irt_inst_event_stream_record;
+
+// returns the offset of the first record within a stream
+static inline uint64 irt_inst_event_stream_payload_offset(const irt_inst_event_stream_header* header) {
+	return sizeof(irt_inst_event_stream_header) + (uint64)header->num_event_types * IRT_INST_EVENT_STREAM_NAME_SIZE;
+}
+
+static inline char* _irt_inst_event_stream_put_varint(char* out, uint64 value) {
+	while(value >= 0x80) {
+		*out++ = (char)((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	*out++ = (char)value;
+	return out;
+}
+
+// returns NULL if the varint is truncated by the end of the buffer
+static inline const char* _irt_inst_event_stream_get_varint(const char* in, const char* end, uint64* value) {
+	uint64 result = 0;
+	for(uint32 shift = 0; in < end && shift < 64; shift += 7) {
+		uint8 byte = (uint8)*in++;
+		result |= (uint64)(byte & 0x7F) << shift;
+		if(!(byte & 0x80)) {
+			*value = result;
+			return in;
+		}
+	}
+	return NULL;
+}
+
+// encodes the given record relative to the timestamp of its predecessor, returns the new end of the output
+static inline char* irt_inst_event_stream_encode(char* out, const irt_inst_event_stream_record* record, uint64 previous_timestamp) {
+	int64 delta = (int64)(record->timestamp - previous_timestamp);
+	out = _irt_inst_event_stream_put_varint(out, ((uint64)delta << 1) ^ (uint64)(delta >> 63));
+	out = _irt_inst_event_stream_put_varint(out, record->event_id);
+	out = _irt_inst_event_stream_put_varint(out, record->thread);
+	return _irt_inst_event_stream_put_varint(out, record->index);
+}
+
+// decodes the record starting at in, returns the start of the next record or NULL if the record is incomplete
+static inline const char* irt_inst_event_stream_decode(const char* in, const char* end, irt_inst_event_stream_record* record, uint64 previous_timestamp) {
+	uint64 delta, event_id, thread, index;
+	if(!(in = _irt_inst_event_stream_get_varint(in, end, &delta))) { return NULL; }
+	if(!(in = _irt_inst_event_stream_get_varint(in, end, &event_id))) { return NULL; }
+	if(!(in = _irt_inst_event_stream_get_varint(in, end, &thread))) { return NULL; }
+	if(!(in = _irt_inst_event_stream_get_varint(in, end, &index))) { return NULL; }
+	record->timestamp = previous_timestamp + (uint64)((int64)(delta >> 1) ^ -(int64)(delta & 1));
+	record->event_id = (uint16)event_id;
+	record->thread = (uint16)thread;
+	record->index = (uint32)index;
+	return in;
+}
+
+#endif // ifndef __GUARD_UTILS_EVENT_STREAM_H
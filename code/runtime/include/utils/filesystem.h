@@ -44,7 +44,7 @@
 /*
  * returns the temporary directory using standard conventions
  */
-const char* irt_get_tmp_dir() {
+static inline const char* irt_get_tmp_dir() {
 	if(getenv("TMPDIR")) {
 		return getenv("TMPDIR");
 	}
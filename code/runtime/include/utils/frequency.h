@@ -47,7 +47,9 @@
  */
 
 // cached information about the current cpu min/max frequencies, eliminates superfluous writes
+#ifndef IRT_DECLARATIONS_ONLY
 static uint32 irt_g_cpu_freq_cur_state[IRT_MAX_CORES][2];
+#endif
 
 /*
  * reads all available frequencies for all available cores as a list into the provided pointer
@@ -172,6 +172,7 @@ static inline irt_affinity_mask irt_get_affinity(uint32 id, irt_affinity_policy
 }
 
 void irt_set_global_affinity_policy(irt_affinity_policy policy) {
+	irt_worker_await_lazy_startup();
 	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
 		irt_affinity_mask mask = irt_get_affinity(i, policy);
 		irt_set_affinity(mask, irt_g_workers[i]->thread);
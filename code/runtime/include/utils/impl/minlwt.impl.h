@@ -44,63 +44,206 @@
 #include "impl/error_handling.impl.h"
 #include "abstraction/atomic.h"
 
-//#include <sys/mman.h> /* not required for now, mmap not used (see below) */
+#ifdef IRT_LWT_STACK_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 struct _lwt_g_stack_reuse {
 	lwt_reused_stack* stacks[IRT_MAX_WORKERS];
+	// number of stacks in each worker's pool
+	uint32 counts[IRT_MAX_WORKERS];
+	// surplus stacks handed back by workers with full pools, available to all workers
+	lwt_reused_stack* shared;
+	uint32 shared_count;
+	volatile uint32 shared_lock;
 } lwt_g_stack_reuse;
 
-lwt_reused_stack* _lwt_get_stack(int w_id) {
-	lwt_reused_stack* ret = lwt_g_stack_reuse.stacks[w_id];
-	#ifdef LWT_STACK_STEALING_ENABLED
-	if(ret) {
-		if(irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.stacks[w_id], ret, ret->next, intptr_t)) {
-			// IRT_DEBUG("LWT_RE\n");
-			return ret;
-		} else {
-			return _lwt_get_stack(w_id);
-		}
-	} else {
-		for(int i = 0; i < irt_g_worker_count; ++i) {
-			ret = lwt_g_stack_reuse.stacks[i];
-			if(ret && irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.stacks[i], ret, ret->next, intptr_t)) {
-				// IRT_DEBUG("LWT_ST\n");
-				return ret;
-			}
-		}
-	}
+#ifdef IRT_LWT_STACK_MMAP
+
+#define _LWT_ROUND_UP(__value, __granularity) ((((__value) + (__granularity)-1) / (__granularity)) * (__granularity))
+
+static inline size_t _lwt_page_size() {
+	static size_t page_size = 0;
+	if(page_size == 0) { page_size = (size_t)sysconf(_SC_PAGESIZE); }
+	return page_size;
+}
+
+static inline size_t _lwt_stack_guard_size() {
+	return _LWT_ROUND_UP((size_t)(IRT_LWT_STACK_GUARD_SIZE), _lwt_page_size());
+}
+
+// a stack mapping consists of the guard region, followed by the lwt_reused_stack header and the stack itself
+// (overflowing stacks grow downwards, over the header into the guard region)
+static inline size_t _lwt_stack_mapping_size() {
+	size_t size = _lwt_stack_guard_size() + sizeof(lwt_reused_stack) + IRT_WI_STACK_SIZE + 4;
+	#ifdef IRT_LWT_STACK_HUGEPAGES
+	return _LWT_ROUND_UP(size, (size_t)(IRT_LWT_STACK_HUGEPAGE_SIZE));
 	#else
-	if(ret) {
-		// IRT_DEBUG("LWT_RE\n");
-		// IRT_VERBOSE_ONLY(
-		//{
-		//	int num_stacks=1;
-		//	lwt_reused_stack* cur = ret;
-		//	while(cur = cur->next) num_stacks++;
-		//	printf("-- %d, Reusing stack %p, %d stack(s) available:\n", w_id, (void*) ret, num_stacks);
-		//	cur = ret;
-		//	printf("---- ");
-		//	do { printf("%p, ", (void*) cur);  } while(cur = cur->next);
-		//	printf("\n");
-		//});
-		lwt_g_stack_reuse.stacks[w_id] = ret->next;
-		return ret;
-	}
+	return _LWT_ROUND_UP(size, _lwt_page_size());
 	#endif
+}
 
-	// create new
+static inline lwt_reused_stack* _lwt_alloc_stack() {
+	size_t size = _lwt_stack_mapping_size();
+	// MAP_NORESERVE: physical memory is only committed for the pages a work item actually touches
+	#ifdef IRT_LWT_STACK_HUGEPAGES
+	// over-allocate, and trim the mapping to huge page alignment
+	size_t alignment = IRT_LWT_STACK_HUGEPAGE_SIZE;
+	char* raw = (char*)mmap(NULL, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	IRT_ASSERT(raw != MAP_FAILED, IRT_ERR_IO, "Mmap of lwt stack failed.\n");
+	char* base = (char*)_LWT_ROUND_UP((uintptr_t)raw, alignment);
+	if(base > raw) { munmap(raw, base - raw); }
+	if(raw + alignment > base) { munmap(base + size, (raw + alignment) - base); }
+	#ifdef MADV_HUGEPAGE
+	// only a hint, fails harmlessly if transparent huge pages are disabled
+	madvise(base, size, MADV_HUGEPAGE);
+	#endif
+	#else
+	char* base = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	IRT_ASSERT(base != MAP_FAILED, IRT_ERR_IO, "Mmap of lwt stack failed.\n");
+	#endif
+	size_t guard = _lwt_stack_guard_size();
+	IRT_ASSERT(guard == 0 || mprotect(base, guard, PROT_NONE) == 0, IRT_ERR_IO, "Protecting lwt stack guard region failed.\n");
+	return (lwt_reused_stack*)(base + guard);
+}
+
+static inline void _lwt_free_stack(lwt_reused_stack* stack) {
+	munmap((char*)stack - _lwt_stack_guard_size(), _lwt_stack_mapping_size());
+}
+
+// returns the memory of a pooled stack to the OS, except for the header page and the pre-faulted top of the stack
+static inline void _lwt_decommit_stack(lwt_reused_stack* stack) {
+	uintptr_t start = _LWT_ROUND_UP((uintptr_t)stack->stack, _lwt_page_size());
+	uintptr_t end = (uintptr_t)stack->stack + IRT_WI_STACK_SIZE - MIN(IRT_LWT_STACK_PREFAULT_SIZE, IRT_WI_STACK_SIZE);
+	end -= end % _lwt_page_size();
+	if(end > start) { madvise((void*)start, end - start, MADV_DONTNEED); }
+}
+
+#else
+
+static inline lwt_reused_stack* _lwt_alloc_stack() {
 	// static unsigned long long total = 0;
 	// total += sizeof(lwt_reused_stack) + IRT_WI_STACK_SIZE;
 	// printf("Total allocated: %6.2lf MB\n", total/(1024.0*1024.0));
 	// TODO [_GEMS]: we need +4 because of gemsclaim compiler generated instruction: when entering a function call the sp is stored on the stack
-	ret = (lwt_reused_stack*)malloc(sizeof(lwt_reused_stack) + IRT_WI_STACK_SIZE + 4);
-
+	lwt_reused_stack* ret = (lwt_reused_stack*)malloc(sizeof(lwt_reused_stack) + IRT_WI_STACK_SIZE + 4);
 	IRT_ASSERT(ret != NULL, IRT_ERR_IO, "Malloc of lwt stack failed.\n");
+	return ret;
+}
+
+static inline void _lwt_free_stack(lwt_reused_stack* stack) {
+	free(stack);
+}
+
+static inline void _lwt_decommit_stack(lwt_reused_stack* stack) {}
+
+#endif // IRT_LWT_STACK_MMAP
+
+// takes a stack from the pool of worker tid, returns NULL if the pool is empty
+static inline lwt_reused_stack* _lwt_pop_stack(int tid) {
+#ifdef LWT_STACK_STEALING_ENABLED
+	for(;;) {
+		lwt_reused_stack* top = lwt_g_stack_reuse.stacks[tid];
+		if(!top) { return NULL; }
+		if(irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.stacks[tid], top, top->next, intptr_t)) {
+			irt_atomic_dec(&lwt_g_stack_reuse.counts[tid], uint32);
+			return top;
+		}
+	}
+	#else
+	lwt_reused_stack* top = lwt_g_stack_reuse.stacks[tid];
+	if(top) {
+		lwt_g_stack_reuse.stacks[tid] = top->next;
+		lwt_g_stack_reuse.counts[tid]--;
+	}
+	return top;
+	#endif
+}
+
+// makes a stack available for reuse by worker tid
+static inline void _lwt_push_stack(int tid, lwt_reused_stack* stack) {
+#ifdef LWT_STACK_STEALING_ENABLED
+	for(;;) {
+		lwt_reused_stack* top = lwt_g_stack_reuse.stacks[tid];
+		stack->next = top;
+		if(irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.stacks[tid], top, stack, intptr_t)) {
+			irt_atomic_inc(&lwt_g_stack_reuse.counts[tid], uint32);
+			return;
+		}
+	}
+	#else
+	stack->next = lwt_g_stack_reuse.stacks[tid];
+	lwt_g_stack_reuse.stacks[tid] = stack;
+	lwt_g_stack_reuse.counts[tid]++;
+	#endif
+}
+
+static inline void _lwt_lock_shared_pool() {
+	while(!irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.shared_lock, 0, 1, uint32)) {}
+}
+
+static inline void _lwt_unlock_shared_pool() {
+	irt_atomic_store(&lwt_g_stack_reuse.shared_lock, 0);
+}
+
+// takes a stack from the shared pool, returns NULL if it is empty
+static inline lwt_reused_stack* _lwt_take_shared_stack() {
+	// cheap unsynchronized check first, the pool is empty most of the time
+	if(irt_atomic_load(&lwt_g_stack_reuse.shared) == NULL) { return NULL; }
+	_lwt_lock_shared_pool();
+	lwt_reused_stack* ret = lwt_g_stack_reuse.shared;
+	if(ret) {
+		lwt_g_stack_reuse.shared = ret->next;
+		lwt_g_stack_reuse.shared_count--;
+	}
+	_lwt_unlock_shared_pool();
+	return ret;
+}
+
+// hands a surplus stack to the shared pool, or releases it if the shared pool is full as well
+static inline void _lwt_give_shared_stack(lwt_reused_stack* stack) {
+	_lwt_decommit_stack(stack);
+	_lwt_lock_shared_pool();
+	if(lwt_g_stack_reuse.shared_count < IRT_LWT_STACK_SHARED_POOL_MAX) {
+		stack->next = lwt_g_stack_reuse.shared;
+		lwt_g_stack_reuse.shared = stack;
+		lwt_g_stack_reuse.shared_count++;
+		stack = NULL;
+	}
+	_lwt_unlock_shared_pool();
+	if(stack) { _lwt_free_stack(stack); }
+}
 
+lwt_reused_stack* _lwt_get_stack(int w_id) {
+	lwt_reused_stack* ret = _lwt_pop_stack(w_id);
+	if(ret) { return ret; }
+	#ifdef LWT_STACK_STEALING_ENABLED
+	for(int i = 0; i < irt_g_worker_count; ++i) {
+		ret = _lwt_pop_stack(i);
+		if(ret) { return ret; }
+	}
+	#endif
+	ret = _lwt_take_shared_stack();
+	if(ret) { return ret; }
+
+	// create new
+	ret = _lwt_alloc_stack();
 	ret->next = NULL;
 	return ret;
 }
 
+void lwt_fill_stack_pool(int tid, uint32 count) {
+	for(uint32 available = lwt_g_stack_reuse.counts[tid]; available < count; ++available) {
+		lwt_reused_stack* stack = _lwt_take_shared_stack();
+		if(!stack) { stack = _lwt_alloc_stack(); }
+		// stacks grow downwards, so the top pages are the ones touched by every work item
+		uint64 prefault = MIN(IRT_LWT_STACK_PREFAULT_SIZE, IRT_WI_STACK_SIZE);
+		memset(stack->stack + IRT_WI_STACK_SIZE - prefault, 0, prefault);
+		_lwt_push_stack(tid, stack);
+	}
+}
+
 static inline void lwt_recycle(int tid, irt_work_item* wi) {
 	if(!wi->stack_storage) {
 	#ifdef IRT_ASTEROIDEA_STACKS
@@ -113,40 +256,13 @@ static inline void lwt_recycle(int tid, irt_work_item* wi) {
 		#endif // IRT_ASTEROIDEA_STACKS
 		return;
 	}
-	#ifdef LWT_STACK_STEALING_ENABLED
-	for(;;) {
-		lwt_reused_stack* top = lwt_g_stack_reuse.stacks[tid];
-		wi->stack_storage->next = top;
-		if(irt_atomic_bool_compare_and_swap(&lwt_g_stack_reuse.stacks[tid], top, wi->stack_storage, intptr_t)) {
-			// IRT_DEBUG("LWT_CYC\n");
-			return;
-		} else {
-			// IRT_DEBUG("LWT_FCY\n");
-		}
+	// keep worker pools bounded, surplus stacks go to the shared pool where workers running short pick them up
+	if(lwt_g_stack_reuse.counts[tid] >= IRT_LWT_STACK_POOL_MAX) {
+		_lwt_give_shared_stack(wi->stack_storage);
+	} else {
+		_lwt_push_stack(tid, wi->stack_storage);
 	}
-	#else
-	// IRT_VERBOSE_ONLY(
-	//{
-	//	int num_stacks=0;
-	//	if(lwt_g_stack_reuse.stacks[tid]) {
-	//		num_stacks=1;
-	//		lwt_reused_stack* cur = lwt_g_stack_reuse.stacks[tid];
-	//		while(cur = cur->next) num_stacks++;
-	//	}
-	//	printf("-- %d, Recycling stack %p, %d stack(s) available:\n", tid, (void*) wi->stack_storage, num_stacks);
-	//	if(lwt_g_stack_reuse.stacks[tid]) {
-	//		lwt_reused_stack* cur = lwt_g_stack_reuse.stacks[tid];
-	//		printf("---- ");
-	//		do { printf("%p, ", (void*) cur);  } while(cur = cur->next);
-	//		printf("\n");
-	//	}
-	//});
-	wi->stack_storage->next = lwt_g_stack_reuse.stacks[tid];
-	lwt_g_stack_reuse.stacks[tid] = wi->stack_storage;
 	wi->stack_storage = NULL;
-	// printf("Reuse!");
-	// IRT_DEBUG("LWT_CYC\n");
-	#endif
 }
 
 #ifdef USING_MINLWT
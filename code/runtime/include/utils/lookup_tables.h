@@ -40,7 +40,9 @@
 
 #include "abstraction/threads.h"
 #include "abstraction/spin_locks.h"
+#ifndef IRT_DECLARATIONS_ONLY
 #include "abstraction/impl/spin_locks.impl.h"
+#endif
 #include "abstraction/rdtsc.h"
 #include "utils/timing.h"
 
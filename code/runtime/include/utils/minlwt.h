@@ -91,8 +91,13 @@ typedef intptr_t lwt_context;
 typedef ucontext_t lwt_context;
 #endif
 
+#ifndef IRT_DECLARATIONS_ONLY
 static inline void lwt_prepare(int tid, irt_work_item* wi, lwt_context* basestack);
 static inline void lwt_recycle(int tid, irt_work_item* wi);
+#endif
+// tops up the reusable stacks of worker tid to count stacks, touching the top IRT_LWT_STACK_PREFAULT_SIZE bytes of new ones
+// needs to be called by the worker owning the stacks
+void lwt_fill_stack_pool(int tid, uint32 count);
 void lwt_start(irt_work_item* wi, lwt_context* basestack, wi_implementation_func* func);
 void lwt_continue(lwt_context* newstack, lwt_context* basestack);
 void lwt_end(lwt_context* basestack);
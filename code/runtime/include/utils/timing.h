@@ -72,7 +72,11 @@ struct timespec {
 */
 
 
+#ifndef IRT_DECLARATIONS_ONLY
 uint64 irt_g_time_ticks_per_sec = 0;
+#else
+extern uint64 irt_g_time_ticks_per_sec;
+#endif
 
 // ====== sleep functions ======================================
 
@@ -43,6 +43,7 @@
 #include "data_item.h"
 
 #include "irt_optimizer.h"
+#include "irt_loop_sched.h"
 
 /* ------------------------------ data structures ----- */
 
@@ -70,6 +71,7 @@ struct _irt_wi_implementation_runtime_data {
 	uint32 completed_wi_count;
 	#endif
 	uint32 chunk_size;
+	irt_loop_sched_selector loop_sched_selector;
 };
 
 struct _irt_wi_implementation_variant {
@@ -64,6 +64,8 @@ struct _irt_work_group {
 	volatile uint32 joined_pfor_count; // index of the latest joined pfor
 	irt_loop_sched_policy cur_sched;   // current scheduling policy
 	irt_loop_sched_data loop_sched_data[IRT_WG_RING_BUFFER_SIZE];
+	irt_spinlock ordered_lock;
+	struct _irt_wg_ordered_waiter* ordered_waiters; // members suspended in an ordered region, protected by ordered_lock
 	#ifdef IRT_ENABLE_REGION_INSTRUMENTATION
 	volatile uint64 regions_started;
 	volatile uint64 regions_ended;
@@ -80,7 +82,18 @@ struct _irt_wi_wg_membership {
 	uint32 pfor_count;
 };
 
+// a member waiting for the ordered counter of a loop to reach the value of its iteration
+typedef struct _irt_wg_ordered_waiter {
+	irt_work_item* wi;
+	irt_worker* worker;
+	volatile int64* counter;
+	int64 value;
+	struct _irt_wg_ordered_waiter* next;
+} irt_wg_ordered_waiter;
+
 typedef void irt_wg_redistribution_function(void** collected, uint32 local_id, uint32 num_participants, void* out_result);
+// folds the value pointed to by in into the one pointed to by inout
+typedef void irt_wg_reduction_function(void* inout, void* in);
 
 /* ------------------------------ operations ----- */
 
@@ -88,7 +101,9 @@ irt_work_group* _irt_wg_create(irt_worker* self);
 irt_work_group* irt_wg_create();
 void irt_wg_destroy(irt_work_group* wg);
 
+#ifndef IRT_DECLARATIONS_ONLY
 static inline void _irt_wg_end_member(irt_work_group* wg);
+#endif
 
 // inline void irt_wg_join(irt_work_group* wg);
 // inline void irt_wg_leave(irt_work_group* wg);
@@ -96,12 +111,20 @@ static inline void _irt_wg_end_member(irt_work_group* wg);
 void irt_wg_insert(irt_work_group* wg, irt_work_item* wi);
 void irt_wg_remove(irt_work_group* wg, irt_work_item* wi);
 
+#ifndef IRT_DECLARATIONS_ONLY
 static inline uint32 irt_wg_get_wi_num(irt_work_group* wg, irt_work_item* wi);
 static inline irt_wi_wg_membership* irt_wg_get_wi_membership(irt_work_group* wg, irt_work_item* wi);
+#endif
 
 void irt_wg_barrier(irt_work_group* wg);
 void irt_wg_joining_barrier(irt_work_group* wg);
 void irt_wg_redistribute(irt_work_group* wg, irt_work_item* this_wi, void* my_data, void* result_data, irt_wg_redistribution_function* func);
+// combines the values of all group members pairwise in log2(#members) steps, member 0's value holds the result afterwards
+void irt_wg_reduce(irt_work_group* wg, irt_work_item* this_wi, void* value, irt_wg_reduction_function* combine);
 void irt_wg_join(irt_work_group_id wg_id);
+// blocks until the given ordered counter reaches the given value; spins briefly, then yields, then suspends until signaled
+void irt_wg_ordered_wait(irt_work_group* wg, volatile int64* counter, int64 value);
+// advances the given ordered counter and resumes the member waiting for its new value, if any
+void irt_wg_ordered_advance(irt_work_group* wg, volatile int64* counter, int64 increment);
 
 #endif // ifndef __GUARD_WORK_GROUP_H
@@ -46,6 +46,7 @@
 #include "irt_scheduling.h"
 #include "irt_events.h"
 #include "data_item.h"
+#include "irt_task_deps.h"
 
 /* ------------------------------ data structures ----- */
 
@@ -65,14 +66,20 @@ static const irt_work_item_range irt_g_wi_range_one_elem = {0, 1, 1};
 static inline int64 irt_wi_range_get_size(const irt_work_item_range* r) {
 	return (r->end - r->begin) / r->step;
 }
+#ifndef IRT_DECLARATIONS_ONLY
 static inline void _irt_print_work_item_range(const irt_work_item_range* r);
+#endif
 
 typedef bool irt_wi_readiness_check_fun(irt_work_item* wi);
 typedef struct _irt_wi_readiness_check {
 	irt_wi_readiness_check_fun* fun;
 	void* data;
 } irt_wi_readiness_check;
+#ifndef IRT_DECLARATIONS_ONLY
 irt_wi_readiness_check irt_g_null_readiness_check = {NULL, NULL};
+#else
+extern irt_wi_readiness_check irt_g_null_readiness_check;
+#endif
 
 struct _irt_work_item {
 	// core functionality
@@ -90,6 +97,8 @@ struct _irt_work_item {
 	irt_wi_wg_membership* wg_memberships;
 	volatile irt_work_item_state state;
 	irt_lw_data_item* parameters;
+	// dependences among the tasks spawned by this wi, created on demand
+	irt_task_dep_table* task_dep_table;
 	// wi splitting related
 	irt_work_item_id source_id;
 	uint32 num_fragments;
@@ -124,7 +133,9 @@ static inline uint32 irt_wi_get_wg_size(irt_work_item* wi, uint32 index);
 static inline irt_work_group* irt_wi_get_wg(irt_work_item* wi, uint32 index);
 
 irt_work_item* _irt_wi_create(irt_worker* self, const irt_work_item_range* range, irt_wi_implementation* impl, irt_lw_data_item* params);
+#ifndef IRT_DECLARATIONS_ONLY
 static inline irt_work_item* irt_wi_create(irt_work_item_range range, irt_wi_implementation* impl, irt_lw_data_item* params);
+#endif
 
 // on the WIN64 platform, function _irt_wi_trampoline will be called from a linked obj-file, which implements some
 // functionality in assembly code for  -> thus its name must not be mangled by a c++ compiler -> wrap extern "C" around
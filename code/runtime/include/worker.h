@@ -67,6 +67,22 @@ typedef enum _irt_worker_state {
 	IRT_WORKER_STATE_JOINED
 } irt_worker_state;
 
+// values of the futex word an idle worker parks on (see irt_scheduling_loop)
+typedef enum _irt_worker_park_state {
+	IRT_WORKER_PARK_AWAKE,   // worker is running or idling without being parked
+	IRT_WORKER_PARK_PARKED,  // worker is blocked on its park word
+	IRT_WORKER_PARK_NOTIFIED // worker has been signaled since it last checked
+} irt_worker_park_state;
+
+// progress of bringing up the workers beyond the first one in lazy startup mode (see irt_runtime_start)
+typedef enum _irt_worker_lazy_startup_state {
+	IRT_WORKER_LAZY_STARTUP_DISABLED, // all workers are started eagerly
+	IRT_WORKER_LAZY_STARTUP_PENDING,  // only worker 0 is running, the others are prepared but have no thread yet
+	IRT_WORKER_LAZY_STARTUP_SPAWNING, // a background thread is starting the remaining workers
+	IRT_WORKER_LAZY_STARTUP_DONE,     // all workers have been started
+	IRT_WORKER_LAZY_STARTUP_CANCELLED // the runtime shut down before parallelism was requested
+} irt_worker_lazy_startup_state;
+
 struct _irt_worker {
 	irt_worker_id id;
 	uint64 generator_id;
@@ -81,8 +97,8 @@ struct _irt_worker {
 	irt_work_item lazy_wi;
 
 	#ifdef IRT_WORKER_SLEEPING
-	bool wake_signal;
-	irt_cond_var wait_cond;
+	volatile uint32 park_state; // irt_worker_park_state
+	uint32 idle_rounds;
 	#endif
 	irt_cond_var dop_wait_cond;
 	irt_spinlock shutdown_lock;
@@ -117,6 +133,7 @@ struct _irt_worker {
 
 typedef struct _irt_worker_init_signal {
 	uint32 init_count;
+	uint32 init_target; // number of workers awaiting each other before entering their scheduling loop
 	#if !defined(_WIN32) || (WINVER >= 0x0600)
 	irt_cond_var init_condvar;
 	#endif
@@ -131,7 +148,20 @@ static inline irt_worker* irt_worker_get_current() {
 	return w;
 }
 
+// allocates and initializes the data structures of a worker and publishes it in irt_g_workers, without starting its thread
+irt_worker* irt_worker_prepare(uint16 index, irt_affinity_mask affinity);
+// starts the thread of a prepared worker, signal may be NULL for workers not taking part in the startup rendezvous
+void irt_worker_start(irt_worker* self, irt_worker_init_signal* signal);
+// prepares and starts a worker
 void irt_worker_create(uint16 index, irt_affinity_mask affinity, irt_worker_init_signal* signal);
+
+// in lazy startup mode, starts the remaining workers in the background if that has not happened yet
+// cheap to call if all workers are running already
+#ifndef IRT_DECLARATIONS_ONLY
+static inline void irt_worker_request_lazy_startup();
+#endif
+// in lazy startup mode, blocks until all workers have been started
+void irt_worker_await_lazy_startup();
 void irt_worker_late_init(irt_worker* self);
 void _irt_worker_cancel_all_others();
 
@@ -139,7 +169,7 @@ void _irt_worker_switch_to_wi(irt_worker* self, irt_work_item* wi);
 void _irt_worker_switch_from_wi(irt_worker* self, irt_work_item* wi);
 
 void irt_worker_run_immediate_wi(irt_worker* self, irt_work_item* wi);
-inline void irt_worker_run_immediate(irt_worker* target, const irt_work_item_range* range, irt_wi_implementation* impl, irt_lw_data_item* args);
+void irt_worker_run_immediate(irt_worker* target, const irt_work_item_range* range, irt_wi_implementation* impl, irt_lw_data_item* args);
 
 void irt_worker_cleanup(irt_worker* self);
 
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+/*
+ * Merges per-worker event logs into a single timeline ordered by time.
+ *
+ * usage: insieme_inst_event_merge [-o output.csv] worker_event_stream.0000 worker_event_stream.0001 ...
+ *
+ * Accepts streamed logs ("INSIEME2", see utils/event_stream.h) as well as binary logs written at
+ * shutdown ("INSIEME1"). Each line of the output reads
+ *
+ *   time,worker,group,thread,index,event
+ *
+ * where time is given in nanoseconds if the log records the clock rate, and in clock ticks otherwise.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils/event_stream.h"
+
+#define IRT_INST_EVENT_LOG_MAGIC "INSIEME1"
+
+typedef struct _irt_inst_merge_input {
+	const char* filename;
+	char* data;
+	uint64 size;
+	uint32 worker;
+	uint64 ticks_per_sec;
+	uint32 num_event_types;
+	const char* names;
+	bool legacy;
+	const char* cur;
+	const char* end;
+	uint64 remaining;
+	irt_inst_event_stream_record record; // current record of this input
+	uint64 time;                         // time of the current record
+} irt_inst_merge_input;
+
+static uint64 _irt_inst_merge_convert(const irt_inst_merge_input* input, uint64 ticks) {
+	if(input->ticks_per_sec == 0) { return ticks; }
+	return (uint64)(ticks / ((double)input->ticks_per_sec / 1000000000));
+}
+
+// advances the input to its next record, returns false if there is none
+static bool _irt_inst_merge_next(irt_inst_merge_input* input) {
+	if(input->remaining == 0) { return false; }
+	if(input->legacy) {
+		if(input->cur + 16 > input->end) { return false; }
+		memcpy(&input->record.timestamp, input->cur, sizeof(uint64));
+		memcpy(&input->record.event_id, input->cur + 8, sizeof(uint16));
+		memcpy(&input->record.thread, input->cur + 10, sizeof(uint16));
+		memcpy(&input->record.index, input->cur + 12, sizeof(uint32));
+		input->cur += 16;
+	} else {
+		const char* next = irt_inst_event_stream_decode(input->cur, input->end, &input->record, input->record.timestamp);
+		if(next == NULL) {
+			fprintf(stderr, "%s: truncated record, ignoring the remainder of the file\n", input->filename);
+			return false;
+		}
+		input->cur = next;
+	}
+	input->remaining--;
+	input->time = _irt_inst_merge_convert(input, input->record.timestamp);
+	return true;
+}
+
+static bool _irt_inst_merge_open(irt_inst_merge_input* input, const char* filename, uint32 position) {
+	memset(input, 0, sizeof(irt_inst_merge_input));
+	input->filename = filename;
+
+	int fd = open(filename, O_RDONLY);
+	struct stat st;
+	if(fd < 0 || fstat(fd, &st) != 0) {
+		fprintf(stderr, "%s: %s\n", filename, strerror(errno));
+		return false;
+	}
+	input->size = st.st_size;
+	input->data = input->size > 0 ? (char*)mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+	close(fd);
+	if(input->data == MAP_FAILED || input->size < 12) {
+		fprintf(stderr, "%s: not an event log\n", filename);
+		return false;
+	}
+
+	const char* end = input->data + input->size;
+	if(strncmp(input->data, IRT_INST_EVENT_STREAM_MAGIC, 8) == 0 && input->size >= sizeof(irt_inst_event_stream_header)) {
+		irt_inst_event_stream_header header;
+		memcpy(&header, input->data, sizeof(header));
+		input->worker = header.worker;
+		input->ticks_per_sec = header.ticks_per_sec;
+		input->num_event_types = header.num_event_types;
+		input->names = input->data + sizeof(header);
+		input->cur = input->data + irt_inst_event_stream_payload_offset(&header);
+		input->end = input->cur + header.payload_size;
+		input->remaining = header.number_of_events;
+	} else if(strncmp(input->data, IRT_INST_EVENT_LOG_MAGIC, 8) == 0) {
+		// legacy logs record neither worker nor clock rate, workers are numbered by argument position
+		input->legacy = true;
+		input->worker = position;
+		memcpy(&input->num_event_types, input->data + 8, sizeof(uint32));
+		input->names = input->data + 12;
+		input->cur = input->names + (uint64)input->num_event_types * IRT_INST_EVENT_STREAM_NAME_SIZE;
+		if(input->cur + sizeof(uint64) <= end) {
+			memcpy(&input->remaining, input->cur, sizeof(uint64));
+			input->cur += sizeof(uint64);
+		}
+		input->end = end;
+	} else {
+		fprintf(stderr, "%s: unknown event log version\n", filename);
+		return false;
+	}
+	if(input->cur > end || input->end > end) {
+		fprintf(stderr, "%s: corrupted header\n", filename);
+		return false;
+	}
+	return true;
+}
+
+// prints the name table entry of the given event, trimming the padding
+static void _irt_inst_merge_print_name(FILE* out, const irt_inst_merge_input* input, uint32 offset, uint32 length, uint16 event_id) {
+	if(event_id >= input->num_event_types) {
+		fprintf(out, "%u", event_id);
+		return;
+	}
+	const char* name = input->names + (uint64)event_id * IRT_INST_EVENT_STREAM_NAME_SIZE + offset;
+	while(length > 0 && name[length - 1] == ' ') {
+		length--;
+	}
+	fwrite(name, 1, length, out);
+}
+
+// restores the heap property for the subtree rooted at position i
+static void _irt_inst_merge_sift_down(irt_inst_merge_input** heap, uint32 size, uint32 i) {
+	for(;;) {
+		uint32 min = i, l = 2 * i + 1, r = 2 * i + 2;
+		if(l < size && heap[l]->time < heap[min]->time) { min = l; }
+		if(r < size && heap[r]->time < heap[min]->time) { min = r; }
+		if(min == i) { return; }
+		irt_inst_merge_input* tmp = heap[i];
+		heap[i] = heap[min];
+		heap[min] = tmp;
+		i = min;
+	}
+}
+
+int main(int argc, char** argv) {
+	FILE* out = stdout;
+	int first = 1;
+	if(argc > 2 && strcmp(argv[1], "-o") == 0) {
+		out = fopen(argv[2], "w");
+		if(out == NULL) {
+			fprintf(stderr, "%s: %s\n", argv[2], strerror(errno));
+			return 1;
+		}
+		first = 3;
+	}
+	if(first >= argc) {
+		fprintf(stderr, "usage: %s [-o output.csv] event_log...\n", argv[0]);
+		return 1;
+	}
+
+	uint32 num_inputs = argc - first;
+	irt_inst_merge_input* inputs = (irt_inst_merge_input*)malloc(num_inputs * sizeof(irt_inst_merge_input));
+	irt_inst_merge_input** heap = (irt_inst_merge_input**)malloc(num_inputs * sizeof(irt_inst_merge_input*));
+	uint32 heap_size = 0;
+	int result = 0;
+
+	for(uint32 i = 0; i < num_inputs; ++i) {
+		if(!_irt_inst_merge_open(&inputs[i], argv[first + i], i)) {
+			result = 1;
+			continue;
+		}
+		if(_irt_inst_merge_next(&inputs[i])) { heap[heap_size++] = &inputs[i]; }
+	}
+	for(uint32 i = heap_size / 2; i-- > 0;) {
+		_irt_inst_merge_sift_down(heap, heap_size, i);
+	}
+
+	// k-way merge, each input is ordered by time on its own
+	uint64 events = 0;
+	while(heap_size > 0) {
+		irt_inst_merge_input* input = heap[0];
+		irt_inst_event_stream_record* record = &input->record;
+		fprintf(out, "%" PRIu64 ",%u,", input->time, input->worker);
+		_irt_inst_merge_print_name(out, input, 0, IRT_INST_EVENT_STREAM_GROUP_NAME_SIZE, record->event_id);
+		fprintf(out, ",%u,%u,", record->thread, record->index);
+		_irt_inst_merge_print_name(out, input, IRT_INST_EVENT_STREAM_GROUP_NAME_SIZE,
+		                           IRT_INST_EVENT_STREAM_NAME_SIZE - IRT_INST_EVENT_STREAM_GROUP_NAME_SIZE, record->event_id);
+		fputc('\n', out);
+		events++;
+
+		if(!_irt_inst_merge_next(input)) { heap[0] = heap[--heap_size]; }
+		_irt_inst_merge_sift_down(heap, heap_size, 0);
+	}
+	fprintf(stderr, "merged %" PRIu64 " events from %u logs\n", events, num_inputs);
+
+	for(uint32 i = 0; i < num_inputs; ++i) {
+		if(inputs[i].data != NULL && inputs[i].data != MAP_FAILED) { munmap(inputs[i].data, inputs[i].size); }
+	}
+	free(heap);
+	free(inputs);
+	if(out != stdout) { fclose(out); }
+	return result;
+}
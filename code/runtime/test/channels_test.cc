@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#include <atomic>
+
+#define NUM_ELEMS 10000
+
+TEST(Channels, TryOperations) {
+	irt::init(1);
+	irt::run([]() {
+		irt_channel* channel = irt_channel_create(sizeof(int), 6);
+		int in[10], out[10];
+		for(int i = 0; i < 10; ++i) {
+			in[i] = i;
+		}
+		EXPECT_TRUE(irt_channel_empty(channel));
+		EXPECT_FALSE(irt_channel_try_recv(channel, out));
+
+		// the capacity is rounded up to 8
+		EXPECT_EQ(8u, irt_channel_try_send_batch(channel, in, 10));
+		EXPECT_TRUE(irt_channel_full(channel));
+		EXPECT_FALSE(irt_channel_try_send(channel, &in[8]));
+
+		EXPECT_EQ(5u, irt_channel_try_recv_batch(channel, out, 5));
+		EXPECT_FALSE(irt_channel_full(channel));
+		EXPECT_FALSE(irt_channel_empty(channel));
+
+		// wrap around
+		EXPECT_EQ(2u, irt_channel_try_send_batch(channel, &in[8], 2));
+		EXPECT_EQ(5u, irt_channel_try_recv_batch(channel, &out[5], 10));
+		EXPECT_TRUE(irt_channel_empty(channel));
+		for(int i = 0; i < 10; ++i) {
+			EXPECT_EQ(i, out[i]);
+		}
+		irt_channel_destroy(channel);
+	});
+	irt::shutdown();
+}
+
+TEST(Channels, ValueMacros) {
+	irt::init(1);
+	irt::run([]() {
+		irt_channel* channel = irt_channel_create(sizeof(double), 2);
+		IRT_CHANNEL_SEND(channel, double, 1.5);
+		IRT_CHANNEL_SEND(channel, double, 2.5);
+		EXPECT_EQ(1.5, IRT_CHANNEL_RECV(channel, double));
+		EXPECT_EQ(2.5, IRT_CHANNEL_RECV(channel, double));
+		irt_channel_destroy(channel);
+	});
+	irt::shutdown();
+}
+
+TEST(Channels, SingleWorkerPipeline) {
+	// with a single worker, a blocked receiver has to be suspended for the sender to make progress
+	irt::init(1);
+	irt::run([]() {
+		irt_channel* channel = irt_channel_create_spsc(sizeof(int), 2);
+		int sum = 0;
+		int* sump = &sum;
+		irt::parallel(1, [channel, sump]() {
+			for(int i = 0; i < NUM_ELEMS; ++i) {
+				int value;
+				irt_channel_recv(channel, &value);
+				EXPECT_EQ(i, value);
+				*sump += value;
+			}
+		});
+		irt::parallel(1, [channel]() {
+			for(int i = 0; i < NUM_ELEMS; ++i) {
+				irt_channel_send(channel, &i);
+			}
+		});
+		irt::merge_all();
+		EXPECT_EQ(NUM_ELEMS * (NUM_ELEMS - 1) / 2, sum);
+		irt_channel_destroy(channel);
+	});
+	irt::shutdown();
+}
+
+TEST(Channels, MultiProducerMultiConsumer) {
+	irt::init(4);
+	irt::run([]() {
+		const int producers = 4, consumers = 4, batch = 10;
+		irt_channel* channel = irt_channel_create(sizeof(int64), 16);
+		std::atomic<int64> sum(0), count(0);
+		std::atomic<int64>* sump = &sum;
+		std::atomic<int64>* countp = &count;
+		for(int p = 0; p < producers; ++p) {
+			irt::parallel(1, [channel, p]() {
+				int64 values[batch];
+				for(int i = 0; i < NUM_ELEMS; i += batch) {
+					for(int j = 0; j < batch; ++j) {
+						values[j] = p * NUM_ELEMS + i + j;
+					}
+					irt_channel_send_batch(channel, values, batch);
+				}
+			});
+		}
+		for(int c = 0; c < consumers; ++c) {
+			irt::parallel(1, [channel, sump, countp]() {
+				int64 values[batch];
+				for(int i = 0; i < NUM_ELEMS; i += batch) {
+					irt_channel_recv_batch(channel, values, batch);
+					for(int j = 0; j < batch; ++j) {
+						*sump += values[j];
+					}
+					*countp += batch;
+				}
+			});
+		}
+		irt::merge_all();
+		int64 total = (int64)producers * NUM_ELEMS;
+		EXPECT_EQ(total, count);
+		EXPECT_EQ(total * (total - 1) / 2, sum);
+		EXPECT_TRUE(irt_channel_empty(channel));
+		irt_channel_destroy(channel);
+	});
+	irt::shutdown();
+}
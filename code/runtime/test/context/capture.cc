@@ -35,6 +35,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <vector>
 
 // enable both phases in the capture mechanism
 #define RECORD
@@ -346,3 +347,189 @@ TEST_F(ContextCapturing, ParallelMatrixMul) {
 
 	EXPECT_EQ(sumA, sumB);
 }
+
+TEST_F(ContextCapturing, BlockLookup) {
+	INIT();
+
+	// register a large number of blocks, some of them overlapping
+	const int N = 2000;
+	char* data = (char*)malloc(N * 16);
+	for(int i = 0; i < N; i++) {
+		REG_BLOCK(data + i * 16, 16);
+	}
+	const irt_cap_data_block_info* wide = irt_cap_dbi_register_block(data + 100 * 16 + 8, 64);
+	const irt_cap_data_block_info* inner = irt_cap_dbi_register_block(data + 101 * 16, 4);
+
+	// lookups have to agree with a linear search, preferring the most recent block
+	for(int pass = 0; pass < 2; pass++) {
+		for(int i = 0; i < N * 16; i++) {
+			const irt_cap_data_block_info* info = irt_cap_dbi_lookup(data + i);
+			ASSERT_TRUE(info != NULL);
+			if(i >= 101 * 16 && i < 101 * 16 + 4) {
+				EXPECT_EQ(inner, info);
+			} else if(i >= 100 * 16 + 8 && i < 100 * 16 + 8 + 64) {
+				EXPECT_EQ(wide, info);
+			} else {
+				EXPECT_EQ((void*)(data + (i / 16) * 16), info->base);
+			}
+		}
+	}
+	EXPECT_TRUE(irt_cap_dbi_lookup(data - 1) == NULL);
+	EXPECT_TRUE(irt_cap_dbi_lookup(data + N * 16) == NULL);
+
+	// blocks registered after the index has been built are covering older ones
+	const irt_cap_data_block_info* late = irt_cap_dbi_register_block(data + 5, 2);
+	EXPECT_EQ(late, irt_cap_dbi_lookup(data + 6));
+	EXPECT_EQ((void*)data, irt_cap_dbi_lookup(data + 7)->base);
+
+	irt_cap_dbi_finalize();
+	free(data);
+}
+
+TEST_F(ContextCapturing, CompressedProfile) {
+	const int N = 1 << 16;
+
+	// --- recording ---
+
+	{
+		INIT();
+
+		int* A = (int*)CREATE_BLOCK(sizeof(int) * N);
+		int* B = (int*)CREATE_BLOCK(sizeof(int) * N);
+		for(int i = 0; i < N; i++) {
+			A[i] = i % 7;
+			B[i] = i;
+		}
+
+		// region 0 is reading every second element of A only
+		START(0);
+		TAG_BLOCK(A, 0);
+		int64 sum = 0;
+		for(int i = 0; i < N; i += 2) {
+			sum += READ(READ_PTR(A)[i]);
+		}
+		STOP(0);
+
+		// region 1 is reading all of B
+		START(1);
+		TAG_BLOCK(B, 0);
+		for(int i = 0; i < N; i++) {
+			sum += READ(READ_PTR(B)[i]);
+		}
+		STOP(1);
+
+		EXPECT_NE(0, sum);
+		free(A);
+		free(B);
+
+		FINISH();
+	}
+
+	// the repetitive data has to be stored compressed
+	FILE* f = fopen(getenv("IRT_CONTEXT_FILE"), "rb");
+	ASSERT_TRUE(f != NULL);
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+	EXPECT_LT(size, (long)(sizeof(int) * N / 2 + sizeof(int) * N));
+
+	// the summary is listing both regions
+	char* summary = NULL;
+	size_t summary_size = 0;
+	FILE* out = open_memstream(&summary, &summary_size);
+	irt_cap_profile_print_summary(out);
+	fclose(out);
+	EXPECT_TRUE(strstr(summary, "in 2 regions") != NULL) << summary;
+	free(summary);
+
+	// --- restoring ---
+
+	{
+		LOAD(int*, A, 0, 0);
+
+		// only the requested region is restored
+		EXPECT_EQ(2u, irt_g_cap_profile->num_contexts);
+		for(size_t i = 0; i < irt_g_cap_profile->num_contexts; i++) {
+			EXPECT_EQ(irt_g_cap_profile->contexts[i].id == 0, irt_g_cap_profile->contexts[i].loaded);
+		}
+
+		for(int i = 0; i < N; i += 2) {
+			EXPECT_EQ(i % 7, A[i]);
+		}
+
+		LOAD(int*, B, 1, 0);
+		for(int i = 0; i < N; i++) {
+			EXPECT_EQ(i, B[i]);
+		}
+
+		FINALIZE();
+	}
+}
+
+TEST_F(ContextCapturing, CorruptedProfile) {
+	const int N = 1 << 10;
+
+	// --- recording ---
+
+	{
+		INIT();
+
+		int* A = (int*)CREATE_BLOCK(sizeof(int) * N);
+		for(int i = 0; i < N; i++) {
+			A[i] = i % 7;
+		}
+
+		START(0);
+		TAG_BLOCK(A, 0);
+		int sum = 0;
+		for(int i = 0; i < N; i++) {
+			sum += READ(READ_PTR(A)[i]);
+		}
+		STOP(0);
+
+		EXPECT_NE(0, sum);
+		free(A);
+
+		FINISH();
+	}
+
+	// load the valid profile
+	const char* file_name = getenv("IRT_CONTEXT_FILE");
+	FILE* f = fopen(file_name, "rb");
+	ASSERT_TRUE(f != NULL);
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	std::vector<char> content(size);
+	ASSERT_EQ((size_t)size, fread(&content[0], 1, size, f));
+	fclose(f);
+
+	irt_cap_profile* profile = irt_cap_load_profile();
+	ASSERT_TRUE(profile != NULL);
+	ASSERT_EQ(1u, profile->num_contexts);
+	uint64 offset = profile->contexts[0].offset;
+	uint64 length = profile->contexts[0].length;
+	_irt_cap_profile_unmap_file(profile->file, profile->file_size);
+	free(profile);
+
+	// a truncated file is rejected
+	f = fopen(file_name, "wb");
+	fwrite(&content[0], 1, size - 1, f);
+	fclose(f);
+	EXPECT_TRUE(irt_cap_load_profile() == NULL);
+
+	// a corrupted region is not restored
+	for(uint64 i = offset + 4 * sizeof(uint32); i < offset + length; i++) {
+		content[i] = (char)0xFF;
+	}
+	f = fopen(file_name, "wb");
+	fwrite(&content[0], 1, size, f);
+	fclose(f);
+
+	profile = irt_cap_load_profile();
+	ASSERT_TRUE(profile != NULL);
+	EXPECT_FALSE(irt_cap_load_region_context(profile, &profile->contexts[0]));
+	EXPECT_FALSE(profile->contexts[0].loaded);
+	_irt_cap_profile_unmap_file(profile->file, profile->file_size);
+	free(profile);
+}
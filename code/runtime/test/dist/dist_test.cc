@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+extern "C" {
+#include "dist/impl/dist.impl.h"
+}
+
+#define NUM_NODES 3
+#define NUM_JOBS 32
+
+typedef struct {
+	irt_type_id type_id;
+	int64 n;
+	int64 result;
+} sum_params;
+
+static void sum_impl(irt_work_item* wi) {
+	sum_params* params = (sum_params*)wi->parameters;
+	volatile int64 res = 0;
+	for(int64 i = 0; i < params->n; ++i) {
+		res += i;
+	}
+	params->result = res;
+}
+
+static irt_wi_implementation_variant g_sum_variants[] = {{&sum_impl, 0, NULL, 0, NULL, NULL, {0}}};
+static irt_wi_implementation g_impl_table[] = {{0, 1, g_sum_variants}};
+
+static void init_context(irt_context* context) {
+	_irt_lib_context_fun(context);
+	context->impl_table_size = 1;
+	context->impl_table = g_impl_table;
+}
+
+static void serve(uint32 rank, int* peers) {
+	irt::init_in_context(2, &init_context, &_irt_lib_context_fun);
+	irt::run([rank, peers]() {
+		dirt_node* node = dirt_node_create(rank, NUM_NODES, peers);
+		dirt_node_serve(node);
+		dirt_node_destroy(node);
+	});
+	irt::shutdown();
+}
+
+static void spawn_and_join(int* peers) {
+	uint32 remote = 0;
+	uint32* remotep = &remote;
+	irt::init_in_context(2, &init_context, &_irt_lib_context_fun);
+	irt::run([peers, remotep]() {
+		dirt_node* node = dirt_node_create(0, NUM_NODES, peers);
+		dirt_job_id jobs[NUM_JOBS];
+		for(int i = 0; i < NUM_JOBS; ++i) {
+			sum_params params = {-(irt_type_id)sizeof(sum_params), 1000000 + i, 0};
+			jobs[i] = dirt_spawn(node, irt_g_wi_range_one_elem, 0, (irt_lw_data_item*)&params);
+		}
+		for(int i = 0; i < NUM_JOBS; ++i) {
+			sum_params result;
+			dirt_join(node, jobs[i], (irt_lw_data_item*)&result);
+			int64 n = 1000000 + i;
+			EXPECT_EQ(n * (n - 1) / 2, result.result);
+		}
+		// stolen jobs may be stolen back, in which case they are completed locally
+		*remotep = node->num_remote_completed;
+		EXPECT_LE(node->num_remote_completed, node->num_stolen);
+		dirt_node_shutdown(node);
+		dirt_node_destroy(node);
+	});
+	irt::shutdown();
+	// the peers have been busy as well
+	EXPECT_LT(0u, remote);
+}
+
+static void wait_for_nodes(pid_t* pids) {
+	for(uint32 i = 1; i < NUM_NODES; ++i) {
+		int status;
+		ASSERT_EQ(pids[i], waitpid(pids[i], &status, 0));
+		EXPECT_TRUE(WIFEXITED(status));
+		EXPECT_EQ(0, WEXITSTATUS(status));
+	}
+}
+
+TEST(Dist, LocalSockets) {
+	int fds[NUM_NODES * NUM_NODES];
+	int peers[NUM_NODES];
+	ASSERT_TRUE(dirt_mesh_create_local(NUM_NODES, fds));
+
+	pid_t pids[NUM_NODES];
+	for(uint32 rank = 1; rank < NUM_NODES; ++rank) {
+		pids[rank] = fork();
+		ASSERT_LE(0, pids[rank]);
+		if(pids[rank] == 0) {
+			dirt_mesh_select_local(NUM_NODES, rank, fds, peers);
+			serve(rank, peers);
+			_exit(0);
+		}
+	}
+
+	dirt_mesh_select_local(NUM_NODES, 0, fds, peers);
+	spawn_and_join(peers);
+	wait_for_nodes(pids);
+}
+
+TEST(Dist, TcpLoopback) {
+	int peers[NUM_NODES];
+	uint16 base_port = 20000 + getpid() % 20000;
+
+	pid_t pids[NUM_NODES];
+	for(uint32 rank = 1; rank < NUM_NODES; ++rank) {
+		pids[rank] = fork();
+		ASSERT_LE(0, pids[rank]);
+		if(pids[rank] == 0) {
+			if(!dirt_mesh_connect_tcp(NUM_NODES, rank, "127.0.0.1", base_port, peers)) { _exit(1); }
+			serve(rank, peers);
+			_exit(0);
+		}
+	}
+
+	ASSERT_TRUE(dirt_mesh_connect_tcp(NUM_NODES, 0, "127.0.0.1", base_port, peers));
+	spawn_and_join(peers);
+	wait_for_nodes(pids);
+}
@@ -38,7 +38,12 @@
 #define IRT_RUNTIME_TUNING
 
 #include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 #include "standalone.h"
+#include "utils/event_stream.h"
 
 // type table
 
@@ -49,17 +54,19 @@ irt_type g_insieme_type_table[] = {
 // work item table
 
 void insieme_wi_startup_implementation_simple(irt_work_item* wi);
+void insieme_wi_startup_implementation_streaming(irt_work_item* wi);
 
 irt_wi_implementation_variant g_insieme_wi_startup_variants_simple[] = {{&insieme_wi_startup_implementation_simple, 0, NULL, 0, NULL, 0, NULL}};
+irt_wi_implementation_variant g_insieme_wi_startup_variants_streaming[] = {{&insieme_wi_startup_implementation_streaming, 0, NULL, 0, NULL, 0, NULL}};
 
 irt_wi_implementation g_insieme_impl_table[] = {
-    {1, 1, g_insieme_wi_startup_variants_simple},
+    {1, 1, g_insieme_wi_startup_variants_simple}, {2, 1, g_insieme_wi_startup_variants_streaming},
 };
 
 // initialization
 void insieme_init_context(irt_context* context) {
 	context->type_table_size = 1;
-	context->impl_table_size = 1;
+	context->impl_table_size = 2;
 	context->type_table = g_insieme_type_table;
 	context->impl_table = g_insieme_impl_table;
 	context->num_regions = 0;
@@ -101,3 +108,87 @@ TEST(event_instrumentation, simple) {
 	uint32 wcount = irt_get_default_worker_count();
 	irt_runtime_standalone(wcount, &insieme_init_context, &insieme_cleanup_context, &g_insieme_impl_table[0], NULL);
 }
+
+#ifdef IRT_INST_EVENT_STREAMING_SUPPORTED
+
+#define STREAMING_TEST_EVENTS (3 * IRT_INST_EVENT_RING_BUFFER_SIZE)
+
+uint32 g_streaming_worker = 0;
+
+void insieme_wi_startup_implementation_streaming(irt_work_item* wi) {
+	irt_worker* worker = irt_worker_get_current();
+	irt_instrumentation_event_data_table* table = worker->instrumentation_event_data;
+	g_streaming_worker = worker->id.thread;
+
+	ASSERT_TRUE(table->stream != NULL);
+	EXPECT_EQ(table->size, IRT_INST_EVENT_RING_BUFFER_SIZE);
+
+	// record more events than fit into the ring buffer
+	irt_work_item_id id = {(uint64)0};
+	uint64 before = table->stream->head;
+	for(uint32 i = 0; i < STREAMING_TEST_EVENTS; ++i) {
+		id.index = i;
+		irt_inst_insert_wi_event(worker, IRT_INST_WORK_ITEM_STARTED, id);
+	}
+	EXPECT_EQ(table->stream->head, before + STREAMING_TEST_EVENTS);
+	EXPECT_LE(table->stream->head - table->stream->tail, table->size);
+	EXPECT_EQ(table->number_of_elements, 0);
+}
+
+TEST(event_instrumentation, streaming) {
+	char dir[] = "/tmp/irt_event_stream_XXXXXX";
+	ASSERT_TRUE(mkdtemp(dir) != NULL);
+	setenv(IRT_INST_WORKER_EVENT_LOGGING_ENV, "enabled", 1);
+	setenv(IRT_INST_WORKER_EVENT_TYPES_ENV, "WI", 1);
+	setenv(IRT_INST_EVENT_STREAMING_ENV, "enabled", 1);
+	setenv(IRT_INST_OUTPUT_PATH_ENV, dir, 1);
+
+	uint32 wcount = irt_get_default_worker_count();
+	irt_runtime_standalone(wcount, &insieme_init_context, &insieme_cleanup_context, &g_insieme_impl_table[1], NULL);
+
+	unsetenv(IRT_INST_WORKER_EVENT_LOGGING_ENV);
+	unsetenv(IRT_INST_WORKER_EVENT_TYPES_ENV);
+	unsetenv(IRT_INST_EVENT_STREAMING_ENV);
+	unsetenv(IRT_INST_OUTPUT_PATH_ENV);
+
+	char filename[IRT_INST_OUTPUT_PATH_CHAR_SIZE];
+	sprintf(filename, "%s/worker_event_stream.%04u", dir, g_streaming_worker);
+	std::ifstream in(filename, std::ios::binary);
+	ASSERT_TRUE(in.good());
+	std::vector<char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	ASSERT_GE(content.size(), sizeof(irt_inst_event_stream_header));
+
+	const irt_inst_event_stream_header* header = (const irt_inst_event_stream_header*)content.data();
+	EXPECT_EQ(std::string(header->magic, 8), IRT_INST_EVENT_STREAM_MAGIC);
+	EXPECT_EQ(header->num_event_types, irt_g_inst_num_event_types);
+	EXPECT_EQ(header->worker, g_streaming_worker);
+	EXPECT_EQ(content.size(), irt_inst_event_stream_payload_offset(header) + header->payload_size);
+
+	// decode all records, the test events have to be complete and in order
+	const char* cur = content.data() + irt_inst_event_stream_payload_offset(header);
+	const char* end = content.data() + content.size();
+	irt_inst_event_stream_record record = {0, 0, 0, 0};
+	uint64 decoded = 0, last_timestamp = 0;
+	uint32 next_index = 0;
+	while(cur != end) {
+		cur = irt_inst_event_stream_decode(cur, end, &record, record.timestamp);
+		ASSERT_TRUE(cur != NULL);
+		decoded++;
+		if(record.event_id == IRT_INST_WORK_ITEM_STARTED && record.thread == 0 && next_index < STREAMING_TEST_EVENTS && record.index == next_index) {
+			EXPECT_GE(record.timestamp, last_timestamp);
+			last_timestamp = record.timestamp;
+			next_index++;
+		}
+	}
+	EXPECT_EQ(decoded, header->number_of_events);
+	EXPECT_EQ(next_index, STREAMING_TEST_EVENTS);
+
+	std::string cleanup = std::string("rm -rf ") + dir;
+	EXPECT_EQ(system(cleanup.c_str()), 0);
+}
+
+#else // if not IRT_INST_EVENT_STREAMING_SUPPORTED
+
+void insieme_wi_startup_implementation_streaming(irt_work_item* wi) {}
+
+#endif // IRT_INST_EVENT_STREAMING_SUPPORTED
@@ -525,3 +525,45 @@ TEST(region_instrumentation, pfor_nested) {
 	});
 	irt::shutdown();
 }
+
+TEST(region_instrumentation, sampling) {
+	setenv(IRT_INST_REGION_INSTRUMENTATION_ENV, "sampling", 1);
+	setenv(IRT_INST_REGION_SAMPLING_INTERVAL_ENV, "500", 1);
+	irt::init_in_context(MAX_PARA, insieme_init_context_nested, insieme_cleanup_context);
+	irt::run([]() {
+		irt_context* context = irt_context_get_current();
+		EXPECT_TRUE(irt_g_inst_region_sampling);
+
+		// samples tick in thread cpu time, so compare against that rather than wall time
+		struct timespec start, end;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		ir_inst_region_start(0);
+		irt_busy_nanosleep(1e8);
+		ir_inst_region_start(1);
+		irt_busy_nanosleep(1e8);
+		ir_inst_region_end(1);
+		ir_inst_region_end(0);
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+
+		double elapsed = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+		irt_inst_region_sampling_collect(context);
+		double ns_per_tick = 1e9 / irt_g_time_ticks_per_sec;
+		double reg0_time = context->inst_region_data[0].aggregated_cpu_time * ns_per_tick;
+		double reg1_time = context->inst_region_data[1].aggregated_cpu_time * ns_per_tick;
+
+		// samples are attributed inclusively to all regions on the stack
+		EXPECT_GT(reg0_time / elapsed, 0.80);
+		EXPECT_LT(reg0_time / elapsed, 1.10);
+		EXPECT_GT(reg1_time / elapsed, 0.35);
+		EXPECT_LT(reg1_time / elapsed, 0.65);
+		EXPECT_EQ(context->inst_region_data[0].num_executions, 1);
+		EXPECT_EQ(context->inst_region_data[1].num_executions, 1);
+		// no per-region measurements are taken
+		EXPECT_EQ(context->inst_region_data[0].aggregated_wall_time, 0);
+	});
+	irt::shutdown();
+	EXPECT_FALSE(irt_g_inst_region_sampling);
+	unsetenv(IRT_INST_REGION_INSTRUMENTATION_ENV);
+	unsetenv(IRT_INST_REGION_SAMPLING_INTERVAL_ENV);
+}
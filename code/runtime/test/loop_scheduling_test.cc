@@ -139,3 +139,72 @@ vector<LoopTestCase> getAllCases() {
 }
 
 INSTANTIATE_TEST_CASE_P(RangeCoverageCheck, LoopSchedTest, ::testing::ValuesIn(getAllCases()));
+
+// loop body used to check adaptive scheduling, counts executions of each index in adaptiveTestVec
+static int32_t adaptiveTestVec[VEC_SIZE];
+void adaptive_loop_body(irt_work_item* wi) {
+	for(int64 i = wi->range.begin; i < wi->range.end; i += wi->range.step) {
+		irt_atomic_add_and_fetch(&adaptiveTestVec[i], 1, int32_t);
+	}
+}
+
+TEST(LoopSchedAdaptive, ExploreAndLockIn) {
+	static irt_wi_implementation_variant impl_var = {&adaptive_loop_body, 0, NULL, 0, NULL, NULL, {0}};
+	static irt_wi_implementation impl = {-3, 1, &impl_var};
+
+	irt::init(MAX_PARA);
+	irt::run([]() {
+		irt::merge(irt::parallel(MAX_PARA, []() {
+			irt_work_item* wi = irt_wi_get_current();
+			irt_work_group* wg = irt_wi_get_wg(wi, 0);
+			irt::master([wg]() { wg->cur_sched = (irt_loop_sched_policy){IRT_ADAPTIVE, MAX_PARA, {0}}; });
+			irt::barrier();
+
+			// every execution has to cover the whole range, regardless of the policy chosen for it
+			for(int run = 0; run < IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS * IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS + 2; ++run) {
+				irt::master([]() { memset(adaptiveTestVec, 0, sizeof(adaptiveTestVec)); });
+				irt::barrier();
+				irt_work_item_range range = {0, VEC_SIZE, 1};
+				irt_pfor(wi, wg, range, &impl, NULL);
+				irt::barrier();
+				irt::master([run]() {
+					for(int64 i = 0; i < VEC_SIZE; ++i) {
+						EXPECT_EQ(1, adaptiveTestVec[i]) << "run " << run << " / i: " << i;
+					}
+				});
+				irt::barrier();
+			}
+		}));
+	});
+
+	// all candidates have been explored often enough, so one of them has to be locked in
+	irt_loop_sched_policy_type chosen;
+	ASSERT_TRUE(irt_loop_sched_get_adaptive_choice(&impl, &chosen));
+	EXPECT_TRUE(chosen == IRT_STATIC || chosen == IRT_DYNAMIC || chosen == IRT_GUIDED);
+	for(int i = 0; i < IRT_LOOP_SCHED_ADAPTIVE_NUM_ARMS; ++i) {
+		EXPECT_EQ(IRT_LOOP_SCHED_ADAPTIVE_EXPLORE_ROUNDS, impl_var.rt_data.loop_sched_selector.samples[i]);
+	}
+
+	// a bound policy overrides the adaptive choice
+	static irt_loop_sched_policy bound = {IRT_DYNAMIC_CHUNKED, MAX_PARA, {7}};
+	irt_loop_sched_bind_policy(&impl, &bound);
+	irt::run([]() {
+		irt::merge(irt::parallel(MAX_PARA, []() {
+			irt_work_item* wi = irt_wi_get_current();
+			irt_work_group* wg = irt_wi_get_wg(wi, 0);
+			irt::master([]() { memset(adaptiveTestVec, 0, sizeof(adaptiveTestVec)); });
+			irt::barrier();
+			irt_work_item_range range = {0, VEC_SIZE, 1};
+			irt_pfor(wi, wg, range, &impl, NULL);
+			irt::barrier();
+			irt::master([wg]() {
+				EXPECT_EQ(IRT_DYNAMIC_CHUNKED, wg->loop_sched_data[wg->pfor_count % IRT_WG_RING_BUFFER_SIZE].policy.type);
+				for(int64 i = 0; i < VEC_SIZE; ++i) {
+					EXPECT_EQ(1, adaptiveTestVec[i]) << "i: " << i;
+				}
+			});
+		}));
+	});
+	irt_loop_sched_bind_policy(&impl, NULL);
+	irt::shutdown();
+}
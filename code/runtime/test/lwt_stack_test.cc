@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LWT_STACK_MMAP
+#define IRT_LWT_STACK_HUGEPAGES
+#define IRT_LWT_STACK_POOL_MAX 4
+#define IRT_LWT_STACK_SHARED_POOL_MAX 8
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+// returns all stacks of worker tid to the OS, including those in the shared pool
+static void drain_stack_pools(int tid) {
+	lwt_reused_stack* stack;
+	while((stack = _lwt_pop_stack(tid))) {
+		_lwt_free_stack(stack);
+	}
+	while((stack = _lwt_take_shared_stack())) {
+		_lwt_free_stack(stack);
+	}
+}
+
+static void recycle_stack(int tid, lwt_reused_stack* stack) {
+	irt_work_item wi;
+	wi.stack_storage = stack;
+	lwt_recycle(tid, &wi);
+	EXPECT_EQ(NULL, wi.stack_storage);
+}
+
+TEST(LwtStacks, Layout) {
+	drain_stack_pools(0);
+	lwt_reused_stack* stack = _lwt_get_stack(0);
+	// the mapping starts with the guard region and is aligned for huge pages
+	EXPECT_EQ(0u, ((uintptr_t)stack - _lwt_stack_guard_size()) % IRT_LWT_STACK_HUGEPAGE_SIZE);
+	EXPECT_EQ(0u, (uintptr_t)stack->stack % LWT_STACK_ALIGNMENT);
+	// the whole stack is usable
+	stack->stack[0] = 1;
+	stack->stack[IRT_WI_STACK_SIZE - 1] = 1;
+	_lwt_decommit_stack(stack);
+	// decommitted pages read as zero again, the header survives
+	EXPECT_EQ(0, stack->stack[_lwt_page_size()]);
+	stack->next = NULL;
+	_lwt_free_stack(stack);
+}
+
+TEST(LwtStacksDeathTest, GuardRegion) {
+	lwt_reused_stack* stack = _lwt_get_stack(0);
+	// overflowing stacks run into the guard region below the header
+	EXPECT_DEATH({ *(volatile char*)((char*)stack - 1) = 0; }, "");
+	recycle_stack(0, stack);
+	drain_stack_pools(0);
+}
+
+TEST(LwtStacks, Balancing) {
+	drain_stack_pools(0);
+	drain_stack_pools(1);
+	const int num_stacks = IRT_LWT_STACK_POOL_MAX + IRT_LWT_STACK_SHARED_POOL_MAX + 2;
+	lwt_reused_stack* stacks[num_stacks];
+	for(int i = 0; i < num_stacks; ++i) {
+		stacks[i] = _lwt_get_stack(0);
+	}
+	for(int i = 0; i < num_stacks; ++i) {
+		recycle_stack(0, stacks[i]);
+	}
+	// worker 0 keeps its share, the surplus goes to the shared pool and whatever does not fit there is released
+	EXPECT_EQ(IRT_LWT_STACK_POOL_MAX, lwt_g_stack_reuse.counts[0]);
+	EXPECT_EQ(IRT_LWT_STACK_SHARED_POOL_MAX, lwt_g_stack_reuse.shared_count);
+
+	// another worker running short picks up the surplus stacks before allocating new ones
+	lwt_reused_stack* stack = _lwt_get_stack(1);
+	EXPECT_EQ(IRT_LWT_STACK_SHARED_POOL_MAX - 1u, lwt_g_stack_reuse.shared_count);
+	recycle_stack(1, stack);
+	EXPECT_EQ(1u, lwt_g_stack_reuse.counts[1]);
+
+	// filling a pool also draws from the shared pool first
+	lwt_fill_stack_pool(1, 3);
+	EXPECT_EQ(3u, lwt_g_stack_reuse.counts[1]);
+	EXPECT_EQ(IRT_LWT_STACK_SHARED_POOL_MAX - 3u, lwt_g_stack_reuse.shared_count);
+
+	drain_stack_pools(0);
+	drain_stack_pools(1);
+}
+
+static int rec_par_count(int n) {
+	if(n == 0) { return 1; }
+	int ret = 0;
+	irt::parallel(n, [&ret, n] { ret = rec_par_count(n - 1) + 1; });
+	irt::merge_all();
+	return ret;
+}
+
+TEST(LwtStacks, Runtime) {
+	irt::init(4);
+	int result = 0;
+	irt::run([&result]() { result = rec_par_count(6); });
+	EXPECT_EQ(7, result);
+	irt::shutdown();
+	for(int i = 0; i < 4; ++i) {
+		EXPECT_LE(lwt_g_stack_reuse.counts[i], (uint32)IRT_LWT_STACK_POOL_MAX);
+	}
+	EXPECT_LE(lwt_g_stack_reuse.shared_count, (uint32)IRT_LWT_STACK_SHARED_POOL_MAX);
+}
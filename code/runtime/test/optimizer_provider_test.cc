@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#define NUM_THREADS 8
+
+// an objective without weights and bounds, as produced by the meta info defaults
+static ompp_objective_info unbounded_objective() {
+	ompp_objective_info obj;
+	memset(&obj, 0, sizeof(obj));
+	obj.energy_min = obj.energy_max = -1;
+	obj.power_min = obj.power_max = -1;
+	obj.quality_min = obj.quality_max = -1;
+	obj.time_min = obj.time_max = -1;
+	obj.param_count = 0;
+	return obj;
+}
+
+TEST(optimizer_provider, simulated_model) {
+	irt_optimizer_sim_model model;
+	irt_optimizer_sim_model_init_default(&model, NUM_THREADS);
+	irt_optimizer_provider provider;
+	irt_optimizer_provider_init_simulated(&provider, &model);
+
+	uint32 freqs[128];
+	uint32 count = 0;
+	ASSERT_EQ(0, provider.get_available_frequencies(provider.state, freqs, &count));
+	ASSERT_GT(count, 1u);
+	EXPECT_EQ(model.max_frequency, freqs[0]);
+	EXPECT_EQ(model.min_frequency, freqs[count - 1]);
+	for(uint32 i = 1; i < count; ++i) {
+		EXPECT_LT(freqs[i], freqs[i - 1]);
+	}
+
+	// evaluation is deterministic, faster with more threads and higher frequencies, and cheaper at lower frequencies
+	irt_optimizer_provider_measurement a, b;
+	irt_optimizer_provider_config c = {freqs[0], 1};
+	ASSERT_TRUE(provider.evaluate(provider.state, &c, &a));
+	ASSERT_TRUE(provider.evaluate(provider.state, &c, &b));
+	EXPECT_EQ(a.time, b.time);
+	EXPECT_EQ(a.energy, b.energy);
+	EXPECT_DOUBLE_EQ(model.work, a.time);
+
+	c.thread_count = NUM_THREADS;
+	ASSERT_TRUE(provider.evaluate(provider.state, &c, &b));
+	EXPECT_LT(b.time, a.time);
+
+	irt_optimizer_provider_config slow = {freqs[count - 1], NUM_THREADS};
+	ASSERT_TRUE(provider.evaluate(provider.state, &slow, &a));
+	EXPECT_GT(a.time, b.time);
+	EXPECT_LT(a.energy, b.energy);
+
+	// invalid configurations are rejected
+	c.thread_count = NUM_THREADS + 1;
+	EXPECT_FALSE(provider.evaluate(provider.state, &c, &a));
+
+	// frequency changes are recorded instead of applied
+	EXPECT_EQ(0, provider.set_frequency_worker(provider.state, NULL, freqs[1]));
+	EXPECT_EQ(freqs[1], model.cur_frequency[IRT_MAX_WORKERS]);
+	EXPECT_NE(0, provider.set_frequency_worker(provider.state, NULL, model.max_frequency + 1));
+	EXPECT_EQ(1u, model.set_frequency_calls);
+}
+
+TEST(optimizer_provider, pareto_front) {
+	irt_optimizer_sim_model model;
+	irt_optimizer_sim_model_init_default(&model, NUM_THREADS);
+	irt_optimizer_provider provider;
+	irt_optimizer_provider_init_simulated(&provider, &model);
+
+	uint32 freqs[128];
+	uint32 count = 0;
+	provider.get_available_frequencies(provider.state, freqs, &count);
+
+	irt_optimizer_pareto_front* front = (irt_optimizer_pareto_front*)calloc(1, sizeof(irt_optimizer_pareto_front));
+	EXPECT_EQ(count * NUM_THREADS, irt_optimizer_pareto_sweep(front, &provider, freqs, count, NUM_THREADS));
+	ASSERT_GT(front->size, 1u);
+	ASSERT_LT(front->size, count * NUM_THREADS);
+
+	// no point of the front is dominated by any evaluated configuration
+	for(uint32 f = 0; f < count; ++f) {
+		for(uint32 t = 1; t <= NUM_THREADS; ++t) {
+			irt_optimizer_provider_config c = {freqs[f], t};
+			irt_optimizer_provider_measurement m;
+			provider.evaluate(provider.state, &c, &m);
+			irt_optimizer_resources res;
+			memset(&res, 0, sizeof(res));
+			res.wall_time = (uint64)(m.time * 1e9);
+			res.cpu_energy = m.energy;
+			for(uint32 i = 0; i < front->size; ++i) {
+				EXPECT_FALSE(irt_optimizer_pareto_dominates(&res, &front->points[i].resources)) << "freq " << freqs[f] << " threads " << t;
+			}
+		}
+	}
+
+	// without weights the most energy efficient setting is picked
+	ompp_objective_info obj = unbounded_objective();
+	int32 sel = irt_optimizer_pareto_select(front, &obj);
+	ASSERT_GE(sel, 0);
+	for(uint32 i = 0; i < front->size; ++i) {
+		EXPECT_LE(front->points[sel].resources.cpu_energy, front->points[i].resources.cpu_energy);
+	}
+
+	// optimizing for time picks the fastest setting: all threads at the highest frequency
+	obj.time_weight = 1;
+	sel = irt_optimizer_pareto_select(front, &obj);
+	ASSERT_GE(sel, 0);
+	EXPECT_EQ(0u, front->points[sel].id.frequency);
+	EXPECT_EQ(NUM_THREADS - 1u, front->points[sel].id.thread_count);
+
+	// minimizing energy under a deadline picks the cheapest setting meeting it
+	obj = unbounded_objective();
+	double fastest = (double)front->points[sel].resources.wall_time / 1e9;
+	obj.time_max = fastest * 1.5;
+	sel = irt_optimizer_pareto_select(front, &obj);
+	ASSERT_GE(sel, 0);
+	EXPECT_LE((double)front->points[sel].resources.wall_time / 1e9, obj.time_max);
+	for(uint32 i = 0; i < front->size; ++i) {
+		if((double)front->points[i].resources.wall_time / 1e9 <= obj.time_max) {
+			EXPECT_LE(front->points[sel].resources.cpu_energy, front->points[i].resources.cpu_energy);
+		}
+	}
+
+	// an infeasible deadline falls back to the fastest setting
+	obj.time_max = fastest / 2;
+	sel = irt_optimizer_pareto_select(front, &obj);
+	ASSERT_GE(sel, 0);
+	EXPECT_DOUBLE_EQ(fastest, (double)front->points[sel].resources.wall_time / 1e9);
+
+	free(front);
+}
+
+TEST(optimizer_provider, pareto_insert) {
+	irt_optimizer_pareto_front front;
+	front.size = 0;
+	irt_optimizer_wi_data_id id;
+	memset(&id, 0, sizeof(id));
+	irt_optimizer_resources res;
+	memset(&res, 0, sizeof(res));
+
+	res.wall_time = 100;
+	res.cpu_energy = 10;
+	EXPECT_TRUE(irt_optimizer_pareto_insert(&front, &id, &res));
+	// slower but cheaper: both kept
+	res.wall_time = 200;
+	res.cpu_energy = 5;
+	EXPECT_TRUE(irt_optimizer_pareto_insert(&front, &id, &res));
+	EXPECT_EQ(2u, front.size);
+	// dominated: rejected
+	res.wall_time = 250;
+	res.cpu_energy = 6;
+	EXPECT_FALSE(irt_optimizer_pareto_insert(&front, &id, &res));
+	EXPECT_EQ(2u, front.size);
+	// dominates both: replaces them
+	res.wall_time = 50;
+	res.cpu_energy = 1;
+	EXPECT_TRUE(irt_optimizer_pareto_insert(&front, &id, &res));
+	EXPECT_EQ(1u, front.size);
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#define NUM_ITERATIONS 200
+
+TEST(WgOrdered, Oversubscribed) {
+	// more group members than workers, members waiting for their turn must not starve the one holding it
+	irt::init(2);
+	for(uint32 members : {1u, 3u, 16u}) {
+		irt::run([members]() {
+			volatile int64 counter = 0;
+			int log[NUM_ITERATIONS];
+			int pos = 0;
+			volatile int64* counterp = &counter;
+			int* logp = log;
+			int* posp = &pos;
+			irt::merge(irt::parallel(members, [counterp, logp, posp]() {
+				irt_work_item* wi = irt_wi_get_current();
+				irt_work_group* wg = irt_wi_get_wg(wi, 0);
+				uint32 id = irt_wi_get_wg_num(wi, 0);
+				uint32 size = irt_wi_get_wg_size(wi, 0);
+				for(int64 i = id; i < NUM_ITERATIONS; i += size) {
+					irt_wg_ordered_wait(wg, counterp, i);
+					logp[(*posp)++] = (int)i;
+					irt_wg_ordered_advance(wg, counterp, 1);
+				}
+			}));
+			EXPECT_EQ(NUM_ITERATIONS, pos) << "members: " << members;
+			EXPECT_EQ(NUM_ITERATIONS, counter) << "members: " << members;
+			for(int i = 0; i < NUM_ITERATIONS; ++i) {
+				EXPECT_EQ(i, log[i]) << "members: " << members;
+			}
+		});
+	}
+	irt::shutdown();
+}
+
+TEST(WgOrdered, Step) {
+	irt::init(4);
+	irt::run([]() {
+		// a loop counting down in steps of 3
+		volatile int64 counter = 90;
+		int64 last = 93;
+		bool ok = true;
+		volatile int64* counterp = &counter;
+		int64* lastp = &last;
+		bool* okp = &ok;
+		irt::merge(irt::parallel(5, [counterp, lastp, okp]() {
+			irt_work_item* wi = irt_wi_get_current();
+			irt_work_group* wg = irt_wi_get_wg(wi, 0);
+			uint32 id = irt_wi_get_wg_num(wi, 0);
+			for(int64 i = 90 - 3 * id; i >= 0; i -= 3 * 5) {
+				irt_wg_ordered_wait(wg, counterp, i);
+				if(*lastp != i + 3) { *okp = false; }
+				*lastp = i;
+				irt_wg_ordered_advance(wg, counterp, -3);
+			}
+		}));
+		EXPECT_TRUE(ok);
+		EXPECT_EQ(0, last);
+	});
+	irt::shutdown();
+}
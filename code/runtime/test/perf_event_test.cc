@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_ENABLE_REGION_INSTRUMENTATION
+#define IRT_USE_PERF_EVENT
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#define MAX_PARA 2
+
+void insieme_init_context_perf(irt_context* context) {
+	context->impl_table_size = 0;
+	context->info_table_size = 0;
+	context->type_table_size = 0;
+	context->num_regions = 1;
+}
+
+void insieme_cleanup_context_perf(irt_context* context) {
+	// nothing
+}
+
+TEST(perf_event, region_counters) {
+	irt::init_in_context(MAX_PARA, insieme_init_context_perf, insieme_cleanup_context_perf);
+	irt::run([]() {
+		const char* env_string = "wall_time,PAPI_TOT_INS,PAPI_TOT_CYC";
+		irt_inst_region_select_metrics(env_string);
+		// explicit selection necessary because we do not have an env var
+		irt_perf_event_select_events(irt_worker_get_current(), env_string);
+
+		if(irt_g_perf_event_data[irt_worker_get_current()->id.thread].num_counters == 0) {
+			std::cout << "perf_event_open not permitted on this system, skipping" << std::endl;
+			return;
+		}
+
+		volatile double a = 2.0;
+		double b = 1.0;
+		ir_inst_region_start(0);
+		while(a < 1e5) {
+			a = a + b;
+		}
+		ir_inst_region_end(0);
+
+		irt_inst_region_context_data* reg0 = &(irt_context_get_current()->inst_region_data[0]);
+
+		EXPECT_GT(reg0->aggregated_PAPI_TOT_INS, 1e5);
+		EXPECT_LT(reg0->aggregated_PAPI_TOT_INS, 1e7);
+		EXPECT_GT(reg0->aggregated_PAPI_TOT_CYC, 0);
+		EXPECT_EQ(reg0->last_PAPI_TOT_INS, 0);
+		EXPECT_GT(reg0->aggregated_wall_time, 0);
+	});
+	irt::shutdown();
+}
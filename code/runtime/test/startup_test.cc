@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <iostream>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#define NUM_WORKERS 4
+#define NUM_STARTUP_ROUNDS 20
+
+static uint32 count_started_workers() {
+	uint32 started = 0;
+	for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+		if(irt_atomic_load(&irt_g_workers[i]->state) != IRT_WORKER_STATE_CREATED) { started++; }
+	}
+	return started;
+}
+
+TEST(startup, lazy_workers_start_on_parallelism) {
+	setenv(IRT_LAZY_WORKER_STARTUP_ENV, "1", 1);
+	irt::init(NUM_WORKERS);
+	EXPECT_EQ(IRT_WORKER_LAZY_STARTUP_PENDING, irt_g_worker_lazy_startup);
+
+	// sequential code does not need the other workers
+	irt::run([]() { EXPECT_EQ(1u, count_started_workers()); });
+	EXPECT_EQ(IRT_WORKER_LAZY_STARTUP_PENDING, irt_g_worker_lazy_startup);
+
+	// the first parallel region brings them up, and its work items all complete
+	volatile uint32 executed = 0;
+	irt::run([&executed]() {
+		irt::merge(irt::parallel(NUM_WORKERS * 2, [&executed]() { irt_atomic_inc(&executed, uint32); }));
+	});
+	EXPECT_EQ(NUM_WORKERS * 2u, executed);
+	irt_worker_await_lazy_startup();
+	EXPECT_EQ(IRT_WORKER_LAZY_STARTUP_DONE, irt_g_worker_lazy_startup);
+	EXPECT_EQ((uint32)NUM_WORKERS, count_started_workers());
+
+	irt::shutdown();
+	unsetenv(IRT_LAZY_WORKER_STARTUP_ENV);
+}
+
+TEST(startup, lazy_shutdown_without_parallelism) {
+	setenv(IRT_LAZY_WORKER_STARTUP_ENV, "1", 1);
+	irt::init(NUM_WORKERS);
+	int result = 0;
+	irt::run([&result]() { result = 42; });
+	EXPECT_EQ(42, result);
+	irt::shutdown();
+	// workers without threads are simply discarded
+	EXPECT_EQ(IRT_WORKER_LAZY_STARTUP_CANCELLED, irt_g_worker_lazy_startup);
+	unsetenv(IRT_LAZY_WORKER_STARTUP_ENV);
+}
+
+TEST(startup, stack_pool) {
+	irt::init(1);
+	// the startup worker pre-allocates its stacks, one of which is in use by the running work item
+	irt::run([]() {
+		uint32 available = 0;
+		for(lwt_reused_stack* cur = lwt_g_stack_reuse.stacks[0]; cur; cur = cur->next) {
+			available++;
+		}
+		EXPECT_GE(available, IRT_LWT_STACK_POOL_SIZE - 1u);
+	});
+	irt::shutdown();
+}
+
+// measures the latency of starting the runtime, running a trivial work item and shutting down again
+static double measure_startup_latency(bool lazy) {
+	if(lazy) {
+		setenv(IRT_LAZY_WORKER_STARTUP_ENV, "1", 1);
+	} else {
+		unsetenv(IRT_LAZY_WORKER_STARTUP_ENV);
+	}
+	uint64 total = 0;
+	for(int i = 0; i < NUM_STARTUP_ROUNDS; ++i) {
+		uint64 start = irt_time_ns();
+		irt::init(NUM_WORKERS);
+		irt::run([]() {});
+		irt::shutdown();
+		total += irt_time_ns() - start;
+	}
+	unsetenv(IRT_LAZY_WORKER_STARTUP_ENV);
+	return total / (NUM_STARTUP_ROUNDS * 1000.0);
+}
+
+// a benchmark rather than a test, run it using --gtest_also_run_disabled_tests
+TEST(startup, DISABLED_latency_benchmark) {
+	double eager = measure_startup_latency(false);
+	double lazy = measure_startup_latency(true);
+	std::cout << "Startup + shutdown latency with " << NUM_WORKERS << " workers: eager " << eager << " us, lazy " << lazy << " us\n";
+	EXPECT_GT(eager, 0.0);
+	EXPECT_GT(lazy, 0.0);
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#include <atomic>
+
+#define NUM_TASKS 32
+
+static void spin(int iterations) {
+	volatile int x = 0;
+	for(int i = 0; i < iterations; ++i) {
+		x += i;
+	}
+}
+
+TEST(TaskDeps, WriteChain) {
+	irt::init(4);
+	irt::run([]() {
+		int data = 0;
+		int log[NUM_TASKS];
+		std::atomic<int> pos(0);
+		int* logp = log;
+		std::atomic<int>* posp = &pos;
+		for(int i = 0; i < NUM_TASKS; ++i) {
+			irt_task_deps deps = irt_task_deps_create();
+			irt_task_deps_add(deps, &data, true);
+			irt::parallel(1, [deps, i, logp, posp]() {
+				irt_task_deps_wait(deps);
+				// earlier tasks do more work, they still have to finish first
+				spin((NUM_TASKS - i) * 1000);
+				logp[(*posp)++] = i;
+				irt_task_deps_release(deps);
+			});
+		}
+		irt::merge_all();
+		ASSERT_EQ(NUM_TASKS, pos);
+		for(int i = 0; i < NUM_TASKS; ++i) {
+			EXPECT_EQ(i, log[i]);
+		}
+	});
+	irt::shutdown();
+}
+
+TEST(TaskDeps, ReadersBetweenWriters) {
+	irt::init(4);
+	irt::run([]() {
+		for(int rep = 0; rep < 10; ++rep) {
+			int data = 0;
+			std::atomic<int> reads(0), errors(0);
+			int* datap = &data;
+			std::atomic<int>* readsp = &reads;
+			std::atomic<int>* errorsp = &errors;
+
+			irt_task_deps writer = irt_task_deps_create();
+			irt_task_deps_add(writer, &data, true);
+			irt::parallel(1, [writer, datap]() {
+				irt_task_deps_wait(writer);
+				spin(100000);
+				*datap = 1;
+				irt_task_deps_release(writer);
+			});
+			// readers run concurrently with each other, but only after the writer
+			for(int i = 0; i < 8; ++i) {
+				irt_task_deps reader = irt_task_deps_create();
+				irt_task_deps_add(reader, &data, false);
+				irt::parallel(1, [reader, datap, readsp, errorsp]() {
+					irt_task_deps_wait(reader);
+					if(*datap != 1) { (*errorsp)++; }
+					spin(10000);
+					(*readsp)++;
+					irt_task_deps_release(reader);
+				});
+			}
+			// the second writer has to wait for all readers
+			irt_task_deps second = irt_task_deps_create();
+			irt_task_deps_add(second, &data, true);
+			irt::parallel(1, [second, datap, readsp, errorsp]() {
+				irt_task_deps_wait(second);
+				if(*readsp != 8) { (*errorsp)++; }
+				*datap = 2;
+				irt_task_deps_release(second);
+			});
+			irt::merge_all();
+			EXPECT_EQ(0, errors);
+			EXPECT_EQ(8, reads);
+			EXPECT_EQ(2, data);
+		}
+	});
+	irt::shutdown();
+}
+
+TEST(TaskDeps, Independent) {
+	irt::init(4);
+	irt::run([]() {
+		// tasks on distinct addresses, and tasks depending on an address they both read and write, do not block
+		int data[NUM_TASKS] = {0};
+		int* datap = data;
+		for(int i = 0; i < NUM_TASKS; ++i) {
+			irt_task_deps deps = irt_task_deps_create();
+			irt_task_deps_add(deps, &data[i], false);
+			irt_task_deps_add(deps, &data[i], true);
+			irt::parallel(1, [deps, i, datap]() {
+				irt_task_deps_wait(deps);
+				datap[i] = i + 1;
+				irt_task_deps_release(deps);
+			});
+		}
+		irt::merge_all();
+		for(int i = 0; i < NUM_TASKS; ++i) {
+			EXPECT_EQ(i + 1, data[i]);
+		}
+	});
+	irt::shutdown();
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#define NUM_REPETITIONS 10
+
+static void combine_sum(void* inout, void* in) {
+	*(int64*)inout += *(int64*)in;
+}
+
+static void combine_max(void* inout, void* in) {
+	if(*(double*)in > *(double*)inout) { *(double*)inout = *(double*)in; }
+}
+
+TEST(WgReduce, Sum) {
+	irt::init(4);
+	for(uint32 members : {1u, 3u, 8u, 13u}) {
+		irt::run([members]() {
+			volatile int64 results[NUM_REPETITIONS];
+			irt::merge(irt::parallel(members, [&results]() {
+				irt_work_item* wi = irt_wi_get_current();
+				irt_work_group* wg = irt_wi_get_wg(wi, 0);
+				uint32 id = irt_wi_get_wg_num(wi, 0);
+				// back-to-back reductions must not interfere with each other
+				for(int i = 0; i < NUM_REPETITIONS; ++i) {
+					int64 value = id + 1 + i;
+					irt_wg_reduce(wg, wi, &value, &combine_sum);
+					if(id == 0) { results[i] = value; }
+				}
+			}));
+			for(int i = 0; i < NUM_REPETITIONS; ++i) {
+				EXPECT_EQ(members * (members + 1) / 2 + members * i, results[i]) << "members: " << members;
+			}
+		});
+	}
+	irt::shutdown();
+}
+
+TEST(WgReduce, Max) {
+	irt::init(4);
+	irt::run([]() {
+		volatile double result = 0.0;
+		irt::merge(irt::parallel(7, [&result]() {
+			irt_work_item* wi = irt_wi_get_current();
+			uint32 id = irt_wi_get_wg_num(wi, 0);
+			double value = (id == 4) ? 100.5 : id * 0.5;
+			irt_wg_reduce(irt_wi_get_wg(wi, 0), wi, &value, &combine_max);
+			if(id == 0) { result = value; }
+		}));
+		EXPECT_EQ(100.5, result);
+	});
+	irt::shutdown();
+}
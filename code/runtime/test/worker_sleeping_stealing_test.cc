@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+
+#include "insieme/common/utils/gtest_utils.h"
+
+// default scheduling policy (circular stealing), default sleeping
+#define IRT_WORKER_IDLE_SPIN_ROUNDS 2
+#define IRT_WORKER_IDLE_YIELD_ROUNDS 2
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#include <atomic>
+
+#define N 16
+
+TEST(WorkerSleepingStealing, ParkAndWake) {
+	EXPECT_IN_TIME(20 * 1000, {
+		irt::init(4);
+		irt::run([]() {
+			std::atomic<int> count(0);
+			for(int i = 0; i < 20; ++i) {
+				// give idle workers time to park before new work arrives
+				irt_nanosleep(2e6);
+				irt::merge(irt::parallel(N, [&count] { count++; }));
+			}
+			EXPECT_EQ(20 * N, count);
+		});
+		irt::shutdown();
+	});
+}
+
+TEST(WorkerSleepingStealing, IdleWorkersPark) {
+	EXPECT_IN_TIME(20 * 1000, {
+		irt::init(4);
+		irt::run([]() {
+			std::atomic<int> count(0);
+			irt::merge(irt::parallel(N, [&count] { count++; }));
+			EXPECT_EQ(N, count);
+			irt_worker* self = irt_worker_get_current();
+			// with nothing left to steal, all other workers eventually park
+			uint32 parked;
+			do {
+				irt_nanosleep(1e5);
+				parked = 0;
+				for(uint32 i = 0; i < irt_g_worker_count; ++i) {
+					if(irt_atomic_load(&irt_g_workers[i]->park_state) == IRT_WORKER_PARK_PARKED) { parked++; }
+				}
+			} while(parked + 1 < irt_g_worker_count);
+			EXPECT_NE(IRT_WORKER_PARK_PARKED, irt_atomic_load(&self->park_state));
+			EXPECT_EQ(1u, irt_atomic_load(&irt_g_active_worker_count));
+		});
+		irt::shutdown();
+	});
+}
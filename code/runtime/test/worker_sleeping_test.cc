@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include "insieme/common/utils/gtest_utils.h"
+
+#define IRT_SCHED_POLICY 1 // IRT_SCHED_POLICY_STATIC, see worker_sleeping_stealing_test.cc for the default policy
+#define IRT_WORKER_SLEEPING
+#define IRT_WORKER_IDLE_SPIN_ROUNDS 2
+#define IRT_WORKER_IDLE_YIELD_ROUNDS 2
+
+#define IRT_LIBRARY_MAIN
+#define IRT_LIBRARY_NO_MAIN_FUN
+#include "irt_library.hxx"
+
+#include <atomic>
+
+#define N 16
+
+TEST(WorkerSleeping, ParkAndWake) {
+	EXPECT_IN_TIME(20 * 1000, {
+		irt::init(4);
+		irt::run([]() {
+			std::atomic<int> count(0);
+			for(int i = 0; i < 20; ++i) {
+				// give idle workers time to park before new work arrives
+				irt_nanosleep(2e6);
+				irt::merge(irt::parallel(N, [&count] { count++; }));
+			}
+			EXPECT_EQ(20 * N, count);
+		});
+		irt::shutdown();
+	});
+}
+
+TEST(WorkerSleeping, PendingSignalIsConsumed) {
+	irt::init(2);
+	irt::run([]() {
+		irt_worker* self = irt_worker_get_current();
+		irt_worker* other = irt_g_workers[(self->id.thread + 1) % irt_g_worker_count];
+		// signaling a worker twice only leaves a single pending notification
+		irt_signal_worker(other);
+		irt_signal_worker(other);
+		uint32 state = irt_atomic_load(&other->park_state);
+		EXPECT_NE(IRT_WORKER_PARK_PARKED, state);
+		// one worker always stays awake
+		EXPECT_LE(1u, irt_atomic_load(&irt_g_active_worker_count));
+	});
+	irt::shutdown();
+}
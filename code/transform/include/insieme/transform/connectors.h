@@ -40,6 +40,7 @@
 #include <limits>
 
 #include "insieme/transform/transformation.h"
+#include "insieme/transform/execution.h"
 #include "insieme/transform/primitives.h"
 #include "insieme/transform/filter/filter.h"
 #include "insieme/transform/catalog.h"
@@ -96,7 +97,7 @@ namespace transform {
 			// apply all transformations, one after another
 			// if one is failing, the entire transformation is failing
 			core::NodeAddress res = target;
-			for_each(getSubTransformations(), [&](const TransformationPtr& cur) { res = cur->apply(res); });
+			for_each(getSubTransformations(), [&](const TransformationPtr& cur) { res = applyTransformation(cur, res); });
 			return res;
 		}
 
@@ -406,7 +407,7 @@ namespace transform {
 		 * @return the transformed program code
 		 */
 		virtual core::NodeAddress apply(const core::NodeAddress& target) const {
-			return (condition(target)) ? thenTransform->apply(target) : elseTransform->apply(target);
+			return (condition(target)) ? applyTransformation(thenTransform, target) : applyTransformation(elseTransform, target);
 		}
 
 		/**
@@ -466,11 +467,11 @@ namespace transform {
 		 */
 		virtual core::NodeAddress apply(const core::NodeAddress& target) const {
 			try {
-				return tryTransform->apply(target);
+				return applyTransformation(tryTransform, target);
 			} catch(const InvalidTargetException& ite) {
 				// => first failed, use otherwise transformation
 			}
-			return otherwiseTransform->apply(target);
+			return applyTransformation(otherwiseTransform, target);
 		}
 
 		/**
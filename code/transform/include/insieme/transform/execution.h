@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <exception>
+
+#include "insieme/core/ir_address.h"
+#include "insieme/transform/transformation.h"
+
+#include "insieme/utils/printable.h"
+
+namespace insieme {
+namespace transform {
+
+	/**
+	 * NOTES:
+	 * The execution engine defined within this header is an optional driver for applying
+	 * (composed) transformations. Connectors are forwarding the application of their
+	 * sub-transformations to the engine currently active within the executing thread (if any).
+	 * This way, the engine is able to
+	 *
+	 *		- memoize the results of applying transformations to nodes (nodes are unique within
+	 *		  their node manager, hence a node pointer is a canonical key for the input)
+	 *		- process independent branches of ForAll and Versioning connectors in parallel
+	 *		- collect timing information on a per-transformation-type basis
+	 *
+	 * Without an active engine, transformations are applied exactly as before.
+	 */
+
+	/**
+	 * A summary of the applications of one type of transformation processed by an engine.
+	 */
+	struct TransformationStatistics {
+		/**
+		 * The number of requested applications, including those served by the cache.
+		 */
+		unsigned applications;
+
+		/**
+		 * The number of applications served by the cache.
+		 */
+		unsigned cacheHits;
+
+		/**
+		 * The number of applications which failed due to an invalid target.
+		 */
+		unsigned failures;
+
+		/**
+		 * The accumulated wall-clock time spent in the transformation in seconds. The times of
+		 * connectors include the times of their sub-transformations. Branches processed in parallel
+		 * are accumulated, hence the sum may exceed the overall execution time.
+		 */
+		double time;
+
+		TransformationStatistics() : applications(0), cacheHits(0), failures(0), time(0.0) {}
+
+		TransformationStatistics& operator+=(const TransformationStatistics& other);
+	};
+
+	/**
+	 * The engine conducting the application of transformations, thereby caching results and
+	 * exploiting the parallelism of independent transformation branches.
+	 *
+	 * Parallel branches are processed within private node managers, since node managers are not
+	 * thread safe. The targets are imported into those managers before, the results are imported
+	 * back after all branches have completed. Hence, transformations have to create new nodes using
+	 * the manager of their target (as is requested by the Transformation interface anyway).
+	 */
+	class ExecutionEngine : public utils::Printable {
+		/**
+		 * The result of applying a transformation to a node - either the resulting node
+		 * or the exception raised by the transformation.
+		 */
+		struct Result {
+			TransformationPtr transformation;
+			core::NodeAddress result;
+			std::exception_ptr error;
+		};
+
+		/**
+		 * The cache of results, indexed by the transformation instance and the target node. Instances are
+		 * distinguished by identity since the equality operator of some transformations (e.g. lambda
+		 * transformations and filters) only compares their labels. The result keeps the instance alive.
+		 */
+		std::map<std::pair<const Transformation*, core::NodePtr>, Result> cache;
+
+		/**
+		 * The statistics collected per transformation type, indexed by the name of the type.
+		 */
+		std::map<string, TransformationStatistics> statistics;
+
+		/**
+		 * The maximum number of threads to be used for processing independent branches.
+		 */
+		unsigned numThreads;
+
+	  public:
+		/**
+		 * Creates a new engine utilizing up to the given number of threads.
+		 *
+		 * @param numThreads the maximum number of threads to be used, 0 for the number of hardware threads
+		 */
+		ExecutionEngine(unsigned numThreads = 0);
+
+		/**
+		 * Applies the given transformation to the given target utilizing this engine. The results of all
+		 * transformations applied to root addresses (including nested transformations) are cached.
+		 *
+		 * @param transform the transformation to be applied
+		 * @param target the node to be transformed
+		 * @return the transformed node
+		 * @throws InvalidTargetException if the transformation can not be applied to the given target
+		 */
+		core::NodeAddress apply(const TransformationPtr& transform, const core::NodeAddress& target);
+
+		/**
+		 * A generic version of the method above preserving the type of the transformed node.
+		 */
+		template <typename T>
+		core::Pointer<const T> apply(const TransformationPtr& transform, const core::Pointer<const T>& target) {
+			return static_pointer_cast<const T>(apply(transform, core::NodeAddress(target)).getAddressedNode());
+		}
+
+		/**
+		 * Applies the given transformations to the associated nodes. Since the individual applications
+		 * are independent, they are processed in parallel if enabled for this engine.
+		 *
+		 * @param tasks the list of transformations and nodes they should be applied to
+		 * @return the list of transformed nodes, in the order of the tasks
+		 * @throws InvalidTargetException if any of the transformations fails; the failure of the first
+		 * 			failing task will be reported
+		 */
+		std::vector<core::NodePtr> applyAll(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks);
+
+		/**
+		 * Obtains the maximum number of threads utilized by this engine.
+		 */
+		unsigned getNumThreads() const {
+			return numThreads;
+		}
+
+		/**
+		 * Obtains the statistics collected by this engine so far.
+		 */
+		const std::map<string, TransformationStatistics>& getStatistics() const {
+			return statistics;
+		}
+
+		/**
+		 * Drops all cached results and collected statistics.
+		 */
+		void reset();
+
+		/**
+		 * Prints a summary of the collected statistics to the given output stream.
+		 */
+		std::ostream& printTo(std::ostream& out) const;
+
+	  private:
+		/**
+		 * Looks up the cache entry for the given transformation and target, null if there is none.
+		 */
+		const Result* lookup(const TransformationPtr& transform, const core::NodePtr& target) const;
+
+		/**
+		 * Processes the given tasks in parallel, each within a private node manager.
+		 */
+		std::vector<core::NodePtr> applyInParallel(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks);
+	};
+
+	/**
+	 * Applies the given transformation to the given target. If there is an execution engine active within
+	 * the current thread, the application will be conducted by the engine. This function should be used by
+	 * connectors for applying their sub-transformations.
+	 *
+	 * @param transform the transformation to be applied
+	 * @param target the node to be transformed
+	 * @return the transformed node
+	 * @throws InvalidTargetException if the transformation can not be applied to the given target
+	 */
+	core::NodeAddress applyTransformation(const TransformationPtr& transform, const core::NodeAddress& target);
+
+	/**
+	 * A generic version of the function above preserving the type of the transformed node.
+	 */
+	template <typename T>
+	core::Pointer<const T> applyTransformation(const TransformationPtr& transform, const core::Pointer<const T>& target) {
+		return static_pointer_cast<const T>(applyTransformation(transform, core::NodeAddress(target)).getAddressedNode());
+	}
+
+	/**
+	 * Applies the given list of independent transformation tasks. If there is an execution engine active
+	 * within the current thread, the tasks may be processed in parallel. Otherwise they are applied one
+	 * after another.
+	 *
+	 * @param tasks the list of transformations and nodes they should be applied to
+	 * @return the list of transformed nodes, in the order of the tasks
+	 * @throws InvalidTargetException if any of the transformations fails
+	 */
+	std::vector<core::NodePtr> applyAll(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks);
+
+} // end namespace transform
+} // end namespace insieme
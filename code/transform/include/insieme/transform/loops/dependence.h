@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "insieme/core/ir.h"
+#include "insieme/core/ir_address.h"
+#include "insieme/utils/set_utils.h"
+
+/**
+ * This header provides a light-weight dependence analysis for loop bodies. Array subscripts
+ * are converted into formulas and, if they are uniform affine functions of the enclosing loop
+ * iterators, dependence distances are derived. Accesses through distinct bases are only
+ * considered independent if both bases are known to refer to distinct allocations; otherwise
+ * they are treated as a dependence of unknown distance.
+ */
+
+namespace insieme {
+namespace transform {
+namespace loops {
+
+	/**
+	 * A single access to an element of an array within a loop body. The base is either an
+	 * array variable or a dereferenced (materialized) parameter.
+	 */
+	struct ArrayAccess {
+		core::ExpressionPtr base;
+		vector<core::ExpressionPtr> indices;
+		bool write;
+	};
+
+	/**
+	 * A summary of the memory accesses within a code fragment. If the fragment contains
+	 * any operation the dependence test can not reason about, the summary is marked as
+	 * not analysable.
+	 */
+	struct AccessSummary {
+		bool analysable;
+		vector<ArrayAccess> accesses;
+		utils::set::PointerSet<core::VariablePtr> locals;
+	};
+
+	/**
+	 * Collects the array accesses within the given code fragment. Accesses to variables
+	 * declared within the fragment are not recorded.
+	 */
+	AccessSummary collectAccesses(const core::NodePtr& code);
+
+	/**
+	 * Collects the variables declared within the compound statements enclosing the given code
+	 * which are initialized by a fresh allocation (ref_var or ref_new). Those can not alias with
+	 * any other access base.
+	 */
+	utils::set::PointerSet<core::ExpressionPtr> getDistinctAllocations(const core::NodeAddress& code);
+
+	/**
+	 * The distance vector of a potential dependence between two accesses. A component
+	 * is absent if the distance along the corresponding loop is unknown.
+	 */
+	typedef vector<boost::optional<int64_t>> DistanceVector;
+
+	/**
+	 * Determines the iteration distance between two accesses to the same array element.
+	 * The distance is measured as the iteration of the second access minus the iteration of
+	 * the first access. If the accesses may not overlap, no distance is returned.
+	 *
+	 * @param a the first access, indexed by the iterators itersA
+	 * @param b the second access, indexed by the iterators itersB
+	 * @param locals the variables declared within the analysed code
+	 * @param distinct the access bases known to refer to distinct allocations
+	 */
+	boost::optional<DistanceVector> getDistance(const ArrayAccess& a, const core::VariableList& itersA, const ArrayAccess& b,
+	                                            const core::VariableList& itersB, const utils::set::PointerSet<core::VariablePtr>& locals,
+	                                            const utils::set::PointerSet<core::ExpressionPtr>& distinct);
+
+	/**
+	 * Determines whether any dependence between the accesses of the two given code fragments
+	 * may have a negative distance along a single loop. This is the case if an access within
+	 * the second fragment in some iteration conflicts with an access of the first fragment
+	 * in a later iteration.
+	 */
+	bool hasBackwardDependence(const AccessSummary& first, const core::VariablePtr& iterA, const AccessSummary& second, const core::VariablePtr& iterB,
+	                           const utils::set::PointerSet<core::ExpressionPtr>& distinct);
+
+	/**
+	 * Determines whether the given loop may carry a dependence between different iterations.
+	 * The result is conservative - if the body can not be analysed, true is returned.
+	 *
+	 * @param loop the loop to be checked
+	 * @param distinct the access bases known to refer to distinct allocations
+	 */
+	bool hasLoopCarriedDependence(const core::ForStmtPtr& loop, const utils::set::PointerSet<core::ExpressionPtr>& distinct);
+
+} // end namespace loops
+} // end namespace transform
+} // end namespace insieme
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#pragma once
+
+#include "insieme/transform/transformation.h"
+
+/**
+ * This header file provides the definition of a set of dependence-checked loop-nest
+ * transformations including loop interchange, fusion, fission and skewing.
+ *
+ * The legality tests are based on a light-weight dependence analysis: array subscripts
+ * are converted into formulas and, if they are uniform affine functions of the loop
+ * iterators, distance vectors are derived. Whenever this is not possible the tests
+ * conservatively reject the transformation.
+ */
+
+namespace insieme {
+namespace transform {
+namespace loops {
+
+
+	// -- Loop Interchange --
+
+	/**
+	 * A transformation swapping the two outermost loops of a perfectly nested loop nest.
+	 * The inner loop bounds must either not depend on the outer iterator or both be shifted
+	 * by the same non-negative multiple of it, as obtained by skewing, in which case unit
+	 * steps are required. No dependence may be reversed by the interchange.
+	 */
+	class LoopInterchange : public Transformation {
+	  public:
+		/**
+		 * Creates a new instance of this transformation type
+		 */
+		LoopInterchange(const parameter::Value& value);
+
+		/**
+		 * Implements the actual transformation.
+		 *
+		 * @param target the outer loop of the nest to be interchanged
+		 */
+		virtual core::NodeAddress apply(const core::NodeAddress& target) const;
+
+		/**
+		 * Prints a readable representation of this transformation to the given output stream
+		 * using the given indent.
+		 */
+		virtual std::ostream& printTo(std::ostream& out, const Indent& indent) const {
+			return out << indent << "LoopInterchange";
+		}
+	};
+
+	/**
+	 * Factory for the loop interchange transformation.
+	 */
+	TRANSFORMATION_TYPE(LoopInterchange, "Interchanges the two outermost loops of a perfect loop nest if dependences permit.", parameter::no_parameters());
+
+	/**
+	 * A factory function creating a loop interchange transformation.
+	 */
+	inline TransformationPtr makeLoopInterchange() {
+		return LoopInterchangeType().buildTransformation(parameter::emptyValue);
+	}
+
+
+	// -- Loop Fusion --
+
+	/**
+	 * A transformation merging two adjacent loops of a compound statement sharing the same
+	 * iteration space into a single loop. The fusion is rejected if it would reverse any
+	 * dependence between the two loop bodies.
+	 */
+	class LoopFusion : public Transformation {
+		/**
+		 * The index of the first of the two loops to be fused within the targeted compound.
+		 */
+		unsigned index;
+
+	  public:
+		/**
+		 * Creates a new instance of this transformation type
+		 */
+		LoopFusion(const parameter::Value& value);
+
+		/**
+		 * Implements the actual transformation.
+		 *
+		 * @param target the compound statement containing the loops to be fused
+		 */
+		virtual core::NodeAddress apply(const core::NodeAddress& target) const;
+
+		/**
+		 * Prints a readable representation of this transformation to the given output stream
+		 * using the given indent.
+		 */
+		virtual std::ostream& printTo(std::ostream& out, const Indent& indent) const {
+			return out << indent << "LoopFusion(" << index << ")";
+		}
+	};
+
+	/**
+	 * Factory for the loop fusion transformation.
+	 */
+	TRANSFORMATION_TYPE(LoopFusion, "Fuses two adjacent loops with equal iteration spaces if dependences permit.",
+	                    parameter::atom<unsigned>("The index of the first loop within the targeted compound statement."));
+
+	/**
+	 * A factory function creating a loop fusion transformation merging the loop at the
+	 * given position of the targeted compound statement with its successor.
+	 */
+	inline TransformationPtr makeLoopFusion(unsigned index) {
+		return LoopFusionType().buildTransformation(parameter::makeValue<unsigned>(index));
+	}
+
+
+	// -- Loop Fission --
+
+	/**
+	 * A transformation splitting the body of a loop at a given statement into two
+	 * consecutive loops covering the same iteration space. The fission is rejected if
+	 * a dependence from the second part of the body to the first part would be reversed.
+	 */
+	class LoopFission : public Transformation {
+		/**
+		 * The index of the first statement of the body to be moved to the second loop.
+		 */
+		unsigned split;
+
+	  public:
+		/**
+		 * Creates a new instance of this transformation type
+		 */
+		LoopFission(const parameter::Value& value);
+
+		/**
+		 * Implements the actual transformation.
+		 *
+		 * @param target the loop to be split
+		 */
+		virtual core::NodeAddress apply(const core::NodeAddress& target) const;
+
+		/**
+		 * Prints a readable representation of this transformation to the given output stream
+		 * using the given indent.
+		 */
+		virtual std::ostream& printTo(std::ostream& out, const Indent& indent) const {
+			return out << indent << "LoopFission(" << split << ")";
+		}
+	};
+
+	/**
+	 * Factory for the loop fission transformation.
+	 */
+	TRANSFORMATION_TYPE(LoopFission, "Splits the body of a loop into two consecutive loops if dependences permit.",
+	                    parameter::atom<unsigned>("The index of the first statement to be moved into the second loop."));
+
+	/**
+	 * A factory function creating a loop fission transformation splitting the body of
+	 * the targeted loop before the statement of the given index.
+	 */
+	inline TransformationPtr makeLoopFission(unsigned split) {
+		return LoopFissionType().buildTransformation(parameter::makeValue<unsigned>(split));
+	}
+
+
+	// -- Loop Skewing --
+
+	/**
+	 * A transformation skewing the inner loop of a two-level loop nest by a multiple of
+	 * the outer iterator. The iteration order is not altered, hence the transformation is
+	 * always legal; it is intended to enable a subsequent interchange or wavefront
+	 * parallelization.
+	 */
+	class LoopSkewing : public Transformation {
+		/**
+		 * The factor the outer iterator is multiplied with when shifting the inner loop.
+		 */
+		unsigned factor;
+
+	  public:
+		/**
+		 * Creates a new instance of this transformation type
+		 */
+		LoopSkewing(const parameter::Value& value);
+
+		/**
+		 * Implements the actual transformation.
+		 *
+		 * @param target the outer loop of the nest to be skewed
+		 */
+		virtual core::NodeAddress apply(const core::NodeAddress& target) const;
+
+		/**
+		 * Prints a readable representation of this transformation to the given output stream
+		 * using the given indent.
+		 */
+		virtual std::ostream& printTo(std::ostream& out, const Indent& indent) const {
+			return out << indent << "LoopSkewing(" << factor << ")";
+		}
+	};
+
+	/**
+	 * Factory for the loop skewing transformation.
+	 */
+	TRANSFORMATION_TYPE(LoopSkewing, "Skews the inner loop of a loop nest by a multiple of the outer iterator.",
+	                    parameter::atom<unsigned>("The skewing factor to be used."));
+
+	/**
+	 * A factory function creating a loop skewing transformation using the given factor.
+	 */
+	inline TransformationPtr makeLoopSkewing(unsigned factor) {
+		return LoopSkewingType().buildTransformation(parameter::makeValue<unsigned>(factor));
+	}
+
+
+} // end namespace loops
+} // end namespace transform
+} // end namespace insieme
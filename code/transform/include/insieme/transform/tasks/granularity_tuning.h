@@ -45,6 +45,9 @@ namespace tasks {
 	/**
 	 * Takes all (mutually) recursive parallel tasks in the given program,
 	 * and multiversions them to feature unrolled and fully sequentialized variants.
+	 * The unrolling factors are selected based on a cost model estimating the effort
+	 * of the tasks, and the resulting variant table is attached as meta information
+	 * to guide the runtime's variant selection.
 	 */
 	core::ProgramPtr applyTaskOptimization(const core::ProgramPtr& program);
 }
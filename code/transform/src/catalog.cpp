@@ -38,6 +38,7 @@
 
 #include "insieme/transform/connectors.h"
 #include "insieme/transform/primitives.h"
+#include "insieme/transform/loops/transformations.h"
 #include "insieme/transform/rulebased/transformations.h"
 
 namespace insieme {
@@ -59,6 +60,12 @@ namespace transform {
 		// add pattern based transformations
 		res.add(rulebased::LoopUnrollingType::getInstance());
 
+		// add dependence-checked loop nest transformations
+		res.add(loops::LoopInterchangeType::getInstance());
+		res.add(loops::LoopFusionType::getInstance());
+		res.add(loops::LoopFissionType::getInstance());
+		res.add(loops::LoopSkewingType::getInstance());
+
 		// TODO: add more transformation
 
 		return res;
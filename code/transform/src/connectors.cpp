@@ -114,9 +114,16 @@ namespace transform {
 		vector<core::NodeAddress> targets = filter(target);
 		if(targets.empty()) { return targetAddress; }
 
+		// transform targets - those are independent, thus they may be processed in parallel
+		vector<std::pair<TransformationPtr, core::NodePtr>> tasks;
+		for_each(targets, [&](const core::NodeAddress& cur) { tasks.push_back(std::make_pair(getTransformation(), cur.getAddressedNode())); });
+		vector<core::NodePtr> transformed = applyAll(tasks);
+
 		// generate replacement map
 		std::map<core::NodeAddress, core::NodePtr> replacements;
-		for_each(targets, [&](const core::NodeAddress& cur) { replacements[cur] = getTransformation()->apply(cur.getAddressedNode()); });
+		for(std::size_t i = 0; i < targets.size(); ++i) {
+			replacements[targets[i]] = transformed[i];
+		}
 
 		// apply replacement
 		auto mod = core::transform::replaceAll(target->getNodeManager(), replacements);
@@ -217,7 +224,7 @@ namespace transform {
 		core::NodePtr res = target;
 
 		// conduct transformation in pre-order if requested
-		if(preorder && filter(res)) { res = getTransformation()->apply(res); }
+		if(preorder && filter(res)) { res = applyTransformation(getTransformation(), res); }
 
 		// conduct recursive decent - by transforming children
 		core::NodeList children = res->getChildList();
@@ -230,7 +237,7 @@ namespace transform {
 		}
 
 		// conduct transformation in post-order if requested
-		if(!preorder && filter(res)) { res = getTransformation()->apply(res); }
+		if(!preorder && filter(res)) { res = applyTransformation(getTransformation(), res); }
 
 		// done
 		return res;
@@ -247,7 +254,7 @@ namespace transform {
 		unsigned counter = 0;
 		do {
 			last = cur;
-			cur = getTransformation()->apply(last);
+			cur = applyTransformation(getTransformation(), last);
 			counter++;
 		} while(*cur != *last && counter <= maxIterations);
 
@@ -0,0 +1,289 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include "insieme/transform/execution.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <iomanip>
+
+#include "insieme/core/ir_node.h"
+
+namespace insieme {
+namespace transform {
+
+	namespace {
+
+		/**
+		 * The engine active within the current thread, null if there is none.
+		 */
+		thread_local ExecutionEngine* currentEngine = nullptr;
+
+		/**
+		 * A guard registering an engine as the active engine of the current thread for its life time.
+		 */
+		class ActiveEngine {
+			ExecutionEngine* last;
+
+		  public:
+			ActiveEngine(ExecutionEngine* engine) : last(currentEngine) {
+				currentEngine = engine;
+			}
+			~ActiveEngine() {
+				currentEngine = last;
+			}
+		};
+
+		/**
+		 * The number of fresh IDs reserved for each branch processed in parallel. Branches are processed
+		 * within independent node managers, thus the ranges have to be disjoint. Branches exceeding their
+		 * range are recomputed within the target manager.
+		 */
+		const unsigned FRESH_ID_RANGE = 1u << 16;
+
+		typedef std::chrono::steady_clock Clock;
+
+		double secondsSince(const Clock::time_point& start) {
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
+	}
+
+	TransformationStatistics& TransformationStatistics::operator+=(const TransformationStatistics& other) {
+		applications += other.applications;
+		cacheHits += other.cacheHits;
+		failures += other.failures;
+		time += other.time;
+		return *this;
+	}
+
+	ExecutionEngine::ExecutionEngine(unsigned numThreads) : numThreads((numThreads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : numThreads) {}
+
+	core::NodeAddress ExecutionEngine::apply(const TransformationPtr& transform, const core::NodeAddress& target) {
+		assert_true(transform) << "Transformation must be valid!";
+		ActiveEngine active(this);
+
+		TransformationStatistics& stats = statistics[transform->getType().getName()];
+		stats.applications++;
+
+		// only root addresses are cached - otherwise the context of the target could be of importance
+		bool cacheable = target.isRoot();
+
+		// check the cache
+		if(cacheable) {
+			if(const Result* hit = lookup(transform, target.getAddressedNode())) {
+				stats.cacheHits++;
+				if(hit->error) { std::rethrow_exception(hit->error); }
+				return hit->result;
+			}
+		}
+
+		// apply the transformation
+		Result res{transform, core::NodeAddress(), nullptr};
+		auto start = Clock::now();
+		try {
+			res.result = transform->apply(target);
+		} catch(const InvalidTargetException&) {
+			res.error = std::current_exception();
+			stats.failures++;
+		}
+		stats.time += secondsSince(start);
+
+		// record and return the result
+		if(cacheable) { cache[std::make_pair(transform.get(), target.getAddressedNode())] = res; }
+		if(res.error) { std::rethrow_exception(res.error); }
+		return res.result;
+	}
+
+	std::vector<core::NodePtr> ExecutionEngine::applyAll(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks) {
+		ActiveEngine active(this);
+
+		// check whether it is worth processing tasks in parallel
+		std::size_t numUncached = 0;
+		for(const auto& cur : tasks) {
+			if(!lookup(cur.first, cur.second)) { numUncached++; }
+		}
+		if(numThreads > 1 && numUncached > 1) { return applyInParallel(tasks); }
+
+		// process tasks sequentially
+		std::vector<core::NodePtr> res;
+		for(const auto& cur : tasks) {
+			res.push_back(apply(cur.first, core::NodeAddress(cur.second)).getAddressedNode());
+		}
+		return res;
+	}
+
+	void ExecutionEngine::reset() {
+		cache.clear();
+		statistics.clear();
+	}
+
+	std::ostream& ExecutionEngine::printTo(std::ostream& out) const {
+		out << "Transformation Statistics:";
+		for(const auto& cur : statistics) {
+			const TransformationStatistics& stats = cur.second;
+			out << "\n    " << std::left << std::setw(30) << cur.first << std::right << " applications: " << std::setw(6) << stats.applications
+			    << " cached: " << std::setw(6) << stats.cacheHits << " failed: " << std::setw(6) << stats.failures << " time: " << std::fixed
+			    << std::setprecision(3) << stats.time << "s";
+		}
+		return out;
+	}
+
+	const ExecutionEngine::Result* ExecutionEngine::lookup(const TransformationPtr& transform, const core::NodePtr& target) const {
+		auto pos = cache.find(std::make_pair(transform.get(), target));
+		return (pos == cache.end()) ? nullptr : &pos->second;
+	}
+
+	std::vector<core::NodePtr> ExecutionEngine::applyInParallel(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks) {
+		std::vector<core::NodePtr> res(tasks.size());
+
+		/**
+		 * A task to be processed in parallel. Each task is processed within a private node manager
+		 * using a private, sequential engine.
+		 */
+		struct Branch {
+			unsigned index;
+			std::unique_ptr<core::NodeManager> manager;
+			core::NodePtr target;
+			core::NodePtr result;
+			std::exception_ptr error;
+			ExecutionEngine engine; // < kept after the manager such that it is destroyed first
+
+			Branch(unsigned index, unsigned firstID) : index(index), manager(new core::NodeManager(firstID)), engine(1) {}
+		};
+
+		// serve cached results and set up branches for the remaining tasks
+		core::NodeManager* mgr = nullptr;
+		unsigned firstID = 0;
+		std::vector<std::unique_ptr<Branch>> branches;
+		for(unsigned i = 0; i < tasks.size(); ++i) {
+			const auto& task = tasks[i];
+			if(lookup(task.first, task.second)) {
+				res[i] = apply(task.first, core::NodeAddress(task.second)).getAddressedNode();
+				continue;
+			}
+
+			// reserve fresh IDs within the target manager
+			if(!mgr) {
+				mgr = &task.second->getNodeManager();
+				firstID = mgr->getFreshID();
+			}
+			assert_eq(mgr, &task.second->getNodeManager()) << "All targets must be maintained by the same manager!";
+
+			// import target into private manager - sequentially, since the source manager is not thread safe
+			branches.push_back(std::unique_ptr<Branch>(new Branch(i, firstID + branches.size() * FRESH_ID_RANGE)));
+			branches.back()->target = branches.back()->manager->get(task.second);
+		}
+		if(branches.empty()) { return res; }
+
+		// process branches in parallel
+		std::atomic<unsigned> next(0);
+		auto worker = [&]() {
+			for(unsigned i = next++; i < branches.size(); i = next++) {
+				Branch& cur = *branches[i];
+				try {
+					cur.result = cur.engine.apply(tasks[cur.index].first, core::NodeAddress(cur.target)).getAddressedNode();
+				} catch(...) { cur.error = std::current_exception(); }
+			}
+		};
+		std::vector<std::thread> workers;
+		for(unsigned i = 1; i < std::min<std::size_t>(numThreads, branches.size()); ++i) {
+			workers.push_back(std::thread(worker));
+		}
+		worker();
+		for(auto& cur : workers) {
+			cur.join();
+		}
+
+		// import results into the target manager and collect statistics
+		std::exception_ptr error;
+		std::vector<unsigned> exceeded;
+		for(unsigned i = 0; i < branches.size(); ++i) {
+			Branch& cur = *branches[i];
+
+			// a branch exceeding its range of fresh IDs may clash with other branches => recompute it below
+			if(cur.manager->getFreshID() >= firstID + (i + 1) * FRESH_ID_RANGE) {
+				exceeded.push_back(cur.index);
+				continue;
+			}
+
+			for(const auto& stats : cur.engine.statistics) {
+				statistics[stats.first] += stats.second;
+			}
+
+			if(cur.error) {
+				if(!error) { error = cur.error; }
+				continue;
+			}
+
+			const auto& task = tasks[cur.index];
+			res[cur.index] = mgr->get(cur.result);
+			cache[std::make_pair(task.first.get(), task.second)] = Result{task.first, core::NodeAddress(res[cur.index]), nullptr};
+		}
+		mgr->setNextFreshID(firstID + branches.size() * FRESH_ID_RANGE);
+
+		// recompute branches which exceeded their range sequentially, drawing fresh IDs from the target manager
+		for(unsigned index : exceeded) {
+			try {
+				res[index] = apply(tasks[index].first, core::NodeAddress(tasks[index].second)).getAddressedNode();
+			} catch(...) {
+				if(!error) { error = std::current_exception(); }
+			}
+		}
+
+		// report the first failure
+		if(error) { std::rethrow_exception(error); }
+		return res;
+	}
+
+	core::NodeAddress applyTransformation(const TransformationPtr& transform, const core::NodeAddress& target) {
+		if(currentEngine) { return currentEngine->apply(transform, target); }
+		return transform->apply(target);
+	}
+
+	std::vector<core::NodePtr> applyAll(const std::vector<std::pair<TransformationPtr, core::NodePtr>>& tasks) {
+		if(currentEngine) { return currentEngine->applyAll(tasks); }
+
+		std::vector<core::NodePtr> res;
+		for(const auto& cur : tasks) {
+			res.push_back(cur.first->apply(cur.second));
+		}
+		return res;
+	}
+
+} // end namespace transform
+} // end namespace insieme
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include "insieme/transform/loops/dependence.h"
+
+#include "insieme/core/ir_visitor.h"
+#include "insieme/core/arithmetic/arithmetic_utils.h"
+#include "insieme/core/lang/reference.h"
+
+namespace insieme {
+namespace transform {
+namespace loops {
+
+	using namespace core;
+	using namespace core::arithmetic;
+
+	namespace {
+
+		/**
+		 * Records an access to the given reference within the given summary. Accesses to
+		 * local variables are ignored, reads of scalar variables are considered invariant.
+		 */
+		bool addAccess(AccessSummary& summary, ExpressionPtr ref, bool write) {
+			auto& refExt = ref->getNodeManager().getLangExtension<lang::ReferenceExtension>();
+
+			// decompose a chain of array element accesses
+			vector<ExpressionPtr> indices;
+			while(auto call = ref.isa<CallExprPtr>()) {
+				if(refExt.isRefDeref(call->getFunctionExpr()) && call->getArgument(0).isa<VariablePtr>()) { break; }
+				if(!refExt.isRefArrayElement(call->getFunctionExpr())) { return false; }
+				indices.push_back(call->getArgument(1));
+				ref = call->getArgument(0);
+			}
+
+			// the base has to be a variable or a dereferenced variable
+			auto var = ref.isa<VariablePtr>();
+			if(!var) { var = ref.as<CallExprPtr>()->getArgument(0).as<VariablePtr>(); }
+
+			// accesses to local variables can not cause loop carried dependences
+			if(summary.locals.contains(var)) { return var == ref; }
+
+			// writes to non-local scalars are not supported
+			if(indices.empty()) { return !write; }
+
+			std::reverse(indices.begin(), indices.end());
+			summary.accesses.push_back(ArrayAccess{ref, indices, write});
+			return true;
+		}
+
+		/**
+		 * An index expression decomposed into coefficients of the loop iterators and
+		 * a loop invariant offset.
+		 */
+		struct AffineIndex {
+			vector<Rational> coefficients;
+			Formula offset;
+		};
+
+		/**
+		 * Converts the given index expression into an affine form based on the given iterators.
+		 */
+		boost::optional<AffineIndex> toAffineIndex(const ExpressionPtr& index, const VariableList& iterators,
+		                                           const utils::set::PointerSet<VariablePtr>& locals) {
+			AffineIndex res;
+			try {
+				res.offset = toFormula(index);
+			} catch(const NotAFormulaException& nafe) { return boost::none; }
+
+			for(const auto& iter : iterators) {
+				Rational coefficient = res.offset[Product(iter)];
+				res.coefficients.push_back(coefficient);
+				if(!coefficient.isZero()) { res.offset = res.offset - Formula(iter, 1, coefficient); }
+			}
+
+			// the offset must neither depend on the iterators nor on variables altered within the loop
+			bool invariant = true;
+			for(const auto& term : res.offset.getTerms()) {
+				for(const auto& factor : term.first.getFactors()) {
+					visitDepthFirstOnce(ExpressionPtr(factor.first), [&](const VariablePtr& var) {
+						if(locals.contains(var) || ::contains(iterators, var)) { invariant = false; }
+					});
+				}
+			}
+			if(!invariant) { return boost::none; }
+
+			return res;
+		}
+
+	} // end anonymous namespace
+
+	AccessSummary collectAccesses(const NodePtr& code) {
+		auto& refExt = code->getNodeManager().getLangExtension<lang::ReferenceExtension>();
+
+		AccessSummary res;
+		res.analysable = true;
+
+		// collect locally declared variables (including nested loop iterators)
+		visitDepthFirstOnce(code, [&](const DeclarationStmtPtr& decl) { res.locals.insert(decl->getVariable()); });
+
+		visitDepthFirstPrunable(code, [&](const NodePtr& cur) -> bool {
+			if(!res.analysable) { return true; }
+
+			// do not descend into the definitions of derived operators
+			if(lang::isBuiltIn(cur)) { return true; }
+
+			// irregular control flow is not supported
+			auto type = cur->getNodeType();
+			if(type == NT_ReturnStmt || type == NT_BreakStmt || type == NT_ContinueStmt || type == NT_GotoStmt) {
+				res.analysable = false;
+				return true;
+			}
+
+			auto call = cur.isa<CallExprPtr>();
+			if(!call) { return false; }
+
+			auto fun = call->getFunctionExpr();
+			if(refExt.isRefAssign(fun)) {
+				res.analysable = addAccess(res, call->getArgument(0), true);
+				return false;
+			}
+			if(refExt.isRefDeref(fun)) {
+				res.analysable = addAccess(res, call->getArgument(0), false);
+				return false;
+			}
+			if(refExt.isRefArrayElement(fun)) { return false; }
+
+			// calls to user defined functions and operators on references may have side effects
+			if(!lang::isBuiltIn(fun) || any(call->getArgumentList(), [](const ExpressionPtr& arg) { return lang::isReference(arg); })) {
+				res.analysable = false;
+				return true;
+			}
+			return false;
+		});
+
+		return res;
+	}
+
+	utils::set::PointerSet<ExpressionPtr> getDistinctAllocations(const NodeAddress& code) {
+		auto& refExt = code->getNodeManager().getLangExtension<lang::ReferenceExtension>();
+
+		utils::set::PointerSet<ExpressionPtr> res;
+		for(NodeAddress cur = code; !cur.isRoot(); cur = cur.getParentAddress()) {
+			auto compound = cur.getParentNode().isa<CompoundStmtPtr>();
+			if(!compound) { continue; }
+			for(const auto& stmt : compound) {
+				auto decl = stmt.isa<DeclarationStmtPtr>();
+				if(!decl) { continue; }
+				auto init = decl->getInitialization();
+				if(refExt.isCallOfRefVar(init) || refExt.isCallOfRefVarInit(init) || refExt.isCallOfRefNew(init) || refExt.isCallOfRefNewInit(init)) {
+					res.insert(decl->getVariable());
+				}
+			}
+		}
+		return res;
+	}
+
+	boost::optional<DistanceVector> getDistance(const ArrayAccess& a, const VariableList& itersA, const ArrayAccess& b, const VariableList& itersB,
+	                                            const utils::set::PointerSet<VariablePtr>& locals, const utils::set::PointerSet<ExpressionPtr>& distinct) {
+		std::size_t n = itersA.size();
+		DistanceVector unknown(n);
+
+		// only writes may cause dependences
+		if(!(a.write || b.write)) { return boost::none; }
+
+		// distinct bases may still alias unless they refer to distinct allocations
+		if(*a.base != *b.base) {
+			if(distinct.contains(a.base) && distinct.contains(b.base)) { return boost::none; }
+			return unknown;
+		}
+		if(a.indices.size() != b.indices.size()) { return unknown; }
+
+		// build one equation sum_k c_k * d_k = rhs per dimension
+		vector<pair<vector<Rational>, Rational>> equations;
+		for(std::size_t i = 0; i < a.indices.size(); ++i) {
+			auto idxA = toAffineIndex(a.indices[i], itersA, locals);
+			auto idxB = toAffineIndex(b.indices[i], itersB, locals);
+			if(!idxA || !idxB) { return unknown; }
+
+			// only uniform dependences are supported
+			if(idxA->coefficients != idxB->coefficients) { return unknown; }
+
+			Formula diff = idxA->offset - idxB->offset;
+			if(!diff.isConstant()) { return unknown; }
+
+			equations.push_back(std::make_pair(idxA->coefficients, diff.getConstantValue()));
+		}
+
+		// solve the system by propagating determined components
+		vector<boost::optional<Rational>> values(n);
+		bool changed = true;
+		while(changed) {
+			changed = false;
+			for(const auto& cur : equations) {
+				Rational rest = cur.second;
+				int open = 0;
+				std::size_t pos = 0;
+				for(std::size_t k = 0; k < n; ++k) {
+					if(cur.first[k].isZero()) { continue; }
+					if(values[k]) {
+						rest = rest - cur.first[k] * *values[k];
+					} else {
+						open++;
+						pos = k;
+					}
+				}
+
+				// a fully determined equation has to be satisfied
+				if(open == 0 && !rest.isZero()) { return boost::none; }
+
+				// a single open component is fixed by the equation
+				if(open == 1) {
+					Rational value = rest / cur.first[pos];
+					if(!value.isInteger()) { return boost::none; }
+					values[pos] = value;
+					changed = true;
+				}
+			}
+		}
+
+		DistanceVector res(n);
+		for(std::size_t k = 0; k < n; ++k) {
+			if(values[k]) { res[k] = values[k]->getNumerator(); }
+		}
+		return res;
+	}
+
+	bool hasBackwardDependence(const AccessSummary& first, const VariablePtr& iterA, const AccessSummary& second, const VariablePtr& iterB,
+	                           const utils::set::PointerSet<ExpressionPtr>& distinct) {
+		auto locals = first.locals;
+		locals.insert(second.locals.begin(), second.locals.end());
+
+		for(const auto& a : first.accesses) {
+			for(const auto& b : second.accesses) {
+				auto distance = getDistance(a, toVector(iterA), b, toVector(iterB), locals, distinct);
+				if(distance && (!(*distance)[0] || *(*distance)[0] < 0)) { return true; }
+			}
+		}
+		return false;
+	}
+
+	bool hasLoopCarriedDependence(const ForStmtPtr& loop, const utils::set::PointerSet<ExpressionPtr>& distinct) {
+		auto summary = collectAccesses(loop->getBody());
+		if(!summary.analysable) { return true; }
+
+		auto iter = toVector(loop->getIterator());
+		for(const auto& a : summary.accesses) {
+			for(const auto& b : summary.accesses) {
+				auto distance = getDistance(a, iter, b, iter, summary.locals, distinct);
+				if(distance && (!(*distance)[0] || *(*distance)[0] != 0)) { return true; }
+			}
+		}
+		return false;
+	}
+
+} // end namespace loops
+} // end namespace transform
+} // end namespace insieme
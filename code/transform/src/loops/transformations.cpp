@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include "insieme/transform/loops/transformations.h"
+
+#include "insieme/core/ir_builder.h"
+#include "insieme/core/analysis/ir_utils.h"
+#include "insieme/core/arithmetic/arithmetic_utils.h"
+#include "insieme/core/transform/manipulation.h"
+#include "insieme/core/transform/node_replacer.h"
+
+#include "insieme/transform/loops/dependence.h"
+
+namespace insieme {
+namespace transform {
+namespace loops {
+
+	using namespace core;
+	using namespace core::arithmetic;
+
+	namespace {
+
+		/**
+		 * Determines whether the given loop is iterating in ascending order using a constant step.
+		 */
+		bool hasPositiveConstantStep(const ForStmtPtr& loop) {
+			try {
+				Formula step = toFormula(loop->getStep());
+				return step.isInteger() && step.getIntegerValue() > 0;
+			} catch(const NotAFormulaException& nafe) { return false; }
+		}
+
+		/**
+		 * Checks whether the given expressions are equivalent loop bounds.
+		 */
+		bool isEquivalentBound(const ExpressionPtr& a, const ExpressionPtr& b) {
+			if(*a == *b) { return true; }
+			try {
+				return toFormula(a) == toFormula(b);
+			} catch(const NotAFormulaException& nafe) { return false; }
+		}
+
+		/**
+		 * Obtains the loop directly nested within the given loop if the nest is perfect.
+		 */
+		ForStmtPtr getPerfectlyNestedLoop(const ForStmtPtr& loop) {
+			StatementPtr cur = loop->getBody();
+			while(auto compound = cur.isa<CompoundStmtPtr>()) {
+				if(compound.size() != 1) { return ForStmtPtr(); }
+				cur = compound[0];
+			}
+			return cur.isa<ForStmtPtr>();
+		}
+
+		/**
+		 * Determines the constant amount the given bound is growing by per increment of the given iterator.
+		 * If the bound is not an affine function of the iterator, no slope is returned.
+		 */
+		boost::optional<int64_t> getSlope(const ExpressionPtr& bound, const VariablePtr& iter) {
+			NodeManager& mgr = bound->getNodeManager();
+			IRBuilder builder(mgr);
+			auto next = core::transform::replaceAllGen(mgr, bound, iter, builder.add(iter, builder.literal(iter->getType(), "1")));
+			try {
+				Formula diff = toFormula(next) - toFormula(bound);
+				if(diff.isInteger()) { return diff.getIntegerValue(); }
+			} catch(const NotAFormulaException& nafe) {}
+			return boost::none;
+		}
+
+	} // end anonymous namespace
+
+
+	// -- Loop Interchange --
+
+	LoopInterchange::LoopInterchange(const parameter::Value& value) : Transformation(LoopInterchangeType::getInstance(), value) {}
+
+	core::NodeAddress LoopInterchange::apply(const core::NodeAddress& targetAddress) const {
+		auto outer = targetAddress.getAddressedNode().isa<ForStmtPtr>();
+		if(!outer) { throw InvalidTargetException("Can only be applied to for loops!"); }
+
+		auto inner = getPerfectlyNestedLoop(outer);
+		if(!inner) { throw InvalidTargetException("Can only be applied to perfectly nested loops!"); }
+
+		NodeManager& mgr = outer->getNodeManager();
+		IRBuilder builder(mgr);
+
+		auto i = outer->getIterator();
+		auto j = inner->getIterator();
+
+		// the iteration space has to be rectangular or a parallelogram, where both inner bounds are shifted by the same
+		// multiple of the outer iterator, as obtained by skewing
+		auto slope = getSlope(inner->getStart(), i);
+		if(!slope || *slope < 0 || slope != getSlope(inner->getEnd(), i) || analysis::contains(inner->getStep(), i)) {
+			throw InvalidTargetException("Inner loop bounds depend on outer iterator!");
+		}
+		bool rectangular = !analysis::contains(inner->getStart(), i) && !analysis::contains(inner->getEnd(), i);
+		if(!rectangular && *slope == 0) { throw InvalidTargetException("Inner loop bounds depend on outer iterator!"); }
+
+		if(!hasPositiveConstantStep(outer) || !hasPositiveConstantStep(inner)) { throw InvalidTargetException("Loop steps have to be positive constants!"); }
+		if(!rectangular && !(isEquivalentBound(outer->getStep(), builder.literal(i->getType(), "1")) && isEquivalentBound(inner->getStep(), builder.literal(j->getType(), "1")))) {
+			throw InvalidTargetException("Skewed loop nests can only be interchanged for unit steps!");
+		}
+
+		// check dependences
+		auto summary = collectAccesses(inner->getBody());
+		if(!summary.analysable) { throw InvalidTargetException("Unable to analyse dependences of loop body!"); }
+
+		VariableList iters = toVector(i, j);
+		auto distinct = getDistinctAllocations(targetAddress);
+		for(const auto& a : summary.accesses) {
+			for(const auto& b : summary.accesses) {
+				auto distance = getDistance(a, iters, b, iters, summary.locals, distinct);
+				if(!distance) { continue; }
+
+				// a dependence is reversed if its components may have opposite signs
+				const auto& di = (*distance)[0];
+				const auto& dj = (*distance)[1];
+				if((di && *di == 0) || (dj && *dj == 0)) { continue; }
+				if(di && dj && ((*di > 0) == (*dj > 0))) { continue; }
+				throw InvalidTargetException("Loop interchange would violate dependences!");
+			}
+		}
+
+		// swap loop headers
+		if(rectangular) {
+			auto res = builder.forStmt(inner->getDeclaration(), inner->getEnd(), inner->getStep(),
+			                           builder.compoundStmt(builder.forStmt(outer->getDeclaration(), outer->getEnd(), outer->getStep(), inner->getBody())));
+			return core::transform::replaceAddress(mgr, targetAddress, res);
+		}
+
+		// for a parallelogram, with start(i) = start(a) + c*(i-a) and end(i) = end(a) + c*(i-a) for the first outer
+		// iteration a, the j loop covers start(a) .. end(b-1) and the i loop all iterations with start(i) <= j < end(i)
+		auto a = outer->getStart();
+		auto b = outer->getEnd();
+		auto iType = i->getType();
+		auto jType = j->getType();
+		auto startA = core::transform::replaceAllGen(mgr, inner->getStart(), i, a);
+		auto endA = core::transform::replaceAllGen(mgr, inner->getEnd(), i, a);
+		auto endB = core::transform::replaceAllGen(mgr, inner->getEnd(), i, builder.sub(b, builder.literal(iType, "1")));
+
+		// the first iteration i > a satisfying bound(i) > j, where j >= bound(a) to avoid negative intermediate values
+		auto next = [&](const ExpressionPtr& bound) {
+			auto steps = builder.div(builder.sub(j, bound), builder.literal(jType, toString(*slope)));
+			return builder.add(a, builder.numericCast(builder.add(steps, builder.literal(jType, "1")), iType));
+		};
+		auto lower = builder.ite(builder.lt(j, endA), builder.wrapLazy(a), builder.wrapLazy(next(endA)));
+		auto upper = builder.min(b, next(startA));
+
+		auto res = builder.forStmt(j, startA, endB, inner->getStep(), builder.compoundStmt(builder.forStmt(i, lower, upper, outer->getStep(), inner->getBody())));
+		return core::transform::replaceAddress(mgr, targetAddress, res);
+	}
+
+
+	// -- Loop Fusion --
+
+	LoopFusion::LoopFusion(const parameter::Value& value)
+	    : Transformation(LoopFusionType::getInstance(), value), index(parameter::getValue<unsigned>(value)) {}
+
+	core::NodeAddress LoopFusion::apply(const core::NodeAddress& targetAddress) const {
+		auto compound = targetAddress.getAddressedNode().isa<CompoundStmtPtr>();
+		if(!compound) { throw InvalidTargetException("Can only be applied to compound statements!"); }
+
+		if(index + 1 >= compound.size()) { throw InvalidTargetException("Compound statement does not contain enough statements!"); }
+
+		auto first = compound[index].isa<ForStmtPtr>();
+		auto second = compound[index + 1].isa<ForStmtPtr>();
+		if(!first || !second) { throw InvalidTargetException("Can only fuse adjacent for loops!"); }
+
+		// the iteration spaces have to be identical
+		if(!isEquivalentBound(first->getStart(), second->getStart()) || !isEquivalentBound(first->getEnd(), second->getEnd())
+		   || !isEquivalentBound(first->getStep(), second->getStep())) {
+			throw InvalidTargetException("Loops do not share the same iteration space!");
+		}
+
+		if(!hasPositiveConstantStep(first)) { throw InvalidTargetException("Loop steps have to be positive constants!"); }
+
+		// check dependences
+		auto summaryA = collectAccesses(first->getBody());
+		auto summaryB = collectAccesses(second->getBody());
+		if(!summaryA.analysable || !summaryB.analysable) { throw InvalidTargetException("Unable to analyse dependences of loop bodies!"); }
+
+		if(hasBackwardDependence(summaryA, first->getIterator(), summaryB, second->getIterator(), getDistinctAllocations(targetAddress))) {
+			throw InvalidTargetException("Loop fusion would violate dependences!");
+		}
+
+		// build fused loop
+		NodeManager& mgr = compound->getNodeManager();
+		IRBuilder builder(mgr);
+
+		auto secondBody = core::transform::replaceAllGen(mgr, second->getBody(), second->getIterator(), first->getIterator());
+
+		StatementList body = first->getBody()->getStatements();
+		for(const auto& cur : secondBody->getStatements()) {
+			body.push_back(cur);
+		}
+		auto fused = builder.forStmt(first->getDeclaration(), first->getEnd(), first->getStep(), builder.compoundStmt(body));
+
+		StatementList stmts = compound->getStatements();
+		stmts[index] = fused;
+		stmts.erase(stmts.begin() + index + 1);
+		return core::transform::replaceAddress(mgr, targetAddress, builder.compoundStmt(stmts));
+	}
+
+
+	// -- Loop Fission --
+
+	LoopFission::LoopFission(const parameter::Value& value)
+	    : Transformation(LoopFissionType::getInstance(), value), split(parameter::getValue<unsigned>(value)) {
+		if(split < 1) { throw InvalidParametersException("Split position must be at least 1!"); }
+	}
+
+	core::NodeAddress LoopFission::apply(const core::NodeAddress& targetAddress) const {
+		auto loop = targetAddress.getAddressedNode().isa<ForStmtPtr>();
+		if(!loop) { throw InvalidTargetException("Can only be applied to for loops!"); }
+
+		auto stmts = loop->getBody()->getStatements();
+		if(split >= stmts.size()) { throw InvalidTargetException("Loop body does not contain enough statements!"); }
+
+		if(!hasPositiveConstantStep(loop)) { throw InvalidTargetException("Loop steps have to be positive constants!"); }
+
+		NodeManager& mgr = loop->getNodeManager();
+		IRBuilder builder(mgr);
+
+		auto partA = builder.compoundStmt(StatementList(stmts.begin(), stmts.begin() + split));
+		auto partB = builder.compoundStmt(StatementList(stmts.begin() + split, stmts.end()));
+
+		// check dependences
+		auto summaryA = collectAccesses(partA);
+		auto summaryB = collectAccesses(partB);
+		if(!summaryA.analysable || !summaryB.analysable) { throw InvalidTargetException("Unable to analyse dependences of loop body!"); }
+
+		// variables declared within the first part must not be used by the second part
+		for(const auto& var : summaryA.locals) {
+			if(analysis::contains(partB, var)) { throw InvalidTargetException("Local variable used across split position!"); }
+		}
+
+		if(hasBackwardDependence(summaryA, loop->getIterator(), summaryB, loop->getIterator(), getDistinctAllocations(targetAddress))) {
+			throw InvalidTargetException("Loop fission would violate dependences!");
+		}
+
+		// build the two loops
+		auto res = builder.compoundStmt(builder.forStmt(loop->getDeclaration(), loop->getEnd(), loop->getStep(), partA),
+		                                builder.forStmt(loop->getDeclaration(), loop->getEnd(), loop->getStep(), partB));
+		return core::transform::replaceAddress(mgr, targetAddress, res);
+	}
+
+
+	// -- Loop Skewing --
+
+	LoopSkewing::LoopSkewing(const parameter::Value& value)
+	    : Transformation(LoopSkewingType::getInstance(), value), factor(parameter::getValue<unsigned>(value)) {
+		if(factor < 1) { throw InvalidParametersException("Skewing factor must be at least 1!"); }
+	}
+
+	core::NodeAddress LoopSkewing::apply(const core::NodeAddress& targetAddress) const {
+		auto outer = targetAddress.getAddressedNode().isa<ForStmtPtr>();
+		if(!outer) { throw InvalidTargetException("Can only be applied to for loops!"); }
+
+		auto inner = getPerfectlyNestedLoop(outer);
+		if(!inner) { throw InvalidTargetException("Can only be applied to perfectly nested loops!"); }
+
+		NodeManager& mgr = outer->getNodeManager();
+		IRBuilder builder(mgr);
+
+		// the shift applied to the inner iteration space: factor * i
+		auto type = inner->getIterator()->getType();
+		auto shift = builder.mul(builder.literal(type, toString(factor)), builder.numericCast(outer->getIterator(), type));
+
+		// j' = start + f*i .. end + f*i, j = j' - f*i
+		auto j = builder.variable(type);
+		auto body = core::transform::replaceAllGen(mgr, inner->getBody(), inner->getIterator(), builder.sub(j, shift));
+		auto skewed = builder.forStmt(j, builder.add(inner->getStart(), shift), builder.add(inner->getEnd(), shift), inner->getStep(), body);
+
+		auto res = builder.forStmt(outer->getDeclaration(), outer->getEnd(), outer->getStep(), builder.compoundStmt(skewed));
+		return core::transform::replaceAddress(mgr, targetAddress, res);
+	}
+
+} // end namespace loops
+} // end namespace transform
+} // end namespace insieme
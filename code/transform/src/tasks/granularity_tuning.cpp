@@ -36,6 +36,10 @@
 
 #include "insieme/transform/tasks/granularity_tuning.h"
 
+#include <limits>
+
+#include "insieme/annotations/meta_info/meta_infos.h"
+
 #include "insieme/utils/container_utils.h"
 #include "insieme/utils/string_utils.h"
 #include "insieme/utils/logging.h"
@@ -45,6 +49,8 @@
 #include "insieme/core/analysis/ir_utils.h"
 #include "insieme/core/ir_mapper.h"
 #include "insieme/core/lang/basic.h"
+#include "insieme/core/lang/lang.h"
+#include "insieme/core/lang/reference.h"
 #include "insieme/core/arithmetic/arithmetic_utils.h"
 #include "insieme/core/transform/manipulation.h"
 #include "insieme/core/transform/node_mapper_utils.h"
@@ -72,6 +78,167 @@ namespace tasks {
 		namespace g = insieme::core::pattern::generator;
 		namespace irg = insieme::core::pattern::generator::irg;
 
+		/**
+		 * The estimated effort (in abstract operation units) a task should at least cover to amortize
+		 * the overhead of its creation and scheduling.
+		 */
+		const uint64_t TASK_GRANULARITY_THRESHOLD = 5000;
+
+		/**
+		 * The maximum number of recursion levels to be unrolled into a single task variant.
+		 */
+		const unsigned MAX_UNROLL_FACTOR = 8;
+
+		uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+			return (a > std::numeric_limits<uint64_t>::max() - b) ? std::numeric_limits<uint64_t>::max() : a + b;
+		}
+
+		uint64_t saturatingMul(uint64_t a, uint64_t b) {
+			return (a != 0 && b > std::numeric_limits<uint64_t>::max() / a) ? std::numeric_limits<uint64_t>::max() : a * b;
+		}
+
+		/**
+		 * A simple cost model estimating the effort of a single execution of a code fragment. Loops are
+		 * weighted by their trip count, calls by the effort of the called function and memory accesses by
+		 * a fixed penalty. The effort of spawned jobs and recursive calls is not included, since those are
+		 * processed by other tasks or accounted for by the recursion depth covered by a task.
+		 */
+		class TaskCostModel {
+			static const uint64_t UNKNOWN_TRIP_COUNT = 100;
+			static const uint64_t OPERATION_COST = 1;
+			static const uint64_t MEMORY_ACCESS_COST = 2;
+			static const uint64_t CALL_COST = 5;
+
+			const lang::ParallelExtension& parExt;
+			const lang::ReferenceExtension& refExt;
+
+			utils::map::PointerMap<NodePtr, uint64_t> cache;
+			NodeSet inProgress;
+
+			uint64_t getTripCount(const ForStmtPtr& loop) {
+				try {
+					arithmetic::Formula range = arithmetic::toFormula(loop->getEnd()) - arithmetic::toFormula(loop->getStart());
+					arithmetic::Formula step = arithmetic::toFormula(loop->getStep());
+					if(range.isInteger() && step.isInteger() && step.getIntegerValue() > 0) {
+						int64_t diff = range.getIntegerValue();
+						int64_t inc = step.getIntegerValue();
+						return (diff > 0) ? (diff + inc - 1) / inc : 0;
+					}
+				} catch(const arithmetic::NotAFormulaException&) {}
+				return UNKNOWN_TRIP_COUNT;
+			}
+
+			uint64_t estimateCall(const CallExprPtr& call) {
+				uint64_t res = 0;
+				for(const auto& arg : call->getArgumentList()) {
+					res = saturatingAdd(res, estimate(arg));
+				}
+
+				// spawned jobs are processed by other tasks
+				const ExpressionPtr& fun = call->getFunctionExpr();
+				if(parExt.isCallOfParallel(call)) { return saturatingAdd(res, CALL_COST); }
+
+				// memory accesses
+				if(refExt.isCallOfRefDeref(call) || refExt.isCallOfRefAssign(call) || refExt.isCallOfRefArrayElement(call)
+				   || refExt.isCallOfRefMemberAccess(call)) {
+					return saturatingAdd(res, MEMORY_ACCESS_COST);
+				}
+
+				// other built-in operators
+				if(lang::isBuiltIn(fun)) { return saturatingAdd(res, OPERATION_COST); }
+
+				// calls to non-recursive functions are covered by the current task
+				if(const LambdaExprPtr& lambda = fun.isa<LambdaExprPtr>()) {
+					if(inProgress.contains(lambda)) { return saturatingAdd(res, CALL_COST); }
+					inProgress.insert(lambda);
+					res = saturatingAdd(res, saturatingAdd(CALL_COST, estimate(lambda->getBody())));
+					inProgress.erase(lambda);
+					return res;
+				}
+
+				// recursive and external calls
+				return saturatingAdd(res, CALL_COST);
+			}
+
+			uint64_t estimateInternal(const NodePtr& node) {
+				switch(node->getNodeType()) {
+				case NT_JobExpr:
+				case NT_LambdaReference:
+				case NT_LambdaExpr:
+				case NT_Literal:
+				case NT_Variable: return 0;
+				case NT_CallExpr: return estimateCall(node.as<CallExprPtr>());
+				case NT_ForStmt: {
+					auto loop = node.as<ForStmtPtr>();
+					uint64_t bounds = saturatingAdd(estimate(loop->getStart()), estimate(loop->getEnd()));
+					return saturatingAdd(bounds, saturatingMul(getTripCount(loop), saturatingAdd(estimate(loop->getBody()), OPERATION_COST)));
+				}
+				case NT_WhileStmt: {
+					auto loop = node.as<WhileStmtPtr>();
+					return saturatingMul(UNKNOWN_TRIP_COUNT, saturatingAdd(estimate(loop->getCondition()), estimate(loop->getBody())));
+				}
+				case NT_IfStmt: {
+					auto stmt = node.as<IfStmtPtr>();
+					return saturatingAdd(estimate(stmt->getCondition()), std::max(estimate(stmt->getThenBody()), estimate(stmt->getElseBody())));
+				}
+				default: break;
+				}
+
+				// types do not cause any effort
+				if(node->getNodeCategory() == NC_Type) { return 0; }
+
+				// sum up the effort of all sub-nodes
+				uint64_t res = 0;
+				for(const auto& cur : node->getChildList()) {
+					res = saturatingAdd(res, estimate(cur));
+				}
+				return res;
+			}
+
+		  public:
+			TaskCostModel(NodeManager& nodeMan)
+			    : parExt(nodeMan.getLangExtension<lang::ParallelExtension>()), refExt(nodeMan.getLangExtension<lang::ReferenceExtension>()) {}
+
+			uint64_t estimate(const NodePtr& node) {
+				auto pos = cache.find(node);
+				if(pos != cache.end()) { return pos->second; }
+				uint64_t res = estimateInternal(node);
+				// results depending on functions currently under evaluation are incomplete
+				if(inProgress.empty()) { cache[node] = res; }
+				return res;
+			}
+		};
+
+		/**
+		 * The granularity estimates obtained for a group of (mutually) recursive task-spawning functions.
+		 */
+		struct TaskGranularity {
+			// the estimated effort of a single invocation, excluding spawned tasks
+			uint64_t invocationEffort;
+			// the maximum number of tasks spawned by a single invocation
+			unsigned branchingFactor;
+
+			// the estimated effort of a task processing the given number of recursion levels
+			uint64_t getTaskEffort(unsigned levels) const {
+				uint64_t res = 0;
+				uint64_t invocations = 1;
+				for(unsigned i = 0; i < levels; ++i) {
+					res = saturatingAdd(res, saturatingMul(invocations, invocationEffort));
+					invocations = saturatingMul(invocations, branchingFactor);
+				}
+				return res;
+			}
+
+			// the smallest number of recursion levels a task has to cover to reach the granularity threshold
+			unsigned getCutoffDepth() const {
+				unsigned depth = 1;
+				while(depth < MAX_UNROLL_FACTOR && getTaskEffort(depth) < TASK_GRANULARITY_THRESHOLD) {
+					++depth;
+				}
+				return depth;
+			}
+		};
+
 		class TaskMultiversioner {
 			NodeManager& nodeMan;
 			IRBuilder build;
@@ -90,7 +257,7 @@ namespace tasks {
 									jobAddresses.push_back(job);
 									return true;
 								}
-							} catch(arithmetic::NotAFormulaException) {}
+							} catch(const arithmetic::NotAFormulaException&) {}
 						}
 					}
 					return false;
@@ -231,7 +398,71 @@ namespace tasks {
 				// return prevLamDef;
 			}
 
+			TaskGranularity estimateGranularity(const LambdaDefinitionPtr& lamDef) {
+				TaskGranularity res = { 0, 1 };
+				TaskCostModel costModel(nodeMan);
+				for(const LambdaBindingPtr& lb : lamDef->getDefinitions()) {
+					LambdaPtr lam = lb->getLambda();
+					unsigned spawns = 0;
+					visitDepthFirstPrunable(lam, [&](const NodePtr& node) -> bool {
+						if(analysis::isCallOf(node, parExt.getParallel())) { ++spawns; }
+						return node.isa<JobExprPtr>();
+					});
+					res.invocationEffort = std::max(res.invocationEffort, costModel.estimate(lam->getBody()));
+					res.branchingFactor = std::max(res.branchingFactor, spawns);
+				}
+				return res;
+			}
+
+			/**
+			 * Selects the unrolling factors of the multiversioned variants based on the cut-off depth
+			 * at which tasks become coarse enough to amortize their creation.
+			 */
+			vector<unsigned> selectUnrollFactors(const TaskGranularity& granularity) {
+				unsigned cutoff = granularity.getCutoffDepth();
+				if(cutoff <= 2) { return toVector(2u, 4u); }
+				if(cutoff * 2 > MAX_UNROLL_FACTOR) { return toVector(MAX_UNROLL_FACTOR / 2, MAX_UNROLL_FACTOR); }
+				return toVector(cutoff, cutoff * 2);
+			}
+
+			/**
+			 * Builds the variant table attached to the multiversioned jobs, enabling the runtime to skip
+			 * variants spawning tasks estimated to be too fine-grained.
+			 */
+			annotations::task_granularity_info buildVariantTable(const TaskGranularity& granularity, const vector<unsigned>& unrollFactors) {
+				annotations::task_granularity_info info;
+				info.unroll_factors.clear();
+				info.estimates.clear();
+
+				auto toEstimate = [](uint64_t effort) { return (unsigned)std::min<uint64_t>(effort, std::numeric_limits<unsigned>::max()); };
+
+				// the original version and the unrolled versions
+				info.unroll_factors.push_back(1);
+				info.estimates.push_back(toEstimate(granularity.getTaskEffort(1)));
+				for(unsigned factor : unrollFactors) {
+					info.unroll_factors.push_back(factor);
+					info.estimates.push_back(toEstimate(granularity.getTaskEffort(factor)));
+				}
+
+				// the sequential version is covering the full recursion
+				info.unroll_factors.push_back(0);
+				info.estimates.push_back(std::numeric_limits<unsigned>::max());
+
+				// the first variant reaching the threshold - the sequential version is never enforced
+				info.min_variant = 0;
+				while(info.min_variant + 2 < info.estimates.size() && info.estimates[info.min_variant] < TASK_GRANULARITY_THRESHOLD) {
+					info.min_variant++;
+				}
+				return info;
+			}
+
 			LambdaDefinitionPtr buildReplacement(const LambdaDefinitionPtr& lamDef) {
+				// determine the recursion depth to be covered by the task variants
+				TaskGranularity granularity = estimateGranularity(lamDef);
+				vector<unsigned> unrollFactors = selectUnrollFactors(granularity);
+				VLOG(1) << "TaskMultiversioner -- estimated effort per invocation: " << granularity.invocationEffort
+				        << ", branching factor: " << granularity.branchingFactor << ", unrolling factors: " << unrollFactors;
+
 				// gather all required option variables
 				vector<LambdaReferenceList> varOptionsList; // list of options for each original lambda definition
 				NodeMap sequentialVarReplacements;   // replacement map for recursive calls in sequentialized version
@@ -239,8 +470,9 @@ namespace tasks {
 					LambdaReferencePtr rVar = lb->getReference();
 					LambdaReferenceList varOptions;
 					varOptions.push_back(rVar);                            // original version is the first option
-					varOptions.push_back(build.lambdaReference(rVar->getType(),rVar->getNameAsString() + "_unroll_2")); // var for 2 unroll
-					varOptions.push_back(build.lambdaReference(rVar->getType(), rVar->getNameAsString() + "_unroll_4")); // var for 4 unroll
+					for(unsigned factor : unrollFactors) {                 // vars for unrolled versions (names need to preserve the order)
+						varOptions.push_back(build.lambdaReference(rVar->getType(), rVar->getNameAsString() + format("_unroll_%02d", factor)));
+					}
 					varOptions.push_back(build.lambdaReference(rVar->getType(), rVar->getNameAsString() + "_unroll_inf")); // var for sequential
 					varOptionsList.push_back(varOptions);
 					sequentialVarReplacements.insert(make_pair(rVar, varOptions.back()));
@@ -248,8 +480,9 @@ namespace tasks {
 				// gather all the required options for the lambda definition
 				vector<LambdaDefinitionPtr> lambdaDefOptionsList;
 				lambdaDefOptionsList.push_back(lamDef);
-				lambdaDefOptionsList.push_back(removeExtraneousMergeAlls(removeOuterParallels(lamDef->unroll(nodeMan, 2))));
-				lambdaDefOptionsList.push_back(removeExtraneousMergeAlls(removeOuterParallels(lamDef->unroll(nodeMan, 4))));
+				for(unsigned factor : unrollFactors) {
+					lambdaDefOptionsList.push_back(removeExtraneousMergeAlls(removeOuterParallels(lamDef->unroll(nodeMan, factor))));
+				}
 				lambdaDefOptionsList.push_back(core::transform::trySequentialize(nodeMan, lambdaDefOptionsList.back(), false));
 
 				// replace recursive jobs in lambdas with pick from available options, generating new bindings
@@ -298,6 +531,12 @@ namespace tasks {
 
 				auto ret = core::transform::simplify(nodeMan, build.lambdaDefinition(newBindings));
 
+				// attach the variant table to the multiversioned jobs
+				auto variantTable = buildVariantTable(granularity, unrollFactors);
+				visitDepthFirstOnce(ret, [&](const JobExprPtr& job) {
+					if(analysis::isCallOf(job->getBody(), basic.getPick())) { job->getBody()->attachValue(variantTable); }
+				});
+
 				VLOG(1) << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n!!!!!!!!!!! orig:\n" << printer::PrettyPrinter(lamDef, printer::PrettyPrinter::NO_LET_BINDINGS)
 				        << "\n!!!!!!!!!! new:\n" << printer::PrettyPrinter(ret, printer::PrettyPrinter::NO_LET_BINDINGS);
 
@@ -41,6 +41,8 @@
 #include "insieme/core/ir_builder.h"
 #include "insieme/core/ir_visitor.h"
 
+#include "insieme/transform/execution.h"
+
 namespace insieme {
 namespace transform {
 
@@ -94,7 +96,7 @@ namespace transform {
 		auto& transformations = getSubTransformations();
 
 		// special handling for single-version node
-		if(transformations.size() == 1u) { return transformations[0]->apply(targetAddress); }
+		if(transformations.size() == 1u) { return applyTransformation(transformations[0], targetAddress); }
 
 		// create switch selecting versions
 		core::IRBuilder builder(target->getNodeManager());
@@ -102,14 +104,17 @@ namespace transform {
 		vector<core::ExpressionPtr> index;
 		vector<core::SwitchCasePtr> cases;
 
-		uint16_t i = 0;
+		// create the versions - those are independent, thus they may be processed in parallel
+		vector<std::pair<TransformationPtr, core::NodePtr>> tasks;
+		for_each(transformations, [&](const TransformationPtr& cur) { tasks.push_back(std::make_pair(cur, target)); });
+		vector<core::NodePtr> versions = applyAll(tasks);
+
 		core::TypePtr uint16 = builder.getLangBasic().getUInt2();
-		for_each(transformations, [&](const TransformationPtr& cur) {
+		for(uint16_t i = 0; i < versions.size(); i++) {
 			core::LiteralPtr lit = builder.literal(uint16, toString(i));
 			index.push_back(lit);
-			cases.push_back(builder.switchCase(lit, static_pointer_cast<core::StatementPtr>(cur->apply(target))));
-			i++;
-		});
+			cases.push_back(builder.switchCase(lit, static_pointer_cast<core::StatementPtr>(versions[i])));
+		}
 
 		// create final switch stmt
 		auto res = builder.switchStmt(builder.pickVariant(index), builder.switchCases(cases), builder.getNoOp());
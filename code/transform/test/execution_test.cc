@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2002-2013 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "insieme/transform/execution.h"
+#include "insieme/transform/connectors.h"
+#include "insieme/transform/versioning.h"
+#include "insieme/transform/primitives.h"
+
+#include "insieme/core/ir_builder.h"
+#include "insieme/core/pattern/ir_pattern.h"
+#include "insieme/core/checks/full_check.h"
+
+namespace insieme {
+namespace transform {
+
+	namespace p = core::pattern;
+	namespace irp = core::pattern::irp;
+
+	namespace {
+
+		TransformationPtr makeDuplicator(std::atomic<unsigned>& counter) {
+			return makeLambdaTransformation("duplicate", [&](const core::NodePtr& cur) -> core::NodePtr {
+				counter++;
+				core::IRBuilder builder(cur->getNodeManager());
+				return builder.compoundStmt(cur.as<core::StatementPtr>(), cur.as<core::StatementPtr>());
+			});
+		}
+	}
+
+	TEST(ExecutionEngine, Memoization) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		core::StatementPtr in = builder.compoundStmt(builder.intLit(1), builder.intLit(2));
+
+		std::atomic<unsigned> counter(0);
+		TransformationPtr dup = makeDuplicator(counter);
+		TransformationPtr a = makePipeline(dup, makeNoOp());
+		TransformationPtr b = makePipeline(dup, dup);
+
+		// without an engine, everything is computed
+		auto resA = a->apply(in);
+		auto resB = b->apply(in);
+		EXPECT_EQ(3u, counter);
+
+		// with an engine, the common prefix is only computed once
+		counter = 0;
+		ExecutionEngine engine(1);
+		EXPECT_EQ(*resA, *engine.apply(a, in));
+		EXPECT_EQ(*resB, *engine.apply(b, in));
+		EXPECT_EQ(2u, counter);
+
+		// and the full result is cached
+		EXPECT_EQ(*resB, *engine.apply(b, in));
+		EXPECT_EQ(2u, counter);
+
+		auto stats = engine.getStatistics();
+		EXPECT_EQ(3u, stats["LambdaTransformation"].applications);
+		EXPECT_EQ(1u, stats["LambdaTransformation"].cacheHits);
+		EXPECT_EQ(3u, stats["Pipeline"].applications);
+		EXPECT_EQ(1u, stats["Pipeline"].cacheHits);
+		EXPECT_FALSE(toString(engine).empty());
+
+		// after a reset, everything is recomputed
+		engine.reset();
+		EXPECT_EQ(*resB, *engine.apply(b, in));
+		EXPECT_EQ(4u, counter);
+
+		// distinct transformations are not confused, even if they are considered equal
+		TransformationPtr other = makeLambdaTransformation("duplicate", [](const core::NodePtr& cur) { return cur; });
+		EXPECT_EQ(*other, *dup);
+		EXPECT_EQ(*in, *engine.apply(other, in));
+		EXPECT_EQ(*resB, *engine.apply(b, in));
+		EXPECT_EQ(4u, counter);
+	}
+
+	TEST(ExecutionEngine, Failures) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		core::StatementPtr in = builder.compoundStmt(builder.intLit(1), builder.intLit(2));
+
+		std::atomic<unsigned> counter(0);
+		TransformationPtr fail = makeLambdaTransformation("fail", [&](const core::NodePtr& cur) -> core::NodePtr {
+			counter++;
+			throw InvalidTargetException(cur);
+		});
+
+		// failures are cached as well
+		ExecutionEngine engine(4);
+		EXPECT_THROW(engine.apply(fail, in), InvalidTargetException);
+		EXPECT_THROW(engine.apply(fail, in), InvalidTargetException);
+		EXPECT_EQ(1u, counter);
+		EXPECT_EQ(*in, *engine.apply(makeTry(fail), in));
+		EXPECT_EQ(1u, counter);
+
+		// failures of parallel branches are reported
+		std::atomic<unsigned> dummy(0);
+		EXPECT_THROW(engine.apply(versioning(makeDuplicator(dummy), makeLambdaTransformation("fail2", [](const core::NodePtr& cur) -> core::NodePtr {
+			throw InvalidTargetException(cur);
+		})), in), InvalidTargetException);
+
+		EXPECT_EQ(2u, engine.getStatistics().at("LambdaTransformation").failures);
+	}
+
+	TEST(ExecutionEngine, ParallelVersioning) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		core::StatementPtr in = builder.compoundStmt(builder.intLit(1), builder.intLit(2));
+
+		std::atomic<unsigned> counter(0);
+		TransformationPtr dup = makeDuplicator(counter);
+		TransformationPtr transform = versioning(makeNoOp(), dup, makePipeline(dup, dup), makePipeline(dup, makeNoOp()));
+
+		// compute reference result sequentially
+		core::NodePtr ref = transform->apply(in);
+		EXPECT_TRUE(core::checks::check(ref).empty());
+
+		// the parallel version has to produce the same result
+		ExecutionEngine engine(4);
+		core::NodePtr res = engine.apply(transform, in);
+		EXPECT_EQ(*ref, *res);
+		EXPECT_EQ(&manager, &res->getNodeManager());
+		EXPECT_TRUE(core::checks::check(res).empty());
+
+		// results of the branches are available in the cache
+		counter = 0;
+		EXPECT_EQ(*dup->apply(in), *engine.apply(dup, in));
+		EXPECT_EQ(1u, counter);
+		EXPECT_TRUE(core::checks::check(engine.apply(versioning(makeNoOp(), dup), in)).empty());
+		EXPECT_EQ(1u, counter);
+	}
+
+	TEST(ExecutionEngine, FreshIDRangeExceeded) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		core::StatementPtr in = builder.compoundStmt(builder.intLit(1), builder.intLit(2));
+
+		// a transformation consuming more fresh IDs than reserved for a parallel branch
+		std::atomic<unsigned> counter(0);
+		TransformationPtr greedy = makeLambdaTransformation("greedy", [&](const core::NodePtr& cur) -> core::NodePtr {
+			counter++;
+			core::NodeManager& mgr = cur->getNodeManager();
+			for(unsigned i = 0; i < (1u << 17); ++i) {
+				mgr.getFreshID();
+			}
+			core::IRBuilder builder(mgr);
+			return builder.compoundStmt(cur.as<core::StatementPtr>(), builder.variable(builder.getLangBasic().getInt4()));
+		});
+
+		// the exceeding branch is recomputed within the target manager
+		ExecutionEngine engine(4);
+		auto res = engine.applyAll({{greedy, in}, {makeNoOp(), in}});
+		EXPECT_EQ(2u, counter);
+		EXPECT_EQ(&manager, &res[0]->getNodeManager());
+		EXPECT_EQ(*in, *res[1]);
+
+		// fresh IDs of the target manager have advanced beyond the IDs used by the result
+		auto var = res[0].as<core::CompoundStmtPtr>()->getStatement(1).as<core::VariablePtr>();
+		EXPECT_LT(var->getId(), manager.getFreshID());
+	}
+
+	TEST(ExecutionEngine, ParallelForAll) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		TransformationPtr replacer = makeLambdaTransformation([](const core::NodePtr& cur) -> core::NodePtr {
+			return core::IRBuilder(cur->getNodeManager()).intLit(42);
+		});
+
+		auto forStmt = p::aT(p::var("x", irp::forStmt()));
+		filter::TargetFilter filter = filter::pattern(p::node(*(forStmt | !forStmt)), "x");
+		TransformationPtr transform = makeForAll(filter, replacer);
+
+		core::NodePtr in = builder.parseStmt("{"
+		                                     "	for(uint<4> i = 6u .. 12u : 3u) {"
+		                                     "		i+1u;"
+		                                     "	}"
+		                                     "	for(uint<4> j = 3u .. 25u : 1u) {"
+		                                     "		j+1u;"
+		                                     "	}"
+		                                     "	for(uint<4> k = 3u .. 25u : 1u) {"
+		                                     "		k+2u;"
+		                                     "	}"
+		                                     "}");
+		ASSERT_TRUE(in);
+
+		ExecutionEngine engine(4);
+		core::NodePtr out = engine.apply(transform, in);
+		EXPECT_EQ("{42; 42; 42;}", toString(*out));
+		EXPECT_EQ(&manager, &out->getNodeManager());
+		EXPECT_EQ(3u, engine.getStatistics().at("LambdaTransformation").applications);
+		EXPECT_EQ(1u, engine.getStatistics().at("ForAll").applications);
+	}
+
+} // end namespace transform
+} // end namespace insieme
@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2002-2015 Distributed and Parallel Systems Group,
+ *                Institute of Computer Science,
+ *               University of Innsbruck, Austria
+ *
+ * This file is part of the INSIEME Compiler and Runtime System.
+ *
+ * We provide the software of this file (below described as "INSIEME")
+ * under GPL Version 3.0 on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ *
+ * If you require different license terms for your intended use of the
+ * software, e.g. for proprietary commercial or industrial use, please
+ * contact us at:
+ *                   insieme@dps.uibk.ac.at
+ *
+ * We kindly ask you to acknowledge the use of this software in any
+ * publication or other disclosure of results by referring to the
+ * following citation:
+ *
+ * H. Jordan, P. Thoman, J. Durillo, S. Pellegrini, P. Gschwandtner,
+ * T. Fahringer, H. Moritsch. A Multi-Objective Auto-Tuning Framework
+ * for Parallel Codes, in Proc. of the Intl. Conference for High
+ * Performance Computing, Networking, Storage and Analysis (SC 2012),
+ * IEEE Computer Society Press, Nov. 2012, Salt Lake City, USA.
+ *
+ * All copyright notices must be kept intact.
+ *
+ * INSIEME depends on several third party software packages. Please
+ * refer to http://www.dps.uibk.ac.at/insieme/license.html for details
+ * regarding third party software licenses.
+ */
+
+#include <gtest/gtest.h>
+
+#include "insieme/transform/loops/transformations.h"
+
+#include "insieme/core/ir_builder.h"
+#include "insieme/core/analysis/ir_utils.h"
+#include "insieme/core/checks/full_check.h"
+
+#include "insieme/utils/test/test_utils.h"
+
+namespace insieme {
+namespace transform {
+namespace loops {
+
+	namespace {
+
+		std::map<std::string, core::NodePtr> getSymbols(core::IRBuilder& builder) {
+			std::map<std::string, core::NodePtr> symbols;
+			symbols["v"] = builder.variable(builder.parseType("ref<array<int<4>,10>,f,f,plain>"));
+			symbols["w"] = builder.variable(builder.parseType("ref<array<int<4>,10>,f,f,plain>"));
+			symbols["m"] = builder.variable(builder.parseType("ref<array<array<int<4>,10>,10>,f,f,plain>"));
+			symbols["s"] = builder.variable(builder.parseType("ref<int<4>,f,f,plain>"));
+			return symbols;
+		}
+
+		// parses the given statement within a compound declaring v and w as distinct local arrays
+		core::NodeAddress parseWithAllocations(core::IRBuilder& builder, const std::string& stmt) {
+			auto symbols = getSymbols(builder);
+			symbols.erase("v");
+			symbols.erase("w");
+			auto code = builder.parseStmt("{"
+			                              "	var ref<array<int<4>,10>,f,f,plain> v = ref_var(type_lit(array<int<4>,10>));"
+			                              "	var ref<array<int<4>,10>,f,f,plain> w = ref_var(type_lit(array<int<4>,10>));"
+			                              + stmt + "}",
+			                              symbols);
+			return (code) ? core::NodeAddress(code).getAddressOfChild(2) : core::NodeAddress();
+		}
+
+	}
+
+	TEST(LoopInterchange, Legal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		auto loop = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                              "	for(uint<4> j = 1u .. 10u) {"
+		                              "		m[i][j] = m[i][j-1u] + 1;"
+		                              "	}"
+		                              "}",
+		                              symbols)
+		                .as<core::ForStmtPtr>();
+		ASSERT_TRUE(loop);
+
+		auto inner = loop->getBody()[0].as<core::ForStmtPtr>();
+
+		auto res = makeLoopInterchange()->apply(loop);
+		ASSERT_EQ(core::NT_ForStmt, res->getNodeType());
+
+		// the former inner loop is now the outer loop
+		auto outer = res.as<core::ForStmtPtr>();
+		EXPECT_EQ(inner->getIterator(), outer->getIterator());
+		EXPECT_EQ(loop->getIterator(), outer->getBody()[0].as<core::ForStmtPtr>()->getIterator());
+		EXPECT_EQ(inner->getBody(), outer->getBody()[0].as<core::ForStmtPtr>()->getBody());
+	}
+
+	TEST(LoopInterchange, Illegal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		// dependence with distance (1,-1)
+		auto loop = builder.parseStmt("for(uint<4> i = 1u .. 10u) {"
+		                              "	for(uint<4> j = 0u .. 9u) {"
+		                              "		m[i][j] = m[i-1u][j+1u] + 1;"
+		                              "	}"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+
+		// non-rectangular iteration space
+		loop = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                         "	for(uint<4> j = i .. 10u) {"
+		                         "		m[i][j] = 0;"
+		                         "	}"
+		                         "}",
+		                         symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+
+		// write to a scalar shared by all iterations
+		loop = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                         "	for(uint<4> j = 0u .. 10u) {"
+		                         "		s = s + m[i][j];"
+		                         "	}"
+		                         "}",
+		                         symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+
+		// not a loop nest
+		loop = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                         "	v[i] = 0;"
+		                         "}",
+		                         symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+	}
+
+	TEST(LoopFusion, Legal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		auto target = parseWithAllocations(builder, "{"
+		                                            "	for(uint<4> i = 0u .. 10u) {"
+		                                            "		v[i] = 1;"
+		                                            "	}"
+		                                            "	for(uint<4> k = 0u .. 10u) {"
+		                                            "		w[k] = v[k] + 1;"
+		                                            "	}"
+		                                            "}");
+		ASSERT_TRUE(target);
+		auto code = target.as<core::CompoundStmtPtr>();
+
+		auto res = makeLoopFusion(0)->apply(target).as<core::CompoundStmtPtr>();
+		ASSERT_EQ(1u, res.size());
+
+		auto loop = res[0].as<core::ForStmtPtr>();
+		ASSERT_TRUE(loop);
+		EXPECT_EQ(2u, loop->getBody().size());
+		EXPECT_EQ(code[0].as<core::ForStmtPtr>()->getIterator(), loop->getIterator());
+	}
+
+	TEST(LoopFusion, Illegal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		// the second loop reads a value produced by a later iteration of the first loop
+		auto code = builder.parseStmt("{"
+		                              "	for(uint<4> i = 0u .. 9u) {"
+		                              "		v[i] = 1;"
+		                              "	}"
+		                              "	for(uint<4> k = 0u .. 9u) {"
+		                              "		w[k] = v[k+1u] + 1;"
+		                              "	}"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(code);
+		EXPECT_THROW(makeLoopFusion(0)->apply(code), InvalidTargetException);
+
+		// different iteration spaces
+		code = builder.parseStmt("{"
+		                         "	for(uint<4> i = 0u .. 9u) {"
+		                         "		v[i] = 1;"
+		                         "	}"
+		                         "	for(uint<4> k = 0u .. 10u) {"
+		                         "		w[k] = 1;"
+		                         "	}"
+		                         "}",
+		                         symbols);
+		ASSERT_TRUE(code);
+		EXPECT_THROW(makeLoopFusion(0)->apply(code), InvalidTargetException);
+		EXPECT_THROW(makeLoopFusion(1)->apply(code), InvalidTargetException);
+	}
+
+	TEST(LoopFission, Factory) {
+		EXPECT_THROW(LoopFissionType().buildTransformation(parameter::makeValue(0u)), InvalidParametersException);
+		EXPECT_NO_THROW(LoopFissionType().buildTransformation(parameter::makeValue(1u)));
+	}
+
+	TEST(LoopFission, Legal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		auto loop = parseWithAllocations(builder, "for(uint<4> i = 1u .. 10u) {"
+		                                          "	v[i] = 1;"
+		                                          "	w[i] = v[i-1u] + 1;"
+		                                          "}");
+		ASSERT_TRUE(loop);
+
+		auto res = makeLoopFission(1)->apply(loop).as<core::CompoundStmtPtr>();
+		ASSERT_EQ(2u, res.size());
+		EXPECT_EQ(core::NT_ForStmt, res[0]->getNodeType());
+		EXPECT_EQ(core::NT_ForStmt, res[1]->getNodeType());
+	}
+
+	TEST(LoopFission, Illegal) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		// the first statement consumes the value produced by the second in the previous iteration
+		auto loop = builder.parseStmt("for(uint<4> i = 0u .. 9u) {"
+		                              "	w[i] = v[i] + 1;"
+		                              "	v[i+1u] = 2;"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopFission(1)->apply(loop), InvalidTargetException);
+		EXPECT_THROW(makeLoopFission(2)->apply(loop), InvalidTargetException);
+	}
+
+	TEST(LoopTransformations, Aliasing) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		// v and w are free variables which may refer to the same array
+		auto code = builder.parseStmt("{"
+		                              "	for(uint<4> i = 0u .. 10u) {"
+		                              "		v[i] = 1;"
+		                              "	}"
+		                              "	for(uint<4> k = 0u .. 10u) {"
+		                              "		w[k] = 2;"
+		                              "	}"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(code);
+		EXPECT_THROW(makeLoopFusion(0)->apply(code), InvalidTargetException);
+
+		auto loop = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                              "	v[i] = 1;"
+		                              "	w[i] = 2;"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopFission(1)->apply(loop), InvalidTargetException);
+
+		auto nest = builder.parseStmt("for(uint<4> i = 0u .. 10u) {"
+		                              "	for(uint<4> j = 0u .. 10u) {"
+		                              "		v[i] = w[j];"
+		                              "	}"
+		                              "}",
+		                              symbols);
+		ASSERT_TRUE(nest);
+		EXPECT_THROW(makeLoopInterchange()->apply(nest), InvalidTargetException);
+
+		// the same code is accepted if v and w are distinct allocations
+		auto target = parseWithAllocations(builder, "{"
+		                                            "	for(uint<4> i = 0u .. 10u) {"
+		                                            "		v[i] = 1;"
+		                                            "	}"
+		                                            "	for(uint<4> k = 0u .. 10u) {"
+		                                            "		w[k] = 2;"
+		                                            "	}"
+		                                            "}");
+		ASSERT_TRUE(target);
+		EXPECT_NO_THROW(makeLoopFusion(0)->apply(target));
+
+		target = parseWithAllocations(builder, "for(uint<4> i = 0u .. 10u) {"
+		                                       "	v[i] = 1;"
+		                                       "	w[i] = 2;"
+		                                       "}");
+		ASSERT_TRUE(target);
+		EXPECT_NO_THROW(makeLoopFission(1)->apply(target));
+	}
+
+	TEST(LoopSkewing, Basic) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		EXPECT_THROW(LoopSkewingType().buildTransformation(parameter::makeValue(0u)), InvalidParametersException);
+
+		auto loop = builder.parseStmt("for(uint<4> i = 1u .. 9u) {"
+		                              "	for(uint<4> j = 1u .. 9u) {"
+		                              "		m[i][j] = m[i-1u][j+1u] + m[i][j-1u];"
+		                              "	}"
+		                              "}",
+		                              symbols)
+		                .as<core::ForStmtPtr>();
+		ASSERT_TRUE(loop);
+
+		// the original nest can not be interchanged
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+
+		auto res = makeLoopSkewing(1)->apply(loop).as<core::ForStmtPtr>();
+		ASSERT_TRUE(res);
+		EXPECT_TRUE(core::checks::check(res).empty()) << core::checks::check(res);
+
+		auto inner = res->getBody()[0].as<core::ForStmtPtr>();
+		ASSERT_TRUE(inner);
+		EXPECT_NE(loop->getBody()[0].as<core::ForStmtPtr>()->getIterator(), inner->getIterator());
+
+		// the skewed inner loop depends on the outer iterator
+		EXPECT_TRUE(core::analysis::contains(inner->getStart(), loop->getIterator()));
+	}
+
+	TEST(LoopSkewing, EnablesInterchange) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+		auto symbols = getSymbols(builder);
+
+		// dependences with distances (1,-1) and (0,1)
+		auto loop = builder.parseStmt("for(uint<4> i = 1u .. 9u) {"
+		                              "	for(uint<4> j = 1u .. 9u) {"
+		                              "		m[i][j] = m[i-1u][j+1u] + m[i][j-1u];"
+		                              "	}"
+		                              "}",
+		                              symbols)
+		                .as<core::ForStmtPtr>();
+		ASSERT_TRUE(loop);
+		EXPECT_THROW(makeLoopInterchange()->apply(loop), InvalidTargetException);
+
+		// after skewing the distances are (1,0) and (0,1), hence the interchange is legal
+		auto skewed = makeLoopSkewing(1)->apply(loop).as<core::ForStmtPtr>();
+		ASSERT_TRUE(skewed);
+		auto skewedInner = skewed->getBody()[0].as<core::ForStmtPtr>();
+
+		auto res = makeLoopInterchange()->apply(skewed).as<core::ForStmtPtr>();
+		ASSERT_TRUE(res);
+		EXPECT_TRUE(core::checks::check(res).empty()) << core::checks::check(res);
+
+		// the skewed iterator is now the outer one, covering the union of all skewed ranges
+		EXPECT_EQ(skewedInner->getIterator(), res->getIterator());
+		EXPECT_FALSE(core::analysis::contains(res->getStart(), loop->getIterator())) << *res->getStart();
+		EXPECT_FALSE(core::analysis::contains(res->getEnd(), loop->getIterator())) << *res->getEnd();
+
+		// the inner loop bounds are derived from the skewed iterator
+		auto inner = res->getBody()[0].as<core::ForStmtPtr>();
+		ASSERT_TRUE(inner);
+		EXPECT_EQ(loop->getIterator(), inner->getIterator());
+		EXPECT_TRUE(core::analysis::contains(inner->getStart(), res->getIterator()));
+		EXPECT_TRUE(core::analysis::contains(inner->getEnd(), res->getIterator()));
+		EXPECT_EQ(skewedInner->getBody(), inner->getBody());
+
+		// skewing by a factor that leaves a reversed dependence does still not permit the interchange
+		auto steep = builder.parseStmt("for(uint<4> i = 2u .. 9u) {"
+		                               "	for(uint<4> j = 0u .. 7u) {"
+		                               "		m[i][j] = m[i-1u][j+2u] + 1;"
+		                               "	}"
+		                               "}",
+		                               symbols);
+		ASSERT_TRUE(steep);
+		EXPECT_THROW(makeLoopInterchange()->apply(makeLoopSkewing(1)->apply(steep)), InvalidTargetException);
+		EXPECT_NO_THROW(makeLoopInterchange()->apply(makeLoopSkewing(2)->apply(steep)));
+	}
+
+} // end namespace loops
+} // end namespace transform
+} // end namespace insieme
@@ -38,6 +38,8 @@
 
 #include "insieme/transform/tasks/granularity_tuning.h"
 
+#include "insieme/annotations/meta_info/meta_infos.h"
+
 #include "insieme/core/ir_builder.h"
 #include "insieme/core/analysis/ir_utils.h"
 #include "insieme/core/printer/pretty_printer.h"
@@ -133,6 +135,83 @@ namespace tasks {
 		EXPECT_EQ(core::analysis::countInstances(definitions[6], builder.parseExpr("mergeAll()")), 1);
 	}
 
+	namespace {
+
+		annotations::task_granularity_info getVariantTable(const core::NodePtr& root) {
+			annotations::task_granularity_info res;
+			core::visitDepthFirstOnce(root, [&](const core::JobExprPtr& job) {
+				if(job->getBody()->hasAttachedValue<annotations::task_granularity_info>()) {
+					res = job->getBody()->getAttachedValue<annotations::task_granularity_info>();
+				}
+			});
+			return res;
+		}
+	}
+
+	TEST(GranularityTuning, VariantTable) {
+		core::NodeManager manager;
+		core::IRBuilder builder(manager);
+
+		// a fine-grained task: the cut-off is deferred as much as possible
+		auto fine = builder.parseProgram(R"1N5P1RE(
+			alias int = int<4>;
+			decl taskfun: (int)->unit;
+			def taskfun = (v: int) -> unit {
+				if(v == 0) {return;}
+				parallel(job [1..1] => taskfun(v-1));
+				parallel(job [1..1] => taskfun(v-2));
+				mergeAll();
+			};
+
+			unit main() {
+				taskfun(20);
+			}
+		)1N5P1RE");
+
+		auto opt = applyTaskOptimization(fine);
+		EXPECT_TRUE(core::checks::check(opt).empty()) << core::checks::check(opt);
+
+		auto table = getVariantTable(opt);
+		ASSERT_EQ(4u, table.unroll_factors.size());
+		ASSERT_EQ(4u, table.estimates.size());
+		EXPECT_EQ(1u, table.unroll_factors[0]);
+		EXPECT_LT(2u, table.unroll_factors[1]);
+		EXPECT_LT(table.unroll_factors[1], table.unroll_factors[2]);
+		EXPECT_EQ(0u, table.unroll_factors[3]);
+		EXPECT_LT(table.estimates[0], table.estimates[1]);
+		EXPECT_LT(table.estimates[1], table.estimates[2]);
+		EXPECT_LT(0u, table.min_variant);
+
+		// a coarse-grained task: the default unrolling is sufficient and all variants may be spawned
+		auto coarse = builder.parseProgram(R"1N5P1RE(
+			alias int = int<4>;
+			decl taskfun: (int, ref<array<int,10000>>)->unit;
+			def taskfun = (v: int, a : ref<array<int,10000>>) -> unit {
+				if(v == 0) {return;}
+				for(int i = 0 .. 10000) {
+					a[i] = v;
+				}
+				parallel(job [1..1] => taskfun(v-1, a));
+				parallel(job [1..1] => taskfun(v-2, a));
+				mergeAll();
+			};
+
+			unit main() {
+				var ref<array<int,10000>> a;
+				taskfun(20, a);
+			}
+		)1N5P1RE");
+
+		opt = applyTaskOptimization(coarse);
+		EXPECT_TRUE(core::checks::check(opt).empty()) << core::checks::check(opt);
+
+		table = getVariantTable(opt);
+		ASSERT_EQ(4u, table.unroll_factors.size());
+		EXPECT_EQ(2u, table.unroll_factors[1]);
+		EXPECT_EQ(4u, table.unroll_factors[2]);
+		EXPECT_EQ(0u, table.min_variant);
+	}
+
 } // end namespace tasks
 } // end namespace transform
 } // end namespace insieme
@@ -149,6 +149,19 @@ namespace compiler {
 	 */
 	bool compile(const vector<string>& sourcefiles, const string& targetfile, const Compiler& compiler = Compiler::getDefaultC99Compiler());
 
+	/**
+	 * Compiles the given source files as individual translation units using up to the given number of concurrent
+	 * compiler processes and links the resulting object files into the given target file. The object file of the
+	 * first source file is the first one passed to the linker.
+	 *
+	 * @param sourcefiles the files to be compiled
+	 * @param targetfile the file to be produced
+	 * @param compiler the compiler to be used for compiling and linking
+	 * @param jobs the maximum number of compiler processes to be run concurrently
+	 * @return true if successful, false otherwise
+	 */
+	bool compile(const vector<string>& sourcefiles, const string& targetfile, const Compiler& compiler, unsigned jobs);
+
 	/**
 	 * Compiles the given source file using the defined compiler (by default, it is the default C compiler) and
 	 * writes the resulting binary into the given target file.
@@ -36,11 +36,14 @@
 
 #include "insieme/utils/compiler/compiler.h"
 
+#include <atomic>
 #include <cstdio>
 #include <sstream>
 #include <fstream>
+#include <thread>
 
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 
 #include "insieme/utils/container_utils.h"
 #include "insieme/utils/config.h"
@@ -103,10 +106,14 @@ string Compiler::getCommand(const vector<string>& inputFiles, const string& outp
 	vector<string> before;
 	vector<string> after;
 
+	// language options do not apply when only linking object files
+	bool linkOnly = !inputFiles.empty() && all(inputFiles, [](const string& cur) { return boost::ends_with(cur, ".o"); });
+
 	// split up flags
 	for(auto cur : flags) {
 		// the -x option has to be before the input file
 		if(cur[0] == '-' && cur[1] == 'x') {
+			if(linkOnly) { continue; }
 			before.push_back(cur);
 		} else {
 			after.push_back(cur);
@@ -197,6 +204,45 @@ bool compile(const vector<string>& sourcefile, const string& targetfile, const C
 	return res == 0;
 }
 
+bool compile(const vector<string>& sourcefiles, const string& targetfile, const Compiler& compiler, unsigned jobs) {
+	// nothing to parallelize => use a single compiler invocation
+	if(sourcefiles.size() <= 1u || jobs <= 1u) { return compile(sourcefiles, targetfile, compiler); }
+
+	// compile the translation units to object files ...
+	Compiler unitCompiler = compiler;
+	unitCompiler.addFlag("-c");
+
+	vector<string> objects;
+	for(const auto& cur : sourcefiles) {
+		objects.push_back(fs::path(cur).replace_extension(".o").string());
+	}
+
+	// ... using a pool of threads, each of them running one compiler process at a time
+	std::atomic<unsigned> next(0);
+	std::atomic<bool> success(true);
+	vector<std::thread> workers;
+	for(unsigned i = 0; i < std::min<std::size_t>(jobs, sourcefiles.size()); ++i) {
+		workers.push_back(std::thread([&]() {
+			for(unsigned cur = next++; cur < sourcefiles.size() && success; cur = next++) {
+				if(!compile(toVector(sourcefiles[cur]), objects[cur], unitCompiler)) { success = false; }
+			}
+		}));
+	}
+	for(auto& cur : workers) {
+		cur.join();
+	}
+
+	// link the resulting object files
+	bool res = success && compile(objects, targetfile, compiler);
+
+	// clean up object files
+	for(const auto& cur : objects) {
+		if(fs::exists(cur)) { fs::remove(cur); }
+	}
+
+	return res;
+}
+
 bool compile(const string& sourcefile, const string& targetfile, const Compiler& compiler) {
 	vector<string> files(1);
 	files[0] = sourcefile;
@@ -230,12 +276,20 @@ bool compileToBinary(const VirtualPrintable& source, const string& targetFile, c
 	LOG(DEBUG) << "Using temporary file " << sourceFile << " as a source file for compilation.";
 
 	// write source to file
+	std::stringstream code;
+	code << source << "\n";
 	std::fstream srcFile(sourceFile.string(), std::fstream::out);
-	srcFile << source << "\n";
+	srcFile << code.str();
 	srcFile.close();
 
+	// simd loop hints emitted by the backend are only honoured (and not reported as unknown pragmas) if
+	// enabled - which does not require the OpenMP runtime
+	Compiler actual = compiler;
+	bool openmp = any(compiler.getFlags(), [](const string& cur) { return boost::starts_with(cur, "-fopenmp"); });
+	if(!openmp && code.str().find("#pragma omp simd") != string::npos) { actual.addFlag("-fopenmp-simd"); }
+
 	// perform compilation
-	bool success = compile(sourceFile.string(), targetFile, compiler);
+	bool success = compile(sourceFile.string(), targetFile, actual);
 
 	// delete source file - only if compilation was a success
 	if(boost::filesystem::exists(sourceFile)) {
@@ -100,6 +100,55 @@ namespace compiler {
 		EXPECT_TRUE(compile(code));
 	}
 
+	TEST(TargetCodeCompilerTest, SimdPragmas) {
+		string code = "int main() {\n"
+		              "	int a[16];\n"
+		              "	#pragma omp simd\n"
+		              "	for(int i = 0; i < 16; i++) { a[i] = i; }\n"
+		              "	return a[3] - 3;\n"
+		              "}\n\n";
+
+		// simd pragmas are enabled on demand, such that they are not reported as unknown pragmas
+		Compiler compiler = Compiler::getDefaultC99Compiler();
+		compiler.addFlag("-Werror");
+		EXPECT_TRUE(compile(code, compiler));
+	}
+
+	TEST(TargetCodeCompilerTest, ParallelCompilationTest) {
+		namespace fs = boost::filesystem;
+
+		// create two translation units referencing each other
+		fs::path dir = fs::unique_path(fs::temp_directory_path() / "insieme-ut-%%%%%%%%");
+		fs::create_directory(dir);
+		fs::path mainFile = dir / "main.c";
+		fs::path funFile = dir / "fun.c";
+		fs::path binFile = dir / "main";
+
+		fs::ofstream code;
+		code.open(mainFile);
+		code << "int fun(int x);\n\n";
+		code << "int main() {\n";
+		code << "	return fun(0);\n";
+		code << "}\n\n";
+		code.close();
+
+		code.open(funFile);
+		code << "int fun(int x) {\n";
+		code << "	return x;\n";
+		code << "}\n\n";
+		code.close();
+
+		// compile both units concurrently and link them
+		EXPECT_TRUE(compile(toVector(mainFile.string(), funFile.string()), binFile.string(), Compiler::getDefaultC99Compiler(), 2));
+		EXPECT_TRUE(fs::exists(binFile));
+
+		// intermediate object files have been removed
+		EXPECT_FALSE(fs::exists(dir / "main.o"));
+		EXPECT_FALSE(fs::exists(dir / "fun.o"));
+
+		fs::remove_all(dir);
+	}
+
 	TEST(TargetCodeCompiler, GetIncludePaths) {
 		EXPECT_FALSE(getDefaultCIncludePaths().empty());
 		EXPECT_FALSE(getDefaultCIncludePaths().empty());
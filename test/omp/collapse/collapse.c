@@ -0,0 +1,52 @@
+#include <stdio.h>
+
+#define N 7
+#define M 5
+#define K 3
+
+int main() {
+	int arr2[N][M];
+	int arr3[N][M][K];
+	long sum = 0;
+
+	#pragma omp parallel
+	{
+		#pragma omp for collapse(2) schedule(dynamic, 3)
+		for(int i = 0; i < N; ++i) {
+			for(int j = 0; j < M; ++j) {
+				arr2[i][j] = i * M + j;
+			}
+		}
+
+		#pragma omp for collapse(3) reduction(+ : sum)
+		for(int i = 1; i < N; i += 2) {
+			for(int j = 0; j < M; ++j) {
+				for(int k = 0; k < K; ++k) {
+					arr3[i][j][k] = i * 100 + j * 10 + k;
+					sum += arr3[i][j][k];
+				}
+			}
+		}
+	}
+
+	int ok = 1;
+	for(int i = 0; i < N; ++i) {
+		for(int j = 0; j < M; ++j) {
+			if(arr2[i][j] != i * M + j) { ok = 0; }
+		}
+	}
+	for(int i = 1; i < N; i += 2) {
+		for(int j = 0; j < M; ++j) {
+			for(int k = 0; k < K; ++k) {
+				if(arr3[i][j][k] != i * 100 + j * 10 + k) { ok = 0; }
+			}
+		}
+	}
+
+	printf("sum: %ld\n", sum);
+	if(ok) {
+		printf("Success!\n");
+	} else {
+		printf("Fail!\n");
+	}
+}
@@ -53,7 +53,7 @@ int main() {
 	}
 	printf("^: %d\n", res);
 
-/*
+
 	res = 12;
 	#pragma omp parallel for reduction(&&:res)
 	for(int i=1; i<=n; i++) {
@@ -68,5 +68,36 @@ int main() {
 		res = res || i;
 	}
 	printf("||: %d\n", res);
-*/
+
+
+	res = 12;
+	#pragma omp parallel for reduction(min:res)
+	for(int i=1; i<=n; i++) {
+		res = (i < res) ? i : res;
+	}
+	printf("min: %d\n", res);
+
+
+	res = 2;
+	#pragma omp parallel for reduction(max:res)
+	for(int i=1; i<=n; i++) {
+		res = (i > res) ? i : res;
+	}
+	printf("max: %d\n", res);
+
+
+	double dres = 0.5;
+	#pragma omp parallel for reduction(+:dres)
+	for(int i=1; i<=n; i++) {
+		dres += i * 0.25;
+	}
+	printf("+ (double): %.2f\n", dres);
+
+
+	dres = 1.5;
+	#pragma omp parallel for reduction(*:dres)
+	for(int i=1; i<=n; i++) {
+		dres *= i;
+	}
+	printf("* (double): %.2f\n", dres);
 }
@@ -0,0 +1,51 @@
+#include <stdio.h>
+
+#define N 8
+
+int main() {
+	int grid[N][N];
+	int chain = 0;
+	int log[N];
+	int pos = 0;
+
+	#pragma omp parallel
+	{
+		#pragma omp single
+		{
+			// a chain of tasks updating the same variable has to run in creation order
+			for(int i = 0; i < N; ++i) {
+				#pragma omp task depend(inout : chain)
+				{
+					chain = chain * 2 + i;
+					log[pos++] = i;
+				}
+			}
+
+			// wavefront: each cell depends on its upper and left neighbor
+			for(int i = 0; i < N; ++i) {
+				for(int j = 0; j < N; ++j) {
+					if(i == 0 || j == 0) {
+						#pragma omp task depend(out : grid[i][j])
+						grid[i][j] = 1;
+					} else {
+						#pragma omp task depend(in : grid[i - 1][j], grid[i][j - 1]) depend(out : grid[i][j])
+						grid[i][j] = (grid[i - 1][j] + grid[i][j - 1]) % 1000;
+					}
+				}
+			}
+			#pragma omp taskwait
+		}
+	}
+
+	printf("chain: %d\n", chain);
+	int ordered = 1;
+	for(int i = 0; i < N; ++i) {
+		if(log[i] != i) { ordered = 0; }
+	}
+	printf("ordered: %d\n", ordered);
+	for(int i = 0; i < N; ++i) {
+		printf("%d ", grid[i][N - 1]);
+	}
+	printf("\n");
+	return 0;
+}